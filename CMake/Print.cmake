@@ -19,6 +19,7 @@ function(ttk_print_summary)
     message(STATUS "TTK_ENABLE_ZLIB: ${TTK_ENABLE_ZLIB}")
     message(STATUS "ttk build -------------------------------------------------------------------")
     message(STATUS "CMAKE_BUILD_TYPE: ${CMAKE_BUILD_TYPE}")
+    message(STATUS "TTK_BUILD_BENCHMARKS: ${TTK_BUILD_BENCHMARKS}")
     message(STATUS "TTK_BUILD_DOCUMENTATION: ${TTK_BUILD_DOCUMENTATION}")
     if(TTK_BUILD_DOCUMENTATION)
         message(STATUS "  DOXYGEN_EXECUTABLE: ${DOXYGEN_EXECUTABLE}")
@@ -7,6 +7,7 @@ set(CMAKE_CXX_STANDARD 14)
 option(TTK_BUILD_VTK_WRAPPERS "Build the TTK VTK Wrappers" ON)
 cmake_dependent_option(TTK_BUILD_PARAVIEW_PLUGINS "Build the TTK ParaView Plugins" ON "TTK_BUILD_VTK_WRAPPERS" OFF)
 option(TTK_BUILD_STANDALONE_APPS "Build the TTK Standalone Applications" ON)
+option(TTK_BUILD_BENCHMARKS "Build the TTK benchmark suite (ttkBenchmarks)" OFF)
 option(TTK_WHITELIST_MODE "Explicitly enable each filter" OFF)
 mark_as_advanced(TTK_WHITELIST_MODE BUILD_SHARED_LIBS)
 
@@ -0,0 +1,103 @@
+#!/usr/bin/env python
+
+# /// \ingroup benchmarks
+# /// \date October 2026.
+# ///
+# /// \brief Compare two JSON files produced by ttkBenchmarks.
+# ///
+# /// Runs are matched by module, backend, field, dimension, size and
+# /// thread number. For each match, the best wall time (and the largest
+# /// peak memory) over the repetitions is compared. The script exits with
+# /// a non-zero status if one of the runs got slower than the given
+# /// threshold, so that it can be used in continuous integration.
+# ///
+# /// Usage:
+# /// \code
+# /// python compare.py baseline.json candidate.json --threshold 1.10
+# /// \endcode
+
+import argparse
+import json
+import sys
+
+KEY = ("module", "backend", "field", "dimension", "size", "threads")
+
+
+def load(path):
+    with open(path) as f:
+        runs = json.load(f)["runs"]
+    res = {}
+    for run in runs:
+        if run.get("status") != "ok":
+            continue
+        key = tuple(run[k] for k in KEY)
+        best = res.get(key)
+        if best is None:
+            res[key] = dict(run)
+        else:
+            best["wallTime"] = min(best["wallTime"], run["wallTime"])
+            best["peakMemory"] = max(best["peakMemory"], run["peakMemory"])
+    return res
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("baseline", help="reference JSON file")
+    parser.add_argument("candidate", help="JSON file to compare")
+    parser.add_argument(
+        "--threshold",
+        type=float,
+        default=1.10,
+        help="maximum accepted time ratio candidate/baseline (default 1.10)",
+    )
+    parser.add_argument(
+        "--min-time",
+        type=float,
+        default=1e-3,
+        help="ignore runs faster than this in the baseline (seconds)",
+    )
+    args = parser.parse_args()
+
+    base = load(args.baseline)
+    cand = load(args.candidate)
+
+    regressions = 0
+    header = "{:<26} {:<9} {:<7} {:>2} {:>5} {:>3} {:>10} {:>10} {:>7} {:>7}"
+    print(
+        header.format(
+            "module", "backend", "field", "D", "size", "T",
+            "base (s)", "cand (s)", "time", "mem",
+        )
+    )
+    for key in sorted(base.keys() & cand.keys(), key=str):
+        b, c = base[key], cand[key]
+        ratio = c["wallTime"] / max(b["wallTime"], 1e-12)
+        memRatio = c["peakMemory"] / max(b["peakMemory"], 1)
+        flag = ""
+        if ratio > args.threshold and b["wallTime"] >= args.min_time:
+            flag = " <-- slower"
+            regressions += 1
+        print(
+            header.format(
+                *[str(k) for k in key],
+                "{:.4f}".format(b["wallTime"]),
+                "{:.4f}".format(c["wallTime"]),
+                "{:.2f}x".format(ratio),
+                "{:.2f}x".format(memRatio),
+            )
+            + flag
+        )
+
+    for key in sorted(base.keys() - cand.keys(), key=str):
+        print("missing in candidate: " + " ".join(str(k) for k in key))
+    for key in sorted(cand.keys() - base.keys(), key=str):
+        print("missing in baseline: " + " ".join(str(k) for k in key))
+
+    if regressions:
+        print("{} run(s) slower than {:.2f}x".format(regressions, args.threshold))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
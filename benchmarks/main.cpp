@@ -0,0 +1,821 @@
+/// \ingroup benchmarks
+/// \date October 2026.
+///
+/// \brief Benchmark suite of the TTK base modules.
+///
+/// Synthetic scalar fields (random, Perlin noise, sinusoids) are
+/// generated on regular grids, either as implicit triangulations or as
+/// explicit (triangulated or tetrahedralized) meshes. Each selected
+/// module is then timed for every combination of field, triangulation
+/// backend and thread number. Every run is executed in a separate
+/// process (when available) so that its peak memory usage is not
+/// polluted by the previous runs.
+///
+/// The results are written in a JSON file, one record per run, with
+/// the total wall time, the peak memory usage (in kB) and the time of
+/// each phase (input generation, vertex order, preconditioning,
+/// execution). Two such files can be compared with compare.py.
+///
+/// The OrderArray module only times the vertex order computation, on the
+/// field stored as float, double and int (grid sides of 100 to 2155 in 3D
+/// cover 1e6 to 1e10 vertices, the latter needing TTK_ENABLE_64BIT_IDS).
+/// The KDTree module builds the KD-tree of a persistence diagram auction on
+/// one (birth, death) point per vertex (grid sides of 100 to 1000 in 2D
+/// cover 1e4 to 1e6 points) then times the bids of every point.
+/// The UnionFind module times the union-find workloads of its callers
+/// (lower link components of every vertex, as in
+/// ScalarFieldCriticalPoints, JacobiSet or ManifoldCheck, then a sweep
+/// merging the vertices by increasing order, as in ContourTree), with
+/// ttk::UnionFind then ttk::UnionFindArray.
+///
+/// Example:
+/// \code
+/// ttkBenchmarks -s 64 -D 3 -T 1 -T 8 -B implicit -B explicit -o run.json
+/// ttkBenchmarks -s 215 -D 3 -M OrderArray -B implicit -F random -o order.json
+/// ttkBenchmarks -s 1000 -D 2 -M KDTree -B implicit -F random -o kdtree.json
+/// ttkBenchmarks -s 100 -D 3 -M UnionFind -B implicit -F perlin -o uf.json
+/// \endcode
+
+#include <CommandLineParser.h>
+#include <FTMTree.h>
+#include <KDTree.h>
+#include <MorseSmaleComplex.h>
+#include <OrderDisambiguation.h>
+#include <Os.h>
+#include <PersistenceDiagram.h>
+#include <ScalarFieldCriticalPoints.h>
+#include <Timer.h>
+#include <Triangulation.h>
+#include <UnionFind.h>
+#include <UnionFindArray.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/wait.h>
+#include <unistd.h>
+#define TTK_BENCHMARKS_FORK
+#endif
+
+namespace {
+
+  const std::vector<std::string> allFields{"random", "perlin", "sine"};
+  const std::vector<std::string> allBackends{
+    "implicit", "hybrid", "periodic", "explicit"};
+  const std::vector<std::string> allModules{
+    "Preconditions",     "OrderArray", "ScalarFieldCriticalPoints",
+    "PersistenceDiagram", "MorseSmaleComplex", "FTMTree",
+    "KDTree",            "UnionFind"};
+
+  struct Case {
+    std::string module{};
+    std::string backend{};
+    std::string field{};
+    int dimension{};
+    int size{};
+    int threads{};
+    int repetition{};
+  };
+
+  /**
+   * @brief Ordered list of named timings
+   */
+  using Phases = std::vector<std::pair<std::string, double>>;
+
+  /**
+   * @brief Improved Perlin noise (K. Perlin, SIGGRAPH 2002)
+   */
+  class PerlinNoise {
+  public:
+    explicit PerlinNoise(const unsigned int seed) {
+      std::array<int, 256> p{};
+      std::iota(p.begin(), p.end(), 0);
+      std::shuffle(p.begin(), p.end(), std::mt19937{seed});
+      for(size_t i = 0; i < perm_.size(); ++i) {
+        perm_[i] = p[i % p.size()];
+      }
+    }
+
+    double operator()(double x, double y, double z) const {
+      const int X = static_cast<int>(std::floor(x)) & 255;
+      const int Y = static_cast<int>(std::floor(y)) & 255;
+      const int Z = static_cast<int>(std::floor(z)) & 255;
+      x -= std::floor(x);
+      y -= std::floor(y);
+      z -= std::floor(z);
+      const double u = fade(x), v = fade(y), w = fade(z);
+      const int A = perm_[X] + Y, AA = perm_[A] + Z, AB = perm_[A + 1] + Z;
+      const int B = perm_[X + 1] + Y, BA = perm_[B] + Z, BB = perm_[B + 1] + Z;
+      return lerp(
+        w,
+        lerp(v,
+             lerp(u, grad(perm_[AA], x, y, z), grad(perm_[BA], x - 1, y, z)),
+             lerp(u, grad(perm_[AB], x, y - 1, z),
+                  grad(perm_[BB], x - 1, y - 1, z))),
+        lerp(v,
+             lerp(u, grad(perm_[AA + 1], x, y, z - 1),
+                  grad(perm_[BA + 1], x - 1, y, z - 1)),
+             lerp(u, grad(perm_[AB + 1], x, y - 1, z - 1),
+                  grad(perm_[BB + 1], x - 1, y - 1, z - 1))));
+    }
+
+  private:
+    static double fade(const double t) {
+      return t * t * t * (t * (t * 6 - 15) + 10);
+    }
+    static double lerp(const double t, const double a, const double b) {
+      return a + t * (b - a);
+    }
+    static double grad(const int hash, const double x, const double y,
+                       const double z) {
+      const int h = hash & 15;
+      const double u = h < 8 ? x : y;
+      const double v = h < 4 ? y : (h == 12 || h == 14 ? x : z);
+      return ((h & 1) == 0 ? u : -u) + ((h & 2) == 0 ? v : -v);
+    }
+
+    std::array<int, 512> perm_{};
+  };
+
+  std::array<ttk::SimplexId, 3> gridDimensions(const Case &c) {
+    return {c.size, c.size, c.dimension == 3 ? c.size : 1};
+  }
+
+  void generateField(const Case &c, std::vector<float> &field) {
+    const auto dims = gridDimensions(c);
+    const size_t nVerts = static_cast<size_t>(dims[0]) * dims[1] * dims[2];
+    field.resize(nVerts);
+    const double h = 1.0 / (c.size - 1);
+
+    if(c.field == "random") {
+      std::mt19937 gen{0};
+      for(auto &f : field) {
+        // do not rely on std::uniform_real_distribution, which is
+        // implementation-defined
+        f = static_cast<float>(gen() >> 8) / static_cast<float>(1 << 24);
+      }
+      return;
+    }
+
+    const PerlinNoise noise{0};
+    for(ttk::SimplexId k = 0; k < dims[2]; ++k) {
+      for(ttk::SimplexId j = 0; j < dims[1]; ++j) {
+        for(ttk::SimplexId i = 0; i < dims[0]; ++i) {
+          const double x = i * h, y = j * h, z = k * h;
+          double f{};
+          if(c.field == "perlin") {
+            // four octaves, starting at four periods per domain side
+            double freq = 4.0, amp = 1.0;
+            for(int o = 0; o < 4; ++o) {
+              f += amp * noise(freq * x + 0.5, freq * y + 0.5, freq * z + 0.5);
+              freq *= 2.0;
+              amp *= 0.5;
+            }
+          } else {
+            // three periods per domain side
+            const double a = 6.0 * 3.14159265358979323846;
+            f = std::sin(a * x) * std::sin(a * y) * std::cos(a * z);
+          }
+          field[i + static_cast<size_t>(dims[0]) * (j + dims[1] * k)]
+            = static_cast<float>(f);
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief Triangulate (2D) or tetrahedralize (3D) the grid with a
+   * Freudenthal (Kuhn) subdivision
+   */
+  void generateMesh(const Case &c,
+                    std::vector<float> &points,
+                    std::vector<ttk::LongSimplexId> &connectivity,
+                    std::vector<ttk::LongSimplexId> &offsets) {
+    const auto dims = gridDimensions(c);
+    const auto vertexId = [&dims](const ttk::SimplexId i,
+                                  const ttk::SimplexId j,
+                                  const ttk::SimplexId k) {
+      return i + dims[0] * (j + dims[1] * k);
+    };
+
+    points.reserve(3 * dims[0] * dims[1] * dims[2]);
+    for(ttk::SimplexId k = 0; k < dims[2]; ++k) {
+      for(ttk::SimplexId j = 0; j < dims[1]; ++j) {
+        for(ttk::SimplexId i = 0; i < dims[0]; ++i) {
+          points.insert(points.end(), {static_cast<float>(i),
+                                       static_cast<float>(j),
+                                       static_cast<float>(k)});
+        }
+      }
+    }
+
+    offsets.emplace_back(0);
+    if(c.dimension == 2) {
+      for(ttk::SimplexId j = 0; j < dims[1] - 1; ++j) {
+        for(ttk::SimplexId i = 0; i < dims[0] - 1; ++i) {
+          connectivity.insert(
+            connectivity.end(), {vertexId(i, j, 0), vertexId(i + 1, j, 0),
+                                 vertexId(i + 1, j + 1, 0),
+                                 vertexId(i, j, 0), vertexId(i, j + 1, 0),
+                                 vertexId(i + 1, j + 1, 0)});
+          offsets.emplace_back(offsets.back() + 3);
+          offsets.emplace_back(offsets.back() + 3);
+        }
+      }
+      return;
+    }
+
+    // one tetrahedron per monotone path between opposite cube corners
+    std::array<int, 3> axes{0, 1, 2};
+    std::vector<std::array<int, 3>> paths{};
+    do {
+      paths.emplace_back(axes);
+    } while(std::next_permutation(axes.begin(), axes.end()));
+
+    for(ttk::SimplexId k = 0; k < dims[2] - 1; ++k) {
+      for(ttk::SimplexId j = 0; j < dims[1] - 1; ++j) {
+        for(ttk::SimplexId i = 0; i < dims[0] - 1; ++i) {
+          for(const auto &path : paths) {
+            std::array<ttk::SimplexId, 3> corner{i, j, k};
+            connectivity.emplace_back(vertexId(corner[0], corner[1], corner[2]));
+            for(const auto axis : path) {
+              corner[axis]++;
+              connectivity.emplace_back(
+                vertexId(corner[0], corner[1], corner[2]));
+            }
+            offsets.emplace_back(offsets.back() + 4);
+          }
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief ttk::UnionFind behind the interface of ttk::UnionFindArray, used
+   * the way its callers did (one object per element, the sets are
+   * tracked by pointers to their representatives)
+   */
+  class PointerUnionFind {
+  public:
+    explicit PointerUnionFind(const size_t nElements)
+      : seeds_(nElements), sets_(nElements) {
+      for(size_t i = 0; i < nElements; ++i) {
+        sets_[i] = &seeds_[i];
+      }
+    }
+
+    ttk::UnionFind *find(const ttk::SimplexId id) {
+      return sets_[id]->find();
+    }
+
+    void makeUnion(const ttk::SimplexId id0, const ttk::SimplexId id1) {
+      sets_[id0] = ttk::UnionFind::makeUnion(sets_[id0], sets_[id1]);
+      sets_[id1] = sets_[id0];
+    }
+
+    size_t getSetNumber() {
+      for(auto &set : sets_) {
+        set = set->find();
+      }
+      std::vector<ttk::UnionFind *> roots{sets_};
+      std::sort(roots.begin(), roots.end());
+      return std::unique(roots.begin(), roots.end()) - roots.begin();
+    }
+
+  private:
+    std::vector<ttk::UnionFind> seeds_;
+    std::vector<ttk::UnionFind *> sets_;
+  };
+
+  /**
+   * @brief Total number of lower link components of the vertices, computed
+   * as in ttk::ScalarFieldCriticalPoints
+   */
+  template <typename UF>
+  size_t lowerLinkComponents(const ttk::Triangulation &triangulation,
+                             const std::vector<ttk::SimplexId> &order,
+                             const int threads) {
+    const ttk::SimplexId nVerts = order.size();
+    size_t res{};
+    TTK_FORCE_USE(threads);
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threads) reduction(+ : res)
+#endif // TTK_ENABLE_OPENMP
+    for(ttk::SimplexId v = 0; v < nVerts; ++v) {
+      std::vector<ttk::SimplexId> lowerNeighbors{};
+      const auto neighborNumber = triangulation.getVertexNeighborNumber(v);
+      for(ttk::SimplexId k = 0; k < neighborNumber; ++k) {
+        ttk::SimplexId neighbor{};
+        triangulation.getVertexNeighbor(v, k, neighbor);
+        if(order[neighbor] < order[v]) {
+          lowerNeighbors.emplace_back(neighbor);
+        }
+      }
+      const auto localId = [&lowerNeighbors](const ttk::SimplexId id) {
+        const auto it
+          = std::find(lowerNeighbors.begin(), lowerNeighbors.end(), id);
+        return it == lowerNeighbors.end() ? -1 : it - lowerNeighbors.begin();
+      };
+
+      UF seeds(lowerNeighbors.size());
+      const auto starNumber = triangulation.getVertexStarNumber(v);
+      for(ttk::SimplexId s = 0; s < starNumber; ++s) {
+        ttk::SimplexId cell{};
+        triangulation.getVertexStar(v, s, cell);
+        const auto cellVertexNumber = triangulation.getCellVertexNumber(cell);
+        for(ttk::SimplexId i = 0; i < cellVertexNumber; ++i) {
+          ttk::SimplexId vi{};
+          triangulation.getCellVertex(cell, i, vi);
+          const auto li = localId(vi);
+          for(ttk::SimplexId j = i + 1; j < cellVertexNumber && li != -1;
+              ++j) {
+            ttk::SimplexId vj{};
+            triangulation.getCellVertex(cell, j, vj);
+            const auto lj = localId(vj);
+            if(lj != -1) {
+              seeds.makeUnion(li, lj);
+            }
+          }
+        }
+      }
+      res += seeds.getSetNumber();
+    }
+    return res;
+  }
+
+  /**
+   * @brief Number of merges of a sweep of the vertices by increasing order,
+   * computed as the join tree of ttk::ContourTree
+   */
+  template <typename UF>
+  size_t sweepMerges(const ttk::Triangulation &triangulation,
+                     const std::vector<ttk::SimplexId> &order) {
+    const ttk::SimplexId nVerts = order.size();
+    std::vector<ttk::SimplexId> sorted(nVerts);
+    for(ttk::SimplexId v = 0; v < nVerts; ++v) {
+      sorted[order[v]] = v;
+    }
+    UF uf(nVerts);
+    size_t res{};
+    for(const auto v : sorted) {
+      const auto neighborNumber = triangulation.getVertexNeighborNumber(v);
+      for(ttk::SimplexId k = 0; k < neighborNumber; ++k) {
+        ttk::SimplexId neighbor{};
+        triangulation.getVertexNeighbor(v, k, neighbor);
+        if(order[neighbor] < order[v] && uf.find(neighbor) != uf.find(v)) {
+          uf.makeUnion(neighbor, v);
+          res++;
+        }
+      }
+    }
+    return res;
+  }
+
+  int runModule(const Case &c,
+                ttk::Triangulation &triangulation,
+                const std::vector<float> &field,
+                Phases &phases) {
+
+    const int debugLevel = static_cast<int>(ttk::debug::Priority::WARNING);
+    const auto nVerts = field.size();
+    std::vector<ttk::SimplexId> order(nVerts);
+    triangulation.setThreadNumber(c.threads);
+
+    ttk::Timer tm{};
+    int ret{};
+
+    if(c.module == "Preconditions") {
+      // the preconditioning functions commonly required by the modules
+      const std::vector<
+        std::pair<std::string, std::function<int(ttk::Triangulation &)>>>
+        preconditions{
+          {"VertexNeighbors",
+           [](ttk::Triangulation &t) { return t.preconditionVertexNeighbors(); }},
+          {"VertexStars",
+           [](ttk::Triangulation &t) { return t.preconditionVertexStars(); }},
+          {"Edges", [](ttk::Triangulation &t) { return t.preconditionEdges(); }},
+          {"EdgeStars",
+           [](ttk::Triangulation &t) { return t.preconditionEdgeStars(); }},
+          {"Triangles",
+           [](ttk::Triangulation &t) { return t.preconditionTriangles(); }},
+          {"TriangleStars",
+           [](ttk::Triangulation &t) { return t.preconditionTriangleStars(); }},
+          {"BoundaryVertices",
+           [](ttk::Triangulation &t) {
+             return t.preconditionBoundaryVertices();
+           }},
+        };
+      for(const auto &p : preconditions) {
+        if(p.first == "TriangleStars" && c.dimension < 3) {
+          // triangles have no star in 2D
+          continue;
+        }
+        tm.reStart();
+        ret |= p.second(triangulation);
+        phases.emplace_back(p.first, tm.getElapsedTime());
+      }
+      return ret;
+    }
+
+    if(c.module == "OrderArray") {
+      // vertex order of the field stored with several scalar types
+      const std::vector<double> fieldDouble(field.begin(), field.end());
+      std::vector<int> fieldInt(nVerts);
+      for(size_t i = 0; i < nVerts; ++i) {
+        fieldInt[i] = static_cast<int>(std::ldexp(field[i], 20));
+      }
+      tm.reStart();
+      ttk::preconditionOrderArray(
+        nVerts, field.data(), order.data(), c.threads);
+      phases.emplace_back("float", tm.getElapsedTime());
+      tm.reStart();
+      ttk::preconditionOrderArray(
+        nVerts, fieldDouble.data(), order.data(), c.threads);
+      phases.emplace_back("double", tm.getElapsedTime());
+      tm.reStart();
+      ttk::preconditionOrderArray(
+        nVerts, fieldInt.data(), order.data(), c.threads);
+      phases.emplace_back("int", tm.getElapsedTime());
+      return ret;
+    }
+
+    if(c.module == "KDTree") {
+      // diagram points from pairs of consecutive values, embedded as in
+      // ttk::PersistenceDiagramAuction (no geometrical lifting)
+      using KDT = ttk::KDTree<double, std::array<double, 5>>;
+      const int nPoints = nVerts;
+      std::vector<double> coordinates(2 * nVerts);
+      for(size_t i = 0; i < nVerts; ++i) {
+        const double a = field[i], b = field[(i + 1) % nVerts];
+        coordinates[2 * i] = std::min(a, b);
+        coordinates[2 * i + 1] = std::max(a, b);
+      }
+      tm.reStart();
+      KDT kdt{true, 2};
+      kdt.setThreadNumber(c.threads);
+      kdt.build(coordinates.data(), nPoints, 2);
+      phases.emplace_back("build", tm.getElapsedTime());
+
+      // two closest goods of every bidder, as in ttk::Bidder::runKDTBidding,
+      // then the price updates, separately then interleaved (sequential
+      // bidding)
+      const auto bid = [&](const int i) {
+        const std::array<double, 5> point{
+          coordinates[2 * i], coordinates[2 * i + 1], 0, 0, 0};
+        std::vector<KDT *> neighbours{};
+        std::vector<double> costs{};
+        kdt.getKClosest(2, point, neighbours, costs);
+        return neighbours[costs.size() == 2 && costs[1] < costs[0] ? 1 : 0];
+      };
+      std::vector<KDT *> closest(nPoints);
+      tm.reStart();
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(c.threads)
+#endif // TTK_ENABLE_OPENMP
+      for(int i = 0; i < nPoints; ++i) {
+        closest[i] = bid(i);
+      }
+      phases.emplace_back("query", tm.getElapsedTime());
+      tm.reStart();
+      for(int i = 0; i < nPoints; ++i) {
+        closest[i]->updateWeight(closest[i]->getWeight() + 1e-3);
+      }
+      phases.emplace_back("update", tm.getElapsedTime());
+      tm.reStart();
+      for(int i = 0; i < nPoints; ++i) {
+        auto *const good = bid(i);
+        good->updateWeight(good->getWeight() + 1e-3);
+      }
+      phases.emplace_back("auction", tm.getElapsedTime());
+      return ret;
+    }
+
+    ttk::preconditionOrderArray(nVerts, field.data(), order.data(), c.threads);
+    phases.emplace_back("order", tm.getElapsedTime());
+
+    if(c.module == "UnionFind") {
+      tm.reStart();
+      triangulation.preconditionVertexNeighbors();
+      triangulation.preconditionVertexStars();
+      phases.emplace_back("precondition", tm.getElapsedTime());
+      tm.reStart();
+      const auto linkPointer = lowerLinkComponents<PointerUnionFind>(
+        triangulation, order, c.threads);
+      phases.emplace_back("link-UnionFind", tm.getElapsedTime());
+      tm.reStart();
+      const auto linkArray
+        = lowerLinkComponents<ttk::UnionFindArray<ttk::SimplexId>>(
+          triangulation, order, c.threads);
+      phases.emplace_back("link-UnionFindArray", tm.getElapsedTime());
+      tm.reStart();
+      const auto sweepPointer
+        = sweepMerges<PointerUnionFind>(triangulation, order);
+      phases.emplace_back("sweep-UnionFind", tm.getElapsedTime());
+      tm.reStart();
+      const auto sweepArray = sweepMerges<ttk::UnionFindArray<ttk::SimplexId>>(
+        triangulation, order);
+      phases.emplace_back("sweep-UnionFindArray", tm.getElapsedTime());
+      // both implementations should find the same components
+      return linkPointer == linkArray && sweepPointer == sweepArray ? 0 : -1;
+    }
+
+    const auto triangulationType = triangulation.getType();
+    const auto data = triangulation.getData();
+
+    if(c.module == "ScalarFieldCriticalPoints") {
+      std::vector<std::pair<ttk::SimplexId, char>> criticalPoints{};
+      ttk::ScalarFieldCriticalPoints module{};
+      module.setDebugLevel(debugLevel);
+      module.setThreadNumber(c.threads);
+      tm.reStart();
+      module.preconditionTriangulation(&triangulation);
+      module.setOutput(&criticalPoints);
+      phases.emplace_back("precondition", tm.getElapsedTime());
+      tm.reStart();
+      ttkTemplateMacro(
+        triangulationType,
+        (ret = module.execute(order.data(), static_cast<TTK_TT *>(data))));
+      phases.emplace_back("execute", tm.getElapsedTime());
+
+    } else if(c.module == "PersistenceDiagram") {
+      std::vector<ttk::PersistencePair> diagram{};
+      ttk::PersistenceDiagram module{};
+      module.setDebugLevel(debugLevel);
+      module.setThreadNumber(c.threads);
+      tm.reStart();
+      module.preconditionTriangulation(&triangulation);
+      phases.emplace_back("precondition", tm.getElapsedTime());
+      tm.reStart();
+      ttkTemplateMacro(
+        triangulationType,
+        (ret = module.execute(diagram, field.data(), 0, order.data(),
+                              static_cast<TTK_TT *>(data))));
+      phases.emplace_back("execute", tm.getElapsedTime());
+
+    } else if(c.module == "MorseSmaleComplex") {
+      ttk::MorseSmaleComplex::OutputCriticalPoints outCriticalPoints{};
+      ttk::MorseSmaleComplex::Output1Separatrices out1Separatrices{};
+      ttk::MorseSmaleComplex::Output2Separatrices out2Separatrices{};
+      std::vector<ttk::SimplexId> ascending(nVerts), descending(nVerts),
+        morseSmale(nVerts);
+      ttk::MorseSmaleComplex::OutputManifold outManifold{
+        ascending.data(), descending.data(), morseSmale.data()};
+      ttk::MorseSmaleComplex module{};
+      module.setDebugLevel(debugLevel);
+      module.setThreadNumber(c.threads);
+      tm.reStart();
+      module.preconditionTriangulation(&triangulation);
+      phases.emplace_back("precondition", tm.getElapsedTime());
+      tm.reStart();
+      ttkTemplateMacro(
+        triangulationType,
+        (ret = module.execute(outCriticalPoints, out1Separatrices,
+                              out2Separatrices, outManifold, field.data(), 0,
+                              order.data(), *static_cast<TTK_TT *>(data))));
+      phases.emplace_back("execute", tm.getElapsedTime());
+
+    } else if(c.module == "FTMTree") {
+      ttk::ftm::FTMTree module{};
+      module.setDebugLevel(debugLevel);
+      module.setThreadNumber(c.threads);
+      tm.reStart();
+      module.preconditionTriangulation(&triangulation);
+      module.setVertexScalars(field.data());
+      module.setVertexSoSoffsets(order.data());
+      module.setTreeType(ttk::ftm::TreeType::Contour);
+      module.setSegmentation(true);
+      phases.emplace_back("precondition", tm.getElapsedTime());
+      tm.reStart();
+      ttkTemplateMacro(triangulationType,
+                       (module.build<float>(static_cast<TTK_TT *>(data))));
+      phases.emplace_back("execute", tm.getElapsedTime());
+    }
+
+    return ret;
+  }
+
+  std::string jsonRecord(const Case &c,
+                         const size_t nVerts,
+                         const bool success,
+                         const Phases &phases,
+                         const double peakMemory) {
+    double wallTime{};
+    std::stringstream phasesStream{};
+    for(size_t i = 0; i < phases.size(); ++i) {
+      // input generation is not part of the module cost
+      if(phases[i].first != "input") {
+        wallTime += phases[i].second;
+      }
+      phasesStream << (i == 0 ? "" : ", ") << "\"" << phases[i].first
+                   << "\": " << phases[i].second;
+    }
+
+    std::stringstream s{};
+    s << "{\"module\": \"" << c.module << "\", \"backend\": \"" << c.backend
+      << "\", \"field\": \"" << c.field << "\", \"dimension\": " << c.dimension
+      << ", \"size\": " << c.size << ", \"vertices\": " << nVerts
+      << ", \"threads\": " << c.threads << ", \"repetition\": " << c.repetition
+      << ", \"status\": \"" << (success ? "ok" : "failed") << "\"";
+    if(success) {
+      s << ", \"wallTime\": " << wallTime << ", \"peakMemory\": " << peakMemory
+        << ", \"phases\": {" << phasesStream.str() << "}";
+    }
+    s << "}";
+    return s.str();
+  }
+
+  std::string runCase(const Case &c) {
+    Phases phases{};
+    ttk::Timer tm{};
+
+    std::vector<float> field{}, points{};
+    std::vector<ttk::LongSimplexId> connectivity{}, offsets{};
+    generateField(c, field);
+
+    ttk::Triangulation triangulation{};
+    triangulation.setDebugLevel(
+      static_cast<int>(ttk::debug::Priority::WARNING));
+    if(c.backend == "explicit") {
+      generateMesh(c, points, connectivity, offsets);
+      triangulation.setInputPoints(field.size(), points.data());
+      const ttk::SimplexId nCells = offsets.size() - 1;
+#ifdef TTK_CELL_ARRAY_NEW
+      triangulation.setInputCells(nCells, connectivity.data(), offsets.data());
+#else
+      ttk::LongSimplexId *cells{};
+      ttk::CellArray::TranslateToFlatLayout(connectivity, offsets, cells);
+      triangulation.setInputCells(nCells, cells);
+#endif
+    } else {
+      const auto dims = gridDimensions(c);
+      triangulation.setInputGrid(0, 0, 0, 1, 1, 1, dims[0], dims[1], dims[2]);
+      triangulation.setPeriodicBoundaryConditions(c.backend == "periodic");
+      triangulation.setImplicitPreconditions(
+        c.backend == "implicit"
+          ? ttk::Triangulation::STRATEGY::NO_PRECONDITIONS
+          : ttk::Triangulation::STRATEGY::WITH_PRECONDITIONS);
+    }
+    phases.emplace_back("input", tm.getElapsedTime());
+
+    const auto ret = runModule(c, triangulation, field, phases);
+
+    return jsonRecord(c, field.size(), ret == 0, phases,
+                      ttk::OsCall::getTotalMemoryUsage());
+  }
+
+  /**
+   * @brief Run a case in a child process and return its JSON record
+   */
+  std::string runIsolatedCase(const Case &c) {
+#ifdef TTK_BENCHMARKS_FORK
+    int fds[2];
+    if(pipe(fds) == 0) {
+      const pid_t pid = fork();
+      if(pid == 0) {
+        close(fds[0]);
+        const auto record = runCase(c);
+        size_t written = 0;
+        while(written < record.size()) {
+          const auto n
+            = write(fds[1], record.data() + written, record.size() - written);
+          if(n <= 0) {
+            break;
+          }
+          written += n;
+        }
+        close(fds[1]);
+        _exit(0);
+      }
+      close(fds[1]);
+      if(pid > 0) {
+        std::string record{};
+        std::array<char, 4096> buffer{};
+        ssize_t n{};
+        while((n = read(fds[0], buffer.data(), buffer.size())) > 0) {
+          record.append(buffer.data(), n);
+        }
+        close(fds[0]);
+        int status{};
+        waitpid(pid, &status, 0);
+        if(!WIFEXITED(status) || WEXITSTATUS(status) != 0 || record.empty()) {
+          return jsonRecord(c, 0, false, {}, 0);
+        }
+        return record;
+      }
+      close(fds[0]);
+    }
+#endif // TTK_BENCHMARKS_FORK
+    return runCase(c);
+  }
+
+  bool checkValues(const std::vector<std::string> &values,
+                   const std::vector<std::string> &allowed,
+                   const std::string &kind,
+                   const ttk::Debug &dbg) {
+    for(const auto &v : values) {
+      if(std::find(allowed.begin(), allowed.end(), v) == allowed.end()) {
+        dbg.printErr("Unknown " + kind + " `" + v + "'");
+        return false;
+      }
+    }
+    return true;
+  }
+
+} // namespace
+
+int main(int argc, char **argv) {
+
+  int size{64}, dimension{3}, repetitions{1};
+  std::vector<int> threads{};
+  std::vector<std::string> fields{}, backends{}, modules{};
+  std::string outputPath{"benchmarks.json"};
+
+  ttk::CommandLineParser parser;
+  parser.setArgument("s", &size, "Number of vertices per grid side", true);
+  parser.setArgument("D", &dimension, "Grid dimension (2 or 3)", true);
+  parser.setArgument("T", &threads, "Thread numbers (repeatable)", true);
+  parser.setArgument(
+    "F", &fields, "Fields: random, perlin, sine (repeatable)", true);
+  parser.setArgument(
+    "B", &backends, "Backends: implicit, hybrid, periodic, explicit", true);
+  parser.setArgument("M", &modules,
+                     "Modules: Preconditions, OrderArray, "
+                     "ScalarFieldCriticalPoints, PersistenceDiagram, "
+                     "MorseSmaleComplex, FTMTree, KDTree, UnionFind",
+                     true);
+  parser.setArgument("r", &repetitions, "Number of repetitions", true);
+  parser.setArgument("o", &outputPath, "Output JSON file", true);
+  parser.parse(argc, argv);
+
+  ttk::Debug dbg;
+  dbg.setDebugLevel(ttk::globalDebugLevel_);
+  dbg.setDebugMsgPrefix("Benchmarks");
+
+  if(threads.empty()) {
+    threads = {1};
+    if(ttk::OsCall::getNumberOfCores() > 1) {
+      threads.emplace_back(ttk::OsCall::getNumberOfCores());
+    }
+  }
+  if(fields.empty()) {
+    fields = allFields;
+  }
+  if(backends.empty()) {
+    backends = {"implicit", "explicit"};
+  }
+  if(modules.empty()) {
+    modules = allModules;
+  }
+  if(!checkValues(fields, allFields, "field", dbg)
+     || !checkValues(backends, allBackends, "backend", dbg)
+     || !checkValues(modules, allModules, "module", dbg)) {
+    return -1;
+  }
+  if(size < 2 || (dimension != 2 && dimension != 3)) {
+    dbg.printErr("Invalid grid size or dimension");
+    return -2;
+  }
+
+  std::ofstream output{outputPath};
+  if(!output) {
+    dbg.printErr("Could not write output file `" + outputPath + "'!");
+    return -3;
+  }
+
+  output << "{\n  \"runs\": [";
+  bool first = true;
+  for(const auto &module : modules) {
+    for(const auto &field : fields) {
+      for(const auto &backend : backends) {
+        for(const auto nThreads : threads) {
+          for(int r = 0; r < repetitions; ++r) {
+            const Case c{module, backend,  field, dimension,
+                         size,   nThreads, r};
+            ttk::Timer tm{};
+            const auto record = runIsolatedCase(c);
+            output << (first ? "\n    " : ",\n    ") << record;
+            output.flush();
+            first = false;
+            dbg.printMsg(module + " " + field + " " + backend, 1.0,
+                         tm.getElapsedTime(), nThreads);
+          }
+        }
+      }
+    }
+  }
+  output << "\n  ]\n}\n";
+
+  dbg.printMsg("Wrote `" + outputPath + "'");
+
+  return 0;
+}
@@ -59,6 +59,9 @@ int AbstractTriangulation::clear() {
   vertexStarList_.clear();
   vertexTriangleList_.clear();
 
+  // the cached gradients were computed on the previous cells
+  this->resetGradientCache();
+
   return 0;
 }
 
@@ -141,3 +144,47 @@ size_t AbstractTriangulation::footprint(size_t size) const {
 
   return size;
 }
+
+#ifdef TTK_ENABLE_MPI
+
+void AbstractTriangulation::preconditionGhostCellLocalIds() {
+  const auto toLocalIds = [this](const std::vector<SimplexId> &globalIds) {
+    std::vector<SimplexId> localIds(globalIds.size());
+    for(size_t i = 0; i < globalIds.size(); ++i) {
+      localIds[i] = this->getCellLocalIdInternal(globalIds[i]);
+    }
+    return localIds;
+  };
+  this->ghostCellLocalIdsPerOwner_.resize(this->ghostCellsPerOwner_.size());
+  for(size_t r = 0; r < this->ghostCellsPerOwner_.size(); ++r) {
+    this->ghostCellLocalIdsPerOwner_[r]
+      = toLocalIds(this->ghostCellsPerOwner_[r]);
+  }
+  this->remoteGhostCellLocalIds_.resize(this->remoteGhostCells_.size());
+  for(size_t r = 0; r < this->remoteGhostCells_.size(); ++r) {
+    this->remoteGhostCellLocalIds_[r] = toLocalIds(this->remoteGhostCells_[r]);
+  }
+}
+
+void AbstractTriangulation::preconditionGhostVertexLocalIds() {
+  const auto toLocalIds = [this](const std::vector<SimplexId> &globalIds) {
+    std::vector<SimplexId> localIds(globalIds.size());
+    for(size_t i = 0; i < globalIds.size(); ++i) {
+      localIds[i] = this->getVertexLocalIdInternal(globalIds[i]);
+    }
+    return localIds;
+  };
+  this->ghostVertexLocalIdsPerOwner_.resize(
+    this->ghostVerticesPerOwner_.size());
+  for(size_t r = 0; r < this->ghostVerticesPerOwner_.size(); ++r) {
+    this->ghostVertexLocalIdsPerOwner_[r]
+      = toLocalIds(this->ghostVerticesPerOwner_[r]);
+  }
+  this->remoteGhostVertexLocalIds_.resize(this->remoteGhostVertices_.size());
+  for(size_t r = 0; r < this->remoteGhostVertices_.size(); ++r) {
+    this->remoteGhostVertexLocalIds_[r]
+      = toLocalIds(this->remoteGhostVertices_[r]);
+  }
+}
+
+#endif // TTK_ENABLE_MPI
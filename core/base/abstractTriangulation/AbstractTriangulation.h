@@ -14,9 +14,11 @@
 // base code includes
 #include <Cache.h>
 #include <Geometry.h>
+#include <GradientArray.h>
 #include <Wrapper.h>
 
 #include <array>
+#include <atomic>
 #include <ostream>
 #include <unordered_map>
 
@@ -2918,6 +2920,55 @@ namespace ttk {
       return this->remoteGhostVertices_;
     }
 
+    // local ids of the simplices listed (as global ids) by
+    // getGhostCellsPerOwner(), getRemoteGhostCells(),
+    // getGhostVerticesPerOwner() and getRemoteGhostVertices(), in the same
+    // order (used by the ghost exchanges in MPIUtils.h)
+
+    virtual inline const std::vector<std::vector<SimplexId>> &
+      getGhostCellLocalIdsPerOwner() const {
+      if(!hasPreconditionedExchangeGhostCells_) {
+        printErr(
+          "The ghostCellLocalIdsPerOwner_ attribute has not been populated!");
+        printErr(
+          "Please call preconditionExchangeGhostCells in a pre-process.");
+      }
+      return this->ghostCellLocalIdsPerOwner_;
+    }
+
+    virtual inline const std::vector<std::vector<SimplexId>> &
+      getRemoteGhostCellLocalIds() const {
+      if(!hasPreconditionedExchangeGhostCells_) {
+        printErr(
+          "The remoteGhostCellLocalIds_ attribute has not been populated!");
+        printErr(
+          "Please call preconditionExchangeGhostCells in a pre-process.");
+      }
+      return this->remoteGhostCellLocalIds_;
+    }
+
+    virtual inline const std::vector<std::vector<SimplexId>> &
+      getGhostVertexLocalIdsPerOwner() const {
+      if(!hasPreconditionedExchangeGhostVertices_) {
+        printErr(
+          "The ghostVertexLocalIdsPerOwner_ attribute has not been populated!");
+        printErr(
+          "Please call preconditionExchangeGhostVertices in a pre-process.");
+      }
+      return this->ghostVertexLocalIdsPerOwner_;
+    }
+
+    virtual inline const std::vector<std::vector<SimplexId>> &
+      getRemoteGhostVertexLocalIds() const {
+      if(!hasPreconditionedExchangeGhostVertices_) {
+        printErr(
+          "The remoteGhostVertexLocalIds_ attribute has not been populated!");
+        printErr(
+          "Please call preconditionExchangeGhostVertices in a pre-process.");
+      }
+      return this->remoteGhostVertexLocalIds_;
+    }
+
     virtual inline void setHasPreconditionedDistributedVertices(bool flag) {
       this->hasPreconditionedDistributedVertices_ = flag;
     }
@@ -3809,6 +3860,12 @@ namespace ttk {
       return 0;
     }
 
+    // fill the local id counterparts of the ghost exchange lists, to be
+    // called at the end of preconditionExchangeGhostCells() and
+    // preconditionExchangeGhostVertices()
+    void preconditionGhostCellLocalIds();
+    void preconditionGhostVertexLocalIds();
+
     // "vtkGhostType" PointData array
     const unsigned char *vertexGhost_{};
     // "vtkGhostType" CellData array
@@ -3826,6 +3883,11 @@ namespace ttk {
     // global ids of local (owned) vertices that are ghost cells of other
     // (neighboring) ranks (per MPI rank)
     std::vector<std::vector<SimplexId>> remoteGhostVertices_{};
+    // local ids counterparts of the four lists above
+    std::vector<std::vector<SimplexId>> ghostCellLocalIdsPerOwner_{};
+    std::vector<std::vector<SimplexId>> remoteGhostCellLocalIds_{};
+    std::vector<std::vector<SimplexId>> ghostVertexLocalIdsPerOwner_{};
+    std::vector<std::vector<SimplexId>> remoteGhostVertexLocalIds_{};
 
     bool hasPreconditionedDistributedCells_{false};
     bool hasPreconditionedExchangeGhostCells_{false};
@@ -3859,23 +3921,29 @@ namespace ttk {
      * 5: paired triangle id per tetra
      * Values: -1 if critical or paired to a cell of another dimension
      *
+     * On implicit grids, values are stored as local indices in the
+     * cell facets/cofacets, packed in 4 bits (see ttk::GradientArray).
+     *
      * Is used as a value type for \ref gradientCacheType.
      */
-    using gradientType = std::array<std::vector<gradIdType>, 6>;
+    using gradientType = std::array<GradientArray<gradIdType>, 6>;
     /**
      * @brief Key type for \ref gradientCacheType.
      *
-     * The key type models a scalar field buffer. The first element is
-     * a const void pointer to the beginning of the buffer and the
-     * second stores the timestamp of the last modification of the
-     * scalar field.
+     * The key is a pair of independent content hashes of the offset
+     * field used to compute the gradient (see
+     * ttk::hash::hashBufferPair()), so that a re-execution on identical
+     * data hits the cache even if the buffer has been re-allocated. A
+     * hit requires both hashes to match.
      */
-    using gradientKeyType = std::pair<const void *, size_t>;
+    using gradientKeyType = std::pair<uint64_t, uint64_t>;
     /*
      * @brief Type for caching Discrete Gradient internal data structure.
      *
      * Uses the ttk::LRUCache with \ref gradientKeytype as key and
-     * \ref gradientType as value types.
+     * \ref gradientType as value types. The cache is thread-safe so
+     * several ttk::dcg::DiscreteGradient instances (e.g. concurrent
+     * ttkForEach iterations) can share it.
      */
     using gradientCacheType = LRUCache<gradientKeyType, gradientType>;
     /*
@@ -3891,5 +3959,37 @@ namespace ttk {
     // store, for each triangulation object and per offset field, a
     // reference to the discrete gradient internal structure
     mutable gradientCacheType gradientCache_{};
+    // if not empty, evicted gradients are spilled to files in this
+    // directory, and lazily reloaded from them (memory mapping)
+    mutable std::string gradientCacheDirectory_{};
+    // size budget (in bytes) of the gradient cache directory
+    mutable size_t gradientCacheDirectoryCapacity_{size_t{1} << 30};
+
+    // atomic value that can be copied along with the triangulation
+    struct AtomicFingerprint {
+      AtomicFingerprint() = default;
+      AtomicFingerprint(const AtomicFingerprint &other)
+        : value{other.value.load()} {
+      }
+      AtomicFingerprint &operator=(const AtomicFingerprint &other) {
+        this->value = other.value.load();
+        return *this;
+      }
+      std::atomic<uint64_t> value{};
+    };
+    // hash of the triangulation connectivity (0 if not computed yet),
+    // used to name gradient cache files; concurrent DiscreteGradient
+    // instances may compute it
+    mutable AtomicFingerprint gradientCacheFingerprint_{};
+
+    /**
+     * @brief Drop the cached gradients and the fingerprint (to be
+     * called when the cells are replaced)
+     */
+    inline void resetGradientCache() const {
+      this->gradientCache_.setEvictionCallback(nullptr);
+      this->gradientCache_.clear();
+      this->gradientCacheFingerprint_.value = 0;
+    }
   };
 } // namespace ttk
@@ -0,0 +1,199 @@
+/// \ingroup base
+/// \class ttk::GradientArray
+/// \date October 2026.
+///
+/// \brief Storage for one component of the discrete gradient.
+///
+/// Stores, for each cell of a given dimension, the identifier of its
+/// paired facet or cofacet (or a negative value such as -1 for
+/// unpaired cells).
+///
+/// Two layouts are available:
+/// - full: one \p IdType per cell,
+/// - packed: 4 bits per cell, for values in [-2, 13]. This is used by
+///   ttk::dcg::DiscreteGradient on implicit and periodic grids, where
+///   the index of the paired cell in the local star of a simplex is
+///   always small (at most 14 edges around a vertex).
+///
+/// In the packed layout, a zero nibble encodes -1 so that a freshly
+/// allocated array only holds unpaired cells. Writes to neighboring
+/// cells sharing the same byte are atomic (if OpenMP is enabled).
+///
+/// The values can also be read from a file mapping (see map()), in
+/// which case the array is read-only: its pages are loaded lazily by
+/// the operating system. A copy of a mapped array is held in memory.
+///
+/// \sa ttk::dcg::DiscreteGradient
+
+#pragma once
+
+#include <DataTypes.h>
+#include <MappedFile.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace ttk {
+
+  template <typename IdType>
+  class GradientArray {
+
+  public:
+    // range of values that can be stored in the packed layout
+    static constexpr int PACKED_MIN_VALUE{-2};
+    static constexpr int PACKED_MAX_VALUE{13};
+
+    GradientArray() = default;
+    GradientArray(const GradientArray &other) {
+      *this = other;
+    }
+    GradientArray(GradientArray &&other) noexcept = default;
+    GradientArray &operator=(GradientArray &&other) noexcept = default;
+    GradientArray &operator=(const GradientArray &other) {
+      if(this != &other) {
+        this->assign(other.data(), other.size_, other.packed_);
+      }
+      return *this;
+    }
+
+    /**
+     * @brief Reset the array to nCells unpaired cells
+     */
+    inline void init(const size_t nCells, const bool packed) {
+      this->size_ = nCells;
+      this->packed_ = packed;
+      this->file_.reset();
+      this->ids_.clear();
+      this->nibbles_.clear();
+      if(packed) {
+        this->ids_.shrink_to_fit();
+        this->nibbles_.resize((nCells + 1) / 2, 0);
+      } else {
+        this->nibbles_.shrink_to_fit();
+        this->ids_.resize(nCells, -1);
+      }
+      this->bindStorage();
+    }
+
+    /**
+     * @brief Read the values from a file mapping, starting at offset
+     * (aligned on the size of IdType), instead of memory
+     */
+    inline void map(std::shared_ptr<const MappedFile> file,
+                    const size_t offset,
+                    const size_t nCells,
+                    const bool packed) {
+      this->size_ = nCells;
+      this->packed_ = packed;
+      std::vector<IdType>{}.swap(this->ids_);
+      std::vector<uint8_t>{}.swap(this->nibbles_);
+      this->file_ = std::move(file);
+      const auto data{this->file_->data() + offset};
+      this->idsData_ = reinterpret_cast<const IdType *>(data);
+      this->nibblesData_ = reinterpret_cast<const uint8_t *>(data);
+    }
+
+    inline bool isMapped() const {
+      return this->file_ != nullptr;
+    }
+
+    inline size_t size() const {
+      return this->size_;
+    }
+
+    inline bool isPacked() const {
+      return this->packed_;
+    }
+
+    inline IdType operator[](const size_t i) const {
+      if(!this->packed_) {
+        return this->idsData_[i];
+      }
+      const auto nibble{(this->nibblesData_[i / 2] >> (4 * (i % 2))) & 0xF};
+      // 0 -> -1, 1..14 -> 0..13, 15 -> -2
+      return static_cast<IdType>(((nibble + 1) & 0xF) - 2);
+    }
+
+    inline void set(const size_t i, const IdType value) {
+      if(!this->packed_) {
+        this->ids_[i] = value;
+        return;
+      }
+      const int shift{4 * static_cast<int>(i % 2)};
+      const auto clear{static_cast<uint8_t>(~(0xF << shift))};
+      const auto bits{static_cast<uint8_t>(((value + 1) & 0xF) << shift)};
+      auto &byte{this->nibbles_[i / 2]};
+      // the other nibble of the byte may be concurrently written
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp atomic update
+#endif // TTK_ENABLE_OPENMP
+      byte &= clear;
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp atomic update
+#endif // TTK_ENABLE_OPENMP
+      byte |= bits;
+    }
+
+    /**
+     * @brief Raw storage, for serialization
+     */
+    inline const char *data() const {
+      return this->packed_ ? reinterpret_cast<const char *>(this->nibblesData_)
+                           : reinterpret_cast<const char *>(this->idsData_);
+    }
+
+    /**
+     * @brief Size in bytes of the raw storage
+     */
+    inline size_t dataSize() const {
+      return this->packed_ ? (this->size_ + 1) / 2
+                           : this->size_ * sizeof(IdType);
+    }
+
+    /**
+     * @brief Fill the array from a raw storage of the same layout
+     */
+    inline void assign(const char *const data,
+                       const size_t nCells,
+                       const bool packed) {
+      this->size_ = nCells;
+      this->packed_ = packed;
+      if(packed) {
+        const auto begin{reinterpret_cast<const uint8_t *>(data)};
+        this->nibbles_.assign(begin, begin + (nCells + 1) / 2);
+        this->ids_.clear();
+      } else {
+        const auto begin{reinterpret_cast<const IdType *>(data)};
+        this->ids_.assign(begin, begin + nCells);
+        this->nibbles_.clear();
+      }
+      this->file_.reset();
+      this->bindStorage();
+    }
+
+    inline size_t memoryUsage() const {
+      return this->ids_.capacity() * sizeof(IdType)
+             + this->nibbles_.capacity() * sizeof(uint8_t);
+    }
+
+  protected:
+    inline void bindStorage() {
+      this->idsData_ = this->ids_.data();
+      this->nibblesData_ = this->nibbles_.data();
+    }
+
+    size_t size_{};
+    bool packed_{false};
+    // full layout
+    std::vector<IdType> ids_{};
+    // packed layout, two cells per byte
+    std::vector<uint8_t> nibbles_{};
+    // mapped storage, if any (see map())
+    std::shared_ptr<const MappedFile> file_{};
+    // values read by operator[]: the vectors or the mapped file
+    const IdType *idsData_{};
+    const uint8_t *nibblesData_{};
+  };
+
+} // namespace ttk
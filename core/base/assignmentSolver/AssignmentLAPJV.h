@@ -0,0 +1,401 @@
+/// \ingroup base
+/// \class ttk::AssignmentLAPJV
+/// \date October 2026.
+///
+/// Jonker-Volgenant shortest augmenting path solver for the Balanced and
+/// Unbalanced Assignment Problem.
+///
+/// The cost matrix is stored in a contiguous row-major buffer. The solver
+/// starts from a column reduction (or from the column prices of a previous
+/// run, see setPrices()) then assigns the remaining free rows one at a time
+/// along shortest augmenting paths (Dijkstra on the reduced costs). The
+/// worst case complexity is O(n^3).
+///
+/// For the unbalanced problem:
+///   The cost matrix in input has a size of (n + 1) x (m + 1)
+///   - n is the number of jobs, m the number of workers
+///   - the nth row contains the cost of not assigning workers
+///   - the mth column is the same but with jobs
+///   - the last cell (costMatrix[n][m]) is not used
+///
+/// This matrix is expanded into a sparse square problem of size (n + m),
+/// where each job (resp. worker) gets its own "not assigned" column (resp.
+/// row), stored in compressed rows. Entries equal to
+/// std::numeric_limits<dataType>::max() are considered as forbidden.
+///
+/// \b Related \b publication \n
+/// "A shortest augmenting path algorithm for dense and sparse linear
+/// assignment problems" \n
+/// R. Jonker, A. Volgenant \n
+/// Computing 38, 1987.
+
+#pragma once
+
+#include <AssignmentSolver.h>
+
+#include <limits>
+
+namespace ttk {
+
+  template <class dataType>
+  class AssignmentLAPJV : virtual public Debug,
+                          public AssignmentSolver<dataType> {
+
+  public:
+    AssignmentLAPJV() {
+      this->setDebugMsgPrefix("AssignmentLAPJV");
+    }
+
+    ~AssignmentLAPJV() override = default;
+
+    int run(std::vector<MatchingType> &matchings) override;
+
+    inline void clear() override {
+      AssignmentSolver<dataType>::clear();
+      costs_.clear();
+    }
+
+    inline int setInput(std::vector<std::vector<dataType>> &C_) override {
+      const int nRows = C_.size();
+      const int nCols = C_[0].size();
+      costs_.resize(static_cast<size_t>(nRows) * nCols);
+      for(int r = 0; r < nRows; ++r)
+        std::copy(C_[r].begin(), C_[r].end(), &costs_[r * nCols]);
+      this->rowSize = nRows;
+      this->colSize = nCols;
+      this->setBalanced(nRows == nCols);
+      return 0;
+    }
+
+    /**
+     * Set the cost matrix from a row-major buffer of size rowSize x colSize
+     * (no intermediate nested vectors).
+     */
+    inline int setInput(const dataType *const costs,
+                        const int rowSize,
+                        const int colSize) {
+      costs_.assign(costs, costs + static_cast<size_t>(rowSize) * colSize);
+      this->rowSize = rowSize;
+      this->colSize = colSize;
+      this->setBalanced(rowSize == colSize);
+      return 0;
+    }
+
+    inline std::vector<std::vector<dataType>> getCostMatrix() override {
+      std::vector<std::vector<dataType>> C(this->rowSize);
+      for(int r = 0; r < this->rowSize; ++r)
+        C[r].assign(costs_.begin() + r * this->colSize,
+                    costs_.begin() + (r + 1) * this->colSize);
+      return C;
+    }
+
+    /**
+     * Warm start: the next run starts from these column prices (dual
+     * variables) instead of a column reduction. Typically the prices of a
+     * previous run on a similar cost matrix of the same size.
+     */
+    inline void setPrices(const std::vector<dataType> &prices) {
+      prices_ = prices;
+      warmStart_ = true;
+    }
+
+    /**
+     * Column prices of the last run, indexed by the columns of the
+     * (expanded if unbalanced) problem.
+     */
+    inline const std::vector<dataType> &getPrices() const {
+      return prices_;
+    }
+
+    /**
+     * Total cost of the last computed assignment.
+     */
+    inline dataType getCost() const {
+      return cost_;
+    }
+
+  private:
+    // row-major cost matrix
+    std::vector<dataType> costs_{};
+
+    // compressed rows of the expanded unbalanced problem
+    std::vector<int> offsets_{};
+    std::vector<int> columns_{};
+    std::vector<dataType> values_{};
+
+    // solution: column of each row, row of each column and cost of the
+    // assigned entry of each row
+    std::vector<int> rowSol_{};
+    std::vector<int> colSol_{};
+    std::vector<dataType> rowCost_{};
+
+    std::vector<dataType> prices_{};
+    bool warmStart_{false};
+    dataType cost_{0};
+
+    /**
+     * Solve the square problem of size n whose allowed entries of row i
+     * are enumerated by visitRow(i, f), calling f(column, cost).
+     */
+    template <typename RowVisitor>
+    int solve(const int n, const RowVisitor &visitRow);
+
+    int runBalanced(std::vector<MatchingType> &matchings);
+    int runUnbalanced(std::vector<MatchingType> &matchings);
+  };
+
+  template <typename dataType>
+  template <typename RowVisitor>
+  int AssignmentLAPJV<dataType>::solve(const int n,
+                                       const RowVisitor &visitRow) {
+    const dataType inf = std::numeric_limits<dataType>::max();
+
+    rowSol_.assign(n, -1);
+    colSol_.assign(n, -1);
+    rowCost_.assign(n, 0);
+
+    // predecessor row of each column on the current shortest path tree
+    std::vector<int> pred(n, -1);
+
+    if(!warmStart_ || prices_.size() != static_cast<size_t>(n)) {
+      // column reduction: price of each column is its minimal cost, the
+      // column is assigned to its minimal row if this one is still free
+      prices_.assign(n, inf);
+      for(int i = 0; i < n; ++i) {
+        visitRow(i, [&](const int j, const dataType c) {
+          if(c < prices_[j]) {
+            prices_[j] = c;
+            pred[j] = i;
+          }
+        });
+      }
+      for(int j = n - 1; j >= 0; --j) {
+        const int i = pred[j];
+        if(i == -1) {
+          this->printErr("Column " + std::to_string(j)
+                         + " cannot be assigned.");
+          return -1;
+        }
+        if(rowSol_[i] == -1) {
+          rowSol_[i] = j;
+          colSol_[j] = i;
+          rowCost_[i] = prices_[j];
+        }
+      }
+    }
+    warmStart_ = false;
+
+    // augmentation
+    enum class State : char { UNREACHED, REACHED, SCANNED };
+    std::vector<State> state(n, State::UNREACHED);
+    std::vector<dataType> dist(n), edgeCost(n);
+    std::vector<int> reached{}, scanned{};
+
+    for(int f = 0; f < n; ++f) {
+      if(rowSol_[f] != -1)
+        continue;
+
+      // relax the allowed entries of row i, at distance mu minus the
+      // reduced cost h of the entry currently assigned to i
+      const auto relax
+        = [&](const int i, const dataType mu, const dataType h) {
+            visitRow(i, [&](const int j, const dataType c) {
+              if(state[j] == State::SCANNED)
+                return;
+              const dataType d = mu + (c - prices_[j]) - h;
+              if(state[j] == State::UNREACHED) {
+                state[j] = State::REACHED;
+                reached.emplace_back(j);
+              } else if(!(d < dist[j])) {
+                return;
+              }
+              dist[j] = d;
+              pred[j] = i;
+              edgeCost[j] = c;
+            });
+          };
+
+      relax(f, 0, 0);
+
+      int endCol = -1;
+      dataType mu = 0;
+      while(!reached.empty()) {
+        // closest reached column, free columns first on ties
+        size_t best = 0;
+        for(size_t k = 1; k < reached.size(); ++k) {
+          const int j = reached[k];
+          const int b = reached[best];
+          if(dist[j] < dist[b]
+             || (dist[j] == dist[b] && colSol_[j] == -1 && colSol_[b] != -1))
+            best = k;
+        }
+        const int j = reached[best];
+        reached[best] = reached.back();
+        reached.pop_back();
+        state[j] = State::SCANNED;
+        scanned.emplace_back(j);
+        mu = dist[j];
+
+        const int i = colSol_[j];
+        if(i == -1) {
+          endCol = j;
+          break;
+        }
+        relax(i, mu, rowCost_[i] - prices_[j]);
+      }
+
+      if(endCol == -1) {
+        this->printErr("Row " + std::to_string(f) + " cannot be assigned.");
+        return -1;
+      }
+
+      // update the prices of the scanned columns
+      for(const auto j : scanned) {
+        if(j != endCol)
+          prices_[j] += dist[j] - mu;
+        state[j] = State::UNREACHED;
+      }
+      for(const auto j : reached)
+        state[j] = State::UNREACHED;
+      scanned.clear();
+      reached.clear();
+
+      // augment along the shortest path
+      for(int j = endCol;;) {
+        const int i = pred[j];
+        const int next = rowSol_[i];
+        colSol_[j] = i;
+        rowSol_[i] = j;
+        rowCost_[i] = edgeCost[j];
+        if(i == f)
+          break;
+        j = next;
+      }
+    }
+
+    cost_ = 0;
+    for(const auto c : rowCost_)
+      cost_ += c;
+
+    return 0;
+  }
+
+  template <typename dataType>
+  int AssignmentLAPJV<dataType>::runBalanced(
+    std::vector<MatchingType> &matchings) {
+    const int n = this->rowSize;
+    if(this->colSize != n) {
+      this->printErr("Balanced assignment needs a square cost matrix.");
+      return -1;
+    }
+
+    const dataType inf = std::numeric_limits<dataType>::max();
+    const auto visitRow = [&](const int i, const auto &f) {
+      const dataType *const row = &costs_[static_cast<size_t>(i) * n];
+      for(int j = 0; j < n; ++j)
+        if(row[j] != inf)
+          f(j, row[j]);
+    };
+
+    const auto status = this->solve(n, visitRow);
+    if(status != 0)
+      return status;
+
+    for(int i = 0; i < n; ++i)
+      matchings.emplace_back(i, rowSol_[i], rowCost_[i]);
+
+    return 0;
+  }
+
+  template <typename dataType>
+  int AssignmentLAPJV<dataType>::runUnbalanced(
+    std::vector<MatchingType> &matchings) {
+    const int n = this->rowSize - 1;
+    const int m = this->colSize - 1;
+    const int N = n + m;
+
+    const dataType inf = std::numeric_limits<dataType>::max();
+    const auto cost = [&](const int i, const int j) {
+      return costs_[static_cast<size_t>(i) * this->colSize + j];
+    };
+
+    // expanded problem:
+    // - row i < n: allowed columns j < m, "not assigned" column m + i
+    // - row n + j: "not assigned" column j, column m + i (zero cost) for
+    //   each allowed (i, j), mirroring the assignment of the other rows
+    offsets_.assign(N + 1, 0);
+    for(int i = 0; i < n; ++i) {
+      for(int j = 0; j < m; ++j) {
+        if(cost(i, j) != inf) {
+          offsets_[i + 1]++;
+          offsets_[n + j + 1]++;
+        }
+      }
+      if(cost(i, m) != inf)
+        offsets_[i + 1]++;
+    }
+    for(int j = 0; j < m; ++j)
+      if(cost(n, j) != inf)
+        offsets_[n + j + 1]++;
+    for(int k = 0; k < N; ++k)
+      offsets_[k + 1] += offsets_[k];
+
+    columns_.resize(offsets_[N]);
+    values_.resize(offsets_[N]);
+    std::vector<int> cursor(offsets_.begin(), offsets_.end() - 1);
+    const auto push = [&](const int row, const int col, const dataType c) {
+      columns_[cursor[row]] = col;
+      values_[cursor[row]] = c;
+      cursor[row]++;
+    };
+    for(int i = 0; i < n; ++i) {
+      for(int j = 0; j < m; ++j) {
+        if(cost(i, j) != inf) {
+          push(i, j, cost(i, j));
+          push(n + j, m + i, 0);
+        }
+      }
+      if(cost(i, m) != inf)
+        push(i, m + i, cost(i, m));
+    }
+    for(int j = 0; j < m; ++j)
+      if(cost(n, j) != inf)
+        push(n + j, j, cost(n, j));
+
+    const auto visitRow = [&](const int i, const auto &f) {
+      for(int k = offsets_[i]; k < offsets_[i + 1]; ++k)
+        f(columns_[k], values_[k]);
+    };
+
+    const auto status = this->solve(N, visitRow);
+    if(status != 0)
+      return status;
+
+    for(int i = 0; i < n; ++i) {
+      const int j = rowSol_[i] < m ? rowSol_[i] : m;
+      matchings.emplace_back(i, j, cost(i, j));
+    }
+    for(int j = 0; j < m; ++j)
+      if(colSol_[j] >= n)
+        matchings.emplace_back(n, j, cost(n, j));
+
+    return 0;
+  }
+
+  template <typename dataType>
+  int AssignmentLAPJV<dataType>::run(std::vector<MatchingType> &matchings) {
+    Timer t;
+    matchings.clear();
+
+    const auto status = this->balancedAssignment
+                          ? this->runBalanced(matchings)
+                          : this->runUnbalanced(matchings);
+
+    this->printMsg("Total cost: " + std::to_string(cost_), 1.0,
+                   t.getElapsedTime(), debug::LineMode::NEW,
+                   debug::Priority::DETAIL);
+
+    return status;
+  }
+
+} // namespace ttk
@@ -1,3 +1,4 @@
+#include <AssignmentLAPJV.h>
 #include <AssignmentMunkres.h>
 #include <BottleneckDistance.h>
 #include <GabowTarjan.h>
@@ -41,6 +42,10 @@ int ttk::BottleneckDistance::execute(const ttk::DiagramType &diag0,
         this->printMsg("Benchmarking");
         this->printErr("Not supported");
       } break;
+      case 5:
+        this->printMsg("Solving with the TTK approach (Jonker-Volgenant)");
+        this->computeBottleneck(diag0, diag1, matchings, true);
+        break;
       default: {
         this->printErr("You must specify a valid assignment algorithm.");
       }
@@ -73,6 +78,11 @@ int ttk::BottleneckDistance::execute(const ttk::DiagramType &diag0,
         this->printMsg("Benchmarking");
         this->printErr("Not supported");
       } break;
+      case str2int("5"):
+      case str2int("lapjv"):
+        this->printMsg("Solving with the TTK approach (Jonker-Volgenant)");
+        this->computeBottleneck(diag0, diag1, matchings, true);
+        break;
       default: {
         this->printErr("You must specify a valid assignment algorithm.");
       }
@@ -372,9 +382,11 @@ void ttk::BottleneckDistance::computeMinMaxSaddleNumberAndMapping(
 
 static void solvePWasserstein(std::vector<std::vector<double>> &matrix,
                               std::vector<ttk::MatchingType> &matchings,
-                              ttk::AssignmentMunkres<double> &solver) {
+                              ttk::AssignmentSolver<double> &solver) {
 
   solver.setInput(matrix);
+  // last row and column hold the diagonal costs
+  solver.setBalanced(false);
   solver.run(matchings);
   solver.clearMatrix();
 }
@@ -501,7 +513,8 @@ double ttk::BottleneckDistance::diagonalDistanceFunction(
 int ttk::BottleneckDistance::computeBottleneck(
   const ttk::DiagramType &d1,
   const ttk::DiagramType &d2,
-  std::vector<MatchingType> &matchings) {
+  std::vector<MatchingType> &matchings,
+  const bool useLAPJV) {
 
   const auto transposeOriginal = d1.size() > d2.size();
   if(transposeOriginal) {
@@ -572,22 +585,30 @@ int ttk::BottleneckDistance::computeBottleneck(
 
   if(!isBottleneck) {
 
+    const auto solve = [useLAPJV](std::vector<std::vector<double>> &matrix,
+                                  std::vector<MatchingType> &matchings_) {
+      if(useLAPJV) {
+        AssignmentLAPJV<double> solver;
+        solvePWasserstein(matrix, matchings_, solver);
+      } else {
+        AssignmentMunkres<double> solver;
+        solvePWasserstein(matrix, matchings_, solver);
+      }
+    };
+
     if(nbRowMin > 0 && nbColMin > 0) {
-      AssignmentMunkres<double> solverMin;
       this->printMsg("Affecting minima...");
-      solvePWasserstein(minMatrix, minMatchings, solverMin);
+      solve(minMatrix, minMatchings);
     }
 
     if(nbRowMax > 0 && nbColMax > 0) {
-      AssignmentMunkres<double> solverMax;
       this->printMsg("Affecting maxima...");
-      solvePWasserstein(maxMatrix, maxMatchings, solverMax);
+      solve(maxMatrix, maxMatchings);
     }
 
     if(nbRowSad > 0 && nbColSad > 0) {
-      AssignmentMunkres<double> solverSad;
       this->printMsg("Affecting saddles...");
-      solvePWasserstein(sadMatrix, sadMatchings, solverSad);
+      solve(sadMatrix, sadMatchings);
     }
 
   } else {
@@ -7,6 +7,12 @@
 /// Based on implementation described in Physically Based Rendering:
 /// From Theory to Implementation by Matt Pharr, Wenzel Jakob and
 /// Greg Humphreys.
+///
+/// The tree is built top-down with a binned surface area heuristic (in
+/// parallel with OpenMP tasks) and then flattened into a depth-first array
+/// of 32-byte nodes. The triangles are copied in leaf order, so that a leaf
+/// only touches a contiguous range of memory. Rays can be traced one at a
+/// time or as coherent packets (see ttk::RayPacket).
 
 #pragma once
 
@@ -14,56 +20,39 @@
 #include <Geometry.h>
 
 #include <algorithm>
+#include <cstdint>
 #include <limits>
 #include <memory>
-#include <stack>
 #include <vector>
 
 namespace ttk {
   template <typename IT>
   class BoundingVolumeHierarchy {
   protected:
-    struct Node {
-      Node() = default;
-      // leaf constructor
-      Node(const std::vector<int> &triangleIndices,
-           const size_t nTriangles,
-           const float *pMin,
-           const float *pMax) {
-        m_minX = pMin[0];
-        m_minY = pMin[1];
-        m_minZ = pMin[2];
-        m_maxX = pMax[0];
-        m_maxY = pMax[1];
-        m_maxZ = pMax[2];
-        indices = triangleIndices;
-        numTriangles = nTriangles;
-      }
-      // interior constructor
-      Node(const int axis,
-           const std::shared_ptr<Node> &left,
-           const std::shared_ptr<Node> &right) {
-        numTriangles = 0;
-        m_left = left;
-        m_right = right;
-        m_splitAxis = axis;
-        m_minX = std::min(left->m_minX, right->m_minX);
-        m_minY = std::min(left->m_minY, right->m_minY);
-        m_minZ = std::min(left->m_minZ, right->m_minZ);
-        m_maxX = std::max(left->m_maxX, right->m_maxX);
-        m_maxY = std::max(left->m_maxY, right->m_maxY);
-        m_maxZ = std::max(left->m_maxZ, right->m_maxZ);
-      }
-
-      ~Node() = default;
+    /**
+     * @brief Node of the flattened tree
+     *
+     * Interior nodes store the index of their second child in offset (the
+     * first child directly follows its parent), leaves store the position of
+     * their first triangle in the leaf-ordered triangle arrays.
+     */
+    struct LinearNode {
+      float pMin[3];
+      float pMax[3];
+      int offset;
+      uint32_t nTriangles : 30; // 0 for interior nodes
+      uint32_t axis : 2;
+    };
 
-      std::vector<int> indices;
-      int numTriangles;
-      float m_minX, m_minY, m_minZ;
-      float m_maxX, m_maxY, m_maxZ;
-      std::shared_ptr<Node> m_left;
-      std::shared_ptr<Node> m_right;
-      int m_splitAxis;
+    /**
+     * @brief Temporary node, only used during the construction
+     */
+    struct BuildNode {
+      float pMin[3];
+      float pMax[3];
+      size_t start{}, end{};
+      int axis{-1}; // -1 for leaves
+      std::unique_ptr<BuildNode> children[2];
     };
 
     struct Triangle {
@@ -91,124 +80,218 @@ namespace ttk {
         m_maxY = pMax[1];
         m_maxZ = pMax[2];
       }
+
+      inline float centroid(const int axis) const {
+        return axis == 0 ? m_centroid_x
+                         : (axis == 1 ? m_centroid_y : m_centroid_z);
+      }
     };
 
+    // number of SAH buckets per split
+    static constexpr int nBuckets_{12};
+    // leaves above that size are always split
+    static constexpr size_t maxLeafSize_{8};
+    // nodes below that depth become leaves, bounds the traversal stack
+    static constexpr int maxDepth_{60};
+    // subtrees above that size are built in separate tasks
+    static constexpr size_t taskGrainSize_{4096};
+    // relative cost of a box test with respect to a triangle test
+    static constexpr float traversalCost_{0.125f};
+
   public:
     BoundingVolumeHierarchy(const float *coords,
                             const IT *connectivityList,
-                            const size_t &nTriangles) {
-      std::vector<Triangle> triangles;
-      buildTriangleList(triangles, coords, connectivityList, nTriangles);
+                            const size_t &nTriangles,
+                            const int threadNumber = 1) {
+      if(nTriangles == 0)
+        return;
 
-      this->nodes = buildTree(triangles, 0, nTriangles);
+      std::vector<Triangle> triangles;
+      buildTriangleList(
+        triangles, coords, connectivityList, nTriangles, threadNumber);
+
+      std::unique_ptr<BuildNode> root{};
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel num_threads(threadNumber)
+#pragma omp single nowait
+#endif
+      root = buildTree(triangles, 0, nTriangles, 0);
+
+      this->nodes_.reserve(2 * nTriangles - 1);
+      this->flattenTree(root.get());
+
+      // copy the triangles in leaf order: v0, v0v1, v0v2 and the index
+      this->triangleIndices_.resize(nTriangles);
+      this->triangleVertices_.resize(9 * nTriangles);
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber)
+#endif
+      for(size_t i = 0; i < nTriangles; i++) {
+        const int ti = triangles[i].m_index;
+        const float *p0 = &coords[connectivityList[ti * 3 + 0] * 3];
+        const float *p1 = &coords[connectivityList[ti * 3 + 1] * 3];
+        const float *p2 = &coords[connectivityList[ti * 3 + 2] * 3];
+        float *tv = &this->triangleVertices_[9 * i];
+        for(int j = 0; j < 3; j++) {
+          tv[j] = p0[j];
+          tv[3 + j] = p1[j] - p0[j];
+          tv[6 + j] = p2[j] - p0[j];
+        }
+        this->triangleIndices_[i] = ti;
+      }
     }
 
     ~BoundingVolumeHierarchy() = default;
 
-    std::shared_ptr<Node>
-      buildTree(std::vector<Triangle> &triangles, size_t start, size_t end) {
+    std::unique_ptr<BuildNode> buildTree(std::vector<Triangle> &triangles,
+                                         const size_t start,
+                                         const size_t end,
+                                         const int depth) const {
+
+      auto node = std::make_unique<BuildNode>();
+      node->start = start;
+      node->end = end;
 
-      float minX, minY, minZ;
-      float maxX, maxY, maxZ;
-      minX = minY = minZ = std::numeric_limits<float>::max();
-      maxX = maxY = maxZ = std::numeric_limits<float>::min();
+      float cMin[3], cMax[3];
+      for(int j = 0; j < 3; j++) {
+        node->pMin[j] = cMin[j] = std::numeric_limits<float>::max();
+        node->pMax[j] = cMax[j] = std::numeric_limits<float>::lowest();
+      }
       for(size_t i = start; i < end; i++) {
         const Triangle &t = triangles[i];
-        minX = std::min(t.m_minX, minX);
-        minY = std::min(t.m_minY, minY);
-        minZ = std::min(t.m_minZ, minZ);
+        const float tMin[3] = {t.m_minX, t.m_minY, t.m_minZ};
+        const float tMax[3] = {t.m_maxX, t.m_maxY, t.m_maxZ};
+        for(int j = 0; j < 3; j++) {
+          node->pMin[j] = std::min(node->pMin[j], tMin[j]);
+          node->pMax[j] = std::max(node->pMax[j], tMax[j]);
+          cMin[j] = std::min(cMin[j], t.centroid(j));
+          cMax[j] = std::max(cMax[j], t.centroid(j));
+        }
+      }
+
+      const size_t numberTriangles = end - start;
+      if(numberTriangles == 1 || depth >= maxDepth_) {
+        return node;
+      }
 
-        maxX = std::max(t.m_maxX, maxX);
-        maxY = std::max(t.m_maxY, maxY);
-        maxZ = std::max(t.m_maxZ, maxZ);
+      // split along the largest extent of the centroids
+      int axis = 0;
+      for(int j = 1; j < 3; j++) {
+        if(cMax[j] - cMin[j] > cMax[axis] - cMin[axis])
+          axis = j;
       }
-      int numberTriangles = end - start;
-      if(numberTriangles == 1) {
-        const Triangle &t = triangles[start];
-        std::vector<int> indices = {t.m_index};
-        float pMin[3] = {t.m_minX, t.m_minY, t.m_minZ};
-        float pMax[3] = {t.m_maxX, t.m_maxY, t.m_maxZ};
-        return std::make_shared<Node>(indices, 1, pMin, pMax);
+
+      size_t mid = start + numberTriangles / 2;
+      if(cMax[axis] == cMin[axis]) {
+        // all centroids coincide, any split is as good as another
+        if(numberTriangles <= maxLeafSize_)
+          return node;
       } else {
-        // find the bounds of the centroids, figure out what dimension to split
-        // on
-        float cminX, cminY, cminZ;
-        float cmaxX, cmaxY, cmaxZ;
-        cminX = cminY = cminZ = std::numeric_limits<float>::max();
-        cmaxX = cmaxY = cmaxZ = std::numeric_limits<float>::min();
+        // binned surface area heuristic
+        const float extent = cMax[axis] - cMin[axis];
+        const auto bucketOf = [&](const Triangle &t) {
+          const int b = static_cast<int>(
+            nBuckets_ * ((t.centroid(axis) - cMin[axis]) / extent));
+          return std::min(b, nBuckets_ - 1);
+        };
+
+        size_t counts[nBuckets_]{};
+        float bMin[nBuckets_][3], bMax[nBuckets_][3];
+        for(int b = 0; b < nBuckets_; b++) {
+          for(int j = 0; j < 3; j++) {
+            bMin[b][j] = std::numeric_limits<float>::max();
+            bMax[b][j] = std::numeric_limits<float>::lowest();
+          }
+        }
         for(size_t i = start; i < end; i++) {
           const Triangle &t = triangles[i];
-          cminX = std::min(t.m_centroid_x, cminX);
-          cminY = std::min(t.m_centroid_y, cminY);
-          cminZ = std::min(t.m_centroid_z, cminZ);
-
-          cmaxX = std::max(t.m_centroid_x, cmaxX);
-          cmaxY = std::max(t.m_centroid_y, cmaxY);
-          cmaxZ = std::max(t.m_centroid_z, cmaxZ);
-        }
-        // figure out the biggest extent, use that dimension
-        float diffX = std::abs(cmaxX - cminX);
-        float diffY = std::abs(cmaxY - cminY);
-        float diffZ = std::abs(cmaxZ - cminZ);
-        float maximumExtent = std::max({diffX, diffY, diffZ});
-        int axis;
-        float minToCheck, maxToCheck;
-        if(maximumExtent == diffX) {
-          axis = 0;
-          minToCheck = cminX;
-          maxToCheck = cmaxX;
-        } else if(maximumExtent == diffY) {
-          axis = 1;
-          minToCheck = cminY;
-          maxToCheck = cmaxY;
-        } else {
-          axis = 2;
-          minToCheck = cminZ;
-          maxToCheck = cmaxZ;
+          const int b = bucketOf(t);
+          const float tMin[3] = {t.m_minX, t.m_minY, t.m_minZ};
+          const float tMax[3] = {t.m_maxX, t.m_maxY, t.m_maxZ};
+          counts[b]++;
+          for(int j = 0; j < 3; j++) {
+            bMin[b][j] = std::min(bMin[b][j], tMin[j]);
+            bMax[b][j] = std::max(bMax[b][j], tMax[j]);
+          }
         }
-        size_t half = (start + end) / 2;
-        // partition triangles into two sets and build children
-        if(minToCheck == maxToCheck) {
 
-          std::vector<int> triangleIndices;
-          for(size_t i = start; i < end; i++) {
-            triangleIndices.push_back(triangles[i].m_index);
+        // sweep the buckets from the right, then from the left
+        float rightArea[nBuckets_];
+        {
+          float rMin[3], rMax[3];
+          std::copy(bMin[nBuckets_ - 1], bMin[nBuckets_ - 1] + 3, rMin);
+          std::copy(bMax[nBuckets_ - 1], bMax[nBuckets_ - 1] + 3, rMax);
+          for(int b = nBuckets_ - 1; b > 0; b--) {
+            for(int j = 0; j < 3; j++) {
+              rMin[j] = std::min(rMin[j], bMin[b][j]);
+              rMax[j] = std::max(rMax[j], bMax[b][j]);
+            }
+            rightArea[b] = surfaceArea(rMin, rMax);
+          }
+        }
+        float lMin[3], lMax[3];
+        std::copy(bMin[0], bMin[0] + 3, lMin);
+        std::copy(bMax[0], bMax[0] + 3, lMax);
+        size_t leftCount = 0;
+        float minCost = std::numeric_limits<float>::max();
+        int minBucket = -1;
+        for(int b = 0; b < nBuckets_ - 1; b++) {
+          leftCount += counts[b];
+          for(int j = 0; j < 3; j++) {
+            lMin[j] = std::min(lMin[j], bMin[b][j]);
+            lMax[j] = std::max(lMax[j], bMax[b][j]);
+          }
+          if(leftCount == 0 || leftCount == numberTriangles)
+            continue;
+          const float cost
+            = leftCount * surfaceArea(lMin, lMax)
+              + (numberTriangles - leftCount) * rightArea[b + 1];
+          if(cost < minCost) {
+            minCost = cost;
+            minBucket = b;
           }
-          float pMin[3] = {minX, minY, minZ};
-          float pMax[3] = {maxX, maxY, maxZ};
-          return std::make_shared<Node>(
-            triangleIndices, triangleIndices.size(), pMin, pMax);
-        } else {
-          // partition triangles into equally sized subsets
-          std::nth_element(&triangles[start], &triangles[half],
-                           &triangles[end - 1] + 1,
-                           [axis](const Triangle &t1, const Triangle &t2) {
-                             switch(axis) {
-                               case 0:
-                               default:
-                                 return t1.m_centroid_x < t2.m_centroid_x;
-                                 break;
-                               case 1:
-                                 return t1.m_centroid_y < t2.m_centroid_y;
-                                 break;
-                               case 2:
-                                 return t1.m_centroid_z < t2.m_centroid_z;
-                                 break;
-                             }
-                           });
-
-          return std::make_shared<Node>(axis, buildTree(triangles, start, half),
-                                        buildTree(triangles, half, end));
         }
+
+        const float area = surfaceArea(node->pMin, node->pMax);
+        minCost = traversalCost_ + (area > 0 ? minCost / area : 0);
+        if(numberTriangles <= maxLeafSize_ && minCost >= numberTriangles)
+          return node;
+
+        const auto midIt = std::partition(
+          triangles.begin() + start, triangles.begin() + end,
+          [&](const Triangle &t) { return bucketOf(t) <= minBucket; });
+        mid = midIt - triangles.begin();
       }
 
-      return nullptr;
+      node->axis = axis;
+      if(numberTriangles > taskGrainSize_) {
+        BuildNode *parent = node.get();
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp task firstprivate(parent, start, mid, depth) shared(triangles)
+#endif
+        parent->children[0] = buildTree(triangles, start, mid, depth + 1);
+        parent->children[1] = buildTree(triangles, mid, end, depth + 1);
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp taskwait
+#endif
+      } else {
+        node->children[0] = buildTree(triangles, start, mid, depth + 1);
+        node->children[1] = buildTree(triangles, mid, end, depth + 1);
+      }
+
+      return node;
     }
+
     int buildTriangleList(std::vector<Triangle> &triangles,
                           const float *coords,
                           const IT *connectivityList,
-                          const size_t &nTriangles) {
+                          const size_t &nTriangles,
+                          const int threadNumber = 1) const {
       triangles.resize(nTriangles);
+      TTK_FORCE_USE(threadNumber);
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber)
+#endif
       for(size_t ti = 0; ti < nTriangles; ti++) {
 
         const IT v1 = connectivityList[ti * 3 + 0] * 3;
@@ -240,138 +323,271 @@ namespace ttk {
       return 1;
     }
 
-    bool MollerTrumbore(Ray &ray,
-                        const IT v0,
-                        const IT v1,
-                        const IT v2,
-                        const float *vertexCoords) const {
-      constexpr float kEpsilon = 1e-8;
-
-      float v0v1[3], v0v2[3], pvec[3], tvec[3], qvec[3];
-      ttk::Geometry::subtractVectors(
-        &vertexCoords[v0], &vertexCoords[v1], v0v1);
-      ttk::Geometry::subtractVectors(
-        &vertexCoords[v0], &vertexCoords[v2], v0v2);
-      ttk::Geometry::crossProduct(ray.m_direction, v0v2, pvec);
-      float det = ttk::Geometry::dotProduct(v0v1, pvec);
-      if(det > -kEpsilon && det < kEpsilon)
+    /**
+     * @brief Trace a single ray, return true if a triangle was hit
+     *
+     * The barycentric coordinates of the hit are stored in the ray.
+     */
+    bool intersect(Ray &r, int *triangleIndex, float *distance) const {
+      if(this->nodes_.empty())
         return false;
 
-      float invDet = 1.0f / det;
-
-      ttk::Geometry::subtractVectors(&vertexCoords[v0], ray.m_origin, tvec);
-      float u = ttk::Geometry::dotProduct(tvec, pvec) * invDet;
-      if(u < 0.0 || u > 1.0)
-        return false;
+      const float *org = r.m_origin;
+      const float *dir = r.m_direction;
+      const float invDir[3] = {1.0f / dir[0], 1.0f / dir[1], 1.0f / dir[2]};
+
+      float tMax = std::numeric_limits<float>::max();
+      int hit = -1;
+
+      int stack[maxDepth_ + 4];
+      int stackSize = 0;
+      int current = 0;
+      while(true) {
+        const LinearNode &node = this->nodes_[current];
+        if(wasNodeHit(node, org, invDir, tMax)) {
+          if(node.nTriangles > 0) {
+            const int leafEnd = node.offset + node.nTriangles;
+            for(int i = node.offset; i < leafEnd; i++) {
+              float t, u, v;
+              if(MollerTrumbore(
+                   &this->triangleVertices_[9 * i], org, dir, t, u, v)
+                 && t < tMax) {
+                tMax = t;
+                hit = i;
+                r.u = u;
+                r.v = v;
+              }
+            }
+          } else {
+            // visit the nearest child first
+            if(dir[node.axis] < 0) {
+              stack[stackSize++] = current + 1;
+              current = node.offset;
+            } else {
+              stack[stackSize++] = node.offset;
+              current = current + 1;
+            }
+            continue;
+          }
+        }
+        if(stackSize == 0)
+          break;
+        current = stack[--stackSize];
+      }
 
-      ttk::Geometry::crossProduct(tvec, v0v1, qvec);
-      float v = ttk::Geometry::dotProduct(ray.m_direction, qvec) * invDet;
-      if(v < 0.0 || u + v > 1.0)
+      if(hit == -1)
         return false;
 
-      float t = ttk::Geometry::dotProduct(v0v2, qvec) * invDet;
-      ray.distance = t;
-      ray.u = u;
-      ray.v = v;
-
+      r.distance = tMax;
+      *triangleIndex = this->triangleIndices_[hit];
+      *distance = tMax;
       return true;
     }
 
-    bool intersect(Ray &r,
-                   const IT *connectivityList,
-                   const float *vertexCoords,
-                   int *triangleIndex,
-                   float *distance) const {
-      bool wasHit = false;
-      float nearestTriangle = std::numeric_limits<float>::max();
-      std::stack<Node *> stack;
-      Node *node = &nodes.get()[0];
-      if(!wasNodeHit(r, node)) {
-        return false;
-      }
-      stack.push(node);
-      while(stack.size() != 0) {
-        node = stack.top();
-        stack.pop();
-        if(wasNodeHit(r, node)) {
-
-          if(node->numTriangles > 0) {
-
-            for(int i = 0; i < node->numTriangles; i++) {
-              bool hasHit = false;
-              int triIdx = node->indices[i];
-
-              IT v0 = connectivityList[triIdx * 3 + 0];
-              IT v1 = connectivityList[triIdx * 3 + 1];
-              IT v2 = connectivityList[triIdx * 3 + 2];
-              v0 *= 3;
-              v1 *= 3;
-              v2 *= 3;
-              hasHit = MollerTrumbore(r, v0, v1, v2, vertexCoords);
-              if(hasHit && r.distance < nearestTriangle) {
-                *triangleIndex = triIdx;
-                nearestTriangle = r.distance;
-                wasHit = true;
-                *distance = r.distance;
-              }
+    /**
+     * @brief Trace a packet of coherent rays
+     *
+     * A node is visited if any ray of the packet hits its bounding box, the
+     * children are ordered according to the direction of the first ray.
+     * The hit records of the packet are updated in place.
+     */
+    template <int N>
+    void intersect(RayPacket<N> &packet) const {
+      if(this->nodes_.empty() || packet.nRays <= 0)
+        return;
+
+      const int nRays = std::min(packet.nRays, N);
+      int stack[maxDepth_ + 4];
+      int stackSize = 0;
+      int current = 0;
+      while(true) {
+        const LinearNode &node = this->nodes_[current];
+        if(wasNodeHit(node, packet, nRays)) {
+          if(node.nTriangles > 0) {
+            const int leafEnd = node.offset + node.nTriangles;
+            for(int i = node.offset; i < leafEnd; i++) {
+              MollerTrumbore(i, packet, nRays);
             }
           } else {
-
-            if(node->m_right != nullptr) {
-              stack.push(node->m_right.get());
-            }
-            if(node->m_left != nullptr) {
-              stack.push(node->m_left.get());
+            if(packet.direction[node.axis][0] < 0) {
+              stack[stackSize++] = current + 1;
+              current = node.offset;
+            } else {
+              stack[stackSize++] = node.offset;
+              current = current + 1;
             }
+            continue;
           }
         }
+        if(stackSize == 0)
+          break;
+        current = stack[--stackSize];
+      }
+
+      for(int i = 0; i < nRays; i++) {
+        if(packet.triangle[i] != -1)
+          packet.triangle[i] = this->triangleIndices_[packet.triangle[i]];
       }
-      return wasHit;
     }
 
-    bool wasNodeHit(const Ray &r, Node *n) const {
-      float tmin = (n->m_minX - r.m_origin[0]) / r.m_direction[0];
-      float tmax = (n->m_maxX - r.m_origin[0]) / r.m_direction[0];
+    inline size_t getNumberOfNodes() const {
+      return this->nodes_.size();
+    }
 
-      if(tmin > tmax)
-        std::swap(tmin, tmax);
+  protected:
+    /**
+     * @brief Möller-Trumbore test of a ray against the triangle stored at
+     * tv (v0, v0v1, v0v2), only hits in front of the origin are reported
+     */
+    static inline bool MollerTrumbore(const float *tv,
+                                      const float *org,
+                                      const float *dir,
+                                      float &t,
+                                      float &u,
+                                      float &v) {
+      constexpr float kEpsilon = 1e-8;
+      const float *v0v1 = &tv[3];
+      const float *v0v2 = &tv[6];
 
-      float tymin = (n->m_minY - r.m_origin[1]) / r.m_direction[1];
-      float tymax = (n->m_maxY - r.m_origin[1]) / r.m_direction[1];
+      float pvec[3], tvec[3], qvec[3];
+      ttk::Geometry::crossProduct(dir, v0v2, pvec);
+      const float det = ttk::Geometry::dotProduct(v0v1, pvec);
+      if(det > -kEpsilon && det < kEpsilon)
+        return false;
 
-      if(tymin > tymax)
-        std::swap(tymin, tymax);
+      const float invDet = 1.0f / det;
 
-      if((tmin > tymax) || (tymin > tmax))
+      ttk::Geometry::subtractVectors(tv, org, tvec);
+      u = ttk::Geometry::dotProduct(tvec, pvec) * invDet;
+      if(u < 0.0 || u > 1.0)
         return false;
 
-      if(tymin > tmin)
-        tmin = tymin;
-
-      if(tymax < tmax)
-        tmax = tymax;
+      ttk::Geometry::crossProduct(tvec, v0v1, qvec);
+      v = ttk::Geometry::dotProduct(dir, qvec) * invDet;
+      if(v < 0.0 || u + v > 1.0)
+        return false;
 
-      float tzmin = (n->m_minZ - r.m_origin[2]) / r.m_direction[2];
-      float tzmax = (n->m_maxZ - r.m_origin[2]) / r.m_direction[2];
+      t = ttk::Geometry::dotProduct(v0v2, qvec) * invDet;
+      return t > 0;
+    }
 
-      if(tzmin > tzmax)
-        std::swap(tzmin, tzmax);
+    /**
+     * @brief Möller-Trumbore test of the whole packet against triangle i
+     *
+     * Branch-free over the rays so that the loop can be vectorized.
+     */
+    template <int N>
+    inline void
+      MollerTrumbore(const int i, RayPacket<N> &p, const int nRays) const {
+      constexpr float kEpsilon = 1e-8;
+      const float *tv = &this->triangleVertices_[9 * i];
+      const float e1x = tv[3], e1y = tv[4], e1z = tv[5];
+      const float e2x = tv[6], e2y = tv[7], e2z = tv[8];
+
+      for(int r = 0; r < nRays; r++) {
+        const float dx = p.direction[0][r];
+        const float dy = p.direction[1][r];
+        const float dz = p.direction[2][r];
+
+        const float px = dy * e2z - dz * e2y;
+        const float py = dz * e2x - dx * e2z;
+        const float pz = dx * e2y - dy * e2x;
+        const float det = e1x * px + e1y * py + e1z * pz;
+        const float invDet = 1.0f / det;
+
+        const float tx = p.origin[0][r] - tv[0];
+        const float ty = p.origin[1][r] - tv[1];
+        const float tz = p.origin[2][r] - tv[2];
+        const float u = (tx * px + ty * py + tz * pz) * invDet;
+
+        const float qx = ty * e1z - tz * e1y;
+        const float qy = tz * e1x - tx * e1z;
+        const float qz = tx * e1y - ty * e1x;
+        const float v = (dx * qx + dy * qy + dz * qz) * invDet;
+        const float t = (e2x * qx + e2y * qy + e2z * qz) * invDet;
+
+        const bool hit = (det <= -kEpsilon || det >= kEpsilon) && u >= 0
+                         && v >= 0 && u + v <= 1 && t > 0
+                         && t < p.distance[r];
+        p.distance[r] = hit ? t : p.distance[r];
+        p.u[r] = hit ? u : p.u[r];
+        p.v[r] = hit ? v : p.v[r];
+        p.triangle[r] = hit ? i : p.triangle[r];
+      }
+    }
 
-      if((tmin > tzmax) || (tzmin > tmax))
-        return false;
+    static inline bool wasNodeHit(const LinearNode &n,
+                                  const float *org,
+                                  const float *invDir,
+                                  const float tMax) {
+      float t0 = 0, t1 = tMax;
+      for(int j = 0; j < 3; j++) {
+        float tNear = (n.pMin[j] - org[j]) * invDir[j];
+        float tFar = (n.pMax[j] - org[j]) * invDir[j];
+        if(tNear > tFar)
+          std::swap(tNear, tFar);
+        t0 = tNear > t0 ? tNear : t0;
+        t1 = tFar < t1 ? tFar : t1;
+        if(t0 > t1)
+          return false;
+      }
+      return true;
+    }
 
-      if(tzmin > tmin)
-        tmin = tzmin;
+    template <int N>
+    static inline bool
+      wasNodeHit(const LinearNode &n, const RayPacket<N> &p, const int nRays) {
+      bool anyHit = false;
+      for(int r = 0; r < nRays; r++) {
+        float t0 = 0, t1 = p.distance[r];
+        for(int j = 0; j < 3; j++) {
+          const float tA = (n.pMin[j] - p.origin[j][r]) * p.invDirection[j][r];
+          const float tB = (n.pMax[j] - p.origin[j][r]) * p.invDirection[j][r];
+          t0 = std::max(t0, std::min(tA, tB));
+          t1 = std::min(t1, std::max(tA, tB));
+        }
+        anyHit |= t0 <= t1;
+      }
+      return anyHit;
+    }
 
-      if(tzmax < tmax)
-        tmax = tzmax;
+    static inline float surfaceArea(const float *pMin, const float *pMax) {
+      const float dx = pMax[0] - pMin[0];
+      const float dy = pMax[1] - pMin[1];
+      const float dz = pMax[2] - pMin[2];
+      return 2 * (dx * dy + dx * dz + dy * dz);
+    }
 
-      return true;
+    int flattenTree(const BuildNode *node) {
+      const int index = this->nodes_.size();
+      this->nodes_.emplace_back();
+      LinearNode &linearNode = this->nodes_.back();
+      std::copy(node->pMin, node->pMin + 3, linearNode.pMin);
+      std::copy(node->pMax, node->pMax + 3, linearNode.pMax);
+      if(node->axis == -1) {
+        linearNode.offset = node->start;
+        linearNode.nTriangles = node->end - node->start;
+        linearNode.axis = 0;
+      } else {
+        linearNode.nTriangles = 0;
+        linearNode.axis = node->axis;
+        this->flattenTree(node->children[0].get());
+        const int second = this->flattenTree(node->children[1].get());
+        this->nodes_[index].offset = second;
+      }
+      return index;
     }
 
   private:
-    std::shared_ptr<Node> nodes;
-    float findCentroid(const float &v1, const float &v2, const float &v3) {
+    // depth-first array of nodes, the root is the first one
+    std::vector<LinearNode> nodes_{};
+    // triangle identifiers in leaf order
+    std::vector<int> triangleIndices_{};
+    // v0, v0v1 and v0v2 of each triangle in leaf order
+    std::vector<float> triangleVertices_{};
+
+    static float
+      findCentroid(const float &v1, const float &v2, const float &v3) {
       return (v1 + v2 + v3) / 3;
     }
   };
@@ -7,6 +7,8 @@
 
 #pragma once
 
+#include <limits>
+
 namespace ttk {
   class Ray {
   public:
@@ -23,4 +25,44 @@ namespace ttk {
     float u;
     float v;
   };
-} // namespace ttk
\ No newline at end of file
+
+  /**
+   * @brief Fixed-size bundle of rays, traversed together through a
+   * ttk::BoundingVolumeHierarchy
+   *
+   * Rays are stored in structure-of-arrays layout so that the
+   * per-ray loops of the traversal can be vectorized by the
+   * compiler. Only the first nRays rays are considered.
+   */
+  template <int N>
+  class RayPacket {
+  public:
+    static constexpr int size{N};
+
+    /**
+     * @brief Set ray i and reset its hit record
+     */
+    inline void
+      setRay(const int i, const float rayOrigin[3], const float rayDir[3]) {
+      for(int j = 0; j < 3; ++j) {
+        this->origin[j][i] = rayOrigin[j];
+        this->direction[j][i] = rayDir[j];
+        this->invDirection[j][i] = 1.0f / rayDir[j];
+      }
+      this->distance[i] = std::numeric_limits<float>::max();
+      this->u[i] = 0;
+      this->v[i] = 0;
+      this->triangle[i] = -1;
+    }
+
+    int nRays{N};
+    float origin[3][N];
+    float direction[3][N];
+    float invDirection[3][N];
+    // hit records (triangle is -1 if no hit)
+    float distance[N];
+    float u[N];
+    float v[N];
+    int triangle[N];
+  };
+} // namespace ttk
@@ -217,6 +217,10 @@ int ttk::CinemaImagingEmbree::renderImage(
                    + std::string(orthographicProjection ? "O" : "P") + "|"
                    + std::to_string(resX) + "x" + std::to_string(resY) + ")",
                  1, timer.getElapsedTime(), this->threadNumber_);
+  this->printMsg("Throughput: "
+                   + std::to_string(resX * resY / timer.getElapsedTime() / 1e6)
+                   + " Mrays/s",
+                 debug::Priority::DETAIL);
 
   return 1;
 };
@@ -50,9 +50,9 @@ int ttk::CinemaImagingNative::renderImage(
   unsigned int *primitiveIds,
   float *barycentricCoordinates,
   const size_t &ttkNotUsed(nVertices),
-  const float *vertexCoords,
+  const float *ttkNotUsed(vertexCoords),
   const size_t &ttkNotUsed(nTriangles),
-  const IT *connectivityList,
+  const IT *ttkNotUsed(connectivityList),
   const BoundingVolumeHierarchy<IT> &bvh,
   const double resolution[2],
   const double camPos[3],
@@ -115,109 +115,80 @@ int ttk::CinemaImagingNative::renderImage(
                             camPos[2] - camRight[2] * camWidthWorldHalf
                               - camUpTrue[2] * camHeightWorldHalf};
 
-  float nan = std::numeric_limits<float>::quiet_NaN();
-  if(orthographicProjection) {
+  // Coherent rays are traced together in packets of consecutive pixels
+  constexpr int packetSize = 8;
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  const auto traceRows = [&](const auto &generateRay) {
 #ifdef TTK_ENABLE_OPENMP
 #pragma omp parallel for num_threads(this->threadNumber_)
 #endif
     for(int y = 0; y < resY; y++) {
-      double v = ((double)y) * pixelHeightWorld;
-
-      size_t pixelIndex = y * resX;
-      size_t bcIndex = 2 * pixelIndex;
-
-      for(int x = 0; x < resX; x++) {
-        double u = ((double)x) * pixelWidthWorld;
+      RayPacket<packetSize> packet;
+      for(int x0 = 0; x0 < resX; x0 += packetSize) {
+        packet.nRays = std::min(packetSize, resX - x0);
+        for(int i = 0; i < packet.nRays; i++) {
+          float ray_origin[3], ray_dir[3];
+          generateRay(x0 + i, y, ray_origin, ray_dir);
+          packet.setRay(i, ray_origin, ray_dir);
+        }
 
-        depthBuffer[pixelIndex] = nan;
-        primitiveIds[pixelIndex] = CinemaImaging::INVALID_ID;
-        barycentricCoordinates[bcIndex] = nan;
-        barycentricCoordinates[bcIndex + 1] = nan;
+        bvh.intersect(packet);
+
+        size_t pixelIndex = y * resX + x0;
+        for(int i = 0; i < packet.nRays; i++, pixelIndex++) {
+          const size_t bcIndex = 2 * pixelIndex;
+          if(packet.triangle[i] != -1) {
+            depthBuffer[pixelIndex] = packet.distance[i];
+            primitiveIds[pixelIndex] = packet.triangle[i];
+            barycentricCoordinates[bcIndex] = packet.u[i];
+            barycentricCoordinates[bcIndex + 1] = packet.v[i];
+          } else {
+            depthBuffer[pixelIndex] = nan;
+            primitiveIds[pixelIndex] = CinemaImaging::INVALID_ID;
+            barycentricCoordinates[bcIndex] = nan;
+            barycentricCoordinates[bcIndex + 1] = nan;
+          }
+        }
+      }
+    }
+  };
 
+  if(orthographicProjection) {
+    traceRows([&](const int x, const int y, float org[3], float dir[3]) {
+      const double u = ((double)x) * pixelWidthWorld;
+      const double v = ((double)y) * pixelHeightWorld;
+      for(int j = 0; j < 3; j++) {
         // set origin
-        float org_x = camPosCorner[0] + u * camRight[0] + v * camUpTrue[0];
-        float org_y = camPosCorner[1] + u * camRight[1] + v * camUpTrue[1];
-        float org_z = camPosCorner[2] + u * camRight[2] + v * camUpTrue[2];
-
-        float ray_origin[3] = {org_x, org_y, org_z};
-
+        org[j] = camPosCorner[j] + u * camRight[j] + v * camUpTrue[j];
         // set dir
-        float dir_x = camDir[0];
-        float dir_y = camDir[1];
-        float dir_z = camDir[2];
-
-        float ray_dir[3] = {dir_x, dir_y, dir_z};
-
-        Ray ray(ray_dir, ray_origin);
-        bool wasHit = false;
-        int triIdx;
-        float distance;
-        wasHit = bvh.intersect(
-          ray, connectivityList, vertexCoords, &triIdx, &distance);
-        if(wasHit) {
-          depthBuffer[pixelIndex] = distance;
-          primitiveIds[pixelIndex] = triIdx;
-          barycentricCoordinates[bcIndex] = ray.u;
-          barycentricCoordinates[bcIndex + 1] = ray.v;
-        }
-        pixelIndex++;
-        bcIndex += 2;
+        dir[j] = camDir[j];
       }
-    }
+    });
   } else {
-    double factor = (viewAngle / 180.0 * 3.141592653589793) / resolution[0];
-
-#ifdef TTK_ENABLE_OPENMP
-#pragma omp parallel for num_threads(this->threadNumber_)
-#endif
-    for(int y = 0; y < resY; y++) {
-      double v = (y - resY * 0.5) * factor;
-      size_t pixelIndex = y * resX;
-      size_t bcIndex = 2 * pixelIndex;
-
-      for(int x = 0; x < resX; x++) {
-        double u = (x - resX * 0.5) * factor;
-
-        depthBuffer[pixelIndex] = nan;
-        primitiveIds[pixelIndex] = CinemaImaging::INVALID_ID;
-        barycentricCoordinates[bcIndex] = nan;
-        barycentricCoordinates[bcIndex + 1] = nan;
+    const double factor
+      = (viewAngle / 180.0 * 3.141592653589793) / resolution[0];
 
+    traceRows([&](const int x, const int y, float org[3], float dir[3]) {
+      const double u = (x - resX * 0.5) * factor;
+      const double v = (y - resY * 0.5) * factor;
+      for(int j = 0; j < 3; j++) {
         // set origin
-        float org_x = camPos[0];
-        float org_y = camPos[1];
-        float org_z = camPos[2];
-
-        float ray_origin[3] = {org_x, org_y, org_z};
+        org[j] = camPos[j];
         // set dir
-        float dir_x = camDir[0] + u * camRight[0] + v * camUpTrue[0];
-        float dir_y = camDir[1] + u * camRight[1] + v * camUpTrue[1];
-        float dir_z = camDir[2] + u * camRight[2] + v * camUpTrue[2];
-
-        float ray_dir[3] = {dir_x, dir_y, dir_z};
-
-        Ray ray(ray_dir, ray_origin);
-        bool wasHit = false;
-        int triIdx;
-        float distance;
-        wasHit = bvh.intersect(
-          ray, connectivityList, vertexCoords, &triIdx, &distance);
-        if(wasHit) {
-          depthBuffer[pixelIndex] = distance;
-          primitiveIds[pixelIndex] = triIdx;
-          barycentricCoordinates[bcIndex] = ray.u;
-          barycentricCoordinates[bcIndex + 1] = ray.v;
-        }
-        pixelIndex++;
-        bcIndex += 2;
+        dir[j] = camDir[j] + u * camRight[j] + v * camUpTrue[j];
       }
-    }
+    });
   }
+
   this->printMsg("Rendering Image ("
                    + std::string(orthographicProjection ? "O" : "P") + "|"
                    + std::to_string(resX) + "x" + std::to_string(resY) + ")",
 
                  1, timer.getElapsedTime(), this->threadNumber_);
+  this->printMsg("Throughput: "
+                   + std::to_string(resX * resY / timer.getElapsedTime() / 1e6)
+                   + " Mrays/s",
+                 debug::Priority::DETAIL);
 
   return 1;
 }
@@ -1,101 +1,540 @@
 #pragma once
 
-#include <list>
-#include <map>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <utility>
+#include <vector>
 
 namespace ttk {
+
+  /**
+   * @brief Default hash functor for the ttk::LRUCache keys
+   *
+   * Falls back to std::hash, with a specialization for std::pair.
+   */
+  template <typename KeyType>
+  struct CacheKeyHash : public std::hash<KeyType> {};
+
+  template <typename T0, typename T1>
+  struct CacheKeyHash<std::pair<T0, T1>> {
+    inline size_t operator()(const std::pair<T0, T1> &key) const {
+      const size_t h0 = std::hash<T0>{}(key.first);
+      const size_t h1 = std::hash<T1>{}(key.second);
+      return h0 ^ (h1 + 0x9e3779b9 + (h0 << 6) + (h0 >> 2));
+    }
+  };
+
   /**
-   * @brief LRU cache implementation
+   * @brief Thread-safe, memory-bounded cache
+   *
+   * Entries are spread over several shards, each one being an
+   * open-addressing hash table (linear probing) protected by a
+   * reader/writer lock. Lookups only take a shared lock, so
+   * concurrent readers do not block each other. The least recently
+   * used entries are approximated with the CLOCK algorithm: a hit
+   * sets a per-entry reference bit, and a single eviction hand sweeps
+   * the tables of all the shards in turn, clearing reference bits
+   * until it finds an unreferenced entry.
    *
-   * Adapted from boost/compute/details/lru_cache.hpp
+   * The cache is bounded by a number of entries (8 by default) and,
+   * optionally, by a byte budget: every entry is inserted with its
+   * memory footprint and, if a budget has been set, entries are
+   * evicted until the total footprint fits in it. Values are stored
+   * as std::shared_ptr so that an evicted entry stays valid for as
+   * long as a caller holds it. An eviction callback can be set to
+   * spill the evicted entries somewhere else.
    */
-  template <class KeyType, class ValueType>
+  template <typename KeyType,
+            typename ValueType,
+            typename Hash = CacheKeyHash<KeyType>>
   class LRUCache {
   public:
-    // default cache with at most 8 entries
-    LRUCache() : capacity_{8} {
+    using ValuePtr = std::shared_ptr<ValueType>;
+    using EvictionCallback
+      = std::function<void(const KeyType &, const ValuePtr &)>;
+
+    struct Statistics {
+      size_t hits{};
+      size_t misses{};
+      size_t insertions{};
+      size_t evictions{};
+      size_t entries{};
+      size_t bytes{};
+    };
+
+    static constexpr size_t unlimited{static_cast<size_t>(-1)};
+    // default cache: at most 8 entries, no byte budget
+    static constexpr size_t defaultMaxEntries{8};
+    static constexpr size_t defaultShardNumber{16};
+
+    LRUCache() : LRUCache{unlimited, defaultMaxEntries} {
     }
 
-    LRUCache(const std::size_t capacity) : capacity_(capacity) {
+    /**
+     * @param[in] capacity Byte budget
+     * @param[in] maxEntries Maximum number of entries
+     * @param[in] shardNumber Number of independently locked shards
+     */
+    LRUCache(const size_t capacity,
+             const size_t maxEntries = unlimited,
+             const size_t shardNumber = defaultShardNumber)
+      : capacity_{capacity}, maxEntries_{maxEntries} {
+      this->shards_.resize(shardNumber > 0 ? shardNumber : 1);
+      for(auto &shard : this->shards_) {
+        shard.reset(new Shard{});
+      }
+    }
+
+    LRUCache(const LRUCache &other)
+      : LRUCache{other.capacity_, other.maxEntries_} {
+      this->evictionCallback_ = other.getEvictionCallback();
+      this->copyEntries(other);
+    }
+
+    LRUCache(LRUCache &&other) : LRUCache{other.capacity_, other.maxEntries_} {
+      this->evictionCallback_ = other.getEvictionCallback();
+      this->copyEntries(other);
+      other.clear();
+    }
+
+    LRUCache &operator=(const LRUCache &other) {
+      if(this != &other) {
+        this->clear();
+        this->capacity_ = other.capacity_;
+        this->maxEntries_ = other.maxEntries_;
+        this->setEvictionCallback(other.getEvictionCallback());
+        this->copyEntries(other);
+      }
+      return *this;
+    }
+
+    /**
+     * @brief The entries still stored are passed to the eviction
+     * callback, if any
+     */
+    ~LRUCache() {
+      if(!this->evictionCallback_) {
+        return;
+      }
+      for(const auto &shard : this->shards_) {
+        for(const auto &slot : shard->slots_) {
+          if(slot.value != nullptr) {
+            this->evictionCallback_(slot.key, slot.value);
+          }
+        }
+      }
+    }
+
+    LRUCache &operator=(LRUCache &&other) {
+      if(this != &other) {
+        *this = other;
+        other.clear();
+      }
+      return *this;
     }
 
     inline bool empty() const {
-      return this->map_.empty();
+      return this->size() == 0;
     }
 
+    /**
+     * @brief Byte budget
+     */
     inline std::size_t capacity() const {
       return this->capacity_;
     }
 
+    /**
+     * @brief Change the byte budget, evict entries if needed
+     */
+    inline void setCapacity(const std::size_t capacity) {
+      this->capacity_ = capacity;
+      this->shrinkToCapacity(nullptr);
+    }
+
+    /**
+     * @brief Maximum number of entries
+     */
+    inline std::size_t maxEntries() const {
+      return this->maxEntries_;
+    }
+
+    /**
+     * @brief Change the maximum number of entries, evict entries if
+     * needed
+     */
+    inline void setMaxEntries(const std::size_t maxEntries) {
+      this->maxEntries_ = maxEntries;
+      this->shrinkToCapacity(nullptr);
+    }
+
+    /**
+     * @brief Function called with every entry evicted to fit in the
+     * cache (or still stored when the cache is destroyed), outside of
+     * the cache locks. Entries removed by clear() are not passed to it.
+     */
+    inline void setEvictionCallback(EvictionCallback callback) {
+      std::lock_guard<std::mutex> handLock{this->handMutex_};
+      this->evictionCallback_ = std::move(callback);
+    }
+
+    inline EvictionCallback getEvictionCallback() const {
+      std::lock_guard<std::mutex> handLock{this->handMutex_};
+      return this->evictionCallback_;
+    }
+
+    /**
+     * @brief Number of entries
+     */
     inline std::size_t size() const {
-      return this->map_.size();
+      return this->entries_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Sum of the memory footprints of the stored entries
+     */
+    inline std::size_t memoryUsage() const {
+      return this->bytes_.load(std::memory_order_relaxed);
     }
 
     inline bool contains(const KeyType &key) const {
-      return this->map_.find(key) != this->map_.end();
+      const auto hash{this->hashKey(key)};
+      const auto &shard{*this->shards_[this->shardId(hash)]};
+      std::shared_lock<std::shared_timed_mutex> lock{shard.mutex_};
+      return shard.findSlot(key, hash) != shard.npos;
     }
 
     inline void clear() {
-      this->map_.clear();
-      this->queue_.clear();
+      for(auto &shard : this->shards_) {
+        std::unique_lock<std::shared_timed_mutex> lock{shard->mutex_};
+        this->entries_ -= shard->nEntries_;
+        this->bytes_ -= shard->nBytes_;
+        shard->reset();
+      }
     }
 
     /**
      * @brief Insert new (key, value) entry
      *
-     * Do nothing if key already in use
+     * Do nothing if key already in use or if the value does not fit
+     * in the cache.
+     *
+     * @param[in] key Entry key
+     * @param[in] value Entry value
+     * @param[in] nBytes Memory footprint of the entry
+     * @return true if the entry was inserted
      */
-    inline void insert(const KeyType &key, const ValueType &value) {
-      if(this->contains(key)) {
-        return; // key already in use
+    inline bool
+      insert(const KeyType &key, ValuePtr value, const std::size_t nBytes) {
+      if(value == nullptr || nBytes > this->capacity_
+         || this->maxEntries_ == 0) {
+        return false;
       }
 
-      if(this->size() >= this->capacity_) {
-        // cache is full, evict the least recently used entry
-        this->map_.erase(this->queue_.back());
-        this->queue_.pop_back();
+      const auto hash{this->hashKey(key)};
+      {
+        auto &shard{*this->shards_[this->shardId(hash)]};
+        std::unique_lock<std::shared_timed_mutex> lock{shard.mutex_};
+        if(!shard.insert(key, hash, std::move(value), nBytes)) {
+          return false; // key already in use
+        }
       }
+      this->entries_++;
+      this->bytes_ += nBytes;
+      this->insertions_++;
 
-      // insert new entry
-      this->queue_.push_front(key);
-      this->map_.emplace(key, std::make_pair(value, this->queue_.begin()));
+      this->shrinkToCapacity(&key);
+      return true;
     }
 
     /**
-     * @brief Get value pointer from key
+     * @brief Get value from key
      *
      * @return nullptr if cache miss
      */
-    inline ValueType *get(const KeyType &key) {
-      const auto i = this->map_.find(key);
-      if(i == this->map_.end()) {
-        // cache miss, nullptr
+    inline ValuePtr get(const KeyType &key) {
+      const auto hash{this->hashKey(key)};
+      auto &shard{*this->shards_[this->shardId(hash)]};
+      std::shared_lock<std::shared_timed_mutex> lock{shard.mutex_};
+      const auto slot{shard.findSlot(key, hash)};
+      if(slot == shard.npos) {
+        this->misses_++;
         return {};
       }
+      shard.slots_[slot].referenced.store(true, std::memory_order_relaxed);
+      this->hits_++;
+      return shard.slots_[slot].value;
+    }
+
+    inline Statistics getStatistics() const {
+      Statistics res{};
+      res.hits = this->hits_;
+      res.misses = this->misses_;
+      res.insertions = this->insertions_;
+      res.evictions = this->evictions_;
+      res.entries = this->entries_;
+      res.bytes = this->bytes_;
+      return res;
+    }
+
+    inline void resetStatistics() {
+      this->hits_ = 0;
+      this->misses_ = 0;
+      this->insertions_ = 0;
+      this->evictions_ = 0;
+    }
+
+  private:
+    class Shard {
+    public:
+      static constexpr size_t npos{static_cast<size_t>(-1)};
+
+      struct Slot {
+        KeyType key{};
+        // nullptr for an empty slot
+        ValuePtr value{};
+        size_t nBytes{};
+        size_t hash{};
+        std::atomic<bool> referenced{false};
+      };
+
+      mutable std::shared_timed_mutex mutex_{};
+      // power-of-two sized open-addressing table, also swept by the
+      // CLOCK hand
+      std::vector<Slot> slots_{};
+      size_t nEntries_{};
+      size_t nBytes_{};
+
+      inline void reset() {
+        std::vector<Slot>{}.swap(this->slots_);
+        this->nEntries_ = 0;
+        this->nBytes_ = 0;
+      }
 
-      // iterator to entry in LRU list
-      const auto oldIt = i->second.second;
-      if(oldIt != this->queue_.begin()) {
-        // update entry, now first in the LRU list
-        this->queue_.erase(oldIt);
-        this->queue_.push_front(key);
+      inline size_t findSlot(const KeyType &key, const size_t hash) const {
+        if(this->slots_.empty()) {
+          return npos;
+        }
+        const size_t mask = this->slots_.size() - 1;
+        for(size_t i = home(hash, mask);; i = (i + 1) & mask) {
+          const auto &slot{this->slots_[i]};
+          if(slot.value == nullptr) {
+            return npos;
+          }
+          if(slot.hash == hash && slot.key == key) {
+            return i;
+          }
+        }
+      }
+
+      inline bool insert(const KeyType &key,
+                         const size_t hash,
+                         ValuePtr &&value,
+                         const size_t nBytes) {
+        if(this->findSlot(key, hash) != npos) {
+          return false;
+        }
+        // keep load factor under 1/2
+        if(2 * (this->nEntries_ + 1) > this->slots_.size()) {
+          this->grow();
+        }
+        const size_t mask = this->slots_.size() - 1;
+        size_t i = home(hash, mask);
+        while(this->slots_[i].value != nullptr) {
+          i = (i + 1) & mask;
+        }
+        this->place(i, key, hash, std::move(value), nBytes, true);
+        this->nEntries_++;
+        this->nBytes_ += nBytes;
+        return true;
+      }
+
+      /**
+       * @brief Move the CLOCK hand over this shard, from slot hand:
+       * give a second chance to the referenced entries and evict the
+       * first unreferenced one
+       *
+       * @return Footprint of the evicted entry (returned in
+       * evictedKey and evictedValue), npos if the hand reached the end
+       * of the shard
+       */
+      inline size_t sweep(size_t &hand,
+                          const KeyType *const protectedKey,
+                          KeyType &evictedKey,
+                          ValuePtr &evictedValue) {
+        for(; hand < this->slots_.size(); ++hand) {
+          auto &slot{this->slots_[hand]};
+          if(slot.value == nullptr
+             || (protectedKey != nullptr && slot.key == *protectedKey)) {
+            continue;
+          }
+          if(slot.referenced.load(std::memory_order_relaxed)) {
+            // second chance
+            slot.referenced.store(false, std::memory_order_relaxed);
+            continue;
+          }
+          const auto nBytes{slot.nBytes};
+          evictedKey = slot.key;
+          evictedValue = slot.value;
+          // the next entry may be shifted back to this slot
+          this->erase(hand);
+          return nBytes;
+        }
+        return npos;
+      }
+
+    private:
+      // the lowest bits select the shard, use the next ones
+      static inline size_t home(const size_t hash, const size_t mask) {
+        return (hash >> 8) & mask;
+      }
+
+      inline void place(const size_t i,
+                        const KeyType &key,
+                        const size_t hash,
+                        ValuePtr &&value,
+                        const size_t nBytes,
+                        const bool referenced) {
+        auto &slot{this->slots_[i]};
+        slot.key = key;
+        slot.hash = hash;
+        slot.value = std::move(value);
+        slot.nBytes = nBytes;
+        slot.referenced.store(referenced, std::memory_order_relaxed);
+      }
 
-        // update queue position in map
-        this->map_[key].second = this->queue_.begin();
+      inline void grow() {
+        std::vector<Slot> old{};
+        old.swap(this->slots_);
+        std::vector<Slot> slots(old.empty() ? 8 : 2 * old.size());
+        this->slots_.swap(slots);
+        const size_t mask = this->slots_.size() - 1;
+        for(auto &slot : old) {
+          if(slot.value == nullptr) {
+            continue;
+          }
+          size_t i = home(slot.hash, mask);
+          while(this->slots_[i].value != nullptr) {
+            i = (i + 1) & mask;
+          }
+          this->place(i, slot.key, slot.hash, std::move(slot.value),
+                      slot.nBytes, slot.referenced.load());
+        }
       }
 
-      // return value address
-      return &i->second.first;
+      // backward-shift deletion, no tombstones
+      inline void erase(size_t i) {
+        const size_t mask = this->slots_.size() - 1;
+        this->nEntries_--;
+        this->nBytes_ -= this->slots_[i].nBytes;
+        this->slots_[i].value.reset();
+        for(size_t j = (i + 1) & mask; this->slots_[j].value != nullptr;
+            j = (j + 1) & mask) {
+          const size_t k = home(this->slots_[j].hash, mask);
+          // entry j can stay if its ideal slot k is cyclically in (i, j]
+          const bool stays = i <= j ? (i < k && k <= j) : (i < k || k <= j);
+          if(stays) {
+            continue;
+          }
+          auto &slot{this->slots_[j]};
+          this->place(i, slot.key, slot.hash, std::move(slot.value),
+                      slot.nBytes, slot.referenced.load());
+          slot.value.reset();
+          i = j;
+        }
+      }
+    };
+
+    inline size_t hashKey(const KeyType &key) const {
+      // mix the bits, keys such as pointers have many zero low bits
+      uint64_t h = Hash{}(key);
+      h ^= h >> 33;
+      h *= 0xff51afd7ed558ccdULL;
+      h ^= h >> 33;
+      return static_cast<size_t>(h);
     }
 
-  private:
-    using ListType = std::list<KeyType>;
-    using MapType
-      = std::map<KeyType, std::pair<ValueType, typename ListType::iterator>>;
+    inline size_t shardId(const size_t hash) const {
+      return (hash & 0xff) % this->shards_.size();
+    }
+
+    /**
+     * @brief Evict entries until the number of entries and their
+     * footprint fit in the cache
+     *
+     * The CLOCK hand is shared by all the shards, so that the victim
+     * is chosen over the whole cache.
+     */
+    inline void shrinkToCapacity(const KeyType *const protectedKey) {
+      std::vector<std::pair<KeyType, ValuePtr>> evicted{};
+      EvictionCallback callback{};
+      {
+        std::lock_guard<std::mutex> handLock{this->handMutex_};
+        const size_t nShards = this->shards_.size();
+        // after two turns without eviction, every reference bit has
+        // been cleared: only the protected entry is left
+        size_t nFruitless{};
+        while((this->bytes_ > this->capacity_
+               || this->entries_ > this->maxEntries_)
+              && nFruitless <= 2 * nShards) {
+          auto &shard{*this->shards_[this->handShard_]};
+          KeyType key{};
+          ValuePtr value{};
+          size_t nBytes{};
+          {
+            std::unique_lock<std::shared_timed_mutex> lock{shard.mutex_};
+            nBytes = shard.sweep(this->handSlot_, protectedKey, key, value);
+          }
+          if(nBytes == Shard::npos) {
+            this->handShard_ = (this->handShard_ + 1) % nShards;
+            this->handSlot_ = 0;
+            nFruitless++;
+            continue;
+          }
+          nFruitless = 0;
+          this->entries_--;
+          this->bytes_ -= nBytes;
+          this->evictions_++;
+          if(this->evictionCallback_) {
+            evicted.emplace_back(std::move(key), std::move(value));
+          }
+        }
+        callback = this->evictionCallback_;
+      }
+      for(const auto &entry : evicted) {
+        callback(entry.first, entry.second);
+      }
+    }
+
+    inline void copyEntries(const LRUCache &other) {
+      for(const auto &shard : other.shards_) {
+        std::shared_lock<std::shared_timed_mutex> lock{shard->mutex_};
+        for(const auto &slot : shard->slots_) {
+          if(slot.value != nullptr) {
+            this->insert(slot.key, slot.value, slot.nBytes);
+          }
+        }
+      }
+    }
 
-    MapType map_;
-    ListType queue_;
+    std::vector<std::unique_ptr<Shard>> shards_{};
     std::size_t capacity_;
+    std::size_t maxEntries_;
+    std::atomic<size_t> entries_{};
+    std::atomic<size_t> bytes_{};
+    std::atomic<size_t> hits_{};
+    std::atomic<size_t> misses_{};
+    std::atomic<size_t> insertions_{};
+    std::atomic<size_t> evictions_{};
+    // CLOCK hand: shard and slot (also guards the eviction callback)
+    mutable std::mutex handMutex_{};
+    size_t handShard_{};
+    size_t handSlot_{};
+    EvictionCallback evictionCallback_{};
   };
 
 } // namespace ttk
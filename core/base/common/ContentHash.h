@@ -0,0 +1,127 @@
+#pragma once
+
+#include <BaseClass.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+namespace ttk {
+
+  namespace hash {
+
+    /**
+     * @brief 64-bit finalizer (from MurmurHash3)
+     */
+    inline uint64_t mix(uint64_t h) {
+      h ^= h >> 33;
+      h *= 0xff51afd7ed558ccdULL;
+      h ^= h >> 33;
+      h *= 0xc4ceb9fe1a85ec53ULL;
+      h ^= h >> 33;
+      return h;
+    }
+
+    /**
+     * @brief Combine a value into a hash seed
+     */
+    inline uint64_t combine(const uint64_t seed, const uint64_t value) {
+      return mix(seed ^ (mix(value) + 0x9e3779b97f4a7c15ULL + (seed << 6)
+                         + (seed >> 2)));
+    }
+
+    /**
+     * @brief Serial hash of a (small) memory buffer
+     */
+    inline uint64_t hashBlock(const void *const data,
+                              const std::size_t nBytes,
+                              uint64_t seed = 0) {
+      const auto bytes = static_cast<const unsigned char *>(data);
+      uint64_t h = seed ^ (nBytes * 0x87c37b91114253d5ULL);
+      std::size_t i = 0;
+      for(; i + sizeof(uint64_t) <= nBytes; i += sizeof(uint64_t)) {
+        uint64_t word{};
+        std::memcpy(&word, bytes + i, sizeof(uint64_t));
+        h = (h ^ mix(word)) * 0x9fb21c651e98df25ULL;
+      }
+      uint64_t tail{};
+      std::memcpy(&tail, bytes + i, nBytes - i);
+      return mix(h ^ mix(tail));
+    }
+
+    /**
+     * @brief Content hash of a memory buffer
+     *
+     * The buffer is split into fixed-size blocks that are hashed in
+     * parallel, the block hashes being then combined in order: the
+     * result does not depend on the number of threads.
+     */
+    inline uint64_t hashBuffer(const void *const data,
+                               const std::size_t nBytes,
+                               const int threadNumber = 1) {
+      constexpr std::size_t blockSize{std::size_t{1} << 20};
+      const auto bytes = static_cast<const unsigned char *>(data);
+      const std::size_t nBlocks = (nBytes + blockSize - 1) / blockSize;
+      std::vector<uint64_t> blockHashes(nBlocks);
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber)
+#endif // TTK_ENABLE_OPENMP
+      for(std::size_t i = 0; i < nBlocks; ++i) {
+        const auto begin = i * blockSize;
+        const auto size = std::min(blockSize, nBytes - begin);
+        blockHashes[i] = hashBlock(bytes + begin, size, i);
+      }
+
+      TTK_FORCE_USE(threadNumber);
+
+      uint64_t res = mix(nBytes);
+      for(const auto h : blockHashes) {
+        res = combine(res, h);
+      }
+      return res;
+    }
+
+    /**
+     * @brief hashBuffer() and a second, independently seeded, content
+     * hash of the same buffer, computed in a single pass
+     *
+     * Both hashes have to collide for two buffers to be mistaken.
+     */
+    inline std::pair<uint64_t, uint64_t>
+      hashBufferPair(const void *const data,
+                     const std::size_t nBytes,
+                     const int threadNumber = 1) {
+      constexpr std::size_t blockSize{std::size_t{1} << 20};
+      constexpr uint64_t seed{0x2545f4914f6cdd1dULL};
+      const auto bytes = static_cast<const unsigned char *>(data);
+      const std::size_t nBlocks = (nBytes + blockSize - 1) / blockSize;
+      std::vector<std::pair<uint64_t, uint64_t>> blockHashes(nBlocks);
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber)
+#endif // TTK_ENABLE_OPENMP
+      for(std::size_t i = 0; i < nBlocks; ++i) {
+        const auto begin = i * blockSize;
+        const auto size = std::min(blockSize, nBytes - begin);
+        // the block is still in cache for the second hash
+        blockHashes[i].first = hashBlock(bytes + begin, size, i);
+        blockHashes[i].second
+          = hashBlock(bytes + begin, size, combine(seed, i));
+      }
+
+      TTK_FORCE_USE(threadNumber);
+
+      std::pair<uint64_t, uint64_t> res{mix(nBytes), combine(seed, nBytes)};
+      for(const auto &h : blockHashes) {
+        res.first = combine(res.first, h.first);
+        res.second = combine(res.second, h.second);
+      }
+      return res;
+    }
+
+  } // namespace hash
+
+} // namespace ttk
@@ -8,14 +8,76 @@ namespace ttk {
    *
    * Use this when instead of a std::vector<std::vector<SimplexId>>
    * when the data is set once and not modified afterwards.
+   *
+   * The buffers are either owned by the array or borrowed from an
+   * external memory area (e.g. a memory-mapped file, see
+   * ttk::ExplicitTriangulation::readFromFile) through setExternalData.
    */
   class FlatJaggedArray {
-    // flattened sub-vectors data
+    // flattened sub-vectors data (if owned)
     std::vector<SimplexId> data_;
-    // offset for every sub-vector
+    // offset for every sub-vector (if owned)
     std::vector<SimplexId> offsets_;
+    // views on either the vectors above or on external buffers
+    const SimplexId *dataPtr_{};
+    const SimplexId *offsetsPtr_{};
+    size_t dataSize_{};
+    size_t offsetsSize_{};
+    bool external_{false};
+
+    inline void updateViews() {
+      this->external_ = false;
+      this->dataPtr_ = this->data_.data();
+      this->offsetsPtr_ = this->offsets_.data();
+      this->dataSize_ = this->data_.size();
+      this->offsetsSize_ = this->offsets_.size();
+    }
+
+    inline void copyViews(const FlatJaggedArray &other) {
+      if(other.external_) {
+        this->external_ = true;
+        this->dataPtr_ = other.dataPtr_;
+        this->offsetsPtr_ = other.offsetsPtr_;
+        this->dataSize_ = other.dataSize_;
+        this->offsetsSize_ = other.offsetsSize_;
+      } else {
+        this->updateViews();
+      }
+    }
 
   public:
+    FlatJaggedArray() = default;
+    ~FlatJaggedArray() = default;
+
+    // the views must be updated on copy and move
+    FlatJaggedArray(const FlatJaggedArray &other)
+      : data_{other.data_}, offsets_{other.offsets_} {
+      this->copyViews(other);
+    }
+    FlatJaggedArray(FlatJaggedArray &&other) noexcept
+      : data_{std::move(other.data_)},
+        offsets_{std::move(other.offsets_)} {
+      this->copyViews(other);
+      other.updateViews();
+    }
+    FlatJaggedArray &operator=(const FlatJaggedArray &other) {
+      if(this != &other) {
+        this->data_ = other.data_;
+        this->offsets_ = other.offsets_;
+        this->copyViews(other);
+      }
+      return *this;
+    }
+    FlatJaggedArray &operator=(FlatJaggedArray &&other) noexcept {
+      if(this != &other) {
+        this->data_ = std::move(other.data_);
+        this->offsets_ = std::move(other.offsets_);
+        this->copyViews(other);
+        other.updateViews();
+      }
+      return *this;
+    }
+
     // ############## //
     // Initialization //
     // ############## //
@@ -27,6 +89,36 @@ namespace ttk {
                         std::vector<SimplexId> &&offsets) {
       this->data_ = std::move(data);
       this->offsets_ = std::move(offsets);
+      this->updateViews();
+    }
+
+    /**
+     * @brief Use external buffers without copying them
+     *
+     * The caller has to keep the buffers alive (and unmodified) as long
+     * as this array uses them.
+     *
+     * @param data Flattened sub-vectors data, of size offsets[nOffsets - 1]
+     * @param offsets Offset of every sub-vector (size nOffsets)
+     * @param nOffsets Number of offsets (number of sub-vectors + 1)
+     */
+    inline void setExternalData(const SimplexId *const data,
+                                const SimplexId *const offsets,
+                                const size_t nOffsets) {
+      this->data_ = {};
+      this->offsets_ = {};
+      this->external_ = true;
+      this->dataPtr_ = data;
+      this->offsetsPtr_ = offsets;
+      this->offsetsSize_ = nOffsets;
+      this->dataSize_ = nOffsets > 0 ? offsets[nOffsets - 1] : 0;
+    }
+
+    /**
+     * @brief If the array uses external buffers
+     */
+    inline bool isExternal() const {
+      return this->external_;
     }
 
     /**
@@ -35,6 +127,7 @@ namespace ttk {
     inline void clear() {
       this->data_.clear();
       this->offsets_.clear();
+      this->updateViews();
     }
 
     // ############################## //
@@ -46,11 +139,11 @@ namespace ttk {
      */
     inline SimplexId size(SimplexId id) const {
 #ifndef TTK_ENABLE_KAMIKAZE
-      if(id < 0 || id > (SimplexId)offsets_.size() - 1) {
+      if(id < 0 || id > (SimplexId)this->offsetsSize_ - 1) {
         return -1;
       }
 #endif
-      return this->offsets_[id + 1] - this->offsets_[id];
+      return this->offsetsPtr_[id + 1] - this->offsetsPtr_[id];
     }
 
     /**
@@ -58,11 +151,11 @@ namespace ttk {
      */
     inline SimplexId offset(SimplexId id) const {
 #ifndef TTK_ENABLE_KAMIKAZE
-      if(id < 0 || id > (SimplexId)offsets_.size()) {
+      if(id < 0 || id > (SimplexId)this->offsetsSize_) {
         return -1;
       }
 #endif
-      return this->offsets_[id];
+      return this->offsetsPtr_[id];
     }
 
     struct Slice {
@@ -113,7 +206,7 @@ namespace ttk {
 
     inline Slice operator[](const size_t id) const {
 #ifndef TTK_ENABLE_KAMIKAZE
-      if(id >= this->offsets_.size()) {
+      if(id >= this->offsetsSize_) {
         return {0, nullptr};
       }
 #endif
@@ -125,14 +218,14 @@ namespace ttk {
      */
     inline SimplexId get(SimplexId id, SimplexId local) const {
 #ifndef TTK_ENABLE_KAMIKAZE
-      if(id < 0 || id > (SimplexId)offsets_.size() - 1) {
+      if(id < 0 || id > (SimplexId)this->offsetsSize_ - 1) {
         return -1;
       }
       if(local < 0 || local >= this->size(id)) {
         return -2;
       }
 #endif
-      return this->data_[this->offsets_[id] + local];
+      return this->dataPtr_[this->offsetsPtr_[id] + local];
     }
 
     /**
@@ -140,21 +233,28 @@ namespace ttk {
      */
     inline const SimplexId *get_ptr(SimplexId id, SimplexId local) const {
 #ifndef TTK_ENABLE_KAMIKAZE
-      if(id < 0 || id > (SimplexId)offsets_.size() - 1) {
+      if(id < 0 || id > (SimplexId)this->offsetsSize_ - 1) {
         return {};
       }
       if(local < 0 || local >= this->size(id)) {
         return {};
       }
 #endif
-      return &this->data_[this->offsets_[id] + local];
+      return &this->dataPtr_[this->offsetsPtr_[id] + local];
     }
 
     /**
      * @brief Returns a const pointer to the offset member
      */
     inline const SimplexId *offset_ptr() const {
-      return offsets_.data();
+      return this->offsetsPtr_;
+    }
+
+    /**
+     * @brief Returns a const pointer to the data member
+     */
+    inline const SimplexId *data_ptr() const {
+      return this->dataPtr_;
     }
 
     /**
@@ -164,25 +264,27 @@ namespace ttk {
       if(this->empty()) {
         return 0;
       }
-      return this->offsets_.size() - 1;
+      return this->offsetsSize_ - 1;
     }
 
     /**
-     * @brief Returns the size of the data_ member
+     * @brief Returns the size of the data buffer
      */
     inline size_t dataSize() const {
-      return this->data_.size();
+      return this->dataSize_;
     }
 
     /**
      * @brief If the underlying buffers are empty
      */
     inline bool empty() const {
-      return this->data_.empty() || this->offsets_.empty();
+      return this->dataSize_ == 0 || this->offsetsSize_ == 0;
     }
 
     /**
      * @brief Computes the memory footprint of the array
+     *
+     * External buffers are not accounted for.
      */
     inline size_t footprint() const {
       return (this->data_.size() + this->offsets_.size()) * sizeof(SimplexId);
@@ -212,6 +314,7 @@ namespace ttk {
           this->data_[this->offsets_[i] + j] = src[i][j];
         }
       }
+      this->updateViews();
       TTK_FORCE_USE(threadNumber);
     }
 
@@ -13,6 +13,7 @@
 
 #include <algorithm>
 #include <array>
+#include <cstring>
 #include <limits>
 #include <unordered_map>
 #include <unordered_set>
@@ -98,275 +99,163 @@ namespace ttk {
   };
 
   /**
-   * @brief Request all ghost cell scalar data from one rank from their owning
-   * ranks and get the data
+   * @brief Non-blocking exchange of ghost simplex data between neighbor ranks
    *
-   * @param[out] scalarArray the scalar array which we want to fill and which is
-   * filled on the other ranks
-   * @param[in] triangulation the triangulation for the data
-   * @param[in] rankToSend Destination process identifier
-   * @param[in] communicator the communicator over which the ranks are connected
-   * (most likely ttk::MPIcomm_)
-   * @return 0 in case of success
+   * The owned simplices listed in sendIds[r] (local ids) are sent to rank r,
+   * which writes them in place of the ghost simplices listed at the same
+   * positions in its recvIds[MPIrank_]. The values of all the arrays
+   * registered with addArray() are packed into a single message per neighbor
+   * rank.
+   *
+   * The MPI requests are persistent: the same exchange can be started and
+   * completed many times (e.g. once per iteration of an iterative method)
+   * and the interior of the domain can be processed between begin() and
+   * end(). Exchanges sharing a communicator must be started in the same order
+   * on all ranks.
    */
-  template <typename DT, typename triangulationType>
-  int getGhostCellScalars(DT *scalarArray,
-                          const triangulationType *triangulation,
-                          const int rankToSend,
-                          MPI_Comm communicator,
-                          const int dimensionNumber) {
-    const std::vector<int> &neighbors = triangulation->getNeighborRanks();
-    if(!ttk::isRunningWithMPI()) {
-      return -1;
+  class GhostExchange {
+  public:
+    /**
+     * @param[in] neighbors the neighbor ranks
+     * @param[in] sendIds local ids of the simplices to send, per rank
+     * @param[in] recvIds local ids of the simplices to receive, per rank
+     * @param[in] communicator the communicator over which the ranks are
+     * connected (most likely ttk::MPIcomm_)
+     *
+     * The three vectors are not copied and should outlive the exchange.
+     */
+    GhostExchange(const std::vector<int> &neighbors,
+                  const std::vector<std::vector<SimplexId>> &sendIds,
+                  const std::vector<std::vector<SimplexId>> &recvIds,
+                  MPI_Comm communicator)
+      : neighbors_{neighbors}, sendIds_{sendIds}, recvIds_{recvIds},
+        communicator_{communicator} {
     }
-    MPI_Datatype MPI_DT = getMPIType(static_cast<DT>(0));
-    // we need unique tags for each rankToSend, otherwise messages might become
-    // entangled
-    int tagMultiplier = rankToSend + 1;
-    int valuesTag = 103 * tagMultiplier;
-    if(rankToSend == ttk::MPIrank_) {
-      int neighborNumber = neighbors.size();
-      const auto &ghostCellsPerOwner = triangulation->getGhostCellsPerOwner();
-      // receive the scalar values
-      for(int r = 0; r < neighborNumber; r++) {
-        ttk::SimplexId nValues = ghostCellsPerOwner[neighbors[r]].size();
-        std::vector<DT> receivedValues(nValues * dimensionNumber);
-        if(nValues > 0) {
-          MPI_Recv(receivedValues.data(), nValues * dimensionNumber, MPI_DT,
-                   neighbors.at(r), valuesTag, communicator, MPI_STATUS_IGNORE);
-
-          for(ttk::SimplexId i = 0; i < nValues; i++) {
-            for(int j = 0; j < dimensionNumber; j++) {
-              DT receivedVal = receivedValues[i * dimensionNumber + j];
-              ttk::SimplexId globalId = ghostCellsPerOwner[neighbors[r]][i];
-              ttk::SimplexId localId = triangulation->getCellLocalId(globalId);
-              scalarArray[localId * dimensionNumber + j] = receivedVal;
-            }
-          }
-        }
-      }
-    } else { // owner ranks
-      // if rankToSend is not the neighbor of the current rank, we do not need
-      // to do anything
-      if(std::find(neighbors.begin(), neighbors.end(), rankToSend)
-         != neighbors.end()) {
-        // get the needed globalids from the triangulation
-        const auto &ghostCellsForThisRank
-          = triangulation->getRemoteGhostCells()[rankToSend];
-        ttk::SimplexId nValues = ghostCellsForThisRank.size();
-        if(nValues > 0) {
-          // assemble the scalar values
-          std::vector<DT> valuesToSend(nValues * dimensionNumber);
-          for(ttk::SimplexId i = 0; i < nValues; i++) {
-            for(int j = 0; j < dimensionNumber; j++) {
-              ttk::SimplexId globalId = ghostCellsForThisRank[i];
-              ttk::SimplexId localId = triangulation->getCellLocalId(globalId);
-              valuesToSend[i * dimensionNumber + j]
-                = scalarArray[localId * dimensionNumber + j];
-            }
-          }
 
-          // send the scalar values
-          MPI_Send(valuesToSend.data(), nValues * dimensionNumber, MPI_DT,
-                   rankToSend, valuesTag, communicator);
-        }
-      }
-    }
+    GhostExchange(const GhostExchange &) = delete;
+    GhostExchange &operator=(const GhostExchange &) = delete;
 
-    return 0;
-  }
+    ~GhostExchange() {
+      this->freeRequests();
+    }
 
-  template <typename DT, typename triangulationType>
-  int getGhostVertexScalars(DT *scalarArray,
-                            const triangulationType *triangulation,
-                            const int rankToSend,
-                            MPI_Comm communicator,
-                            const int dimensionNumber) {
-    const std::vector<int> &neighbors = triangulation->getNeighborRanks();
-    if(!ttk::isRunningWithMPI()) {
-      return -1;
+    /**
+     * @brief Register an array whose ghost values are exchanged
+     *
+     * @param[in,out] array the scalar array, with dimensionNumber components
+     * per simplex
+     * @param[in] dimensionNumber the number of components
+     */
+    template <typename DT>
+    void addArray(DT *array, const int dimensionNumber = 1) {
+      this->freeRequests();
+      this->arrays_.emplace_back(
+        reinterpret_cast<char *>(array), sizeof(DT) * dimensionNumber);
+      this->valueSize_ += sizeof(DT) * dimensionNumber;
     }
-    MPI_Datatype MPI_DT = getMPIType(static_cast<DT>(0));
-    // we need unique tags for each rankToSend, otherwise messages might become
-    // entangled
-    int tagMultiplier = rankToSend + 1;
-    int valuesTag = 103 * tagMultiplier;
-    if(rankToSend == ttk::MPIrank_) {
-      int neighborNumber = neighbors.size();
-      const auto &ghostVerticesPerOwner
-        = triangulation->getGhostVerticesPerOwner();
-      // receive the scalar values
-      for(int r = 0; r < neighborNumber; r++) {
-        ttk::SimplexId nValues = ghostVerticesPerOwner[neighbors[r]].size();
-        std::vector<DT> receivedValues(nValues * dimensionNumber);
-        if(nValues > 0) {
-          MPI_Recv(receivedValues.data(), nValues * dimensionNumber, MPI_DT,
-                   neighbors.at(r), valuesTag, communicator, MPI_STATUS_IGNORE);
-          for(ttk::SimplexId i = 0; i < nValues; i++) {
-            for(int j = 0; j < dimensionNumber; j++) {
-              DT receivedVal = receivedValues[i * dimensionNumber + j];
-              ttk::SimplexId globalId = ghostVerticesPerOwner[neighbors[r]][i];
-              ttk::SimplexId localId
-                = triangulation->getVertexLocalId(globalId);
-              scalarArray[localId * dimensionNumber + j] = receivedVal;
-            }
+
+    /**
+     * @brief Pack the values of the owned simplices and start the
+     * communications
+     */
+    int begin() {
+      if(this->requests_.empty()) {
+        this->initRequests();
+      }
+      for(size_t i = 0; i < this->neighbors_.size(); ++i) {
+        const auto &ids = this->getIds(this->sendIds_, this->neighbors_[i]);
+        char *buffer = this->sendBuffers_[i].data();
+        for(const auto id : ids) {
+          for(const auto &array : this->arrays_) {
+            std::memcpy(buffer, array.first + id * array.second, array.second);
+            buffer += array.second;
           }
         }
       }
-    } else { // owner ranks
-      // if rankToSend is not the neighbor of the current rank, we do not need
-      // to do anything
-      if(std::find(neighbors.begin(), neighbors.end(), rankToSend)
-         != neighbors.end()) {
-        // get the needed globalids from the triangulation
-        const auto &ghostVerticesForThisRank
-          = triangulation->getRemoteGhostVertices()[rankToSend];
-        ttk::SimplexId nValues = ghostVerticesForThisRank.size();
-        if(nValues > 0) {
-          // assemble the scalar values
-          std::vector<DT> valuesToSend(nValues * dimensionNumber);
-          for(ttk::SimplexId i = 0; i < nValues; i++) {
-            for(int j = 0; j < dimensionNumber; j++) {
-              ttk::SimplexId globalId = ghostVerticesForThisRank[i];
-              ttk::SimplexId localId
-                = triangulation->getVertexLocalId(globalId);
-              valuesToSend[i * dimensionNumber + j]
-                = scalarArray[localId * dimensionNumber + j];
-            }
-          }
+      if(!this->requests_.empty()) {
+        MPI_Startall(this->requests_.size(), this->requests_.data());
+      }
+      return 0;
+    }
 
-          // send the scalar values
-          MPI_Send(valuesToSend.data(), nValues * dimensionNumber, MPI_DT,
-                   rankToSend, valuesTag, communicator);
+    /**
+     * @brief Wait for the communications and write the values of the ghost
+     * simplices
+     */
+    int end() {
+      if(!this->requests_.empty()) {
+        MPI_Waitall(
+          this->requests_.size(), this->requests_.data(), MPI_STATUSES_IGNORE);
+      }
+      for(size_t i = 0; i < this->neighbors_.size(); ++i) {
+        const auto &ids = this->getIds(this->recvIds_, this->neighbors_[i]);
+        const char *buffer = this->recvBuffers_[i].data();
+        for(const auto id : ids) {
+          for(const auto &array : this->arrays_) {
+            std::memcpy(array.first + id * array.second, buffer, array.second);
+            buffer += array.second;
+          }
         }
       }
+      return 0;
     }
 
-    return 0;
-  }
-
-  /**
-   * @brief Request all ghost cell scalar data from one rank from their owning
-   * ranks and get the data
-   * this method is for usage without a triangulation, if a triangulation is
-   * available, use getGhostCellScalars(), it is more performant when used
-   * multiple times
-   *
-   * @param[out] scalarArray the scalar array which we want to fill and which is
-   * filled on the other ranks
-   * @param[in] getVertexRank lambda to get rank from vertex
-   * @param[in] globalIds the global id array for the scalar data
-   * @param[in] gidToLidMap a map which translates global ids to local,
-   * rank-based ids
-   * @param[in] neighbors a set of rank neighbors of rankToSend, to prevent
-   * unnecessary communication
-   * @param[in] rankToSend Destination process identifier
-   * @param[in] nVerts number of vertices in the arrays
-   * @param[in] communicator the communicator over which the ranks are connected
-   * (most likely ttk::MPIcomm_)
-   * @return 0 in case of success
-   */
-  template <typename DT,
-            typename IT,
-            typename GVGID,
-            typename GVR,
-            typename GVLID>
-  int getGhostDataScalarsWithoutTriangulation(DT *scalarArray,
-                                              const GVR &getVertexRank,
-                                              const GVGID &getVertexGlobalId,
-                                              const GVLID &getVertexLocalId,
-                                              const std::vector<int> &neighbors,
-                                              const int rankToSend,
-                                              const IT nVerts,
-                                              MPI_Comm communicator,
-                                              const int dimensionNumber) {
-    int neighborNumber = neighbors.size();
-    if(!ttk::isRunningWithMPI()) {
-      return -1;
+  private:
+    const std::vector<SimplexId> &
+      getIds(const std::vector<std::vector<SimplexId>> &ids,
+             const int rank) const {
+      static const std::vector<SimplexId> noIds{};
+      return static_cast<size_t>(rank) < ids.size() ? ids[rank] : noIds;
     }
-    MPI_Datatype MPI_DT = getMPIType(static_cast<DT>(0));
-    MPI_Datatype MPI_IT = getMPIType(static_cast<IT>(0));
-    using globalIdType = decltype(getVertexGlobalId(0));
-    MPI_Datatype MPI_GIT = getMPIType(static_cast<globalIdType>(0));
-    // we need unique tags for each rankToSend, otherwise messages might become
-    // entangled
-    int tagMultiplier = rankToSend + 1;
-    int amountTag = 101 * tagMultiplier;
-    int idsTag = 102 * tagMultiplier;
-    int valuesTag = 103 * tagMultiplier;
-    if(rankToSend == ttk::MPIrank_) {
-      // initialize the inner vectors with size 0
-      std::vector<std::vector<globalIdType>> rankVectors(
-        ttk::MPIsize_, std::vector<globalIdType>(0));
-      // aggregate the needed ids
-
-      for(IT i = 0; i < nVerts; i++) {
-        if(ttk::MPIrank_ != getVertexRank(i)) {
-          rankVectors[getVertexRank(i)].push_back(getVertexGlobalId(i));
-        }
-      }
-      // send the amount of ids and the needed ids themselves
-      for(int r = 0; r < neighborNumber; r++) {
-        IT nValues = rankVectors[neighbors[r]].size();
-        MPI_Send(&nValues, 1, MPI_IT, neighbors[r], amountTag, communicator);
-        if(nValues > 0) {
-          MPI_Send(rankVectors[neighbors[r]].data(), nValues, MPI_GIT,
-                   neighbors[r], idsTag, communicator);
+
+    void initRequests() {
+      const int nNeighbors = this->neighbors_.size();
+      this->sendBuffers_.resize(nNeighbors);
+      this->recvBuffers_.resize(nNeighbors);
+      for(int i = 0; i < nNeighbors; ++i) {
+        const int rank = this->neighbors_[i];
+        this->sendBuffers_[i].resize(this->getIds(this->sendIds_, rank).size()
+                                     * this->valueSize_);
+        this->recvBuffers_[i].resize(this->getIds(this->recvIds_, rank).size()
+                                     * this->valueSize_);
+        if(!this->recvBuffers_[i].empty()) {
+          this->requests_.emplace_back();
+          MPI_Recv_init(this->recvBuffers_[i].data(),
+                        this->recvBuffers_[i].size(), MPI_CHAR, rank,
+                        this->valuesTag_, this->communicator_,
+                        &this->requests_.back());
         }
-      }
-      // receive the scalar values
-      for(int r = 0; r < neighborNumber; r++) {
-        IT nValues = rankVectors[neighbors[r]].size();
-        std::vector<DT> receivedValues(nValues * dimensionNumber);
-        if(nValues > 0) {
-          MPI_Recv(receivedValues.data(), nValues * dimensionNumber, MPI_DT,
-                   neighbors[r], valuesTag, communicator, MPI_STATUS_IGNORE);
-          for(IT i = 0; i < nValues; i++) {
-            for(int j = 0; j < dimensionNumber; j++) {
-              DT receivedVal = receivedValues[i * dimensionNumber + j];
-              const auto globalId = rankVectors[neighbors[r]][i];
-              IT localId = getVertexLocalId(globalId);
-              scalarArray[localId * dimensionNumber + j] = receivedVal;
-            }
-          }
+        if(!this->sendBuffers_[i].empty()) {
+          this->requests_.emplace_back();
+          MPI_Send_init(this->sendBuffers_[i].data(),
+                        this->sendBuffers_[i].size(), MPI_CHAR, rank,
+                        this->valuesTag_, this->communicator_,
+                        &this->requests_.back());
         }
       }
-    } else { // owner ranks
-      // if rankToSend is not the neighbor of the current rank, we do not need
-      // to do anything
-      if(std::find(neighbors.begin(), neighbors.end(), rankToSend)
-         != neighbors.end()) {
-        // receive the amount of ids and the needed ids themselves
-        IT nValues;
-
-        MPI_Recv(&nValues, 1, MPI_IT, rankToSend, amountTag, communicator,
-                 MPI_STATUS_IGNORE);
-
-        if(nValues > 0) {
-          std::vector<globalIdType> receivedIds(nValues);
-          MPI_Recv(receivedIds.data(), nValues, MPI_GIT, rankToSend, idsTag,
-                   communicator, MPI_STATUS_IGNORE);
-
-          // assemble the scalar values
-          std::vector<DT> valuesToSend(nValues * dimensionNumber);
-          for(IT i = 0; i < nValues; i++) {
-            for(int j = 0; j < dimensionNumber; j++) {
-              IT globalId = receivedIds[i];
-              IT localId = getVertexLocalId(globalId);
-              valuesToSend[i * dimensionNumber + j]
-                = scalarArray[localId * dimensionNumber + j];
-            }
-          }
+    }
 
-          // send the scalar values
-          MPI_Send(valuesToSend.data(), nValues * dimensionNumber, MPI_DT,
-                   rankToSend, valuesTag, communicator);
-        }
+    void freeRequests() {
+      for(auto &request : this->requests_) {
+        MPI_Request_free(&request);
       }
+      this->requests_.clear();
     }
 
-    return 0;
-  }
+    const int valuesTag_{103};
+    const std::vector<int> &neighbors_;
+    const std::vector<std::vector<SimplexId>> &sendIds_;
+    const std::vector<std::vector<SimplexId>> &recvIds_;
+    MPI_Comm communicator_;
+    // array pointers and size in bytes of their values
+    std::vector<std::pair<char *, size_t>> arrays_{};
+    // size in bytes of the values of all arrays for one simplex
+    size_t valueSize_{};
+    // one send and one receive buffer per neighbor
+    std::vector<std::vector<char>> sendBuffers_{};
+    std::vector<std::vector<char>> recvBuffers_{};
+    std::vector<MPI_Request> requests_{};
+  };
 
   /**
    * @brief get the neighbors of a rank
@@ -473,11 +362,11 @@ namespace ttk {
   }
 
   /**
-   * @brief exchange all ghost cell information by calling getGhostCellScalars
-   * for every rank
+   * @brief exchange the scalar values of all ghost cells with a
+   * GhostExchange
    *
-   * @param[out] scalarArray the scalar array which we want to fill and which is
-   * filled on the other ranks
+   * @param[in,out] scalarArray the scalar array which we want to fill and
+   * which is filled on the other ranks
    * @param[in] triangulation the triangulation for the data
    * @param[in] communicator the communicator over which the ranks are connected
    * (most likely ttk::MPIcomm_)
@@ -494,12 +383,13 @@ namespace ttk {
     if(!triangulation->hasPreconditionedDistributedCells()) {
       return -1;
     }
-    for(int r = 0; r < ttk::MPIsize_; r++) {
-      getGhostCellScalars<DT, triangulationType>(
-        scalarArray, triangulation, r, communicator, dimensionNumber);
-      MPI_Barrier(communicator);
-    }
-    return 0;
+    GhostExchange exchange{triangulation->getNeighborRanks(),
+                           triangulation->getRemoteGhostCellLocalIds(),
+                           triangulation->getGhostCellLocalIdsPerOwner(),
+                           communicator};
+    exchange.addArray(scalarArray, dimensionNumber);
+    exchange.begin();
+    return exchange.end();
   }
 
   template <typename DT, typename triangulationType>
@@ -513,35 +403,32 @@ namespace ttk {
     if(!triangulation->hasPreconditionedDistributedVertices()) {
       return -1;
     }
-    for(int r = 0; r < ttk::MPIsize_; r++) {
-      getGhostVertexScalars<DT, triangulationType>(
-        scalarArray, triangulation, r, communicator, dimensionNumber);
-      MPI_Barrier(communicator);
-    }
-    return 0;
+    GhostExchange exchange{triangulation->getNeighborRanks(),
+                           triangulation->getRemoteGhostVertexLocalIds(),
+                           triangulation->getGhostVertexLocalIdsPerOwner(),
+                           communicator};
+    exchange.addArray(scalarArray, dimensionNumber);
+    exchange.begin();
+    return exchange.end();
   }
 
   /**
-     * @brief exchange all ghost cell information by calling getGhostCellScalars
-     * for every rank
-     * this method is for usage without a triangulation, if a triangulation is
-     available,
-     * use exchangeGhostCells(), it is more performant when used multiple
-     times
-
-     * @param[out] scalarArray the scalar array which we want to fill and which
-     is
-     * filled on the other ranks
-     * @param[in] getVertexRank lambda to get rank from vertex
-     * @param[in] globalIds the global id array for the scalar data
-     * @param[in] gidToLidMap a map which translates global ids to local,
-     * rank-based ids
-     * @param[in] nVerts number of vertices in the arrays
-     * @param[in] communicator the communicator over which the ranks are
-     connected
-     * (most likely ttk::MPIcomm_)
-     * @return 0 in case of success
-     */
+   * @brief exchange the scalar values of all ghost vertices
+   * this method is for usage without a triangulation, if a triangulation is
+   * available, use exchangeGhostVertices(), it is more performant when used
+   * multiple times (the ids to exchange are computed and sent at each call)
+   *
+   * @param[in,out] scalarArray the scalar array which we want to fill and
+   * which is filled on the other ranks
+   * @param[in] getVertexRank lambda to get rank from vertex
+   * @param[in] getVertexGlobalId lambda to get global id from vertex
+   * @param[in] getVertexLocalId lambda to get local id from global id
+   * @param[in] nVerts number of vertices in the arrays
+   * @param[in] communicator the communicator over which the ranks are connected
+   * (most likely ttk::MPIcomm_)
+   * @param[in] neighbors the neighbor ranks
+   * @return 0 in case of success
+   */
   template <typename DT,
             typename IT,
             typename GVGID,
@@ -558,13 +445,71 @@ namespace ttk {
     if(!ttk::isRunningWithMPI()) {
       return -1;
     }
-    for(int r = 0; r < ttk::MPIsize_; r++) {
-      getGhostDataScalarsWithoutTriangulation(
-        scalarArray, getVertexRank, getVertexGlobalId, getVertexLocalId,
-        neighbors, r, nVerts, communicator, dimensionNumber);
-      MPI_Barrier(communicator);
+    const int neighborNumber = neighbors.size();
+    MPI_Datatype MPI_IT = getMPIType(static_cast<IT>(0));
+    using globalIdType = decltype(getVertexGlobalId(0));
+    MPI_Datatype MPI_GIT = getMPIType(static_cast<globalIdType>(0));
+    const int amountTag = 101;
+    const int idsTag = 102;
+
+    // local ids of ghost vertices, and their global ids, per owner rank
+    std::vector<std::vector<SimplexId>> recvIds(ttk::MPIsize_);
+    std::vector<std::vector<globalIdType>> neededGids(ttk::MPIsize_);
+    for(IT i = 0; i < nVerts; i++) {
+      const int rank = getVertexRank(i);
+      if(rank != ttk::MPIrank_) {
+        recvIds[rank].emplace_back(i);
+        neededGids[rank].emplace_back(getVertexGlobalId(i));
+      }
     }
-    return 0;
+
+    // send the amount of ids and the needed ids themselves to all neighbors
+    // at once
+    std::vector<IT> sendAmounts(neighborNumber), recvAmounts(neighborNumber);
+    std::vector<MPI_Request> requests{};
+    requests.reserve(2 * neighborNumber);
+    for(int r = 0; r < neighborNumber; r++) {
+      sendAmounts[r] = neededGids[neighbors[r]].size();
+      requests.emplace_back();
+      MPI_Irecv(&recvAmounts[r], 1, MPI_IT, neighbors[r], amountTag,
+                communicator, &requests.back());
+      requests.emplace_back();
+      MPI_Isend(&sendAmounts[r], 1, MPI_IT, neighbors[r], amountTag,
+                communicator, &requests.back());
+    }
+    MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+    requests.clear();
+
+    std::vector<std::vector<globalIdType>> requestedGids(neighborNumber);
+    for(int r = 0; r < neighborNumber; r++) {
+      requestedGids[r].resize(recvAmounts[r]);
+      if(recvAmounts[r] > 0) {
+        requests.emplace_back();
+        MPI_Irecv(requestedGids[r].data(), recvAmounts[r], MPI_GIT,
+                  neighbors[r], idsTag, communicator, &requests.back());
+      }
+      if(sendAmounts[r] > 0) {
+        requests.emplace_back();
+        MPI_Isend(neededGids[neighbors[r]].data(), sendAmounts[r], MPI_GIT,
+                  neighbors[r], idsTag, communicator, &requests.back());
+      }
+    }
+    MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+
+    // local ids of the vertices requested by each neighbor
+    std::vector<std::vector<SimplexId>> sendIds(ttk::MPIsize_);
+    for(int r = 0; r < neighborNumber; r++) {
+      auto &ids = sendIds[neighbors[r]];
+      ids.reserve(requestedGids[r].size());
+      for(const auto globalId : requestedGids[r]) {
+        ids.emplace_back(getVertexLocalId(globalId));
+      }
+    }
+
+    GhostExchange exchange{neighbors, sendIds, recvIds, communicator};
+    exchange.addArray(scalarArray, dimensionNumber);
+    exchange.begin();
+    return exchange.end();
   }
 
   // returns true if bounding boxes intersect, false if not
@@ -0,0 +1,119 @@
+#include <MappedFile.h>
+
+#include <utility>
+
+#ifdef _WIN32
+
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+
+#include <windows.h>
+
+#else
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#endif // _WIN32
+
+namespace ttk {
+
+  MappedFile::~MappedFile() {
+    this->close();
+  }
+
+  MappedFile::MappedFile(MappedFile &&other) noexcept {
+    *this = std::move(other);
+  }
+
+  MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+    if(this != &other) {
+      this->close();
+      std::swap(this->data_, other.data_);
+      std::swap(this->size_, other.size_);
+#ifdef _WIN32
+      std::swap(this->fileHandle_, other.fileHandle_);
+      std::swap(this->mappingHandle_, other.mappingHandle_);
+#endif // _WIN32
+    }
+    return *this;
+  }
+
+  int MappedFile::open(const std::string &fileName) {
+    this->close();
+
+#ifdef _WIN32
+    HANDLE file
+      = CreateFileA(fileName.data(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                    OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if(file == INVALID_HANDLE_VALUE) {
+      return -1;
+    }
+    LARGE_INTEGER fileSize{};
+    if(!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+      CloseHandle(file);
+      return -2;
+    }
+    HANDLE mapping
+      = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if(mapping == nullptr) {
+      CloseHandle(file);
+      return -2;
+    }
+    const void *data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if(data == nullptr) {
+      CloseHandle(mapping);
+      CloseHandle(file);
+      return -2;
+    }
+    this->fileHandle_ = file;
+    this->mappingHandle_ = mapping;
+    this->size_ = static_cast<std::size_t>(fileSize.QuadPart);
+#else
+    const int fd = ::open(fileName.data(), O_RDONLY);
+    if(fd < 0) {
+      return -1;
+    }
+    struct stat fileStat {};
+    if(fstat(fd, &fileStat) != 0 || fileStat.st_size == 0) {
+      ::close(fd);
+      return -2;
+    }
+    const auto size = static_cast<std::size_t>(fileStat.st_size);
+    void *data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    // the mapping stays valid once the file descriptor is closed
+    ::close(fd);
+    if(data == MAP_FAILED) {
+      return -2;
+    }
+    this->size_ = size;
+#endif // _WIN32
+
+    this->data_ = static_cast<const char *>(data);
+    return 0;
+  }
+
+  void MappedFile::close() {
+    if(this->data_ == nullptr) {
+      return;
+    }
+#ifdef _WIN32
+    UnmapViewOfFile(this->data_);
+    CloseHandle(this->mappingHandle_);
+    CloseHandle(this->fileHandle_);
+    this->fileHandle_ = nullptr;
+    this->mappingHandle_ = nullptr;
+#else
+    munmap(const_cast<char *>(this->data_), this->size_);
+#endif // _WIN32
+    this->data_ = nullptr;
+    this->size_ = 0;
+  }
+
+} // namespace ttk
@@ -0,0 +1,63 @@
+/// \ingroup base
+/// \class ttk::MappedFile
+/// \date October 2026.
+///
+/// \brief Read-only memory mapping of a whole file.
+///
+/// The file content is mapped in the process address space without
+/// any copy: pages are loaded lazily by the operating system and are
+/// shared between processes mapping the same file.
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace ttk {
+
+  class MappedFile {
+
+  public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+    MappedFile(MappedFile &&other) noexcept;
+    MappedFile &operator=(MappedFile &&other) noexcept;
+
+    /**
+     * @brief Map the given file
+     *
+     * @return 0 in case of success, -1 if the file cannot be opened,
+     * -2 if the mapping failed
+     */
+    int open(const std::string &fileName);
+
+    /**
+     * @brief Unmap the file (called by the destructor)
+     */
+    void close();
+
+    inline bool isOpen() const {
+      return this->data_ != nullptr;
+    }
+
+    inline const char *data() const {
+      return this->data_;
+    }
+
+    inline std::size_t size() const {
+      return this->size_;
+    }
+
+  protected:
+    const char *data_{};
+    std::size_t size_{};
+#ifdef _WIN32
+    void *fileHandle_{};
+    void *mappingHandle_{};
+#endif // _WIN32
+  };
+
+} // namespace ttk
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cstddef>
+#include <vector>
+
 #ifdef TTK_ENABLE_OPENMP
 #include <omp.h>
 #endif // TTK_ENABLE_OPENMP
@@ -47,6 +50,50 @@ namespace ttk {
 #endif // _GLIBCXX_PARALLEL_FEATURES_H && TTK_ENABLE_OPENMP
 
 namespace ttk {
+  /**
+   * @brief In-place parallel inclusive prefix sum
+   *
+   * Used to turn counts into offsets (offsets[i + 1] holding the
+   * number of elements of the i-th bucket, offsets[0] being 0). Each
+   * thread scans a contiguous chunk, then shifts it by the sum of the
+   * previous chunks: integer results are identical to the sequential
+   * scan.
+   */
+  template <typename T>
+  inline void
+    parallelInclusiveScan(T *const data, const size_t n, const int nThreads) {
+    const size_t nChunks = nThreads;
+    if(nChunks < 2 || n < nChunks * 1024) {
+      for(size_t i = 1; i < n; ++i) {
+        data[i] += data[i - 1];
+      }
+      return;
+    }
+    std::vector<T> chunkSums(nChunks + 1);
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(nThreads) schedule(static, 1)
+#endif // TTK_ENABLE_OPENMP
+    for(size_t c = 0; c < nChunks; ++c) {
+      const size_t end = n * (c + 1) / nChunks;
+      for(size_t i = n * c / nChunks + 1; i < end; ++i) {
+        data[i] += data[i - 1];
+      }
+      chunkSums[c + 1] = data[end - 1];
+    }
+    for(size_t c = 1; c < nChunks; ++c) {
+      chunkSums[c] += chunkSums[c - 1];
+    }
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(nThreads) schedule(static, 1)
+#endif // TTK_ENABLE_OPENMP
+    for(size_t c = 1; c < nChunks; ++c) {
+      const size_t end = n * (c + 1) / nChunks;
+      for(size_t i = n * c / nChunks; i < end; ++i) {
+        data[i] += chunkSums[c];
+      }
+    }
+  }
+
   /**
    * @brief RAII wrapper around OpenMP lock
    */
@@ -1,15 +1,102 @@
 #pragma once
 
 #include <BaseClass.h>
+#include <RadixSort.h>
 
 #include <algorithm>
 #include <vector>
 
 namespace ttk {
 
+  namespace radix {
+
+    /**
+     * @brief Sort vertex ids with a radix sort on (scalar, offset) keys
+     */
+    template <typename scalarType, typename idType>
+    void sortVertices(const size_t nVerts,
+                      const scalarType *const scalars,
+                      const idType *const offsets,
+                      std::vector<SimplexId> &sortedVertices,
+                      const int nThreads,
+                      std::true_type) {
+
+      // the radix sort being stable, sort by offsets (or keep the
+      // vertex ids order) then by scalars
+      if(offsets != nullptr) {
+        std::vector<KeyType<idType>> offsetKeys(nVerts);
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(nThreads)
+#endif // TTK_ENABLE_OPENMP
+        for(size_t i = 0; i < nVerts; ++i) {
+          sortedVertices[i] = i;
+          offsetKeys[i] = toRadixKey(offsets[i]);
+        }
+        radixSortByKey(offsetKeys, sortedVertices, nThreads);
+      } else {
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(nThreads)
+#endif // TTK_ENABLE_OPENMP
+        for(size_t i = 0; i < nVerts; ++i) {
+          sortedVertices[i] = i;
+        }
+      }
+
+      std::vector<KeyType<scalarType>> keys(nVerts);
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(nThreads)
+#endif // TTK_ENABLE_OPENMP
+      for(size_t i = 0; i < nVerts; ++i) {
+        keys[i] = toRadixKey(scalars[sortedVertices[i]]);
+      }
+      radixSortByKey(keys, sortedVertices, nThreads);
+    }
+
+    /**
+     * @brief Comparison sort fallback for non-arithmetic types
+     */
+    template <typename scalarType, typename idType>
+    void sortVertices(const size_t nVerts,
+                      const scalarType *const scalars,
+                      const idType *const offsets,
+                      std::vector<SimplexId> &sortedVertices,
+                      const int nThreads,
+                      std::false_type) {
+
+      TTK_FORCE_USE(nThreads);
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(nThreads)
+#endif // TTK_ENABLE_OPENMP
+      for(size_t i = 0; i < nVerts; ++i) {
+        sortedVertices[i] = i;
+      }
+
+      if(offsets != nullptr) {
+        TTK_PSORT(
+          nThreads, sortedVertices.begin(), sortedVertices.end(),
+          [&](const SimplexId a, const SimplexId b) {
+            return (scalars[a] < scalars[b])
+                   || (scalars[a] == scalars[b] && offsets[a] < offsets[b]);
+          });
+      } else {
+        TTK_PSORT(nThreads, sortedVertices.begin(), sortedVertices.end(),
+                  [&](const SimplexId a, const SimplexId b) {
+                    return (scalars[a] < scalars[b])
+                           || (scalars[a] == scalars[b] && a < b);
+                  });
+      }
+    }
+
+  } // namespace radix
+
   /**
    * @brief Sort vertices according to scalars disambiguated by offsets
    *
+   * Arithmetic scalars and offsets are sorted with a parallel radix sort
+   * (see ttk::radixSortByKey()), other types with TTK_PSORT. Both give
+   * the same order.
+   *
    * @param[in] nVerts number of vertices
    * @param[in] scalars array of size nVerts, main vertex comparator
    * @param[in] offsets array of size nVerts, disambiguate scalars on plateaux
@@ -26,29 +113,10 @@ namespace ttk {
     // array of pre-sorted vertices
     std::vector<SimplexId> sortedVertices(nVerts);
 
-    TTK_FORCE_USE(nThreads);
-
-#ifdef TTK_ENABLE_OPENMP
-#pragma omp parallel for num_threads(nThreads)
-#endif // TTK_ENABLE_OPENMP
-    for(size_t i = 0; i < sortedVertices.size(); ++i) {
-      sortedVertices[i] = i;
-    }
-
-    if(offsets != nullptr) {
-      TTK_PSORT(
-        nThreads, sortedVertices.begin(), sortedVertices.end(),
-        [&](const SimplexId a, const SimplexId b) {
-          return (scalars[a] < scalars[b])
-                 || (scalars[a] == scalars[b] && offsets[a] < offsets[b]);
-        });
-    } else {
-      TTK_PSORT(nThreads, sortedVertices.begin(), sortedVertices.end(),
-                [&](const SimplexId a, const SimplexId b) {
-                  return (scalars[a] < scalars[b])
-                         || (scalars[a] == scalars[b] && a < b);
-                });
-    }
+    radix::sortVertices(
+      nVerts, scalars, offsets, sortedVertices, nThreads,
+      std::integral_constant<bool, radix::IsSortable<scalarType>::value
+                                     && radix::IsSortable<idType>::value>{});
 
 #ifdef TTK_ENABLE_OPENMP
 #pragma omp parallel for num_threads(nThreads)
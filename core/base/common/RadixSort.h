@@ -0,0 +1,173 @@
+#pragma once
+
+#include <BaseClass.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace ttk {
+
+  namespace radix {
+
+    template <size_t N>
+    struct UnsignedOfSize {};
+    template <>
+    struct UnsignedOfSize<1> {
+      using type = std::uint8_t;
+    };
+    template <>
+    struct UnsignedOfSize<2> {
+      using type = std::uint16_t;
+    };
+    template <>
+    struct UnsignedOfSize<4> {
+      using type = std::uint32_t;
+    };
+    template <>
+    struct UnsignedOfSize<8> {
+      using type = std::uint64_t;
+    };
+
+    /**
+     * @brief Unsigned integer type of the radix keys of type T
+     */
+    template <typename T>
+    using KeyType = typename UnsignedOfSize<sizeof(T)>::type;
+
+    /**
+     * @brief Whether values of type T can be mapped to radix keys
+     */
+    template <typename T>
+    using IsSortable = std::integral_constant<
+      bool,
+      std::is_arithmetic<T>::value
+        && (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4
+            || sizeof(T) == 8)>;
+
+    /**
+     * @brief Map an arithmetic value to an unsigned integer such that
+     * a < b if and only if toRadixKey(a) < toRadixKey(b)
+     *
+     * IEEE floats: the sign bit is flipped for positive values, every bit
+     * for negative ones. -0. and +0. (equal for operator<) share the same
+     * key. Signed integers: the sign bit is flipped.
+     */
+    template <typename T>
+    inline KeyType<T> toRadixKey(T value) {
+      static_assert(std::is_arithmetic<T>::value, "Arithmetic type expected");
+      using K = KeyType<T>;
+      constexpr K signBit = static_cast<K>(K{1} << (8 * sizeof(T) - 1));
+      if(std::is_floating_point<T>::value && value == T{0}) {
+        value = T{0};
+      }
+      K bits{};
+      std::memcpy(&bits, &value, sizeof(T));
+      if(std::is_floating_point<T>::value) {
+        return (bits & signBit) ? static_cast<K>(~bits)
+                                : static_cast<K>(bits | signBit);
+      }
+      if(std::is_signed<T>::value) {
+        return static_cast<K>(bits ^ signBit);
+      }
+      return bits;
+    }
+
+  } // namespace radix
+
+  /**
+   * @brief Stable sort of @p values according to @p keys (in place)
+   *
+   * Parallel LSD radix sort, independent from the standard library
+   * parallel extensions (TTK_PSORT is only parallel with libstdc++). The
+   * keys are sorted one byte at a time from the least significant one,
+   * skipping the bytes shared by every key. Each pass counts the bytes of
+   * a contiguous chunk per thread, then scatters the chunks in order: the
+   * result does not depend on the number of threads.
+   *
+   * @param[in,out] keys Unsigned integer keys, sorted on output
+   * @param[in,out] values Values, permuted as the keys
+   * @param[in] nThreads Number of threads
+   */
+  template <typename keyType, typename valueType>
+  void radixSortByKey(std::vector<keyType> &keys,
+                      std::vector<valueType> &values,
+                      const int nThreads) {
+    static_assert(std::is_unsigned<keyType>::value, "Unsigned keys expected");
+
+    constexpr size_t nBuckets = 256;
+    const size_t n = keys.size();
+    if(n < 2) {
+      return;
+    }
+
+    // bytes shared by every key need no pass
+    keyType keysOr{0}, keysAnd{static_cast<keyType>(~keyType{0})};
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(nThreads) \
+  reduction(| : keysOr) reduction(& : keysAnd)
+#endif // TTK_ENABLE_OPENMP
+    for(size_t i = 0; i < n; ++i) {
+      keysOr |= keys[i];
+      keysAnd &= keys[i];
+    }
+    const keyType varyingBits = keysOr ^ keysAnd;
+
+    // contiguous chunks, large enough to amortize the bucket counts
+    const size_t nChunks
+      = std::max(size_t{1}, std::min(static_cast<size_t>(nThreads),
+                                     n / (16 * nBuckets)));
+    std::vector<size_t> counts(nChunks * nBuckets);
+    std::vector<keyType> keysTmp(n);
+    std::vector<valueType> valuesTmp(n);
+
+    for(size_t shift = 0; shift < 8 * sizeof(keyType); shift += 8) {
+      if(((varyingBits >> shift) & 0xff) == 0) {
+        continue;
+      }
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(nThreads) schedule(static, 1)
+#endif // TTK_ENABLE_OPENMP
+      for(size_t c = 0; c < nChunks; ++c) {
+        size_t *const count = &counts[c * nBuckets];
+        std::fill(count, count + nBuckets, 0);
+        const size_t end = n * (c + 1) / nChunks;
+        for(size_t i = n * c / nChunks; i < end; ++i) {
+          count[(keys[i] >> shift) & 0xff]++;
+        }
+      }
+
+      // offsets: buckets in order, chunks in order within a bucket
+      size_t offset{0};
+      for(size_t b = 0; b < nBuckets; ++b) {
+        for(size_t c = 0; c < nChunks; ++c) {
+          const auto count = counts[c * nBuckets + b];
+          counts[c * nBuckets + b] = offset;
+          offset += count;
+        }
+      }
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(nThreads) schedule(static, 1)
+#endif // TTK_ENABLE_OPENMP
+      for(size_t c = 0; c < nChunks; ++c) {
+        size_t *const dest = &counts[c * nBuckets];
+        const size_t end = n * (c + 1) / nChunks;
+        for(size_t i = n * c / nChunks; i < end; ++i) {
+          const auto pos = dest[(keys[i] >> shift) & 0xff]++;
+          keysTmp[pos] = keys[i];
+          valuesTmp[pos] = values[i];
+        }
+      }
+
+      keys.swap(keysTmp);
+      values.swap(valuesTmp);
+    }
+
+    TTK_FORCE_USE(nThreads);
+  }
+
+} // namespace ttk
@@ -1,12 +1,12 @@
 #include <CompactTriangulation.h>
 
+#include <boost/unordered_set.hpp>
+
 using namespace ttk;
 
 CompactTriangulation::CompactTriangulation() {
   setDebugMsgPrefix("CompactTriangulation");
   clear();
-  caches_.resize(threadNumber_);
-  cacheMaps_.resize(threadNumber_);
 }
 
 CompactTriangulation::CompactTriangulation(const CompactTriangulation &rhs)
@@ -17,7 +17,10 @@ CompactTriangulation::CompactTriangulation(const CompactTriangulation &rhs)
     vertexIntervals_(rhs.vertexIntervals_), edgeIntervals_(rhs.edgeIntervals_),
     triangleIntervals_(rhs.triangleIntervals_),
     cellIntervals_(rhs.cellIntervals_), cellArray_(rhs.cellArray_),
-    externalCells_(rhs.externalCells_) {
+    externalCells_(rhs.externalCells_), cacheSize_(rhs.cacheSize_) {
+  // the cache is not shared with rhs
+  cache_.setCapacity(cacheSize_);
+  this->resetCache(0);
 }
 
 CompactTriangulation &
@@ -37,11 +40,16 @@ CompactTriangulation &
     cellArray_ = rhs.cellArray_;
     externalCells_ = rhs.externalCells_;
     // cache system is not copied
+    cacheSize_ = rhs.cacheSize_;
+    cache_.setCapacity(cacheSize_);
+    this->resetCache(0);
   }
   return *this;
 }
 
-CompactTriangulation::~CompactTriangulation() = default;
+CompactTriangulation::~CompactTriangulation() {
+  this->printCacheStatistics();
+}
 
 int CompactTriangulation::reorderVertices(std::vector<SimplexId> &vertexMap) {
   // get the number of nodes (the max value in the array)
@@ -219,20 +227,9 @@ int CompactTriangulation::buildInternalEdgeMap(
     return -1;
 #endif
 
-  SimplexId edgeCount = 0, verticesPerCell = cellArray_->getCellVertexNumber(0);
-
-  if(!nodePtr->internalEdgeMap_.empty()) {
-    // if the edge map has been computed and only request the edge list
-    if(computeInternalEdgeList) {
-      nodePtr->internalEdgeList_ = std::vector<std::array<SimplexId, 2>>(
-        nodePtr->internalEdgeMap_.size());
-      for(auto iter = nodePtr->internalEdgeMap_.begin();
-          iter != nodePtr->internalEdgeMap_.end(); iter++) {
-        nodePtr->internalEdgeList_[iter->second - 1] = iter->first;
-      }
-      return 0;
-    }
-  }
+  SimplexId verticesPerCell = cellArray_->getCellVertexNumber(0);
+  // internal edges, numbered by order of first occurrence
+  std::vector<std::array<SimplexId, 2>> edges;
 
   // loop through the internal cell list
   for(SimplexId cid = cellIntervals_[nodePtr->nid - 1] + 1;
@@ -248,13 +245,7 @@ int CompactTriangulation::buildInternalEdgeMap(
       }
       for(SimplexId k = j + 1; k < verticesPerCell; k++) {
         edgeIds[1] = cellArray_->getCellVertex(cid, k);
-
-        // not found in the edge map - assign new edge id
-        if(nodePtr->internalEdgeMap_.find(edgeIds)
-           == nodePtr->internalEdgeMap_.end()) {
-          edgeCount++;
-          nodePtr->internalEdgeMap_[edgeIds] = edgeCount;
-        }
+        edges.emplace_back(edgeIds);
       }
     }
   }
@@ -272,27 +263,24 @@ int CompactTriangulation::buildInternalEdgeMap(
         // the edge is in the current node
         if(edgeIds[0] > vertexIntervals_[nodePtr->nid - 1]
            && edgeIds[0] <= vertexIntervals_[nodePtr->nid]) {
-          if(nodePtr->internalEdgeMap_.find(edgeIds)
-             == nodePtr->internalEdgeMap_.end()) {
-            edgeCount++;
-            (nodePtr->internalEdgeMap_)[edgeIds] = edgeCount;
-          }
+          edges.emplace_back(edgeIds);
         }
       }
     }
   }
 
+  SimplexIdMap<2> edgeMap;
+  edgeMap.setFirstOccurrences(edges);
+
   if(computeInternalEdgeList) {
-    nodePtr->internalEdgeList_
-      = std::vector<std::array<SimplexId, 2>>(nodePtr->internalEdgeMap_.size());
-    for(auto iter = nodePtr->internalEdgeMap_.begin();
-        iter != nodePtr->internalEdgeMap_.end(); iter++) {
-      nodePtr->internalEdgeList_[iter->second - 1] = iter->first;
+    nodePtr->internalEdgeList_.resize(edgeMap.size());
+    for(const auto &e : edgeMap) {
+      nodePtr->internalEdgeList_[e.second - 1] = e.first;
     }
   }
 
-  if(!computeInternalEdgeMap) {
-    nodePtr->internalEdgeMap_.clear();
+  if(computeInternalEdgeMap) {
+    nodePtr->internalEdgeMap_ = std::move(edgeMap);
   }
 
   return 0;
@@ -332,28 +320,19 @@ int CompactTriangulation::buildExternalEdgeMap(
     }
   }
 
+  std::vector<SimplexIdMap<2>::value_type> externalEdges;
   boost::unordered_map<SimplexId,
                        std::vector<std::array<SimplexId, 2>>>::iterator iter;
   for(iter = edgeNodes.begin(); iter != edgeNodes.end(); iter++) {
-    ImplicitCluster *exnode = searchCache(iter->first, nodePtr->nid);
-    if(exnode) {
-      if(exnode->internalEdgeMap_.empty())
-        buildInternalEdgeMap(exnode, false, true);
-      for(std::array<SimplexId, 2> edgePair : iter->second) {
-        (nodePtr->externalEdgeMap_)[edgePair]
-          = exnode->internalEdgeMap_.at(edgePair)
-            + edgeIntervals_[iter->first - 1];
-      }
-    } else {
-      ImplicitCluster tmpCluster(iter->first);
-      buildInternalEdgeMap(&tmpCluster, false, true);
-      for(std::array<SimplexId, 2> edgePair : iter->second) {
-        (nodePtr->externalEdgeMap_)[edgePair]
-          = tmpCluster.internalEdgeMap_.at(edgePair)
-            + edgeIntervals_[iter->first - 1];
-      }
+    const auto exnode = searchCache(iter->first);
+    expandCluster(exnode.get(), RELATION::INTERNAL_EDGE_MAP);
+    for(std::array<SimplexId, 2> edgePair : iter->second) {
+      externalEdges.emplace_back(edgePair,
+                                 exnode->internalEdgeMap_.at(edgePair)
+                                   + edgeIntervals_[iter->first - 1]);
     }
   }
+  nodePtr->externalEdgeMap_.setEntries(std::move(externalEdges));
 
   return 0;
 }
@@ -368,20 +347,9 @@ int CompactTriangulation::buildInternalTriangleMap(
     return -1;
 #endif
 
-  SimplexId triangleCount = 0, verticesPerCell = 4;
-  std::vector<std::vector<SimplexId>> localTriangleStars;
-
-  if(!nodePtr->internalTriangleMap_.empty()) {
-    if(computeInternalTriangleList) {
-      nodePtr->internalTriangleList_ = std::vector<std::array<SimplexId, 3>>(
-        nodePtr->internalTriangleMap_.size());
-      for(auto iter = nodePtr->internalTriangleMap_.begin();
-          iter != nodePtr->internalTriangleMap_.end(); iter++) {
-        (nodePtr->internalTriangleList_)[iter->second - 1] = iter->first;
-      }
-      return 0;
-    }
-  }
+  SimplexId verticesPerCell = 4;
+  // internal triangles, numbered by order of first occurrence
+  std::vector<std::array<SimplexId, 3>> triangles;
 
   // loop through the internal cell list
   for(SimplexId cid = cellIntervals_[nodePtr->nid - 1] + 1;
@@ -399,12 +367,7 @@ int CompactTriangulation::buildInternalTriangleMap(
         for(SimplexId l = k + 1; l < verticesPerCell; l++) {
           triangleIds[1] = cellArray_->getCellVertex(cid, k);
           triangleIds[2] = cellArray_->getCellVertex(cid, l);
-
-          if(nodePtr->internalTriangleMap_.find(triangleIds)
-             == nodePtr->internalTriangleMap_.end()) {
-            triangleCount++;
-            (nodePtr->internalTriangleMap_)[triangleIds] = triangleCount;
-          }
+          triangles.emplace_back(triangleIds);
         }
       }
     }
@@ -423,29 +386,25 @@ int CompactTriangulation::buildInternalTriangleMap(
           for(SimplexId l = k + 1; l < verticesPerCell; l++) {
             triangleIds[1] = cellArray_->getCellVertex(cid, k);
             triangleIds[2] = cellArray_->getCellVertex(cid, l);
-
-            if(nodePtr->internalTriangleMap_.find(triangleIds)
-               == nodePtr->internalTriangleMap_.end()) {
-              triangleCount++;
-              (nodePtr->internalTriangleMap_)[triangleIds] = triangleCount;
-            }
+            triangles.emplace_back(triangleIds);
           }
         }
       }
     }
   }
 
+  SimplexIdMap<3> triangleMap;
+  triangleMap.setFirstOccurrences(triangles);
+
   if(computeInternalTriangleList) {
-    nodePtr->internalTriangleList_ = std::vector<std::array<SimplexId, 3>>(
-      nodePtr->internalTriangleMap_.size());
-    for(auto iter = nodePtr->internalTriangleMap_.begin();
-        iter != nodePtr->internalTriangleMap_.end(); iter++) {
-      (nodePtr->internalTriangleList_)[iter->second - 1] = iter->first;
+    nodePtr->internalTriangleList_.resize(triangleMap.size());
+    for(const auto &t : triangleMap) {
+      nodePtr->internalTriangleList_[t.second - 1] = t.first;
     }
   }
 
-  if(!computeInternalTriangleMap) {
-    nodePtr->internalTriangleMap_.clear();
+  if(computeInternalTriangleMap) {
+    nodePtr->internalTriangleMap_ = std::move(triangleMap);
   }
 
   return 0;
@@ -491,28 +450,19 @@ int CompactTriangulation::buildExternalTriangleMap(
     }
   }
 
+  std::vector<SimplexIdMap<3>::value_type> externalTriangles;
   boost::unordered_map<SimplexId,
                        std::vector<std::array<SimplexId, 3>>>::iterator iter;
   for(iter = nodeTriangles.begin(); iter != nodeTriangles.end(); iter++) {
-    ImplicitCluster *exnode = searchCache(iter->first, nodePtr->nid);
-    if(exnode) {
-      if(exnode->internalTriangleMap_.empty())
-        buildInternalTriangleMap(exnode, false, true);
-      for(std::array<SimplexId, 3> triangleVec : iter->second) {
-        (nodePtr->externalTriangleMap_)[triangleVec]
-          = exnode->internalTriangleMap_.at(triangleVec)
-            + triangleIntervals_[iter->first - 1];
-      }
-    } else {
-      ImplicitCluster tmpCluster(iter->first);
-      buildInternalTriangleMap(&tmpCluster, false, true);
-      for(std::array<SimplexId, 3> triangleVec : iter->second) {
-        (nodePtr->externalTriangleMap_)[triangleVec]
-          = tmpCluster.internalTriangleMap_.at(triangleVec)
-            + triangleIntervals_[iter->first - 1];
-      }
+    const auto exnode = searchCache(iter->first);
+    expandCluster(exnode.get(), RELATION::INTERNAL_TRIANGLE_MAP);
+    for(std::array<SimplexId, 3> triangleVec : iter->second) {
+      externalTriangles.emplace_back(
+        triangleVec, exnode->internalTriangleMap_.at(triangleVec)
+                       + triangleIntervals_[iter->first - 1]);
     }
   }
+  nodePtr->externalTriangleMap_.setEntries(std::move(externalTriangles));
 
   return 0;
 }
@@ -524,10 +474,8 @@ SimplexId CompactTriangulation::countInternalEdges(SimplexId nodeId) const {
     return -1;
 #endif
 
-  SimplexId edgeCount = 0, verticesPerCell = cellArray_->getCellVertexNumber(0);
-  boost::unordered_set<std::array<SimplexId, 2>,
-                       boost::hash<std::array<SimplexId, 2>>>
-    edgeSet;
+  SimplexId verticesPerCell = cellArray_->getCellVertexNumber(0);
+  std::vector<std::array<SimplexId, 2>> edges;
 
   // loop through the internal cell list
   for(SimplexId cid = cellIntervals_[nodeId - 1] + 1;
@@ -544,11 +492,7 @@ SimplexId CompactTriangulation::countInternalEdges(SimplexId nodeId) const {
       for(SimplexId k = j + 1; k < verticesPerCell; k++) {
         edgeIds[1] = cellArray_->getCellVertex(cid, k);
 
-        // not found in the edge map - assign new edge id
-        if(edgeSet.find(edgeIds) == edgeSet.end()) {
-          edgeCount++;
-          edgeSet.insert(edgeIds);
-        }
+        edges.emplace_back(edgeIds);
       }
     }
   }
@@ -566,16 +510,14 @@ SimplexId CompactTriangulation::countInternalEdges(SimplexId nodeId) const {
         // the edge is in the current node
         if(edgeIds[0] > vertexIntervals_[nodeId - 1]
            && edgeIds[0] <= vertexIntervals_[nodeId]) {
-          if(edgeSet.find(edgeIds) == edgeSet.end()) {
-            edgeCount++;
-            edgeSet.insert(edgeIds);
-          }
+          edges.emplace_back(edgeIds);
         }
       }
     }
   }
 
-  return edgeCount;
+  std::sort(edges.begin(), edges.end());
+  return std::unique(edges.begin(), edges.end()) - edges.begin();
 }
 
 int CompactTriangulation::countInternalTriangles(SimplexId nodeId) const {
@@ -585,9 +527,8 @@ int CompactTriangulation::countInternalTriangles(SimplexId nodeId) const {
     return -1;
 #endif
 
-  SimplexId triangleCount = 0,
-            verticesPerCell = cellArray_->getCellVertexNumber(0);
-  boost::unordered_set<std::array<SimplexId, 3>> triangleSet;
+  SimplexId verticesPerCell = cellArray_->getCellVertexNumber(0);
+  std::vector<std::array<SimplexId, 3>> triangles;
 
   // loop through the internal cell list
   for(SimplexId cid = cellIntervals_[nodeId - 1] + 1;
@@ -606,10 +547,7 @@ int CompactTriangulation::countInternalTriangles(SimplexId nodeId) const {
           triangleIds[1] = cellArray_->getCellVertex(cid, k);
           triangleIds[2] = cellArray_->getCellVertex(cid, l);
 
-          if(triangleSet.find(triangleIds) == triangleSet.end()) {
-            triangleCount++;
-            triangleSet.insert(triangleIds);
-          }
+          triangles.emplace_back(triangleIds);
         }
       }
     }
@@ -629,17 +567,15 @@ int CompactTriangulation::countInternalTriangles(SimplexId nodeId) const {
             triangleIds[1] = cellArray_->getCellVertex(cid, k);
             triangleIds[2] = cellArray_->getCellVertex(cid, l);
 
-            if(triangleSet.find(triangleIds) == triangleSet.end()) {
-              triangleCount++;
-              triangleSet.insert(triangleIds);
-            }
+            triangles.emplace_back(triangleIds);
           }
         }
       }
     }
   }
 
-  return triangleCount;
+  std::sort(triangles.begin(), triangles.end());
+  return std::unique(triangles.begin(), triangles.end()) - triangles.begin();
 }
 
 int CompactTriangulation::getClusterCellNeighbors(
@@ -655,9 +591,7 @@ int CompactTriangulation::getClusterCellNeighbors(
   SimplexId verticesPerCell = cellArray_->getCellVertexNumber(0);
   std::vector<std::vector<SimplexId>> localVertexStars;
 
-  if(nodePtr->vertexStars_.empty()) {
-    getClusterVertexStars(nodePtr);
-  }
+  expandCluster(nodePtr, RELATION::VERTEX_STARS);
   // sort the vertex star vector
   nodePtr->vertexStars_.copyTo(localVertexStars);
   for(size_t i = 0; i < localVertexStars.size(); i++) {
@@ -872,9 +806,7 @@ int CompactTriangulation::getClusterCellTriangles(
   nodePtr->tetraTriangles_ = std::vector<std::array<SimplexId, 4>>(
     cellIntervals_[nodePtr->nid] - cellIntervals_[nodePtr->nid - 1]);
 
-  if(nodePtr->internalTriangleMap_.empty()) {
-    buildInternalTriangleMap(nodePtr, false, true);
-  }
+  expandCluster(nodePtr, RELATION::INTERNAL_TRIANGLE_MAP);
 
   for(SimplexId i = cellIntervals_[nodePtr->nid - 1] + 1;
       i <= cellIntervals_[nodePtr->nid]; i++) {
@@ -909,31 +841,16 @@ int CompactTriangulation::getClusterCellTriangles(
   }
 
   for(auto iter = nodeTriangles.begin(); iter != nodeTriangles.end(); iter++) {
-    ImplicitCluster *exnode = searchCache(iter->first, nodePtr->nid);
-    if(exnode) {
-      if(exnode->internalTriangleMap_.empty())
-        buildInternalTriangleMap(exnode, false, true);
-      for(std::vector<SimplexId> triangleVec : iter->second) {
-        std::array<SimplexId, 3> triangle
-          = {triangleVec[1], triangleVec[2], triangleVec[3]};
-        (nodePtr->tetraTriangles_)[triangleVec[0]
-                                   - cellIntervals_[nodePtr->nid - 1] - 1]
-          .back()
-          = exnode->internalTriangleMap_.at(triangle)
-            + triangleIntervals_[iter->first - 1];
-      }
-    } else {
-      ImplicitCluster tmpCluster(iter->first);
-      buildInternalTriangleMap(&tmpCluster, false, true);
-      for(std::vector<SimplexId> triangleVec : iter->second) {
-        std::array<SimplexId, 3> triangle
-          = {triangleVec[1], triangleVec[2], triangleVec[3]};
-        (nodePtr->tetraTriangles_)[triangleVec[0]
-                                   - cellIntervals_[nodePtr->nid - 1] - 1]
-          .back()
-          = tmpCluster.internalTriangleMap_.at(triangle)
-            + triangleIntervals_[iter->first - 1];
-      }
+    const auto exnode = searchCache(iter->first);
+    expandCluster(exnode.get(), RELATION::INTERNAL_TRIANGLE_MAP);
+    for(std::vector<SimplexId> triangleVec : iter->second) {
+      std::array<SimplexId, 3> triangle
+        = {triangleVec[1], triangleVec[2], triangleVec[3]};
+      (nodePtr->tetraTriangles_)[triangleVec[0]
+                                 - cellIntervals_[nodePtr->nid - 1] - 1]
+        .back()
+        = exnode->internalTriangleMap_.at(triangle)
+          + triangleIntervals_[iter->first - 1];
     }
   }
 
@@ -954,12 +871,9 @@ int CompactTriangulation::getClusterEdgeLinks(
     linksCount(localEdgeNum, 0);
 
   if(getDimensionality() == 2) {
-    if(nodePtr->edgeStars_.empty()) {
-      getClusterEdgeStars(nodePtr);
-    }
+    expandCluster(nodePtr, RELATION::EDGE_STARS);
     // set the offsets vector
-    boost::unordered_map<std::array<SimplexId, 2>, SimplexId>::const_iterator
-      iter;
+    SimplexIdMap<2>::const_iterator iter;
     for(iter = nodePtr->internalEdgeMap_.begin();
         iter != nodePtr->internalEdgeMap_.end(); iter++) {
       for(SimplexId j = 0; j < nodePtr->edgeStars_.size(iter->second - 1);
@@ -1005,12 +919,8 @@ int CompactTriangulation::getClusterEdgeLinks(
     // fill FlatJaggedArray struct
     nodePtr->edgeLinks_.setData(std::move(edgeLinkData), std::move(offsets));
   } else if(getDimensionality() == 3) {
-    if(nodePtr->tetraEdges_.empty()) {
-      getClusterTetraEdges(nodePtr);
-    }
-    if(nodePtr->internalEdgeMap_.empty()) {
-      buildInternalEdgeMap(nodePtr, false, true);
-    }
+    expandCluster(nodePtr, RELATION::TETRA_EDGES);
+    expandCluster(nodePtr, RELATION::INTERNAL_EDGE_MAP);
 
     // set the offsets vector
     SimplexId localCellNum
@@ -1144,7 +1054,7 @@ int CompactTriangulation::getClusterEdgeLinks(
             }
             SimplexId nodeId = vertexIndices_[otherEdge[0]];
             if(nodeMaps.find(nodeId) == nodeMaps.end()) {
-              nodeMaps[nodeId] = ImplicitCluster(nodeId);
+              nodeMaps.emplace(nodeId, nodeId);
               buildInternalEdgeMap(&nodeMaps[nodeId], false, true);
             }
             SimplexId localEdgeId = nodePtr->internalEdgeMap_.at(edgeIds) - 1;
@@ -1176,9 +1086,7 @@ int CompactTriangulation::getClusterEdgeStars(
     = edgeIntervals_[nodePtr->nid] - edgeIntervals_[nodePtr->nid - 1];
   std::vector<SimplexId> offsets(localEdgeNum + 1, 0), starsCount(localEdgeNum);
 
-  if(nodePtr->internalEdgeMap_.empty()) {
-    buildInternalEdgeMap(nodePtr, false, true);
-  }
+  expandCluster(nodePtr, RELATION::INTERNAL_EDGE_MAP);
 
   // set the offsets vector
   // loop through the internal cell list
@@ -1275,18 +1183,12 @@ int CompactTriangulation::getClusterEdgeTriangles(
   std::vector<SimplexId> offsets(localEdgeNum + 1, 0),
     trianglesCount(localEdgeNum, 0);
 
-  if(nodePtr->internalEdgeMap_.empty()) {
-    buildInternalEdgeMap(nodePtr, false, true);
-  }
-  if(nodePtr->internalTriangleMap_.empty()) {
-    buildInternalTriangleMap(nodePtr, false, true);
-  }
-  if(nodePtr->externalTriangleMap_.empty()) {
-    buildExternalTriangleMap(nodePtr);
-  }
+  expandCluster(nodePtr, RELATION::INTERNAL_EDGE_MAP);
+  expandCluster(nodePtr, RELATION::INTERNAL_TRIANGLE_MAP);
+  expandCluster(nodePtr, RELATION::EXTERNAL_TRIANGLE_MAP);
 
   // set the offsets vector
-  boost::unordered_map<std::array<SimplexId, 3>, SimplexId>::iterator iter;
+  SimplexIdMap<3>::const_iterator iter;
   for(iter = nodePtr->internalTriangleMap_.begin();
       iter != nodePtr->internalTriangleMap_.end(); iter++) {
     std::array<SimplexId, 2> edge1 = {iter->first[0], iter->first[1]};
@@ -1372,9 +1274,7 @@ int CompactTriangulation::getClusterTetraEdges(
   boost::unordered_map<SimplexId, std::vector<std::vector<SimplexId>>>
     edgeNodes;
 
-  if(nodePtr->internalEdgeMap_.empty()) {
-    buildInternalEdgeMap(nodePtr, false, true);
-  }
+  expandCluster(nodePtr, RELATION::INTERNAL_EDGE_MAP);
 
   for(SimplexId i = cellIntervals_[nodePtr->nid - 1] + 1;
       i <= cellIntervals_[nodePtr->nid]; i++) {
@@ -1410,27 +1310,14 @@ int CompactTriangulation::getClusterTetraEdges(
   }
 
   for(auto iter = edgeNodes.begin(); iter != edgeNodes.end(); iter++) {
-    ImplicitCluster *exnode = searchCache(iter->first, nodePtr->nid);
-    if(exnode) {
-      if(exnode->internalEdgeMap_.empty())
-        buildInternalEdgeMap(exnode, false, true);
-      for(std::vector<SimplexId> edgeTuple : iter->second) {
-        std::array<SimplexId, 2> edgePair = {edgeTuple[2], edgeTuple[3]};
-        (nodePtr->tetraEdges_)[edgeTuple[0] - cellIntervals_[nodePtr->nid - 1]
-                               - 1][edgeTuple[1]]
-          = exnode->internalEdgeMap_.at(edgePair)
-            + edgeIntervals_[iter->first - 1];
-      }
-    } else {
-      ImplicitCluster tmpCluster(iter->first);
-      buildInternalEdgeMap(&tmpCluster, false, true);
-      for(std::vector<SimplexId> edgeTuple : iter->second) {
-        std::array<SimplexId, 2> edgePair = {edgeTuple[2], edgeTuple[3]};
-        (nodePtr->tetraEdges_)[edgeTuple[0] - cellIntervals_[nodePtr->nid - 1]
-                               - 1][edgeTuple[1]]
-          = tmpCluster.internalEdgeMap_.at(edgePair)
-            + edgeIntervals_[iter->first - 1];
-      }
+    const auto exnode = searchCache(iter->first);
+    expandCluster(exnode.get(), RELATION::INTERNAL_EDGE_MAP);
+    for(std::vector<SimplexId> edgeTuple : iter->second) {
+      std::array<SimplexId, 2> edgePair = {edgeTuple[2], edgeTuple[3]};
+      (nodePtr->tetraEdges_)[edgeTuple[0] - cellIntervals_[nodePtr->nid - 1]
+                             - 1][edgeTuple[1]]
+        = exnode->internalEdgeMap_.at(edgePair)
+          + edgeIntervals_[iter->first - 1];
     }
   }
 
@@ -1449,9 +1336,7 @@ int CompactTriangulation::getClusterTriangleEdges(
   boost::unordered_map<SimplexId, std::vector<std::vector<SimplexId>>>
     edgeNodes;
 
-  if(nodePtr->internalEdgeMap_.empty()) {
-    buildInternalEdgeMap(nodePtr, false, true);
-  }
+  expandCluster(nodePtr, RELATION::INTERNAL_EDGE_MAP);
 
   if(getDimensionality() == 2) {
     for(SimplexId i = cellIntervals_[nodePtr->nid - 1] + 1;
@@ -1484,33 +1369,18 @@ int CompactTriangulation::getClusterTriangleEdges(
     }
 
     for(auto iter = edgeNodes.begin(); iter != edgeNodes.end(); iter++) {
-      ImplicitCluster *exnode = searchCache(iter->first, nodePtr->nid);
-      if(exnode) {
-        if(exnode->internalEdgeMap_.empty())
-          buildInternalEdgeMap(exnode, false, true);
-        for(std::vector<SimplexId> edgeTuple : iter->second) {
-          std::array<SimplexId, 2> edgePair = {edgeTuple[1], edgeTuple[2]};
-          (nodePtr->triangleEdges_)[edgeTuple[0]
-                                    - cellIntervals_[nodePtr->nid - 1] - 1][2]
-            = exnode->internalEdgeMap_.at(edgePair)
-              + edgeIntervals_[iter->first - 1];
-        }
-      } else {
-        ImplicitCluster tmpCluster(iter->first);
-        buildInternalEdgeMap(&tmpCluster, false, true);
-        for(std::vector<SimplexId> edgeTuple : iter->second) {
-          std::array<SimplexId, 2> edgePair = {edgeTuple[1], edgeTuple[2]};
-          (nodePtr->triangleEdges_)[edgeTuple[0]
-                                    - cellIntervals_[nodePtr->nid - 1] - 1][2]
-            = tmpCluster.internalEdgeMap_.at(edgePair)
-              + edgeIntervals_[iter->first - 1];
-        }
+      const auto exnode = searchCache(iter->first);
+      expandCluster(exnode.get(), RELATION::INTERNAL_EDGE_MAP);
+      for(std::vector<SimplexId> edgeTuple : iter->second) {
+        std::array<SimplexId, 2> edgePair = {edgeTuple[1], edgeTuple[2]};
+        (nodePtr->triangleEdges_)[edgeTuple[0]
+                                  - cellIntervals_[nodePtr->nid - 1] - 1][2]
+          = exnode->internalEdgeMap_.at(edgePair)
+            + edgeIntervals_[iter->first - 1];
       }
     }
   } else if(getDimensionality() == 3) {
-    if(nodePtr->internalTriangleMap_.empty()) {
-      buildInternalTriangleMap(nodePtr, false, true);
-    }
+    expandCluster(nodePtr, RELATION::INTERNAL_TRIANGLE_MAP);
 
     for(auto iter = nodePtr->internalTriangleMap_.begin();
         iter != nodePtr->internalTriangleMap_.end(); iter++) {
@@ -1538,25 +1408,13 @@ int CompactTriangulation::getClusterTriangleEdges(
     }
 
     for(auto iter = edgeNodes.begin(); iter != edgeNodes.end(); iter++) {
-      ImplicitCluster *exnode = searchCache(iter->first, nodePtr->nid);
-      if(exnode) {
-        if(exnode->internalEdgeMap_.empty())
-          buildInternalEdgeMap(exnode, false, true);
-        for(std::vector<SimplexId> edgeTuple : iter->second) {
-          std::array<SimplexId, 2> edgePair = {edgeTuple[1], edgeTuple[2]};
-          (nodePtr->triangleEdges_)[edgeTuple[0]][2]
-            = exnode->internalEdgeMap_.at(edgePair)
-              + edgeIntervals_[iter->first - 1];
-        }
-      } else {
-        ImplicitCluster tmpCluster(iter->first);
-        buildInternalEdgeMap(&tmpCluster, false, true);
-        for(std::vector<SimplexId> edgeTuple : iter->second) {
-          std::array<SimplexId, 2> edgePair = {edgeTuple[1], edgeTuple[2]};
-          (nodePtr->triangleEdges_)[edgeTuple[0]][2]
-            = tmpCluster.internalEdgeMap_.at(edgePair)
-              + edgeIntervals_[iter->first - 1];
-        }
+      const auto exnode = searchCache(iter->first);
+      expandCluster(exnode.get(), RELATION::INTERNAL_EDGE_MAP);
+      for(std::vector<SimplexId> edgeTuple : iter->second) {
+        std::array<SimplexId, 2> edgePair = {edgeTuple[1], edgeTuple[2]};
+        (nodePtr->triangleEdges_)[edgeTuple[0]][2]
+          = exnode->internalEdgeMap_.at(edgePair)
+            + edgeIntervals_[iter->first - 1];
       }
     }
   }
@@ -1577,13 +1435,10 @@ int CompactTriangulation::getClusterTriangleLinks(
   std::vector<SimplexId> offsets(localTriangleNum + 1, 0),
     linksCount(localTriangleNum, 0);
 
-  if(nodePtr->triangleStars_.empty()) {
-    getClusterTriangleStars(nodePtr);
-  }
+  expandCluster(nodePtr, RELATION::TRIANGLE_STARS);
 
   // set the offsets vector
-  boost::unordered_map<std::array<SimplexId, 3>, SimplexId>::const_iterator
-    iter;
+  SimplexIdMap<3>::const_iterator iter;
   for(iter = nodePtr->internalTriangleMap_.begin();
       iter != nodePtr->internalTriangleMap_.end(); iter++) {
     for(SimplexId i = 0; i < nodePtr->triangleStars_.size(iter->second - 1);
@@ -1649,9 +1504,7 @@ int CompactTriangulation::getClusterTriangleStars(
   std::vector<SimplexId> offsets(localTriangleNum + 1, 0),
     starsCount(localTriangleNum, 0);
 
-  if(nodePtr->internalTriangleMap_.empty()) {
-    buildInternalTriangleMap(nodePtr, false, true);
-  }
+  expandCluster(nodePtr, RELATION::INTERNAL_TRIANGLE_MAP);
 
   // set the offsets vector
   // loop through the internal cell list
@@ -1768,15 +1621,11 @@ int CompactTriangulation::getClusterVertexEdges(
   std::vector<SimplexId> offsets(localVertexNum + 1, 0),
     edgesCount(localVertexNum, 0);
 
-  if(nodePtr->internalEdgeMap_.empty()) {
-    buildInternalEdgeMap(nodePtr, false, true);
-  }
-  if(nodePtr->externalEdgeMap_.empty()) {
-    buildExternalEdgeMap(nodePtr);
-  }
+  expandCluster(nodePtr, RELATION::INTERNAL_EDGE_MAP);
+  expandCluster(nodePtr, RELATION::EXTERNAL_EDGE_MAP);
 
   // set the offsets vector
-  boost::unordered_map<std::array<SimplexId, 2>, SimplexId>::iterator iter;
+  SimplexIdMap<2>::const_iterator iter;
   for(iter = nodePtr->internalEdgeMap_.begin();
       iter != nodePtr->internalEdgeMap_.end(); iter++) {
     offsets[iter->first[0] - vertexIntervals_[nodePtr->nid - 1]]++;
@@ -1841,9 +1690,7 @@ int CompactTriangulation::getClusterVertexLinks(
   boost::unordered_map<SimplexId, ImplicitCluster> nodeMaps;
   // triangle mesh
   if(getDimensionality() == 2) {
-    if(nodePtr->internalEdgeMap_.empty()) {
-      buildInternalEdgeMap(nodePtr, false, true);
-    }
+    expandCluster(nodePtr, RELATION::INTERNAL_EDGE_MAP);
 
     // set the offsets vector
     for(SimplexId cid = cellIntervals_[nodePtr->nid - 1] + 1;
@@ -1887,7 +1734,7 @@ int CompactTriangulation::getClusterVertexLinks(
       std::array<SimplexId, 2> edgePair = {vertexIds[1], vertexIds[2]};
       SimplexId nodeId = vertexIndices_[vertexIds[1]];
       if(nodeMaps.find(nodeId) == nodeMaps.end()) {
-        nodeMaps[nodeId] = ImplicitCluster(nodeId);
+        nodeMaps.emplace(nodeId, nodeId);
         buildInternalEdgeMap(&nodeMaps[nodeId], false, true);
       }
       SimplexId localVertexId
@@ -1922,7 +1769,7 @@ int CompactTriangulation::getClusterVertexLinks(
       std::array<SimplexId, 2> edgePair = {vertexIds[0], vertexIds[2]};
       SimplexId nodeId = vertexIndices_[edgePair[0]];
       if(nodeMaps.find(nodeId) == nodeMaps.end()) {
-        nodeMaps[nodeId] = ImplicitCluster(nodeId);
+        nodeMaps.emplace(nodeId, nodeId);
         buildInternalEdgeMap(&nodeMaps[nodeId], false, true);
       }
       SimplexId localVertexId
@@ -1952,9 +1799,7 @@ int CompactTriangulation::getClusterVertexLinks(
     // tetrahedral mesh
   } else if(getDimensionality() == 3) {
 
-    if(nodePtr->internalTriangleMap_.empty()) {
-      buildInternalTriangleMap(nodePtr, false, true);
-    }
+    expandCluster(nodePtr, RELATION::INTERNAL_TRIANGLE_MAP);
 
     // set the offsets vector
     for(SimplexId cid = cellIntervals_[nodePtr->nid - 1] + 1;
@@ -2001,7 +1846,7 @@ int CompactTriangulation::getClusterVertexLinks(
         = {vertexIds[1], vertexIds[2], vertexIds[3]};
       SimplexId nodeId = vertexIndices_[vertexIds[1]];
       if(nodeMaps.find(nodeId) == nodeMaps.end()) {
-        nodeMaps[nodeId] = ImplicitCluster(nodeId);
+        nodeMaps.emplace(nodeId, nodeId);
         buildInternalTriangleMap(&nodeMaps[nodeId], false, true);
       }
       SimplexId localVertexId
@@ -2051,7 +1896,7 @@ int CompactTriangulation::getClusterVertexLinks(
         = {vertexIds[0], vertexIds[2], vertexIds[3]};
       SimplexId nodeId = vertexIndices_[vertexIds[0]];
       if(nodeMaps.find(nodeId) == nodeMaps.end()) {
-        nodeMaps[nodeId] = ImplicitCluster(nodeId);
+        nodeMaps.emplace(nodeId, nodeId);
         buildInternalTriangleMap(&nodeMaps[nodeId], false, true);
       }
       SimplexId localVertexId
@@ -2256,15 +2101,11 @@ int CompactTriangulation::getClusterVertexTriangles(
   std::vector<SimplexId> offsets(localVertexNum + 1, 0),
     trianglesCount(localVertexNum, 0);
 
-  if(nodePtr->internalTriangleMap_.empty()) {
-    buildInternalTriangleMap(nodePtr, false, true);
-  }
-  if(nodePtr->externalTriangleMap_.empty()) {
-    buildExternalTriangleMap(nodePtr);
-  }
+  expandCluster(nodePtr, RELATION::INTERNAL_TRIANGLE_MAP);
+  expandCluster(nodePtr, RELATION::EXTERNAL_TRIANGLE_MAP);
 
   // set the offsets vector
-  boost::unordered_map<std::array<SimplexId, 3>, SimplexId>::iterator iter;
+  SimplexIdMap<3>::const_iterator iter;
   for(iter = nodePtr->internalTriangleMap_.begin();
       iter != nodePtr->internalTriangleMap_.end(); iter++) {
     for(SimplexId j = 0; j < 3; j++) {
@@ -2338,176 +2179,176 @@ int CompactTriangulation::getBoundaryCells(ImplicitCluster *const nodePtr,
   if(getDimensionality() == 2) {
     SimplexId localEdgeNum
       = edgeIntervals_[nodePtr->nid] - edgeIntervals_[nodePtr->nid - 1];
-    if(nodePtr->boundaryEdges_.empty()) {
+    expandCluster(nodePtr, RELATION::BOUNDARY_EDGES, [&]() {
       nodePtr->boundaryEdges_ = std::vector<bool>(localEdgeNum, false);
-      if(nodePtr->edgeStars_.empty()) {
-        getClusterEdgeStars(nodePtr);
-      }
+      expandCluster(nodePtr, RELATION::EDGE_STARS);
       for(SimplexId i = 0; i < localEdgeNum; i++) {
         if(nodePtr->edgeStars_.size(i) == 1) {
           nodePtr->boundaryEdges_.at(i) = true;
         }
       }
-    }
+    });
     // if boundary vertices are requested
-    if(dim == 0 && nodePtr->boundaryVertices_.empty()) {
-      nodePtr->boundaryVertices_ = std::vector<bool>(
-        vertexIntervals_[nodePtr->nid] - vertexIntervals_[nodePtr->nid - 1],
-        false);
-      if(nodePtr->externalEdgeMap_.empty()) {
-        buildExternalEdgeMap(nodePtr);
-      }
-      // internal edges
-      for(auto iter = nodePtr->internalEdgeMap_.begin();
-          iter != nodePtr->internalEdgeMap_.end(); iter++) {
-        if((nodePtr->boundaryEdges_)[iter->second - 1]) {
-          (nodePtr->boundaryVertices_)[iter->first[0]
-                                       - vertexIntervals_[nodePtr->nid - 1] - 1]
-            = true;
-          if(iter->first[1] <= vertexIntervals_[nodePtr->nid]) {
-            (nodePtr
-               ->boundaryVertices_)[iter->first[1]
-                                    - vertexIntervals_[nodePtr->nid - 1] - 1]
+    if(dim == 0) {
+      expandCluster(nodePtr, RELATION::BOUNDARY_VERTICES, [&]() {
+        nodePtr->boundaryVertices_ = std::vector<bool>(
+          vertexIntervals_[nodePtr->nid] - vertexIntervals_[nodePtr->nid - 1],
+          false);
+        expandCluster(nodePtr, RELATION::INTERNAL_EDGE_MAP);
+        expandCluster(nodePtr, RELATION::EXTERNAL_EDGE_MAP);
+        // internal edges
+        for(auto iter = nodePtr->internalEdgeMap_.begin();
+            iter != nodePtr->internalEdgeMap_.end(); iter++) {
+          if((nodePtr->boundaryEdges_)[iter->second - 1]) {
+            (nodePtr->boundaryVertices_)[iter->first[0]
+                                         - vertexIntervals_[nodePtr->nid - 1]
+                                         - 1]
               = true;
+            if(iter->first[1] <= vertexIntervals_[nodePtr->nid]) {
+              (nodePtr->boundaryVertices_)[iter->first[1]
+                                           - vertexIntervals_[nodePtr->nid - 1]
+                                           - 1]
+                = true;
+            }
           }
         }
-      }
-      // external edges
-      boost::unordered_map<SimplexId, ImplicitCluster> nodeMaps;
-      for(auto iter = nodePtr->externalEdgeMap_.begin();
-          iter != nodePtr->externalEdgeMap_.end(); iter++) {
-        SimplexId nodeId = vertexIndices_[iter->first[0]];
-        if(nodeMaps.find(nodeId) == nodeMaps.end()) {
-          nodeMaps[nodeId] = ImplicitCluster(nodeId);
-          getBoundaryCells(&nodeMaps[nodeId]);
-        }
-        if((nodeMaps[nodeId]
-              .boundaryEdges_)[iter->second - edgeIntervals_[nodeId - 1] - 1]) {
-          (nodePtr->boundaryVertices_)[iter->first[1]
-                                       - vertexIntervals_[nodePtr->nid - 1] - 1]
-            = true;
+        // external edges
+        boost::unordered_map<SimplexId, ImplicitCluster> nodeMaps;
+        for(auto iter = nodePtr->externalEdgeMap_.begin();
+            iter != nodePtr->externalEdgeMap_.end(); iter++) {
+          SimplexId nodeId = vertexIndices_[iter->first[0]];
+          if(nodeMaps.find(nodeId) == nodeMaps.end()) {
+            nodeMaps.emplace(nodeId, nodeId);
+            getBoundaryCells(&nodeMaps[nodeId]);
+          }
+          if((nodeMaps[nodeId].boundaryEdges_)[iter->second
+                                               - edgeIntervals_[nodeId - 1]
+                                               - 1]) {
+            (nodePtr->boundaryVertices_)[iter->first[1]
+                                         - vertexIntervals_[nodePtr->nid - 1]
+                                         - 1]
+              = true;
+          }
         }
-      }
+      });
     }
   } else if(getDimensionality() == 3) {
     // get the boundary triangles first
     SimplexId localTriangleNum
       = triangleIntervals_[nodePtr->nid] - triangleIntervals_[nodePtr->nid - 1];
-    if(nodePtr->boundaryTriangles_.empty()) {
+    expandCluster(nodePtr, RELATION::BOUNDARY_TRIANGLES, [&]() {
       nodePtr->boundaryTriangles_ = std::vector<bool>(localTriangleNum, false);
-      if(nodePtr->triangleStars_.empty()) {
-        getClusterTriangleStars(nodePtr);
-      }
+      expandCluster(nodePtr, RELATION::TRIANGLE_STARS);
       for(SimplexId i = 0; i < localTriangleNum; i++) {
         if(nodePtr->triangleStars_.size(i) == 1) {
           (nodePtr->boundaryTriangles_)[i] = true;
         }
       }
-    }
+    });
     // if the boundary edges are requested
-    if(dim == 1 && nodePtr->boundaryEdges_.empty()) {
-      nodePtr->boundaryEdges_ = std::vector<bool>(
-        edgeIntervals_[nodePtr->nid] - edgeIntervals_[nodePtr->nid - 1], false);
-      if(nodePtr->externalTriangleMap_.empty()) {
-        buildExternalTriangleMap(nodePtr);
-      }
-      if(nodePtr->internalEdgeMap_.empty()) {
-        buildInternalEdgeMap(nodePtr, false, true);
-      }
-      // internal triangles
-      for(auto iter = nodePtr->internalTriangleMap_.begin();
-          iter != nodePtr->internalTriangleMap_.end(); iter++) {
-        if((nodePtr->boundaryTriangles_)[iter->second - 1]) {
-          std::array<SimplexId, 2> edgePair = {iter->first[0], iter->first[1]};
-          (nodePtr->boundaryEdges_)[nodePtr->internalEdgeMap_.at(edgePair) - 1]
-            = true;
-          edgePair[1] = iter->first[2];
-          (nodePtr->boundaryEdges_)[nodePtr->internalEdgeMap_.at(edgePair) - 1]
-            = true;
-          if(iter->first[1] <= vertexIntervals_[nodePtr->nid]) {
-            edgePair[0] = iter->first[1];
+    if(dim == 1) {
+      expandCluster(nodePtr, RELATION::BOUNDARY_EDGES, [&]() {
+        nodePtr->boundaryEdges_ = std::vector<bool>(
+          edgeIntervals_[nodePtr->nid] - edgeIntervals_[nodePtr->nid - 1],
+          false);
+        expandCluster(nodePtr, RELATION::INTERNAL_TRIANGLE_MAP);
+        expandCluster(nodePtr, RELATION::EXTERNAL_TRIANGLE_MAP);
+        expandCluster(nodePtr, RELATION::INTERNAL_EDGE_MAP);
+        // internal triangles
+        for(auto iter = nodePtr->internalTriangleMap_.begin();
+            iter != nodePtr->internalTriangleMap_.end(); iter++) {
+          if((nodePtr->boundaryTriangles_)[iter->second - 1]) {
+            std::array<SimplexId, 2> edgePair
+              = {iter->first[0], iter->first[1]};
             (nodePtr
                ->boundaryEdges_)[nodePtr->internalEdgeMap_.at(edgePair) - 1]
               = true;
-          }
-        }
-      }
-      // external triangles
-      boost::unordered_map<SimplexId, ImplicitCluster> nodeMaps;
-      for(auto iter = nodePtr->externalTriangleMap_.begin();
-          iter != nodePtr->externalTriangleMap_.end(); iter++) {
-        SimplexId nodeId = vertexIndices_[iter->first[0]];
-        if(nodeMaps.find(nodeId) == nodeMaps.end()) {
-          nodeMaps[nodeId] = ImplicitCluster(nodeId);
-          getBoundaryCells(&nodeMaps[nodeId]);
-        }
-        if((nodeMaps[nodeId]
-              .boundaryTriangles_)[iter->second - triangleIntervals_[nodeId - 1]
-                                   - 1]) {
-          if(iter->first[1] > vertexIntervals_[nodePtr->nid - 1]
-             && iter->first[1] <= vertexIntervals_[nodePtr->nid]) {
-            std::array<SimplexId, 2> edgePair
-              = {iter->first[1], iter->first[2]};
+            edgePair[1] = iter->first[2];
             (nodePtr
                ->boundaryEdges_)[nodePtr->internalEdgeMap_.at(edgePair) - 1]
               = true;
+            if(iter->first[1] <= vertexIntervals_[nodePtr->nid]) {
+              edgePair[0] = iter->first[1];
+              (nodePtr
+                 ->boundaryEdges_)[nodePtr->internalEdgeMap_.at(edgePair) - 1]
+                = true;
+            }
           }
         }
-      }
-    }
-
-    // if the boundary vertices are requested
-    else if(dim == 0 && nodePtr->boundaryVertices_.empty()) {
-      nodePtr->boundaryVertices_ = std::vector<bool>(
-        vertexIntervals_[nodePtr->nid] - vertexIntervals_[nodePtr->nid - 1],
-        false);
-      if(nodePtr->externalTriangleMap_.empty()) {
-        buildExternalTriangleMap(nodePtr);
-      }
-      // internal triangles
-      for(auto iter = nodePtr->internalTriangleMap_.begin();
-          iter != nodePtr->internalTriangleMap_.end(); iter++) {
-        if((nodePtr->boundaryTriangles_)[iter->second - 1]) {
-          for(int j = 0; j < 3; j++) {
-            SimplexId vid = iter->first[j];
-            if(vid <= vertexIntervals_[nodePtr->nid]) {
+        // external triangles
+        boost::unordered_map<SimplexId, ImplicitCluster> nodeMaps;
+        for(auto iter = nodePtr->externalTriangleMap_.begin();
+            iter != nodePtr->externalTriangleMap_.end(); iter++) {
+          SimplexId nodeId = vertexIndices_[iter->first[0]];
+          if(nodeMaps.find(nodeId) == nodeMaps.end()) {
+            nodeMaps.emplace(nodeId, nodeId);
+            getBoundaryCells(&nodeMaps[nodeId]);
+          }
+          if((nodeMaps[nodeId].boundaryTriangles_)
+               [iter->second - triangleIntervals_[nodeId - 1] - 1]) {
+            if(iter->first[1] > vertexIntervals_[nodePtr->nid - 1]
+               && iter->first[1] <= vertexIntervals_[nodePtr->nid]) {
+              std::array<SimplexId, 2> edgePair
+                = {iter->first[1], iter->first[2]};
               (nodePtr
-                 ->boundaryVertices_)[vid - vertexIntervals_[nodePtr->nid - 1]
-                                      - 1]
+                 ->boundaryEdges_)[nodePtr->internalEdgeMap_.at(edgePair) - 1]
                 = true;
             }
           }
         }
-      }
-      // external triangles
-      boost::unordered_map<SimplexId, ImplicitCluster> nodeMaps;
-      for(auto iter = nodePtr->externalTriangleMap_.begin();
-          iter != nodePtr->externalTriangleMap_.end(); iter++) {
-        SimplexId nodeId = vertexIndices_[iter->first[0]];
-        if(nodeMaps.find(nodeId) == nodeMaps.end()) {
-          nodeMaps[nodeId] = ImplicitCluster(nodeId);
-          ;
-          getBoundaryCells(&nodeMaps[nodeId]);
+      });
+    }
+
+    // if the boundary vertices are requested
+    else if(dim == 0) {
+      expandCluster(nodePtr, RELATION::BOUNDARY_VERTICES, [&]() {
+        nodePtr->boundaryVertices_ = std::vector<bool>(
+          vertexIntervals_[nodePtr->nid] - vertexIntervals_[nodePtr->nid - 1],
+          false);
+        expandCluster(nodePtr, RELATION::INTERNAL_TRIANGLE_MAP);
+        expandCluster(nodePtr, RELATION::EXTERNAL_TRIANGLE_MAP);
+        // internal triangles
+        for(auto iter = nodePtr->internalTriangleMap_.begin();
+            iter != nodePtr->internalTriangleMap_.end(); iter++) {
+          if((nodePtr->boundaryTriangles_)[iter->second - 1]) {
+            for(int j = 0; j < 3; j++) {
+              SimplexId vid = iter->first[j];
+              if(vid <= vertexIntervals_[nodePtr->nid]) {
+                (nodePtr->boundaryVertices_)
+                  [vid - vertexIntervals_[nodePtr->nid - 1] - 1]
+                  = true;
+              }
+            }
+          }
         }
-        if((nodeMaps[nodeId]
-              .boundaryTriangles_)[iter->second - triangleIntervals_[nodeId - 1]
-                                   - 1]) {
-          if(iter->first[1] > vertexIntervals_[nodePtr->nid - 1]
-             && iter->first[1] <= vertexIntervals_[nodePtr->nid]) {
-            (nodePtr
-               ->boundaryVertices_)[iter->first[1]
-                                    - vertexIntervals_[nodePtr->nid - 1] - 1]
-              = true;
+        // external triangles
+        boost::unordered_map<SimplexId, ImplicitCluster> nodeMaps;
+        for(auto iter = nodePtr->externalTriangleMap_.begin();
+            iter != nodePtr->externalTriangleMap_.end(); iter++) {
+          SimplexId nodeId = vertexIndices_[iter->first[0]];
+          if(nodeMaps.find(nodeId) == nodeMaps.end()) {
+            nodeMaps.emplace(nodeId, nodeId);
+            getBoundaryCells(&nodeMaps[nodeId]);
           }
-          if(iter->first[2] > vertexIntervals_[nodePtr->nid - 1]
-             && iter->first[2] <= vertexIntervals_[nodePtr->nid]) {
-            (nodePtr
-               ->boundaryVertices_)[iter->first[2]
-                                    - vertexIntervals_[nodePtr->nid - 1] - 1]
-              = true;
+          if((nodeMaps[nodeId].boundaryTriangles_)
+               [iter->second - triangleIntervals_[nodeId - 1] - 1]) {
+            if(iter->first[1] > vertexIntervals_[nodePtr->nid - 1]
+               && iter->first[1] <= vertexIntervals_[nodePtr->nid]) {
+              (nodePtr->boundaryVertices_)[iter->first[1]
+                                           - vertexIntervals_[nodePtr->nid - 1]
+                                           - 1]
+                = true;
+            }
+            if(iter->first[2] > vertexIntervals_[nodePtr->nid - 1]
+               && iter->first[2] <= vertexIntervals_[nodePtr->nid]) {
+              (nodePtr->boundaryVertices_)[iter->first[2]
+                                           - vertexIntervals_[nodePtr->nid - 1]
+                                           - 1]
+                = true;
+            }
           }
         }
-      }
+      });
     }
   } else {
     return -1;
@@ -2515,3 +2356,128 @@ int CompactTriangulation::getBoundaryCells(ImplicitCluster *const nodePtr,
 
   return 0;
 }
+
+void CompactTriangulation::expandCluster(ImplicitCluster *const nodePtr,
+                                         const RELATION relation) const {
+  switch(relation) {
+    case RELATION::INTERNAL_EDGE_LIST:
+      expandCluster(nodePtr, relation, [&]() {
+        buildInternalEdgeMap(nodePtr, true, false);
+      });
+      break;
+    case RELATION::INTERNAL_EDGE_MAP:
+      expandCluster(nodePtr, relation, [&]() {
+        buildInternalEdgeMap(nodePtr, false, true);
+      });
+      break;
+    case RELATION::EXTERNAL_EDGE_MAP:
+      expandCluster(
+        nodePtr, relation, [&]() { buildExternalEdgeMap(nodePtr); });
+      break;
+    case RELATION::INTERNAL_TRIANGLE_LIST:
+      expandCluster(nodePtr, relation, [&]() {
+        buildInternalTriangleMap(nodePtr, true, false);
+      });
+      break;
+    case RELATION::INTERNAL_TRIANGLE_MAP:
+      expandCluster(nodePtr, relation, [&]() {
+        buildInternalTriangleMap(nodePtr, false, true);
+      });
+      break;
+    case RELATION::EXTERNAL_TRIANGLE_MAP:
+      expandCluster(
+        nodePtr, relation, [&]() { buildExternalTriangleMap(nodePtr); });
+      break;
+    case RELATION::BOUNDARY_VERTICES:
+      getBoundaryCells(nodePtr, 0);
+      break;
+    case RELATION::BOUNDARY_EDGES:
+      getBoundaryCells(nodePtr, 1);
+      break;
+    case RELATION::BOUNDARY_TRIANGLES:
+      getBoundaryCells(nodePtr);
+      break;
+    case RELATION::VERTEX_EDGES:
+      expandCluster(
+        nodePtr, relation, [&]() { getClusterVertexEdges(nodePtr); });
+      break;
+    case RELATION::VERTEX_LINKS:
+      expandCluster(
+        nodePtr, relation, [&]() { getClusterVertexLinks(nodePtr); });
+      break;
+    case RELATION::VERTEX_NEIGHBORS:
+      expandCluster(
+        nodePtr, relation, [&]() { getClusterVertexNeighbors(nodePtr); });
+      break;
+    case RELATION::VERTEX_STARS:
+      expandCluster(
+        nodePtr, relation, [&]() { getClusterVertexStars(nodePtr); });
+      break;
+    case RELATION::VERTEX_TRIANGLES:
+      expandCluster(
+        nodePtr, relation, [&]() { getClusterVertexTriangles(nodePtr); });
+      break;
+    case RELATION::EDGE_LINKS:
+      expandCluster(
+        nodePtr, relation, [&]() { getClusterEdgeLinks(nodePtr); });
+      break;
+    case RELATION::EDGE_STARS:
+      expandCluster(
+        nodePtr, relation, [&]() { getClusterEdgeStars(nodePtr); });
+      break;
+    case RELATION::EDGE_TRIANGLES:
+      expandCluster(
+        nodePtr, relation, [&]() { getClusterEdgeTriangles(nodePtr); });
+      break;
+    case RELATION::TRIANGLE_EDGES:
+      expandCluster(
+        nodePtr, relation, [&]() { getClusterTriangleEdges(nodePtr); });
+      break;
+    case RELATION::TRIANGLE_LINKS:
+      expandCluster(
+        nodePtr, relation, [&]() { getClusterTriangleLinks(nodePtr); });
+      break;
+    case RELATION::TRIANGLE_STARS:
+      expandCluster(
+        nodePtr, relation, [&]() { getClusterTriangleStars(nodePtr); });
+      break;
+    case RELATION::TETRA_EDGES:
+      expandCluster(
+        nodePtr, relation, [&]() { getClusterTetraEdges(nodePtr); });
+      break;
+    case RELATION::CELL_NEIGHBORS:
+      expandCluster(
+        nodePtr, relation, [&]() { getClusterCellNeighbors(nodePtr); });
+      break;
+    case RELATION::TETRA_TRIANGLES:
+      expandCluster(
+        nodePtr, relation, [&]() { getClusterCellTriangles(nodePtr); });
+      break;
+    case RELATION::COUNT:
+      break;
+  }
+}
+
+size_t CompactTriangulation::nextCacheGeneration() {
+  // generations are unique among all triangulations
+  static std::atomic<size_t> generation{0};
+  return ++generation;
+}
+
+void CompactTriangulation::printCacheStatistics() const {
+  const auto stats = cache_.getStatistics();
+  const auto lookups = stats.hits + stats.misses;
+  if(lookups == 0) {
+    return;
+  }
+  this->printMsg("Cluster cache: "
+                   + std::to_string(100 * stats.hits / lookups)
+                   + "% hit rate (" + std::to_string(stats.hits) + "/"
+                   + std::to_string(lookups) + " lookups, "
+                   + std::to_string(stats.evictions) + " evictions)",
+                 debug::Priority::DETAIL);
+  this->printMsg("Expanded " + std::to_string(expansions_.number)
+                   + " cluster relations",
+                 1.0, expansions_.time * 1e-6, this->threadNumber_,
+                 debug::LineMode::NEW, debug::Priority::DETAIL);
+}
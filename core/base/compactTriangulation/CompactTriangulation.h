@@ -30,28 +30,150 @@
 
 // base code includes
 #include <AbstractTriangulation.h>
+#include <Cache.h>
 #include <CellArray.h>
 #include <FlatJaggedArray.h>
 #include <algorithm>
-#include <boost/functional/hash.hpp>
+#include <atomic>
 #include <boost/unordered_map.hpp>
-#include <boost/unordered_set.hpp>
-#include <list>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
 
 namespace ttk {
 
+  /**
+   * Sorted flat map from the vertices of a simplex to its id. Entries are
+   * stored contiguously, sorted by vertices, and found by binary search.
+   */
+  template <size_t n>
+  class SimplexIdMap {
+  public:
+    using key_type = std::array<SimplexId, n>;
+    using value_type = std::pair<key_type, SimplexId>;
+    using const_iterator = typename std::vector<value_type>::const_iterator;
+    using iterator = const_iterator;
+
+    inline const_iterator begin() const {
+      return data_.begin();
+    }
+    inline const_iterator end() const {
+      return data_.end();
+    }
+    inline bool empty() const {
+      return data_.empty();
+    }
+    inline size_t size() const {
+      return data_.size();
+    }
+    inline void clear() {
+      data_ = {};
+    }
+
+    /**
+     * Number the given simplices from 1, by order of first occurrence
+     * (duplicates are allowed).
+     */
+    inline void setFirstOccurrences(const std::vector<key_type> &simplices) {
+      std::vector<value_type> entries(simplices.size());
+      for(size_t i = 0; i < simplices.size(); i++) {
+        entries[i] = {simplices[i], static_cast<SimplexId>(i)};
+      }
+      // keep the first occurrence of every simplex
+      std::sort(entries.begin(), entries.end());
+      entries.erase(std::unique(entries.begin(), entries.end(),
+                                [](const value_type &a, const value_type &b) {
+                                  return a.first == b.first;
+                                }),
+                    entries.end());
+      // rank of the first occurrences
+      std::vector<SimplexId> ranks(simplices.size());
+      for(const auto &e : entries) {
+        ranks[e.second] = 1;
+      }
+      std::partial_sum(ranks.begin(), ranks.end(), ranks.begin());
+      for(auto &e : entries) {
+        e.second = ranks[e.second];
+      }
+      data_ = std::move(entries);
+    }
+
+    /**
+     * Set the (simplex, id) entries, only the first entry of duplicated
+     * simplices is kept.
+     */
+    inline void setEntries(std::vector<value_type> &&entries) {
+      std::stable_sort(entries.begin(), entries.end(),
+                       [](const value_type &a, const value_type &b) {
+                         return a.first < b.first;
+                       });
+      entries.erase(std::unique(entries.begin(), entries.end(),
+                                [](const value_type &a, const value_type &b) {
+                                  return a.first == b.first;
+                                }),
+                    entries.end());
+      data_ = std::move(entries);
+    }
+
+    inline const_iterator find(const key_type &key) const {
+      const auto it = std::lower_bound(
+        data_.begin(), data_.end(), key,
+        [](const value_type &a, const key_type &b) { return a.first < b; });
+      return (it != data_.end() && it->first == key) ? it : data_.end();
+    }
+
+    inline SimplexId at(const key_type &key) const {
+      const auto it = this->find(key);
+      if(it == data_.end()) {
+        throw std::out_of_range("SimplexIdMap::at");
+      }
+      return it->second;
+    }
+
+  private:
+    std::vector<value_type> data_{};
+  };
+
   class ImplicitCluster {
+  public:
+    /* relations computed on demand */
+    enum class RELATION : int {
+      INTERNAL_EDGE_LIST,
+      INTERNAL_EDGE_MAP,
+      EXTERNAL_EDGE_MAP,
+      INTERNAL_TRIANGLE_LIST,
+      INTERNAL_TRIANGLE_MAP,
+      EXTERNAL_TRIANGLE_MAP,
+      BOUNDARY_VERTICES,
+      BOUNDARY_EDGES,
+      BOUNDARY_TRIANGLES,
+      VERTEX_EDGES,
+      VERTEX_LINKS,
+      VERTEX_NEIGHBORS,
+      VERTEX_STARS,
+      VERTEX_TRIANGLES,
+      EDGE_LINKS,
+      EDGE_STARS,
+      EDGE_TRIANGLES,
+      TRIANGLE_EDGES,
+      TRIANGLE_LINKS,
+      TRIANGLE_STARS,
+      TETRA_EDGES,
+      CELL_NEIGHBORS,
+      TETRA_TRIANGLES,
+      COUNT
+    };
+
   private:
     /* components */
     SimplexId nid;
     std::vector<std::array<SimplexId, 2>> internalEdgeList_;
     std::vector<std::array<SimplexId, 3>> internalTriangleList_;
-    boost::unordered_map<std::array<SimplexId, 2>, SimplexId> internalEdgeMap_;
-    boost::unordered_map<std::array<SimplexId, 2>, SimplexId> externalEdgeMap_;
-    boost::unordered_map<std::array<SimplexId, 3>, SimplexId>
-      internalTriangleMap_;
-    boost::unordered_map<std::array<SimplexId, 3>, SimplexId>
-      externalTriangleMap_;
+    SimplexIdMap<2> internalEdgeMap_;
+    SimplexIdMap<2> externalEdgeMap_;
+    SimplexIdMap<3> internalTriangleMap_;
+    SimplexIdMap<3> externalTriangleMap_;
     /* boundary cells */
     std::vector<bool> boundaryVertices_;
     std::vector<bool> boundaryEdges_;
@@ -76,6 +198,9 @@ namespace ttk {
     std::vector<std::array<SimplexId, 6>> tetraEdges_;
     FlatJaggedArray cellNeighbors_;
     std::vector<std::array<SimplexId, 4>> tetraTriangles_;
+    /* one flag per relation, a cluster can be shared by several threads */
+    std::array<std::once_flag, static_cast<size_t>(RELATION::COUNT)>
+      expanded_;
 
   public:
     ImplicitCluster() = default;
@@ -243,10 +368,8 @@ namespace ttk {
 
       SimplexId nid = vertexIndices_[cellArray_->getCellVertex(cellId, 0)];
       SimplexId localCellId = cellId - cellIntervals_[nid - 1] - 1;
-      ImplicitCluster *exnode = searchCache(nid);
-      if(exnode->tetraEdges_.empty()) {
-        getClusterTetraEdges(exnode);
-      }
+      const auto exnode = searchCache(nid);
+      expandCluster(exnode.get(), RELATION::TETRA_EDGES);
 
       if(localEdgeId >= (int)(exnode->tetraEdges_)[localCellId].size()) {
         edgeId = -2;
@@ -273,10 +396,8 @@ namespace ttk {
       if(cellEdgeVector_.empty()) {
         cellEdgeVector_.reserve(cellNumber_);
         for(SimplexId nid = 1; nid <= nodeNumber_; nid++) {
-          ImplicitCluster *exnode = searchCache(nid);
-          if(exnode->tetraEdges_.empty()) {
-            getClusterTetraEdges(exnode);
-          }
+          const auto exnode = searchCache(nid);
+          expandCluster(exnode.get(), RELATION::TETRA_EDGES);
           for(size_t i = 0; i < exnode->tetraEdges_.size(); i++) {
             cellEdgeVector_.emplace_back(exnode->tetraEdges_.at(i).begin(),
                                          exnode->tetraEdges_.at(i).end());
@@ -304,10 +425,8 @@ namespace ttk {
 
       SimplexId nid = vertexIndices_[cellArray_->getCellVertex(cellId, 0)];
       SimplexId localCellId = cellId - cellIntervals_[nid - 1] - 1;
-      ImplicitCluster *exnode = searchCache(nid);
-      if(exnode->cellNeighbors_.empty()) {
-        getClusterCellNeighbors(exnode);
-      }
+      const auto exnode = searchCache(nid);
+      expandCluster(exnode.get(), RELATION::CELL_NEIGHBORS);
 
       if(localNeighborId >= exnode->cellNeighbors_.size(localCellId)) {
         neighborId = -2;
@@ -327,10 +446,8 @@ namespace ttk {
 
       SimplexId nid = vertexIndices_[cellArray_->getCellVertex(cellId, 0)];
       SimplexId localCellId = cellId - cellIntervals_[nid - 1] - 1;
-      ImplicitCluster *exnode = searchCache(nid);
-      if(exnode->cellNeighbors_.empty()) {
-        getClusterCellNeighbors(exnode);
-      }
+      const auto exnode = searchCache(nid);
+      expandCluster(exnode.get(), RELATION::CELL_NEIGHBORS);
       return exnode->cellNeighbors_.size(localCellId);
     }
 
@@ -339,10 +456,8 @@ namespace ttk {
       cellNeighborList_.reserve(cellNumber_);
       for(SimplexId nid = 1; nid <= nodeNumber_; nid++) {
         std::vector<std::vector<SimplexId>> localCellNeighbors;
-        ImplicitCluster *exnode = searchCache(nid);
-        if(exnode->cellNeighbors_.empty()) {
-          getClusterCellNeighbors(exnode);
-        }
+        const auto exnode = searchCache(nid);
+        expandCluster(exnode.get(), RELATION::CELL_NEIGHBORS);
         exnode->cellNeighbors_.copyTo(localCellNeighbors);
         cellNeighborList_.insert(cellNeighborList_.end(),
                                  localCellNeighbors.begin(),
@@ -369,10 +484,8 @@ namespace ttk {
 
       SimplexId nid = vertexIndices_[cellArray_->getCellVertex(cellId, 0)];
       SimplexId localCellId = cellId - cellIntervals_[nid - 1] - 1;
-      ImplicitCluster *exnode = searchCache(nid);
-      if(exnode->tetraTriangles_.empty()) {
-        getClusterCellTriangles(exnode);
-      }
+      const auto exnode = searchCache(nid);
+      expandCluster(exnode.get(), RELATION::TETRA_TRIANGLES);
       triangleId = (exnode->tetraTriangles_)[localCellId][localTriangleId];
       return 0;
     }
@@ -394,10 +507,8 @@ namespace ttk {
       if(cellTriangleVector_.empty()) {
         cellTriangleVector_.reserve(cellNumber_);
         for(SimplexId nid = 1; nid <= nodeNumber_; nid++) {
-          ImplicitCluster *exnode = searchCache(nid);
-          if(exnode->tetraTriangles_.empty()) {
-            getClusterCellTriangles(exnode);
-          }
+          const auto exnode = searchCache(nid);
+          expandCluster(exnode.get(), RELATION::TETRA_TRIANGLES);
           for(size_t i = 0; i < exnode->tetraTriangles_.size(); i++) {
             cellTriangleVector_.emplace_back(
               exnode->tetraTriangles_.at(i).begin(),
@@ -448,9 +559,8 @@ namespace ttk {
       TTK_TRIANGULATION_INTERNAL(getEdges)() override {
       edgeList_.reserve(edgeIntervals_.back() + 1);
       for(SimplexId nid = 1; nid <= nodeNumber_; nid++) {
-        ImplicitCluster *exnode = searchCache(nid);
-        if(exnode->internalEdgeList_.empty())
-          buildInternalEdgeMap(exnode, true, false);
+        const auto exnode = searchCache(nid);
+        expandCluster(exnode.get(), RELATION::INTERNAL_EDGE_LIST);
         edgeList_.insert(edgeList_.end(), exnode->internalEdgeList_.begin(),
                          exnode->internalEdgeList_.end());
       }
@@ -475,10 +585,8 @@ namespace ttk {
 
       SimplexId nid = findNodeIndex(edgeId, SIMPLEX_ID::EDGE_ID);
       SimplexId localEdgeId = edgeId - edgeIntervals_[nid - 1] - 1;
-      ImplicitCluster *exnode = searchCache(nid);
-      if(exnode->edgeLinks_.empty()) {
-        getClusterEdgeLinks(exnode);
-      }
+      const auto exnode = searchCache(nid);
+      expandCluster(exnode.get(), RELATION::EDGE_LINKS);
 
       if(localLinkId >= exnode->edgeLinks_.size(localEdgeId)) {
         linkId = -2;
@@ -498,10 +606,8 @@ namespace ttk {
 
       SimplexId nid = findNodeIndex(edgeId, SIMPLEX_ID::EDGE_ID);
       SimplexId localEdgeId = edgeId - edgeIntervals_[nid - 1] - 1;
-      ImplicitCluster *exnode = searchCache(nid);
-      if(exnode->edgeLinks_.empty()) {
-        getClusterEdgeLinks(exnode);
-      }
+      const auto exnode = searchCache(nid);
+      expandCluster(exnode.get(), RELATION::EDGE_LINKS);
       return exnode->edgeLinks_.size(localEdgeId);
     }
 
@@ -510,10 +616,8 @@ namespace ttk {
       edgeLinkList_.reserve(edgeIntervals_.back() + 1);
       for(SimplexId nid = 1; nid <= nodeNumber_; nid++) {
         std::vector<std::vector<SimplexId>> localEdgeLinks;
-        ImplicitCluster *exnode = searchCache(nid);
-        if(exnode->edgeLinks_.empty()) {
-          getClusterEdgeLinks(exnode);
-        }
+        const auto exnode = searchCache(nid);
+        expandCluster(exnode.get(), RELATION::EDGE_LINKS);
         exnode->edgeLinks_.copyTo(localEdgeLinks);
         edgeLinkList_.insert(
           edgeLinkList_.end(), localEdgeLinks.begin(), localEdgeLinks.end());
@@ -539,10 +643,8 @@ namespace ttk {
 
       SimplexId nid = findNodeIndex(edgeId, SIMPLEX_ID::EDGE_ID);
       SimplexId localEdgeId = edgeId - edgeIntervals_[nid - 1] - 1;
-      ImplicitCluster *exnode = searchCache(nid);
-      if(exnode->edgeStars_.empty()) {
-        getClusterEdgeStars(exnode);
-      }
+      const auto exnode = searchCache(nid);
+      expandCluster(exnode.get(), RELATION::EDGE_STARS);
 
       if(localStarId >= exnode->edgeStars_.size(localEdgeId)) {
         starId = -2;
@@ -560,11 +662,9 @@ namespace ttk {
         return -1;
 #endif
       SimplexId nid = findNodeIndex(edgeId, SIMPLEX_ID::EDGE_ID);
-      ImplicitCluster *exnode = searchCache(nid);
+      const auto exnode = searchCache(nid);
       SimplexId localEdgeId = edgeId - edgeIntervals_[nid - 1] - 1;
-      if(exnode->edgeStars_.empty()) {
-        getClusterEdgeStars(exnode);
-      }
+      expandCluster(exnode.get(), RELATION::EDGE_STARS);
       return exnode->edgeStars_.size(localEdgeId);
     }
 
@@ -573,10 +673,8 @@ namespace ttk {
       edgeStarList_.reserve(edgeIntervals_.back() + 1);
       for(SimplexId nid = 1; nid <= nodeNumber_; nid++) {
         std::vector<std::vector<SimplexId>> localEdgeStars;
-        ImplicitCluster *exnode = searchCache(nid);
-        if(exnode->edgeStars_.empty()) {
-          getClusterEdgeStars(exnode);
-        }
+        const auto exnode = searchCache(nid);
+        expandCluster(exnode.get(), RELATION::EDGE_STARS);
         exnode->edgeStars_.copyTo(localEdgeStars);
         edgeStarList_.insert(
           edgeStarList_.end(), localEdgeStars.begin(), localEdgeStars.end());
@@ -601,10 +699,8 @@ namespace ttk {
 
       SimplexId nid = findNodeIndex(edgeId, SIMPLEX_ID::EDGE_ID);
       SimplexId localEdgeId = edgeId - edgeIntervals_[nid - 1] - 1;
-      ImplicitCluster *exnode = searchCache(nid);
-      if(exnode->edgeTriangles_.empty()) {
-        getClusterEdgeTriangles(exnode);
-      }
+      const auto exnode = searchCache(nid);
+      expandCluster(exnode.get(), RELATION::EDGE_TRIANGLES);
 
       if(localTriangleId >= exnode->edgeTriangles_.size(localEdgeId)) {
         triangleId = -2;
@@ -624,10 +720,8 @@ namespace ttk {
 
       SimplexId nid = findNodeIndex(edgeId, SIMPLEX_ID::EDGE_ID);
       SimplexId localEdgeId = edgeId - edgeIntervals_[nid - 1] - 1;
-      ImplicitCluster *exnode = searchCache(nid);
-      if(exnode->edgeTriangles_.empty()) {
-        getClusterEdgeTriangles(exnode);
-      }
+      const auto exnode = searchCache(nid);
+      expandCluster(exnode.get(), RELATION::EDGE_TRIANGLES);
       return exnode->edgeTriangles_.size(localEdgeId);
     }
 
@@ -636,10 +730,8 @@ namespace ttk {
       edgeTriangleList_.reserve(edgeIntervals_.back() + 1);
       for(SimplexId nid = 1; nid <= nodeNumber_; nid++) {
         std::vector<std::vector<SimplexId>> localEdgeTriangles;
-        ImplicitCluster *exnode = searchCache(nid);
-        if(exnode->edgeTriangles_.empty()) {
-          getClusterEdgeTriangles(exnode);
-        }
+        const auto exnode = searchCache(nid);
+        expandCluster(exnode.get(), RELATION::EDGE_TRIANGLES);
         exnode->edgeTriangles_.copyTo(localEdgeTriangles);
         edgeTriangleList_.insert(edgeTriangleList_.end(),
                                  localEdgeTriangles.begin(),
@@ -665,10 +757,8 @@ namespace ttk {
 
       SimplexId nid = findNodeIndex(edgeId, SIMPLEX_ID::EDGE_ID);
       SimplexId localEdgeId = edgeId - edgeIntervals_[nid - 1] - 1;
-      ImplicitCluster *exnode = searchCache(nid);
-      if(exnode->internalEdgeList_.empty()) {
-        buildInternalEdgeMap(exnode, true, false);
-      }
+      const auto exnode = searchCache(nid);
+      expandCluster(exnode.get(), RELATION::INTERNAL_EDGE_LIST);
 
       if(localVertexId) {
         vertexId = exnode->internalEdgeList_.at(localEdgeId)[1];
@@ -721,10 +811,8 @@ namespace ttk {
       } else {
         triangleList_.reserve(triangleIntervals_.back() + 1);
         for(SimplexId nid = 1; nid <= nodeNumber_; nid++) {
-          ImplicitCluster *exnode = searchCache(nid);
-          if(exnode->internalTriangleList_.empty()) {
-            buildInternalTriangleMap(exnode, true, false);
-          }
+          const auto exnode = searchCache(nid);
+          expandCluster(exnode.get(), RELATION::INTERNAL_TRIANGLE_LIST);
           triangleList_.insert(triangleList_.end(),
                                exnode->internalTriangleList_.begin(),
                                exnode->internalTriangleList_.end());
@@ -750,10 +838,8 @@ namespace ttk {
 
       SimplexId nid = findNodeIndex(triangleId, SIMPLEX_ID::TRIANGLE_ID);
       SimplexId localTriangleId = triangleId - triangleIntervals_[nid - 1] - 1;
-      ImplicitCluster *exnode = searchCache(nid);
-      if(exnode->triangleEdges_.empty()) {
-        getClusterTriangleEdges(exnode);
-      }
+      const auto exnode = searchCache(nid);
+      expandCluster(exnode.get(), RELATION::TRIANGLE_EDGES);
       edgeId = (exnode->triangleEdges_)[localTriangleId][localEdgeId];
       return 0;
     }
@@ -774,10 +860,8 @@ namespace ttk {
       if(triangleEdgeVector_.empty()) {
         triangleEdgeVector_.reserve(triangleIntervals_.size() + 1);
         for(SimplexId nid = 1; nid <= nodeNumber_; nid++) {
-          ImplicitCluster *exnode = searchCache(nid);
-          if(exnode->triangleEdges_.empty()) {
-            getClusterTriangleEdges(exnode);
-          }
+          const auto exnode = searchCache(nid);
+          expandCluster(exnode.get(), RELATION::TRIANGLE_EDGES);
           for(size_t i = 0; i < exnode->triangleEdges_.size(); i++) {
             triangleEdgeVector_.emplace_back(
               exnode->triangleEdges_.at(i).begin(),
@@ -806,10 +890,8 @@ namespace ttk {
 
       SimplexId nid = findNodeIndex(triangleId, SIMPLEX_ID::TRIANGLE_ID);
       SimplexId localTriangleId = triangleId - triangleIntervals_[nid - 1] - 1;
-      ImplicitCluster *exnode = searchCache(nid);
-      if(exnode->triangleLinks_.empty()) {
-        getClusterTriangleLinks(exnode);
-      }
+      const auto exnode = searchCache(nid);
+      expandCluster(exnode.get(), RELATION::TRIANGLE_LINKS);
 
       if(localLinkId >= exnode->triangleLinks_.size(localTriangleId)) {
         linkId = -2;
@@ -829,10 +911,8 @@ namespace ttk {
 
       SimplexId nid = findNodeIndex(triangleId, SIMPLEX_ID::TRIANGLE_ID);
       SimplexId localTriangleId = triangleId - triangleIntervals_[nid - 1] - 1;
-      ImplicitCluster *exnode = searchCache(nid);
-      if(exnode->triangleLinks_.empty()) {
-        getClusterTriangleLinks(exnode);
-      }
+      const auto exnode = searchCache(nid);
+      expandCluster(exnode.get(), RELATION::TRIANGLE_LINKS);
       return exnode->triangleLinks_.size(localTriangleId);
     }
 
@@ -841,10 +921,8 @@ namespace ttk {
       triangleLinkList_.reserve(triangleIntervals_.back() + 1);
       for(SimplexId nid = 1; nid <= nodeNumber_; nid++) {
         std::vector<std::vector<SimplexId>> localTriangleLinks;
-        ImplicitCluster *exnode = searchCache(nid);
-        if(exnode->triangleLinks_.empty()) {
-          getClusterTriangleLinks(exnode);
-        }
+        const auto exnode = searchCache(nid);
+        expandCluster(exnode.get(), RELATION::TRIANGLE_LINKS);
         exnode->triangleLinks_.copyTo(localTriangleLinks);
         triangleLinkList_.insert(triangleLinkList_.end(),
                                  localTriangleLinks.begin(),
@@ -872,10 +950,8 @@ namespace ttk {
 
       SimplexId nid = findNodeIndex(triangleId, SIMPLEX_ID::TRIANGLE_ID);
       SimplexId localTriangleId = triangleId - triangleIntervals_[nid - 1] - 1;
-      ImplicitCluster *exnode = searchCache(nid);
-      if(exnode->triangleStars_.empty()) {
-        getClusterTriangleStars(exnode);
-      }
+      const auto exnode = searchCache(nid);
+      expandCluster(exnode.get(), RELATION::TRIANGLE_STARS);
 
       if(localStarId >= exnode->triangleStars_.size(localTriangleId)) {
         starId = -2;
@@ -896,10 +972,8 @@ namespace ttk {
 
       SimplexId nid = findNodeIndex(triangleId, SIMPLEX_ID::TRIANGLE_ID);
       SimplexId localTriangleId = triangleId - triangleIntervals_[nid - 1] - 1;
-      ImplicitCluster *exnode = searchCache(nid);
-      if(exnode->triangleStars_.empty()) {
-        getClusterTriangleStars(exnode);
-      }
+      const auto exnode = searchCache(nid);
+      expandCluster(exnode.get(), RELATION::TRIANGLE_STARS);
       return exnode->triangleStars_.size(localTriangleId);
     }
 
@@ -908,10 +982,8 @@ namespace ttk {
       triangleStarList_.reserve(triangleIntervals_.back() + 1);
       for(SimplexId nid = 1; nid <= nodeNumber_; nid++) {
         std::vector<std::vector<SimplexId>> localTriangleStars;
-        ImplicitCluster *exnode = searchCache(nid);
-        if(exnode->triangleStars_.empty()) {
-          getClusterTriangleStars(exnode);
-        }
+        const auto exnode = searchCache(nid);
+        expandCluster(exnode.get(), RELATION::TRIANGLE_STARS);
         triangleStarList_.insert(triangleStarList_.end(),
                                  localTriangleStars.begin(),
                                  localTriangleStars.end());
@@ -936,10 +1008,8 @@ namespace ttk {
 
       SimplexId nid = findNodeIndex(triangleId, SIMPLEX_ID::TRIANGLE_ID);
       SimplexId localTriangleId = triangleId - triangleIntervals_[nid - 1] - 1;
-      ImplicitCluster *exnode = searchCache(nid);
-      if(exnode->internalTriangleList_.empty()) {
-        buildInternalTriangleMap(exnode, true, false);
-      }
+      const auto exnode = searchCache(nid);
+      expandCluster(exnode.get(), RELATION::INTERNAL_TRIANGLE_LIST);
       vertexId
         = exnode->internalTriangleList_.at(localTriangleId)[localVertexId];
       return 0;
@@ -962,10 +1032,8 @@ namespace ttk {
 
       SimplexId nid = vertexIndices_[vertexId];
       SimplexId localVertexId = vertexId - vertexIntervals_[nid - 1] - 1;
-      ImplicitCluster *exnode = searchCache(nid);
-      if(exnode->vertexEdges_.empty()) {
-        getClusterVertexEdges(exnode);
-      }
+      const auto exnode = searchCache(nid);
+      expandCluster(exnode.get(), RELATION::VERTEX_EDGES);
       if(localEdgeId >= exnode->vertexEdges_.size(localVertexId)) {
         edgeId = -2;
       } else {
@@ -984,10 +1052,8 @@ namespace ttk {
 
       SimplexId nid = vertexIndices_[vertexId];
       SimplexId localVertexId = vertexId - vertexIntervals_[nid - 1] - 1;
-      ImplicitCluster *exnode = searchCache(nid);
-      if(exnode->vertexEdges_.empty()) {
-        getClusterVertexEdges(exnode);
-      }
+      const auto exnode = searchCache(nid);
+      expandCluster(exnode.get(), RELATION::VERTEX_EDGES);
       return exnode->vertexEdges_.size(localVertexId);
     }
 
@@ -996,10 +1062,8 @@ namespace ttk {
       vertexEdgeList_.reserve(vertexNumber_);
       for(SimplexId nid = 1; nid <= nodeNumber_; nid++) {
         std::vector<std::vector<SimplexId>> localVertexEdges;
-        ImplicitCluster *exnode = searchCache(nid);
-        if(exnode->vertexEdges_.empty()) {
-          getClusterVertexEdges(exnode);
-        }
+        const auto exnode = searchCache(nid);
+        expandCluster(exnode.get(), RELATION::VERTEX_EDGES);
         exnode->vertexEdges_.copyTo(localVertexEdges);
         vertexEdgeList_.insert(vertexEdgeList_.end(), localVertexEdges.begin(),
                                localVertexEdges.end());
@@ -1026,10 +1090,8 @@ namespace ttk {
 
       SimplexId nid = vertexIndices_[vertexId];
       SimplexId localVertexId = vertexId - vertexIntervals_[nid - 1] - 1;
-      ImplicitCluster *exnode = searchCache(nid);
-      if(exnode->vertexLinks_.empty()) {
-        getClusterVertexLinks(exnode);
-      }
+      const auto exnode = searchCache(nid);
+      expandCluster(exnode.get(), RELATION::VERTEX_LINKS);
       if(localLinkId >= exnode->vertexLinks_.size(localVertexId)) {
         linkId = -2;
       } else {
@@ -1048,10 +1110,8 @@ namespace ttk {
 
       SimplexId nid = vertexIndices_[vertexId];
       SimplexId localVertexId = vertexId - vertexIntervals_[nid - 1] - 1;
-      ImplicitCluster *exnode = searchCache(nid);
-      if(exnode->vertexLinks_.empty()) {
-        getClusterVertexLinks(exnode);
-      }
+      const auto exnode = searchCache(nid);
+      expandCluster(exnode.get(), RELATION::VERTEX_LINKS);
       return exnode->vertexLinks_.size(localVertexId);
     }
 
@@ -1060,10 +1120,8 @@ namespace ttk {
       vertexLinkList_.reserve(vertexIntervals_.back() + 1);
       for(SimplexId nid = 1; nid <= nodeNumber_; nid++) {
         std::vector<std::vector<SimplexId>> localVertexLinks;
-        ImplicitCluster *exnode = searchCache(nid);
-        if(exnode->vertexLinks_.empty()) {
-          getClusterVertexLinks(exnode);
-        }
+        const auto exnode = searchCache(nid);
+        expandCluster(exnode.get(), RELATION::VERTEX_LINKS);
         exnode->vertexLinks_.copyTo(localVertexLinks);
         vertexLinkList_.insert(vertexLinkList_.end(), localVertexLinks.begin(),
                                localVertexLinks.end());
@@ -1088,13 +1146,11 @@ namespace ttk {
 
       SimplexId nid = vertexIndices_[vertexId];
       SimplexId localVertexId = vertexId - vertexIntervals_[nid - 1] - 1;
-      ImplicitCluster *exnode = searchCache(nid);
+      const auto exnode = searchCache(nid);
       if(exnode == nullptr) {
         return -1;
       }
-      if(exnode->vertexNeighbors_.empty()) {
-        getClusterVertexNeighbors(exnode);
-      }
+      expandCluster(exnode.get(), RELATION::VERTEX_NEIGHBORS);
       if(localNeighborId >= exnode->vertexNeighbors_.size(localVertexId)) {
         neighborId = -2;
       } else {
@@ -1114,10 +1170,8 @@ namespace ttk {
 
       SimplexId nid = vertexIndices_[vertexId];
       SimplexId localVertexId = vertexId - vertexIntervals_[nid - 1] - 1;
-      ImplicitCluster *exnode = searchCache(nid);
-      if(exnode->vertexNeighbors_.empty()) {
-        getClusterVertexNeighbors(exnode);
-      }
+      const auto exnode = searchCache(nid);
+      expandCluster(exnode.get(), RELATION::VERTEX_NEIGHBORS);
       return exnode->vertexNeighbors_.size(localVertexId);
     }
 
@@ -1126,10 +1180,8 @@ namespace ttk {
       vertexNeighborList_.reserve(vertexNumber_);
       for(SimplexId nid = 1; nid <= nodeNumber_; nid++) {
         std::vector<std::vector<SimplexId>> localVertexNeighbors;
-        ImplicitCluster *exnode = searchCache(nid);
-        if(exnode->vertexNeighbors_.empty()) {
-          getClusterVertexNeighbors(exnode);
-        }
+        const auto exnode = searchCache(nid);
+        expandCluster(exnode.get(), RELATION::VERTEX_NEIGHBORS);
         exnode->vertexNeighbors_.copyTo(localVertexNeighbors);
         vertexNeighborList_.insert(vertexNeighborList_.end(),
                                    localVertexNeighbors.begin(),
@@ -1177,10 +1229,8 @@ namespace ttk {
 
       SimplexId nid = vertexIndices_[vertexId];
       SimplexId localVertexId = vertexId - vertexIntervals_[nid - 1] - 1;
-      ImplicitCluster *exnode = searchCache(nid);
-      if(exnode->vertexStars_.empty()) {
-        getClusterVertexStars(exnode);
-      }
+      const auto exnode = searchCache(nid);
+      expandCluster(exnode.get(), RELATION::VERTEX_STARS);
       if(localStarId >= exnode->vertexStars_.size(localVertexId)) {
         starId = -2;
       } else {
@@ -1199,10 +1249,8 @@ namespace ttk {
 
       SimplexId nid = vertexIndices_[vertexId];
       SimplexId localVertexId = vertexId - vertexIntervals_[nid - 1] - 1;
-      ImplicitCluster *exnode = searchCache(nid);
-      if(exnode->vertexStars_.empty()) {
-        getClusterVertexStars(exnode);
-      }
+      const auto exnode = searchCache(nid);
+      expandCluster(exnode.get(), RELATION::VERTEX_STARS);
       return exnode->vertexStars_.size(localVertexId);
     }
 
@@ -1211,10 +1259,8 @@ namespace ttk {
       vertexStarList_.reserve(vertexNumber_);
       for(SimplexId nid = 1; nid <= nodeNumber_; nid++) {
         std::vector<std::vector<SimplexId>> localVertexStars;
-        ImplicitCluster *exnode = searchCache(nid);
-        if(exnode->vertexStars_.empty()) {
-          getClusterVertexStars(exnode);
-        }
+        const auto exnode = searchCache(nid);
+        expandCluster(exnode.get(), RELATION::VERTEX_STARS);
         exnode->vertexStars_.copyTo(localVertexStars);
         vertexStarList_.insert(vertexStarList_.end(), localVertexStars.begin(),
                                localVertexStars.end());
@@ -1239,10 +1285,8 @@ namespace ttk {
 
       SimplexId nid = vertexIndices_[vertexId];
       SimplexId localVertexId = vertexId - vertexIntervals_[nid - 1] - 1;
-      ImplicitCluster *exnode = searchCache(nid);
-      if(exnode->vertexTriangles_.empty()) {
-        getClusterVertexTriangles(exnode);
-      }
+      const auto exnode = searchCache(nid);
+      expandCluster(exnode.get(), RELATION::VERTEX_TRIANGLES);
       if(localTriangleId >= exnode->vertexTriangles_.size(localVertexId)) {
         triangleId = -2;
       } else {
@@ -1262,10 +1306,8 @@ namespace ttk {
 
       SimplexId nid = vertexIndices_[vertexId];
       SimplexId localVertexId = vertexId - vertexIntervals_[nid - 1] - 1;
-      ImplicitCluster *exnode = searchCache(nid);
-      if(exnode->vertexTriangles_.empty()) {
-        getClusterVertexTriangles(exnode);
-      }
+      const auto exnode = searchCache(nid);
+      expandCluster(exnode.get(), RELATION::VERTEX_TRIANGLES);
       return exnode->vertexTriangles_.size(localVertexId);
     }
 
@@ -1274,10 +1316,8 @@ namespace ttk {
       vertexTriangleList_.reserve(vertexNumber_);
       for(SimplexId nid = 1; nid <= nodeNumber_; nid++) {
         std::vector<std::vector<SimplexId>> localVertexTriangles;
-        ImplicitCluster *exnode = searchCache(nid);
-        if(exnode->vertexTriangles_.empty()) {
-          getClusterVertexTriangles(exnode);
-        }
+        const auto exnode = searchCache(nid);
+        expandCluster(exnode.get(), RELATION::VERTEX_TRIANGLES);
         exnode->vertexTriangles_.copyTo(localVertexTriangles);
         vertexTriangleList_.insert(vertexTriangleList_.end(),
                                    localVertexTriangles.begin(),
@@ -1294,8 +1334,8 @@ namespace ttk {
 #endif
       SimplexId nid = findNodeIndex(edgeId, SIMPLEX_ID::EDGE_ID);
       SimplexId localedgeId = edgeId - edgeIntervals_[nid - 1] - 1;
-      ImplicitCluster *exnode = searchCache(nid);
-      getBoundaryCells(exnode, 1);
+      const auto exnode = searchCache(nid);
+      getBoundaryCells(exnode.get(), 1);
       return (exnode->boundaryEdges_)[localedgeId];
     }
 
@@ -1314,8 +1354,8 @@ namespace ttk {
 #endif
       SimplexId nid = findNodeIndex(triangleId, SIMPLEX_ID::TRIANGLE_ID);
       SimplexId localtriangleId = triangleId - triangleIntervals_[nid - 1] - 1;
-      ImplicitCluster *exnode = searchCache(nid);
-      getBoundaryCells(exnode);
+      const auto exnode = searchCache(nid);
+      getBoundaryCells(exnode.get());
       return (exnode->boundaryTriangles_)[localtriangleId];
     }
 
@@ -1327,8 +1367,8 @@ namespace ttk {
 #endif
       SimplexId nid = vertexIndices_[vertexId];
       SimplexId localVertexId = vertexId - vertexIntervals_[nid - 1] - 1;
-      ImplicitCluster *exnode = searchCache(nid);
-      getBoundaryCells(exnode, 0);
+      const auto exnode = searchCache(nid);
+      getBoundaryCells(exnode.get(), 0);
       return (exnode->boundaryVertices_)[localVertexId];
     }
 
@@ -1494,16 +1534,14 @@ namespace ttk {
     }
 
     /**
-     * Initialize the cache with the ratio.
+     * Initialize the cache with the ratio. The cache is shared by all the
+     * threads and holds at most (ratio * number of clusters + 1) clusters.
      */
     inline void initCache(const float ratio = 0.2) {
+      this->printCacheStatistics();
       cacheSize_ = nodeNumber_ * ratio + 1;
-      caches_.resize(threadNumber_);
-      cacheMaps_.resize(threadNumber_);
-      for(int i = 0; i < threadNumber_; i++) {
-        caches_[i].clear();
-        cacheMaps_[i].clear();
-      }
+      cache_.setCapacity(cacheSize_);
+      this->resetCache(0);
       this->printMsg("Initializing cache: " + std::to_string(cacheSize_));
     }
 
@@ -1515,26 +1553,25 @@ namespace ttk {
     }
 
     /**
-     * Reset the cache size to better fit in the parallel or sequential
-     * algorithms.
+     * Empty the cache. Since the cache is shared by all the threads, the
+     * same cache fits both the parallel and the sequential algorithms
+     * and the option is ignored.
      */
     inline int resetCache(int option) {
-      for(int i = 0; i < threadNumber_; i++) {
-        caches_[i].clear();
-        cacheMaps_[i].clear();
-      }
-      if(option) {
-        caches_.resize(1);
-        cacheMaps_.resize(1);
-        cacheSize_ *= threadNumber_;
-      } else {
-        caches_.resize(threadNumber_);
-        cacheMaps_.resize(threadNumber_);
-        cacheSize_ /= threadNumber_;
-      }
+      TTK_FORCE_USE(option);
+      cache_.clear();
+      cache_.resetStatistics();
+      expansions_.reset();
+      cacheGeneration_ = nextCacheGeneration();
       return 0;
     }
 
+    /**
+     * Print the hit rate of the cache and the time spent expanding the
+     * clusters (debug level 4 and above).
+     */
+    void printCacheStatistics() const;
+
   protected:
     inline int clear() {
       vertexIntervals_.clear();
@@ -1542,8 +1579,7 @@ namespace ttk {
       triangleIntervals_.clear();
       cellIntervals_.clear();
       externalCells_.clear();
-      cacheMaps_.clear();
-      cacheMaps_.clear();
+      this->resetCache(0);
       return AbstractTriangulation::clear();
     }
 
@@ -1567,30 +1603,73 @@ namespace ttk {
     }
 
     /**
-     * Search the node in the cache.
+     * Search the node in the cache, create it if missing. The returned
+     * cluster stays valid even if it is evicted from the cache.
      */
-    inline ImplicitCluster *searchCache(const SimplexId &nodeId,
-                                        const SimplexId reservedId = 0) const {
-      ThreadId threadId = 0;
-#ifdef TTK_ENABLE_OPENMP
-      threadId = omp_get_thread_num();
-#endif
-
-      // cannot find the expanded node in the cache
-      if(cacheMaps_[threadId].find(nodeId) == cacheMaps_[threadId].end()) {
-        if(caches_[threadId].size() >= cacheSize_) {
-          if(caches_[threadId].back().nid == reservedId) {
-            return nullptr;
+    inline std::shared_ptr<ImplicitCluster>
+      searchCache(const SimplexId &nodeId) const {
+
+      // last cluster accessed by the current thread
+      struct LastCluster {
+        size_t generation{};
+        SimplexId id{-1};
+        std::shared_ptr<ImplicitCluster> cluster{};
+      };
+      thread_local LastCluster last{};
+      if(last.generation == cacheGeneration_ && last.id == nodeId) {
+        return last.cluster;
+      }
+
+      auto cluster = cache_.get(nodeId);
+      if(cluster == nullptr) {
+        cluster = std::make_shared<ImplicitCluster>(nodeId);
+        // the capacity is a number of clusters
+        if(!cache_.insert(nodeId, cluster, 1)) {
+          // inserted by another thread in the meantime
+          auto other = cache_.get(nodeId);
+          if(other != nullptr) {
+            cluster = std::move(other);
           }
-          cacheMaps_[threadId].erase(caches_[threadId].back().nid);
-          caches_[threadId].pop_back();
         }
-        caches_[threadId].push_front(ImplicitCluster(nodeId));
-        cacheMaps_[threadId][nodeId] = caches_[threadId].begin();
       }
-      return &(*cacheMaps_[threadId][nodeId]);
+
+      last.generation = cacheGeneration_;
+      last.id = nodeId;
+      last.cluster = cluster;
+      return cluster;
     }
 
+    using RELATION = ImplicitCluster::RELATION;
+
+    /**
+     * Compute a relation of the node with the given function, once, even
+     * if the node is shared by several threads.
+     */
+    template <typename Builder>
+    inline void expandCluster(ImplicitCluster *const nodePtr,
+                              const RELATION relation,
+                              const Builder &builder) const {
+      std::call_once(
+        nodePtr->expanded_[static_cast<size_t>(relation)], [&]() {
+          // nested expansions are timed by the outermost one
+          thread_local int depth{};
+          Timer t;
+          depth++;
+          builder();
+          depth--;
+          expansions_.number++;
+          if(depth == 0) {
+            expansions_.time += static_cast<size_t>(t.getElapsedTime() * 1e6);
+          }
+        });
+    }
+
+    /**
+     * Compute a relation of the node, once.
+     */
+    void expandCluster(ImplicitCluster *const nodePtr,
+                       const RELATION relation) const;
+
     /**
      * Build the internal edge list in the node.
      */
@@ -1717,11 +1796,29 @@ namespace ttk {
     std::shared_ptr<CellArray> cellArray_;
     std::vector<std::vector<SimplexId>> externalCells_;
 
-    // Cache system
-    size_t cacheSize_;
-    mutable std::vector<std::list<ImplicitCluster>> caches_;
-    mutable std::vector<
-      boost::unordered_map<SimplexId, std::list<ImplicitCluster>::iterator>>
-      cacheMaps_;
+    // Cache system, shared by all threads
+    static size_t nextCacheGeneration();
+
+    struct ExpansionStatistics {
+      std::atomic<size_t> number{};
+      // microseconds
+      std::atomic<size_t> time{};
+
+      ExpansionStatistics() = default;
+      ExpansionStatistics(const ExpansionStatistics &) {
+      }
+      ExpansionStatistics &operator=(const ExpansionStatistics &) {
+        return *this;
+      }
+      inline void reset() {
+        number = 0;
+        time = 0;
+      }
+    };
+
+    size_t cacheSize_{std::numeric_limits<size_t>::max()};
+    size_t cacheGeneration_{};
+    mutable LRUCache<SimplexId, ImplicitCluster> cache_{cacheSize_};
+    mutable ExpansionStatistics expansions_{};
   };
 } // namespace ttk
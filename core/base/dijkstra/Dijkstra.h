@@ -3,10 +3,12 @@
 #include <Geometry.h>
 #include <Triangulation.h>
 
+#include <algorithm>
 #include <array>
 #include <functional>
 #include <limits>
 #include <queue>
+#include <tuple>
 
 namespace ttk {
   namespace Dijkstra {
@@ -112,5 +114,305 @@ namespace ttk {
       return 0;
     }
 
+    /**
+     * @brief Compute the shortest paths from a set of sources with a single
+     * priority queue
+     *
+     * Every vertex is labelled with the index (in sources) of its closest
+     * source, ties being broken towards the smallest index. This gives the
+     * same result as taking the minimum over one shortest path computation
+     * per source, with memory linear in the number of vertices.
+     *
+     * @param[in] sources Source vertices
+     * @param[in] triangulation Access to neighbor vertices
+     * @param[out] outputDists Distance to the closest source
+     * @param[out] outputLabels Index of the closest source in sources
+     * @param[out] outputOrigins Closest source vertex (optional)
+     *
+     * @return 0 in case of success
+     */
+    template <typename T,
+              typename triangulationType = ttk::AbstractTriangulation>
+    int multiSourceShortestPath(const std::vector<SimplexId> &sources,
+                                const triangulationType &triangulation,
+                                T *const outputDists,
+                                SimplexId *const outputLabels,
+                                SimplexId *const outputOrigins = nullptr) {
+
+      const SimplexId vertexNumber = triangulation.getNumberOfVertices();
+      std::fill(outputDists, outputDists + vertexNumber,
+                std::numeric_limits<T>::infinity());
+      std::fill(outputLabels, outputLabels + vertexNumber, -1);
+
+      // (distance, label, vertex): ties are popped by increasing label
+      using pq_t = std::tuple<T, SimplexId, SimplexId>;
+      std::priority_queue<pq_t, std::vector<pq_t>, std::greater<pq_t>> pq;
+
+      for(size_t i = 0; i < sources.size(); ++i) {
+        const auto s = sources[i];
+        if(s < 0 || s >= vertexNumber) {
+          return 1;
+        }
+        if(outputLabels[s] == -1) {
+          outputDists[s] = T(0.0F);
+          outputLabels[s] = i;
+          pq.emplace(T(0.0F), i, s);
+        }
+      }
+
+      while(!pq.empty()) {
+        const auto elem = pq.top();
+        pq.pop();
+        const auto vert = std::get<2>(elem);
+        // skip outdated entries
+        if(std::get<0>(elem) != outputDists[vert]
+           || std::get<1>(elem) != outputLabels[vert]) {
+          continue;
+        }
+
+        std::array<float, 3> vCoords{};
+        triangulation.getVertexPoint(vert, vCoords[0], vCoords[1], vCoords[2]);
+
+        const auto nneigh = triangulation.getVertexNeighborNumber(vert);
+        for(SimplexId i = 0; i < nneigh; i++) {
+          SimplexId neigh{};
+          triangulation.getVertexNeighbor(vert, i, neigh);
+          std::array<float, 3> nCoords{};
+          triangulation.getVertexPoint(
+            neigh, nCoords[0], nCoords[1], nCoords[2]);
+          const T distVN = Geometry::distance(vCoords.data(), nCoords.data());
+          const T newDist = outputDists[vert] + distVN;
+          if(newDist < outputDists[neigh]
+             || (newDist == outputDists[neigh]
+                 && outputLabels[vert] < outputLabels[neigh])) {
+            outputDists[neigh] = newDist;
+            outputLabels[neigh] = outputLabels[vert];
+            pq.emplace(newDist, outputLabels[neigh], neigh);
+          }
+        }
+      }
+
+      if(outputOrigins != nullptr) {
+        for(SimplexId i = 0; i < vertexNumber; ++i) {
+          outputOrigins[i]
+            = outputLabels[i] == -1 ? -1 : sources[outputLabels[i]];
+        }
+      }
+
+      return 0;
+    }
+
+    /**
+     * @brief Parallel multi-source shortest paths (delta-stepping)
+     *
+     * Vertices are processed by buckets of width delta; the vertices of
+     * the current bucket are relaxed in parallel, and the relaxation
+     * requests are then applied by the thread owning their target vertex,
+     * until the bucket stays empty. The output is identical to
+     * multiSourceShortestPath().
+     *
+     * @param[in] sources Source vertices
+     * @param[in] triangulation Access to neighbor vertices
+     * @param[out] outputDists Distance to the closest source
+     * @param[out] outputLabels Index of the closest source in sources
+     * @param[out] outputOrigins Closest source vertex (optional)
+     * @param[in] delta Bucket width (mean edge length if not positive)
+     * @param[in] nThreads Number of threads
+     *
+     * @return 0 in case of success
+     */
+    template <typename T,
+              typename triangulationType = ttk::AbstractTriangulation>
+    int deltaSteppingShortestPath(const std::vector<SimplexId> &sources,
+                                  const triangulationType &triangulation,
+                                  T *const outputDists,
+                                  SimplexId *const outputLabels,
+                                  SimplexId *const outputOrigins = nullptr,
+                                  T delta = T(0.0F),
+                                  int nThreads = 1) {
+
+#ifndef TTK_ENABLE_OPENMP
+      nThreads = 1;
+#endif // TTK_ENABLE_OPENMP
+
+      const SimplexId vertexNumber = triangulation.getNumberOfVertices();
+      constexpr size_t noBucket{std::numeric_limits<size_t>::max()};
+      // bucket in which each vertex is currently stored
+      std::vector<size_t> vertBucket(vertexNumber, noBucket);
+
+      const auto edgeLength = [&triangulation](const SimplexId a,
+                                               const SimplexId b) {
+        std::array<float, 3> aCoords{}, bCoords{};
+        triangulation.getVertexPoint(a, aCoords[0], aCoords[1], aCoords[2]);
+        triangulation.getVertexPoint(b, bCoords[0], bCoords[1], bCoords[2]);
+        return static_cast<T>(
+          Geometry::distance(aCoords.data(), bCoords.data()));
+      };
+
+      if(!(delta > T(0.0F))) {
+        // mean edge length
+        double sum{};
+        size_t nEdges{};
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(nThreads) reduction(+ : sum, nEdges)
+#endif // TTK_ENABLE_OPENMP
+        for(SimplexId i = 0; i < vertexNumber; ++i) {
+          const auto nneigh = triangulation.getVertexNeighborNumber(i);
+          for(SimplexId j = 0; j < nneigh; ++j) {
+            SimplexId neigh{};
+            triangulation.getVertexNeighbor(i, j, neigh);
+            sum += edgeLength(i, neigh);
+          }
+          nEdges += nneigh;
+        }
+        delta = nEdges > 0 ? static_cast<T>(sum / nEdges) : T(1.0F);
+        if(!(delta > T(0.0F))) {
+          delta = T(1.0F);
+        }
+      }
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(nThreads)
+#endif // TTK_ENABLE_OPENMP
+      for(SimplexId i = 0; i < vertexNumber; ++i) {
+        outputDists[i] = std::numeric_limits<T>::infinity();
+        outputLabels[i] = -1;
+      }
+
+      std::vector<std::vector<SimplexId>> buckets(1);
+      for(size_t i = 0; i < sources.size(); ++i) {
+        const auto s = sources[i];
+        if(s < 0 || s >= vertexNumber) {
+          return 1;
+        }
+        if(outputLabels[s] == -1) {
+          outputDists[s] = T(0.0F);
+          outputLabels[s] = i;
+          vertBucket[s] = 0;
+          buckets[0].emplace_back(s);
+        }
+      }
+
+      struct Request {
+        SimplexId vertex;
+        SimplexId label;
+        T dist;
+      };
+      // requests[producer][owner], the owner of v being v % nThreads
+      std::vector<std::vector<std::vector<Request>>> requests(
+        nThreads, std::vector<std::vector<Request>>(nThreads));
+      // vertices moved to a new bucket, per owner
+      std::vector<std::vector<std::pair<size_t, SimplexId>>> moved(nThreads);
+
+      std::vector<SimplexId> frontier{};
+      size_t current{};
+      while(current < buckets.size()) {
+        if(buckets[current].empty()) {
+          ++current;
+          continue;
+        }
+        frontier.clear();
+        frontier.swap(buckets[current]);
+
+        // relax the edges of the frontier vertices
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel num_threads(nThreads)
+#endif // TTK_ENABLE_OPENMP
+        {
+#ifdef TTK_ENABLE_OPENMP
+          const int tid = omp_get_thread_num();
+#else
+          const int tid = 0;
+#endif // TTK_ENABLE_OPENMP
+          auto &localRequests = requests[tid];
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp for schedule(dynamic, 64)
+#endif // TTK_ENABLE_OPENMP
+          for(size_t i = 0; i < frontier.size(); ++i) {
+            const auto vert = frontier[i];
+            // outdated entry, the vertex was moved to a lower bucket
+            if(vertBucket[vert] != current) {
+              continue;
+            }
+            const auto nneigh = triangulation.getVertexNeighborNumber(vert);
+            for(SimplexId j = 0; j < nneigh; ++j) {
+              SimplexId neigh{};
+              triangulation.getVertexNeighbor(vert, j, neigh);
+              const T newDist = outputDists[vert] + edgeLength(vert, neigh);
+              if(newDist < outputDists[neigh]
+                 || (newDist == outputDists[neigh]
+                     && outputLabels[vert] < outputLabels[neigh])) {
+                localRequests[neigh % nThreads].emplace_back(
+                  Request{neigh, outputLabels[vert], newDist});
+              }
+            }
+          }
+
+          // frontier vertices leave the current bucket
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp for
+#endif // TTK_ENABLE_OPENMP
+          for(size_t i = 0; i < frontier.size(); ++i) {
+            if(vertBucket[frontier[i]] == current) {
+              vertBucket[frontier[i]] = noBucket;
+            }
+          }
+
+          // apply the requests targeting the vertices owned by this thread
+          auto &localMoved = moved[tid];
+          for(int p = 0; p < nThreads; ++p) {
+            for(const auto &req : requests[p][tid]) {
+              const auto v = req.vertex;
+              if(req.dist < outputDists[v]
+                 || (req.dist == outputDists[v]
+                     && req.label < outputLabels[v])) {
+                outputDists[v] = req.dist;
+                outputLabels[v] = req.label;
+                const auto b = static_cast<size_t>(req.dist / delta);
+                if(vertBucket[v] != b) {
+                  vertBucket[v] = b;
+                  localMoved.emplace_back(b, v);
+                }
+              }
+            }
+          }
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp barrier
+#endif // TTK_ENABLE_OPENMP
+          for(int o = 0; o < nThreads; ++o) {
+            requests[tid][o].clear();
+          }
+        }
+
+        // insert the moved vertices in their (new) bucket
+        for(auto &localMoved : moved) {
+          for(const auto &m : localMoved) {
+            // vertices moved twice are only kept in their last bucket
+            if(vertBucket[m.second] != m.first) {
+              continue;
+            }
+            if(m.first >= buckets.size()) {
+              buckets.resize(m.first + 1);
+            }
+            buckets[m.first].emplace_back(m.second);
+          }
+          localMoved.clear();
+        }
+      }
+
+      if(outputOrigins != nullptr) {
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(nThreads)
+#endif // TTK_ENABLE_OPENMP
+        for(SimplexId i = 0; i < vertexNumber; ++i) {
+          outputOrigins[i]
+            = outputLabels[i] == -1 ? -1 : sources[outputLabels[i]];
+        }
+      }
+
+      return 0;
+    }
+
   } // namespace Dijkstra
 } // namespace ttk
@@ -1,4 +1,11 @@
 #include <DiscreteGradient.h>
+#include <MappedFile.h>
+
+#include <sys/stat.h>
+
+#include <cstring>
+#include <fstream>
+#include <random>
 
 using namespace std;
 using namespace ttk;
@@ -12,7 +19,8 @@ int DiscreteGradient::getNumberOfDimensions() const {
   return dimensionality_ + 1;
 }
 
-void DiscreteGradient::initMemory(const AbstractTriangulation &triangulation) {
+void DiscreteGradient::initMemory(const AbstractTriangulation &triangulation,
+                                  const bool packed) {
 
   Timer tm{};
   const int numberOfDimensions = this->getNumberOfDimensions();
@@ -25,10 +33,12 @@ void DiscreteGradient::initMemory(const AbstractTriangulation &triangulation) {
 
   // clear & init gradient memory
   for(int i = 0; i < dimensionality_; ++i) {
-    (*gradient_)[2 * i].clear();
-    (*gradient_)[2 * i].resize(numberOfCells[i], -1);
-    (*gradient_)[2 * i + 1].clear();
-    (*gradient_)[2 * i + 1].resize(numberOfCells[i + 1], -1);
+    (*gradient_)[2 * i].init(numberOfCells[i], packed);
+    (*gradient_)[2 * i + 1].init(numberOfCells[i + 1], packed);
+  }
+  // unused arrays follow the same layout (see storesLocalIds())
+  for(size_t i = 2 * dimensionality_; i < gradient_->size(); ++i) {
+    (*gradient_)[i].init(0, packed);
   }
 
   std::vector<std::vector<std::string>> rows{
@@ -46,11 +56,213 @@ void DiscreteGradient::initMemory(const AbstractTriangulation &triangulation) {
       std::vector<std::string>{"#Tetras", std::to_string(numberOfCells[3])});
   }
 
+  if(packed) {
+    rows.emplace_back(std::vector<std::string>{"Layout", "4 bits per cell"});
+  }
+
   this->printMsg(rows);
   this->printMsg("Initialized discrete gradient memory", 1.0,
                  tm.getElapsedTime(), this->threadNumber_);
 }
 
+namespace {
+  // header of discrete gradient cache files
+  struct CacheFileHeader {
+    char magic[8]{'T', 'T', 'K', 'D', 'C', 'G', '\0', '\0'};
+    uint32_t version{3};
+    uint32_t idSize{};
+    // the two independent hashes of the offset field
+    uint64_t key{};
+    uint64_t check{};
+    uint64_t fingerprint{};
+    // 1 if the arrays use the 4 bits per cell layout
+    uint64_t packed{};
+    // number of cells per array
+    std::array<uint64_t, 6> sizes{};
+  };
+
+  // size in bytes of a serialized gradient array
+  inline size_t arrayDataSize(const CacheFileHeader &header, const size_t i) {
+    return header.packed != 0 ? (header.sizes[i] + 1) / 2
+                              : header.sizes[i] * header.idSize;
+  }
+} // namespace
+
+std::string DiscreteGradient::getCacheFileName(
+  const std::string &directory,
+  const AbstractTriangulation::gradientKeyType &key,
+  const uint64_t fingerprint) const {
+
+  std::stringstream fileName{};
+  fileName << directory << "/ttkDiscreteGradient_" << std::hex << key.first
+           << "_" << fingerprint << ".bin";
+  return fileName.str();
+}
+
+int DiscreteGradient::writeCacheFile(
+  const std::string &fileName,
+  const AbstractTriangulation::gradientKeyType &key,
+  const uint64_t fingerprint,
+  const AbstractTriangulation::gradientType &gradient) const {
+
+  Timer tm{};
+
+  CacheFileHeader header{};
+  header.idSize = sizeof(AbstractTriangulation::gradIdType);
+  header.key = key.first;
+  header.check = key.second;
+  header.fingerprint = fingerprint;
+  header.packed = gradient[0].isPacked() ? 1 : 0;
+  for(size_t i = 0; i < header.sizes.size(); ++i) {
+    header.sizes[i] = gradient[i].size();
+  }
+
+  // write to a temporary file, then rename it so that concurrent
+  // readers never see a partial file
+  const auto tmpFileName{fileName + ".tmp"
+                         + std::to_string(std::random_device{}())};
+  std::ofstream out(tmpFileName, std::ios::out | std::ios::binary);
+  if(!out) {
+    this->printWrn("Could not write gradient cache file `" + fileName + "'");
+    return -1;
+  }
+  out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  for(const auto &vec : gradient) {
+    out.write(vec.data(), vec.dataSize());
+  }
+  out.close();
+
+  if(!out || std::rename(tmpFileName.data(), fileName.data()) != 0) {
+    OsCall::rmFile(tmpFileName);
+    this->printWrn("Could not write gradient cache file `" + fileName + "'");
+    return -2;
+  }
+
+  this->printMsg("Wrote discrete gradient to `" + fileName + "'", 1.0,
+                 tm.getElapsedTime(), debug::LineMode::NEW,
+                 debug::Priority::DETAIL);
+  return 0;
+}
+
+std::shared_ptr<AbstractTriangulation::gradientType>
+  DiscreteGradient::readCacheFile(
+    const std::string &fileName,
+    const AbstractTriangulation::gradientKeyType &key,
+    const uint64_t fingerprint) const {
+
+  auto file{std::make_shared<MappedFile>()};
+  if(file->open(fileName) != 0) {
+    return {};
+  }
+
+  CacheFileHeader header{}, expected{};
+  expected.idSize = sizeof(AbstractTriangulation::gradIdType);
+  if(file->size() < sizeof(header)) {
+    this->printWrn("Ignoring truncated gradient cache file `" + fileName
+                   + "'");
+    return {};
+  }
+  std::memcpy(&header, file->data(), sizeof(header));
+  if(std::memcmp(header.magic, expected.magic, sizeof(header.magic)) != 0
+     || header.version != expected.version
+     || header.idSize != expected.idSize || header.key != key.first
+     || header.check != key.second || header.fingerprint != fingerprint
+     || header.packed > 1) {
+    this->printWrn("Ignoring mismatching gradient cache file `" + fileName
+                   + "'");
+    return {};
+  }
+
+  size_t fileSize{sizeof(header)};
+  for(size_t i = 0; i < header.sizes.size(); ++i) {
+    fileSize += arrayDataSize(header, i);
+  }
+  if(file->size() != fileSize) {
+    this->printWrn("Ignoring truncated gradient cache file `" + fileName
+                   + "'");
+    return {};
+  }
+
+  // the arrays read the mapping directly: only the pages that are
+  // accessed are loaded
+  auto res{std::make_shared<AbstractTriangulation::gradientType>()};
+  size_t offset{sizeof(header)};
+  for(size_t i = 0; i < res->size(); ++i) {
+    (*res)[i].map(file, offset, header.sizes[i], header.packed != 0);
+    offset += arrayDataSize(header, i);
+  }
+
+  return res;
+}
+
+void DiscreteGradient::spillCacheEntry(
+  const std::string &directory,
+  const AbstractTriangulation::gradientKeyType &key,
+  const uint64_t fingerprint,
+  const size_t capacity,
+  const AbstractTriangulation::gradientType &gradient) const {
+
+  if(gradient[0].isMapped()) {
+    // reloaded from the cache directory
+    return;
+  }
+  // an existing file is replaced: it did not match, or it was written
+  // concurrently by another process with the same content
+  const auto fileName{this->getCacheFileName(directory, key, fingerprint)};
+  if(this->writeCacheFile(fileName, key, fingerprint, gradient) == 0) {
+    this->pruneCacheDirectory(directory, capacity, fileName);
+  }
+}
+
+void DiscreteGradient::pruneCacheDirectory(const std::string &directory,
+                                           const size_t capacity,
+                                           const std::string &keptFile) const {
+
+  struct CacheFile {
+    std::string name;
+    size_t size;
+    time_t mtime;
+  };
+  std::vector<CacheFile> files{};
+  size_t totalSize{};
+
+  const std::string prefix{directory + "/ttkDiscreteGradient_"};
+  for(const auto &name : OsCall::listFilesInDirectory(directory, "bin")) {
+    struct stat info {};
+    if(name.compare(0, prefix.size(), prefix) != 0
+       || stat(name.data(), &info) != 0) {
+      continue;
+    }
+    files.emplace_back(CacheFile{
+      name, static_cast<size_t>(info.st_size), info.st_mtime});
+    totalSize += files.back().size;
+  }
+  if(totalSize <= capacity) {
+    return;
+  }
+
+  // delete the least recently written files first
+  std::sort(files.begin(), files.end(),
+            [](const CacheFile &a, const CacheFile &b) {
+              return a.mtime < b.mtime;
+            });
+  size_t nRemoved{};
+  for(const auto &file : files) {
+    if(totalSize <= capacity) {
+      break;
+    }
+    // another process may have already removed it
+    if(file.name != keptFile && OsCall::rmFile(file.name) == 0) {
+      totalSize -= file.size;
+      nRemoved++;
+    }
+  }
+
+  this->printMsg("Removed " + std::to_string(nRemoved)
+                   + " gradient cache file(s) from `" + directory + "'",
+                 debug::Priority::DETAIL);
+}
+
 std::pair<size_t, SimplexId>
   DiscreteGradient::numUnpairedFaces(const CellExt &c,
                                      const lowerStarType &ls) const {
@@ -238,21 +450,21 @@ int DiscreteGradient::setManifoldSize(
 void DiscreteGradient::setCellToGhost(const int cellDim,
                                       const SimplexId cellId) {
   if(cellDim == 0) {
-    (*gradient_)[0][cellId] = GHOST_GRADIENT;
+    (*gradient_)[0].set(cellId, GHOST_GRADIENT);
   }
 
   if(cellDim == 1) {
-    (*gradient_)[1][cellId] = GHOST_GRADIENT;
-    (*gradient_)[2][cellId] = GHOST_GRADIENT;
+    (*gradient_)[1].set(cellId, GHOST_GRADIENT);
+    (*gradient_)[2].set(cellId, GHOST_GRADIENT);
   }
 
   if(cellDim == 2) {
-    (*gradient_)[3][cellId] = GHOST_GRADIENT;
-    (*gradient_)[4][cellId] = GHOST_GRADIENT;
+    (*gradient_)[3].set(cellId, GHOST_GRADIENT);
+    (*gradient_)[4].set(cellId, GHOST_GRADIENT);
   }
 
   if(cellDim == 3) {
-    (*gradient_)[5][cellId] = GHOST_GRADIENT;
+    (*gradient_)[5].set(cellId, GHOST_GRADIENT);
   }
 }
 #endif
@@ -16,6 +16,7 @@
 #pragma once
 
 // base code includes
+#include <ContentHash.h>
 #include <Geometry.h>
 #include <Triangulation.h>
 #include <VisitedMask.h>
@@ -110,6 +111,10 @@ triangulation.
        * (often provided by ttkUtils::GetVoidPointer()), the second
        * one is a timestamp representing the last modification time of
        * the scalar field (often provided by vtkObject::GetMTime()).
+       *
+       * The gradient cache is only used if a scalar field is
+       * provided. Cache entries are keyed on a hash of the offset
+       * field content.
        */
       inline void setInputScalarField(const void *const data,
                                       const size_t mTime) {
@@ -151,13 +156,98 @@ triangulation.
         triangulation.gradientCache_.clear();
       }
 
+      /**
+       * @brief Set the memory budget (in bytes) of the in-memory
+       * gradient cache of the given triangulation
+       *
+       * There is no budget by default: the cache only holds a
+       * bounded number of gradients (see setCacheMaxEntries()).
+       */
+      static inline void
+        setCacheCapacity(const AbstractTriangulation &triangulation,
+                         const size_t capacity) {
+        triangulation.gradientCache_.setCapacity(capacity);
+      }
+
+      /**
+       * @brief Set the maximum number of gradients in the in-memory
+       * gradient cache of the given triangulation (8 by default)
+       */
+      static inline void
+        setCacheMaxEntries(const AbstractTriangulation &triangulation,
+                           const size_t maxEntries) {
+        triangulation.gradientCache_.setMaxEntries(maxEntries);
+      }
+
+      /**
+       * @brief Persist the gradient cache of the given triangulation
+       * in a directory
+       *
+       * Gradients evicted from the in-memory cache (or still stored
+       * when the triangulation is destroyed) are written to a file in
+       * this directory. Gradients missing from the in-memory cache
+       * are reloaded from there by mapping the file: its pages are
+       * only read when accessed. Use an empty string to disable the
+       * on-disk cache.
+       */
+      static inline void
+        setCacheDirectory(const AbstractTriangulation &triangulation,
+                          const std::string &directory) {
+        triangulation.gradientCacheDirectory_ = directory;
+        // set again by buildGradient() with the new directory
+        triangulation.gradientCache_.setEvictionCallback(nullptr);
+      }
+
+      /**
+       * @brief Set the size budget (in bytes) of the on-disk
+       * gradient cache of the given triangulation
+       *
+       * After each write, the least recently written files of the
+       * cache directory are deleted until their total size fits in
+       * this budget (1GiB by default).
+       */
+      static inline void
+        setCacheDirectoryCapacity(const AbstractTriangulation &triangulation,
+                                  const size_t capacity) {
+        triangulation.gradientCacheDirectoryCapacity_ = capacity;
+      }
+
       /**
        * @brief Use local storage instead of cache
+       *
+       * A gradient fetched from the cache is shared with the other
+       * instances using the same input: it is copied in local
+       * storage so that it can be modified in place.
        */
       inline void setLocalGradient() {
+        if(this->cachedGradient_ != nullptr) {
+          this->localGradient_ = *this->cachedGradient_;
+          this->cachedGradient_.reset();
+        }
         this->gradient_ = &this->localGradient_;
       }
 
+      /**
+       * @brief Store the gradient on implicit and periodic grids as
+       * local indices packed in 4 bits per cell (enabled by default)
+       */
+      inline void setUseCompactGradient(const bool state) {
+        this->UseCompactGradient = state;
+      }
+
+      /**
+       * @brief Memory footprint of the gradient internal structure
+       */
+      inline size_t getGradientMemory() const {
+        size_t res{};
+        if(this->gradient_ != nullptr) {
+          for(const auto &vec : *this->gradient_) {
+            res += vec.memoryUsage();
+          }
+        }
+        return res;
+      }
+
       /**
        * Set the input offset function.
        *
@@ -364,6 +454,63 @@ in the gradient.
                             const triangulationType &triangulation) const;
 
     private:
+      /**
+       * @brief Hash of the triangulation connectivity, computed once
+       * per triangulation object
+       */
+      template <typename triangulationType>
+      uint64_t getTriangulationFingerprint(
+        const triangulationType &triangulation) const;
+
+      /**
+       * @brief Name of the file storing the gradient for the given key
+       */
+      std::string
+        getCacheFileName(const std::string &directory,
+                         const AbstractTriangulation::gradientKeyType &key,
+                         const uint64_t fingerprint) const;
+
+      /**
+       * @brief Write a gradient in a cache file
+       */
+      int writeCacheFile(
+        const std::string &fileName,
+        const AbstractTriangulation::gradientKeyType &key,
+        const uint64_t fingerprint,
+        const AbstractTriangulation::gradientType &gradient) const;
+
+      /**
+       * @brief Map a gradient from a cache file
+       *
+       * @return nullptr if the file does not exist or does not match
+       * (both hashes of the key are checked)
+       */
+      std::shared_ptr<AbstractTriangulation::gradientType>
+        readCacheFile(const std::string &fileName,
+                      const AbstractTriangulation::gradientKeyType &key,
+                      const uint64_t fingerprint) const;
+
+      /**
+       * @brief Write a gradient evicted from the in-memory cache in
+       * the cache directory, unless it was mapped from there
+       */
+      void spillCacheEntry(
+        const std::string &directory,
+        const AbstractTriangulation::gradientKeyType &key,
+        const uint64_t fingerprint,
+        const size_t capacity,
+        const AbstractTriangulation::gradientType &gradient) const;
+
+      /**
+       * @brief Delete the least recently written cache files of a
+       * directory until their total size fits in a byte budget
+       *
+       * @param[in] keptFile File that should not be deleted
+       */
+      void pruneCacheDirectory(const std::string &directory,
+                               const size_t capacity,
+                               const std::string &keptFile) const;
+
       /**
        * Type alias for lower stars of a given cell
        */
@@ -430,8 +577,33 @@ in the gradient.
 
       /**
        * @brief Initialize/Allocate discrete gradient memory
+       *
+       * @param[in] packed Use the 4 bits per cell layout
        */
-      void initMemory(const AbstractTriangulation &triangulation);
+      void initMemory(const AbstractTriangulation &triangulation,
+                      const bool packed);
+
+      /**
+       * @brief If the gradient stores indices local to the cell
+       * facets/cofacets instead of global cell identifiers
+       */
+      inline bool storesLocalIds() const {
+#ifdef TTK_ENABLE_DCG_OPTIMIZE_MEMORY
+        return true;
+#else
+        return (*this->gradient_)[0].isPacked();
+#endif // TTK_ENABLE_DCG_OPTIMIZE_MEMORY
+      }
+
+      /**
+       * @brief Store in the gradient the pair between a cell of
+       * dimension @p alphaDim and one of its cofacets
+       */
+      template <typename triangulationType>
+      void setGradientPair(const int alphaDim,
+                           const SimplexId alphaId,
+                           const SimplexId betaId,
+                           const triangulationType &triangulation) const;
 
     public:
       /**
@@ -472,14 +644,14 @@ gradient, false otherwise.
        */
       template <typename triangulationType>
       int reverseAscendingPath(const std::vector<Cell> &vpath,
-                               const triangulationType &triangulation) const;
+                               const triangulationType &triangulation);
 
       /**
        * Reverse the given descending VPath.
        */
       template <typename triangulationType>
       int reverseDescendingPath(const std::vector<Cell> &vpath,
-                                const triangulationType &triangulation) const;
+                                const triangulationType &triangulation);
 
       /**
        * Reverse the given ascending VPath restricted on a 2-separatrice.
@@ -487,7 +659,7 @@ gradient, false otherwise.
       template <typename triangulationType>
       int reverseAscendingPathOnWall(
         const std::vector<Cell> &vpath,
-        const triangulationType &triangulation) const;
+        const triangulationType &triangulation);
 
       /**
        * Reverse the given descending VPath restricted on a 2-separatrice.
@@ -495,18 +667,23 @@ gradient, false otherwise.
       template <typename triangulationType>
       int reverseDescendingPathOnWall(
         const std::vector<Cell> &vpath,
-        const triangulationType &triangulation) const;
+        const triangulationType &triangulation);
 
     protected:
       int dimensionality_{-1};
       SimplexId numberOfVertices_{};
+      bool UseCompactGradient{true};
 
       // spare storage (bypass cache) for gradient internal structure
       AbstractTriangulation::gradientType localGradient_{};
-      // cache key (scalar field pointer + timestamp)
-      AbstractTriangulation::gradientKeyType inputScalarField_{};
-      // pointer to either cache entry corresponding to inputScalarField_ or
-      // localGradient_ (if cache is bypassed)
+      // scalar field pointer + timestamp, only used to know whether a
+      // scalar field was provided
+      std::pair<const void *, size_t> inputScalarField_{};
+      // cache entry keyed on the content of inputOffsets_, kept alive
+      // even if evicted from the cache
+      std::shared_ptr<AbstractTriangulation::gradientType> cachedGradient_{};
+      // pointer to either cachedGradient_ or localGradient_ (if cache
+      // is bypassed)
       AbstractTriangulation::gradientType *gradient_{};
       const SimplexId *inputOffsets_{};
     };
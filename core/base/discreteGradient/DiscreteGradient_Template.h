@@ -33,41 +33,134 @@ dataType DiscreteGradient::getPersistence(
 }
 
 template <typename triangulationType>
-int DiscreteGradient::buildGradient(const triangulationType &triangulation,
-                                    bool bypassCache) {
+uint64_t DiscreteGradient::getTriangulationFingerprint(
+  const triangulationType &triangulation) const {
 
-  auto &cacheHandler = *triangulation.getGradientCacheHandler();
-  const auto findGradient
-    = [this, &cacheHandler]() -> AbstractTriangulation::gradientType * {
-    if(this->inputScalarField_.first == nullptr) {
-      return {};
-    }
-    return cacheHandler.get(this->inputScalarField_);
-  };
+  auto &fingerprint{triangulation.gradientCacheFingerprint_.value};
+  const auto cached{fingerprint.load()};
+  if(cached != 0) {
+    return cached;
+  }
+
+  const SimplexId nCells = triangulation.getNumberOfCells();
+  const SimplexId blockSize = 1 << 16;
+  const SimplexId nBlocks = (nCells + blockSize - 1) / blockSize;
+  std::vector<uint64_t> blockHashes(nBlocks);
 
 #ifdef TTK_ENABLE_OPENMP
-  if(!bypassCache && omp_in_parallel()) {
-    this->printWrn(
-      "buildGradient() called inside a parallel region, disabling cache...");
-    bypassCache = true;
-  }
+#pragma omp parallel num_threads(threadNumber_)
 #endif // TTK_ENABLE_OPENMP
+  {
+    std::vector<SimplexId> cellVertices{};
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp for
+#endif // TTK_ENABLE_OPENMP
+    for(SimplexId i = 0; i < nBlocks; ++i) {
+      cellVertices.clear();
+      const auto end = std::min(nCells, (i + 1) * blockSize);
+      for(SimplexId c = i * blockSize; c < end; ++c) {
+        const auto nVerts = triangulation.getCellVertexNumber(c);
+        for(SimplexId j = 0; j < nVerts; ++j) {
+          SimplexId v{};
+          triangulation.getCellVertex(c, j, v);
+          cellVertices.emplace_back(v);
+        }
+      }
+      blockHashes[i] = hash::hashBlock(
+        cellVertices.data(), cellVertices.size() * sizeof(SimplexId), i);
+    }
+  }
+
+  uint64_t res = hash::combine(
+    triangulation.getDimensionality(), triangulation.getNumberOfVertices());
+  for(const auto h : blockHashes) {
+    res = hash::combine(res, h);
+  }
+  // 0 means "not computed"; concurrent callers compute the same value
+  res = res != 0 ? res : 1;
+  fingerprint.store(res);
+
+  return res;
+}
+
+template <typename triangulationType>
+int DiscreteGradient::buildGradient(const triangulationType &triangulation,
+                                    bool bypassCache) {
+
+  auto &cacheHandler = *triangulation.getGradientCacheHandler();
+  // the cache is thread-safe: it can be used inside parallel regions
+  const bool useCache = !bypassCache && this->inputScalarField_.first != nullptr
+                        && this->inputOffsets_ != nullptr;
 
   // set member variables at each buildGradient() call
   this->dimensionality_ = triangulation.getCellVertexNumber(0) - 1;
   this->numberOfVertices_ = triangulation.getNumberOfVertices();
 
-  this->gradient_ = bypassCache ? &this->localGradient_ : findGradient();
-  if(this->gradient_ == nullptr || bypassCache) {
+  // cache key: two independent hashes of the offset field content,
+  // so that a collision on both is needed to get a wrong gradient
+  AbstractTriangulation::gradientKeyType key{};
+  if(useCache) {
+    key = hash::hashBufferPair(this->inputOffsets_,
+                               this->numberOfVertices_ * sizeof(SimplexId),
+                               this->threadNumber_);
+  }
 
-    if(!bypassCache) {
-      // add new cache entry
-      cacheHandler.insert(this->inputScalarField_, {});
-      this->gradient_ = cacheHandler.get(this->inputScalarField_);
+  this->cachedGradient_ = useCache ? cacheHandler.get(key) : nullptr;
+
+  // on-disk cache, if any: filled by the evicted entries
+  const auto &directory{triangulation.gradientCacheDirectory_};
+  std::string fileName{};
+  if(useCache && !directory.empty()) {
+    const auto fingerprint{this->getTriangulationFingerprint(triangulation)};
+    const auto capacity{triangulation.gradientCacheDirectoryCapacity_};
+    const auto debugLevel{this->debugLevel_};
+    cacheHandler.setEvictionCallback(
+      [directory, fingerprint, capacity, debugLevel](
+        const AbstractTriangulation::gradientKeyType &evictedKey,
+        const std::shared_ptr<AbstractTriangulation::gradientType>
+          &gradient) {
+        DiscreteGradient dg{};
+        dg.setDebugLevel(debugLevel);
+        dg.spillCacheEntry(
+          directory, evictedKey, fingerprint, capacity, *gradient);
+      });
+    fileName = this->getCacheFileName(directory, key, fingerprint);
+  }
+
+  if(this->cachedGradient_ == nullptr && !fileName.empty()) {
+    Timer tm{};
+    this->cachedGradient_ = this->readCacheFile(
+      fileName, key, this->getTriangulationFingerprint(triangulation));
+    if(this->cachedGradient_ != nullptr) {
+      this->gradient_ = this->cachedGradient_.get();
+      cacheHandler.insert(
+        key, this->cachedGradient_, this->getGradientMemory());
+      this->printMsg("Mapped discrete gradient from `" + fileName + "'", 1.0,
+                     tm.getElapsedTime(), this->threadNumber_);
+      return 0;
+    }
+  }
+
+  if(this->cachedGradient_ == nullptr) {
+
+    if(useCache) {
+      // new cache entry, inserted once filled
+      this->cachedGradient_
+        = std::make_shared<AbstractTriangulation::gradientType>();
+      this->gradient_ = this->cachedGradient_.get();
+    } else {
+      this->gradient_ = &this->localGradient_;
     }
 
+    // on implicit grids, a cell has at most 14 facets/cofacets: the
+    // index of the paired cell can be packed in 4 bits
+    constexpr bool isImplicitGrid{
+      std::is_base_of<ImplicitTriangulation, triangulationType>::value
+      || std::is_base_of<PeriodicImplicitTriangulation,
+                         triangulationType>::value};
+
     // allocate gradient memory
-    this->initMemory(triangulation);
+    this->initMemory(triangulation, isImplicitGrid && this->UseCompactGradient);
 
     Timer tm{};
     // compute gradient pairs
@@ -75,10 +168,25 @@ int DiscreteGradient::buildGradient(const triangulationType &triangulation,
 
     this->printMsg(
       "Built discrete gradient", 1.0, tm.getElapsedTime(), this->threadNumber_);
+
+    // written to the cache directory only once evicted
+    if(useCache) {
+      cacheHandler.insert(
+        key, this->cachedGradient_, this->getGradientMemory());
+    }
   } else {
+    this->gradient_ = this->cachedGradient_.get();
     this->printMsg("Fetched cached discrete gradient");
   }
 
+  if(useCache) {
+    const auto stats{cacheHandler.getStatistics()};
+    this->printMsg("Gradient cache: " + std::to_string(stats.hits) + " hits, "
+                     + std::to_string(stats.misses) + " misses, "
+                     + std::to_string(stats.evictions) + " evictions",
+                   debug::Priority::DETAIL);
+  }
+
   return 0;
 }
 
@@ -389,69 +497,85 @@ inline void
 template <typename triangulationType>
 inline void DiscreteGradient::pairCells(
   CellExt &alpha, CellExt &beta, const triangulationType &triangulation) {
-#ifdef TTK_ENABLE_DCG_OPTIMIZE_MEMORY
-  char localBId{0}, localAId{0};
-  SimplexId a{}, b{};
+  this->setGradientPair(alpha.dim_, alpha.id_, beta.id_, triangulation);
+  alpha.paired_ = true;
+  beta.paired_ = true;
+}
 
-  if(beta.dim_ == 1) {
+template <typename triangulationType>
+void DiscreteGradient::setGradientPair(
+  const int alphaDim,
+  const SimplexId alphaId,
+  const SimplexId betaId,
+  const triangulationType &triangulation) const {
+
+  auto &facetToCofacet{(*gradient_)[2 * alphaDim]};
+  auto &cofacetToFacet{(*gradient_)[2 * alphaDim + 1]};
+
+  if(!this->storesLocalIds()) {
+    facetToCofacet.set(alphaId, betaId);
+    cofacetToFacet.set(betaId, alphaId);
+    return;
+  }
+
+  // store the index of beta in the cofacets of alpha and the index of
+  // alpha in the facets of beta, with the same triangulation queries
+  // as getPairedCell()
+  SimplexId localAId{0}, localBId{0};
+  SimplexId tmp{};
 
+  if(alphaDim == 0) {
     for(SimplexId i = 0; i < 2; ++i) {
-      triangulation.getEdgeVertex(beta.id_, i, a);
-      if(a == alpha.id_) {
+      triangulation.getEdgeVertex(betaId, i, tmp);
+      if(tmp == alphaId) {
         localAId = i;
         break;
       }
     }
-    const auto nedges = triangulation.getVertexEdgeNumber(alpha.id_);
+    const auto nedges = triangulation.getVertexEdgeNumber(alphaId);
     for(SimplexId i = 0; i < nedges; ++i) {
-      triangulation.getVertexEdge(alpha.id_, i, b);
-      if(b == beta.id_) {
+      triangulation.getVertexEdge(alphaId, i, tmp);
+      if(tmp == betaId) {
         localBId = i;
         break;
       }
     }
-  } else if(beta.dim_ == 2) {
+  } else if(alphaDim == 1) {
     for(SimplexId i = 0; i < 3; ++i) {
-      triangulation.getTriangleEdge(beta.id_, i, a);
-      if(a == alpha.id_) {
+      triangulation.getTriangleEdge(betaId, i, tmp);
+      if(tmp == alphaId) {
         localAId = i;
         break;
       }
     }
-    const auto ntri = triangulation.getEdgeTriangleNumber(alpha.id_);
+    const auto ntri = triangulation.getEdgeTriangleNumber(alphaId);
     for(SimplexId i = 0; i < ntri; ++i) {
-      triangulation.getEdgeTriangle(alpha.id_, i, b);
-      if(b == beta.id_) {
+      triangulation.getEdgeTriangle(alphaId, i, tmp);
+      if(tmp == betaId) {
         localBId = i;
         break;
       }
     }
   } else {
     for(SimplexId i = 0; i < 4; ++i) {
-      triangulation.getCellTriangle(beta.id_, i, a);
-      if(a == alpha.id_) {
+      triangulation.getCellTriangle(betaId, i, tmp);
+      if(tmp == alphaId) {
         localAId = i;
         break;
       }
     }
-    const auto ntetra = triangulation.getTriangleStarNumber(alpha.id_);
+    const auto ntetra = triangulation.getTriangleStarNumber(alphaId);
     for(SimplexId i = 0; i < ntetra; ++i) {
-      triangulation.getTriangleStar(alpha.id_, i, b);
-      if(b == beta.id_) {
+      triangulation.getTriangleStar(alphaId, i, tmp);
+      if(tmp == betaId) {
         localBId = i;
         break;
       }
     }
   }
-  (*gradient_)[2 * alpha.dim_][alpha.id_] = localBId;
-  (*gradient_)[2 * alpha.dim_ + 1][beta.id_] = localAId;
-#else
-  TTK_FORCE_USE(triangulation);
-  (*gradient_)[2 * alpha.dim_][alpha.id_] = beta.id_;
-  (*gradient_)[2 * alpha.dim_ + 1][beta.id_] = alpha.id_;
-#endif // TTK_ENABLE_DCG_OPTIMIZE_MEMORY
-  alpha.paired_ = true;
-  beta.paired_ = true;
+
+  facetToCofacet.set(alphaId, localBId);
+  cofacetToFacet.set(betaId, localAId);
 }
 
 template <typename triangulationType>
@@ -640,85 +764,46 @@ SimplexId
     std::is_base_of<AbstractTriangulation, triangulationType>(),
     "triangulationType should be an AbstractTriangulation derivative");
 
-#ifndef TTK_ENABLE_DCG_OPTIMIZE_MEMORY
-  TTK_FORCE_USE(triangulation);
-#endif // !TTK_ENABLE_DCG_OPTIMIZE_MEMORY
-
   if((cell.dim_ > this->dimensionality_ - 1 && !isReverse)
      || (cell.dim_ > this->dimensionality_ && isReverse) || cell.dim_ < 0) {
     return -1;
   }
 
-  SimplexId id{-1};
-
-  if(cell.dim_ == 0) {
-    if(!isReverse) {
-#ifdef TTK_ENABLE_DCG_OPTIMIZE_MEMORY
-      const auto locId{(*gradient_)[0][cell.id_]};
-      if(locId != -1) {
-        triangulation.getVertexEdge(cell.id_, locId, id);
-      }
-#else
-      id = (*gradient_)[0][cell.id_];
-#endif
-    }
+  // index in the gradient array
+  const auto k{2 * cell.dim_ + (isReverse ? -1 : 0)};
+  if(k < 0 || k > 5) {
+    return -1;
   }
 
-  else if(cell.dim_ == 1) {
-    if(isReverse) {
-#ifdef TTK_ENABLE_DCG_OPTIMIZE_MEMORY
-      const auto locId{(*gradient_)[1][cell.id_]};
-      if(locId != -1) {
-        triangulation.getEdgeVertex(cell.id_, locId, id);
-      }
-#else
-      id = (*gradient_)[1][cell.id_];
-#endif
-    } else {
-#ifdef TTK_ENABLE_DCG_OPTIMIZE_MEMORY
-      const auto locId{(*gradient_)[2][cell.id_]};
-      if(locId != -1) {
-        triangulation.getEdgeTriangle(cell.id_, locId, id);
-      }
-#else
-      id = (*gradient_)[2][cell.id_];
-#endif
-    }
-  }
+  SimplexId id = (*gradient_)[k][cell.id_];
 
-  else if(cell.dim_ == 2) {
-    if(isReverse) {
-#ifdef TTK_ENABLE_DCG_OPTIMIZE_MEMORY
-      const auto locId{(*gradient_)[3][cell.id_]};
-      if(locId != -1) {
-        triangulation.getTriangleEdge(cell.id_, locId, id);
-      }
-#else
-      id = (*gradient_)[3][cell.id_];
-#endif
-    } else {
-#ifdef TTK_ENABLE_DCG_OPTIMIZE_MEMORY
-      const auto locId{(*gradient_)[4][cell.id_]};
-      if(locId != -1) {
-        triangulation.getTriangleStar(cell.id_, locId, id);
-      }
-#else
-      id = (*gradient_)[4][cell.id_];
-#endif
-    }
+  if(id < 0 || !this->storesLocalIds()) {
+    return id;
   }
 
-  else if(cell.dim_ == 3) {
-    if(isReverse) {
-#ifdef TTK_ENABLE_DCG_OPTIMIZE_MEMORY
-      const auto locId{(*gradient_)[5][cell.id_]};
-      if(locId != -1) {
-        triangulation.getCellTriangle(cell.id_, locId, id);
-      }
-#else
-      id = (*gradient_)[5][cell.id_];
-#endif
-    }
+  // convert the local index into a cell id
+  const auto locId{id};
+  switch(k) {
+    case 0:
+      triangulation.getVertexEdge(cell.id_, locId, id);
+      break;
+    case 1:
+      triangulation.getEdgeVertex(cell.id_, locId, id);
+      break;
+    case 2:
+      triangulation.getEdgeTriangle(cell.id_, locId, id);
+      break;
+    case 3:
+      triangulation.getTriangleEdge(cell.id_, locId, id);
+      break;
+    case 4:
+      triangulation.getTriangleStar(cell.id_, locId, id);
+      break;
+    case 5:
+      triangulation.getCellTriangle(cell.id_, locId, id);
+      break;
+    default:
+      break;
   }
 
   return id;
@@ -1243,7 +1328,10 @@ int DiscreteGradient::getAscendingWall(
 template <typename triangulationType>
 int DiscreteGradient::reverseAscendingPath(
   const std::vector<Cell> &vpath,
-  const triangulationType &triangulation) const {
+  const triangulationType &triangulation) {
+
+  // copy-on-write: do not modify a gradient shared through the cache
+  this->setLocalGradient();
 
   if(dimensionality_ == 2) {
     // assume that the first cell is an edge
@@ -1251,29 +1339,7 @@ int DiscreteGradient::reverseAscendingPath(
     for(SimplexId i = 0; i < numberOfCellsInPath; i += 2) {
       const SimplexId edgeId = vpath[i].id_;
       const SimplexId triangleId = vpath[i + 1].id_;
-
-#ifdef TTK_ENABLE_DCG_OPTIMIZE_MEMORY
-      for(int k = 0; k < 3; ++k) {
-        SimplexId tmp;
-        triangulation.getCellEdge(triangleId, k, tmp);
-        if(tmp == edgeId) {
-          (*gradient_)[3][triangleId] = k;
-          break;
-        }
-      }
-      for(int k = 0; k < triangulation.getEdgeStarNumber(edgeId); ++k) {
-        SimplexId tmp;
-        triangulation.getEdgeStar(edgeId, k, tmp);
-        if(tmp == triangleId) {
-          (*gradient_)[2][edgeId] = k;
-          break;
-        }
-      }
-#else
-      TTK_FORCE_USE(triangulation);
-      (*gradient_)[3][triangleId] = edgeId;
-      (*gradient_)[2][edgeId] = triangleId;
-#endif
+      this->setGradientPair(1, edgeId, triangleId, triangulation);
     }
   } else if(dimensionality_ == 3) {
     // assume that the first cell is a triangle
@@ -1281,28 +1347,7 @@ int DiscreteGradient::reverseAscendingPath(
     for(SimplexId i = 0; i < numberOfCellsInPath; i += 2) {
       const SimplexId triangleId = vpath[i].id_;
       const SimplexId tetraId = vpath[i + 1].id_;
-
-#ifdef TTK_ENABLE_DCG_OPTIMIZE_MEMORY
-      for(int k = 0; k < 4; ++k) {
-        SimplexId tmp;
-        triangulation.getCellTriangle(tetraId, k, tmp);
-        if(tmp == triangleId) {
-          (*gradient_)[5][tetraId] = k;
-          break;
-        }
-      }
-      for(int k = 0; k < triangulation.getTriangleStarNumber(triangleId); ++k) {
-        SimplexId tmp;
-        triangulation.getTriangleStar(triangleId, k, tmp);
-        if(tmp == tetraId) {
-          (*gradient_)[4][triangleId] = k;
-          break;
-        }
-      }
-#else
-      (*gradient_)[5][tetraId] = triangleId;
-      (*gradient_)[4][triangleId] = tetraId;
-#endif
+      this->setGradientPair(2, triangleId, tetraId, triangulation);
     }
   }
 
@@ -1312,37 +1357,15 @@ int DiscreteGradient::reverseAscendingPath(
 template <typename triangulationType>
 int DiscreteGradient::reverseDescendingPath(
   const std::vector<Cell> &vpath,
-  const triangulationType &triangulation) const {
+  const triangulationType &triangulation) {
+
+  this->setLocalGradient();
 
   // assume that the first cell is an edge
   for(size_t i = 0; i < vpath.size(); i += 2) {
     const SimplexId edgeId = vpath[i].id_;
     const SimplexId vertId = vpath[i + 1].id_;
-
-#ifdef TTK_ENABLE_DCG_OPTIMIZE_MEMORY
-    const auto nneighs = triangulation.getVertexEdgeNumber();
-    for(int k = 0; k < nneighs; ++k) {
-      SimplexId tmp;
-      triangulation.getVertexEdge(vertId, k, tmp);
-      if(tmp == edgeId) {
-        (*gradient_)[0][vertId] = k;
-        break;
-      }
-    }
-    const auto nverts = triangulation.getEdgeStarNumber(edgeId);
-    for(int k = 0; k < nverts; ++k) {
-      SimplexId tmp;
-      triangulation.getEdgeVertex(edgeId, k, tmp);
-      if(tmp == vertId) {
-        (*gradient_)[1][edgeId] = k;
-        break;
-      }
-    }
-#else
-    TTK_FORCE_USE(triangulation);
-    (*gradient_)[0][vertId] = edgeId;
-    (*gradient_)[1][edgeId] = vertId;
-#endif
+    this->setGradientPair(0, vertId, edgeId, triangulation);
   }
 
   return 0;
@@ -1351,7 +1374,9 @@ int DiscreteGradient::reverseDescendingPath(
 template <typename triangulationType>
 int DiscreteGradient::reverseAscendingPathOnWall(
   const std::vector<Cell> &vpath,
-  const triangulationType &triangulation) const {
+  const triangulationType &triangulation) {
+
+  this->setLocalGradient();
 
   if(dimensionality_ == 3) {
     // assume that the first cell is an edge
@@ -1359,29 +1384,7 @@ int DiscreteGradient::reverseAscendingPathOnWall(
     for(SimplexId i = 0; i < numberOfCellsInPath; i += 2) {
       const SimplexId edgeId = vpath[i].id_;
       const SimplexId triangleId = vpath[i + 1].id_;
-
-#ifdef TTK_ENABLE_DCG_OPTIMIZE_MEMORY
-      for(int k = 0; k < 3; ++k) {
-        SimplexId tmp;
-        triangulation.getTriangleEdge(triangleId, k, tmp);
-        if(tmp == edgeId) {
-          (*gradient_)[3][triangleId] = k;
-          break;
-        }
-      }
-      for(int k = 0; k < triangulation.getEdgeTriangleNumber(edgeId); ++k) {
-        SimplexId tmp;
-        triangulation.getEdgeTriangle(edgeId, k, tmp);
-        if(tmp == triangleId) {
-          (*gradient_)[2][edgeId] = k;
-          break;
-        }
-      }
-#else
-      TTK_FORCE_USE(triangulation);
-      (*gradient_)[3][triangleId] = edgeId;
-      (*gradient_)[2][edgeId] = triangleId;
-#endif
+      this->setGradientPair(1, edgeId, triangleId, triangulation);
     }
   }
 
@@ -1391,7 +1394,9 @@ int DiscreteGradient::reverseAscendingPathOnWall(
 template <typename triangulationType>
 int DiscreteGradient::reverseDescendingPathOnWall(
   const std::vector<Cell> &vpath,
-  const triangulationType &triangulation) const {
+  const triangulationType &triangulation) {
+
+  this->setLocalGradient();
 
   if(dimensionality_ == 3) {
     // assume that the first cell is a triangle
@@ -1399,29 +1404,7 @@ int DiscreteGradient::reverseDescendingPathOnWall(
     for(SimplexId i = 0; i < numberOfCellsInPath; i += 2) {
       const SimplexId triangleId = vpath[i].id_;
       const SimplexId edgeId = vpath[i + 1].id_;
-
-#ifdef TTK_ENABLE_DCG_OPTIMIZE_MEMORY
-      for(int k = 0; k < 3; ++k) {
-        SimplexId tmp;
-        triangulation.getTriangleEdge(triangleId, k, tmp);
-        if(tmp == edgeId) {
-          (*gradient_)[3][triangleId] = k;
-          break;
-        }
-      }
-      for(int k = 0; k < triangulation.getEdgeTriangleNumber(edgeId); ++k) {
-        SimplexId tmp;
-        triangulation.getEdgeTriangle(edgeId, k, tmp);
-        if(tmp == triangleId) {
-          (*gradient_)[2][edgeId] = k;
-          break;
-        }
-      }
-#else
-      TTK_FORCE_USE(triangulation);
-      (*gradient_)[2][edgeId] = triangleId;
-      (*gradient_)[3][triangleId] = edgeId;
-#endif
+      this->setGradientPair(1, edgeId, triangleId, triangulation);
     }
   }
 
@@ -63,6 +63,14 @@ namespace ttk {
     inline void setComputeSadMax(const bool data) {
       this->ComputeSadMax = data;
     }
+    /**
+     * @brief Keep the working buffers between two calls to
+     * computePersistencePairs() on the same triangulation (e.g. when
+     * processing a sequence of scalar fields) instead of releasing them
+     */
+    inline void setReleaseMemory(const bool data) {
+      this->ReleaseMemory = data;
+    }
 
     template <typename triangulationType>
     inline int buildGradient(const void *const scalars,
@@ -438,17 +446,18 @@ namespace ttk {
       }
       if(dim > 2) {
         this->critEdges_.resize(triangulation.getNumberOfEdges());
-        this->edgeTrianglePartner_.resize(triangulation.getNumberOfEdges(), -1);
-        this->onBoundary_.resize(triangulation.getNumberOfEdges(), false);
-        this->s2Mapping_.resize(triangulation.getNumberOfTriangles(), -1);
-        this->s1Mapping_.resize(triangulation.getNumberOfEdges(), -1);
+        // assign() resets the buffers kept from a previous run
+        this->edgeTrianglePartner_.assign(triangulation.getNumberOfEdges(), -1);
+        this->onBoundary_.assign(triangulation.getNumberOfEdges(), false);
+        this->s2Mapping_.assign(triangulation.getNumberOfTriangles(), -1);
+        this->s1Mapping_.assign(triangulation.getNumberOfEdges(), -1);
       }
       for(int i = 0; i < dim + 1; ++i) {
-        this->pairedCritCells_[i].resize(
+        this->pairedCritCells_[i].assign(
           this->dg_.getNumberOfCells(i, triangulation), false);
       }
       for(int i = 1; i < dim + 1; ++i) {
-        this->critCellsOrder_[i].resize(
+        this->critCellsOrder_[i].assign(
           this->dg_.getNumberOfCells(i, triangulation), -1);
       }
       this->printMsg("Memory allocations", 1.0, tm.getElapsedTime(), 1,
@@ -485,6 +494,7 @@ namespace ttk {
     bool ComputeSadSad{true};
     bool ComputeSadMax{true};
     bool Compute2SaddlesChildren{false};
+    bool ReleaseMemory{true};
   };
 } // namespace ttk
 
@@ -1275,7 +1285,9 @@ int ttk::DiscreteMorseSandwich::computePersistencePairs(
                      paired2Saddles, pairedMaxima);
 
   // free memory
-  this->clear();
+  if(this->ReleaseMemory) {
+    this->clear();
+  }
 
   return 0;
 }
@@ -15,6 +15,10 @@
 /// Edsger W. Dijkstra \n
 /// Numerische Mathematik, 1959.
 ///
+/// "Delta-stepping: a parallelizable shortest path algorithm" \n
+/// Ulrich Meyer and Peter Sanders \n
+/// Journal of Algorithms, 2003.
+///
 /// \sa ttkDistanceField.cpp %for a usage example.
 #pragma once
 
@@ -68,6 +72,17 @@ namespace ttk {
       outputSegmentation_ = data;
     }
 
+    enum class METHOD {
+      /** sequential multi-source Dijkstra */
+      DIJKSTRA = 0,
+      /** parallel bucket-based (delta-stepping) propagation */
+      DELTA_STEPPING = 1,
+    };
+
+    inline void setMethod(const METHOD method) {
+      Method = method;
+    }
+
   protected:
     SimplexId vertexNumber_{};
     SimplexId sourceNumber_{};
@@ -75,6 +90,7 @@ namespace ttk {
     void *outputScalarFieldPointer_{};
     void *outputIdentifiers_{};
     void *outputSegmentation_{};
+    METHOD Method{METHOD::DELTA_STEPPING};
   };
 } // namespace ttk
 
@@ -91,9 +107,6 @@ int ttk::DistanceField::execute(const triangulationType *triangulation_) const {
 
   Timer t;
 
-  std::fill(dist, dist + vertexNumber_, std::numeric_limits<dataType>::max());
-  std::fill(origin, origin + vertexNumber_, -1);
-
   // get the sources
   std::set<SimplexId> isSource;
   for(SimplexId k = 0; k < sourceNumber_; ++k)
@@ -101,34 +114,20 @@ int ttk::DistanceField::execute(const triangulationType *triangulation_) const {
   std::vector<SimplexId> sources(isSource.begin(), isSource.end());
   isSource.clear();
 
-  // prepare output
-  std::vector<std::vector<dataType>> scalars(sources.size());
-
-  // @PETER This doesn't seem to very work efficient, there's multilple source
-  // shortest paths algorithms.
-#ifdef TTK_ENABLE_OPENMP
-#pragma omp parallel for num_threads(threadNumber_)
-#endif
-  for(size_t i = 0; i < sources.size(); ++i) {
-    int ret = Dijkstra::shortestPath<dataType>(
-      sources[i], *triangulation_, scalars[i]);
-    if(ret != 0) {
-      this->printErr(
-        "Algorithm not successful (error code:  " + std::to_string(ret) + ").");
-    }
+  // a single propagation from all sources computes dist, origin and seg
+  int ret{};
+  if(this->Method == METHOD::DELTA_STEPPING) {
+    ret = Dijkstra::deltaSteppingShortestPath<dataType>(
+      sources, *triangulation_, dist, seg, origin, dataType(0.0F),
+      this->threadNumber_);
+  } else {
+    ret = Dijkstra::multiSourceShortestPath<dataType>(
+      sources, *triangulation_, dist, seg, origin);
   }
-
-#ifdef TTK_ENABLE_OPENMP
-#pragma omp parallel for num_threads(threadNumber_)
-#endif
-  for(SimplexId k = 0; k < vertexNumber_; ++k) {
-    for(size_t i = 0; i < sources.size(); ++i) {
-      if(i == 0 or dist[k] > scalars[i][k]) {
-        dist[k] = scalars[i][k];
-        origin[k] = sources[i];
-        seg[k] = i;
-      }
-    }
+  if(ret != 0) {
+    this->printErr(
+      "Algorithm not successful (error code:  " + std::to_string(ret) + ").");
+    return ret;
   }
 
   this->printMsg(
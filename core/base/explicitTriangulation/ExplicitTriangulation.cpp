@@ -5,6 +5,9 @@
 #include <TwoSkeleton.h>
 #include <ZeroSkeleton.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <cstring>
 #include <numeric>
 
@@ -24,6 +27,8 @@ int ExplicitTriangulation::clear() {
   cellNumber_ = 0;
   doublePrecision_ = false;
 
+  this->resetLazyBlocks();
+
   printMsg("Triangulation cleared.", debug::Priority::DETAIL);
 
   return AbstractTriangulation::clear();
@@ -759,6 +764,235 @@ int ExplicitTriangulation::preconditionVertexStarsInternal() {
   return 0;
 }
 
+// lazy block generations are unique among all triangulations
+static size_t nextLazyGeneration() {
+  static std::atomic<size_t> generation{0};
+  return ++generation;
+}
+
+void ExplicitTriangulation::setLazyPreconditioning(const bool lazy) {
+  if(lazy == this->lazyPreconditioning_) {
+    return;
+  }
+  // relations preconditioned in lazy mode have no global array
+  if(this->hasPreconditionedVertexNeighbors_ && vertexNeighborData_.empty()) {
+    this->hasPreconditionedVertexNeighbors_ = false;
+  }
+  if(this->hasPreconditionedVertexStars_ && vertexStarData_.empty()) {
+    this->hasPreconditionedVertexStars_ = false;
+  }
+  this->resetLazyBlocks();
+  this->lazyPreconditioning_ = lazy;
+}
+
+void ExplicitTriangulation::setLazyBlockSize(const SimplexId blockSize) {
+  if(blockSize < 1 || blockSize == this->lazyBlockSize_) {
+    return;
+  }
+  this->lazyBlockSize_ = blockSize;
+  if(!this->lazyBlockCells_.empty()) {
+    this->resetLazyBlocks();
+    this->preconditionLazyBlocks();
+  }
+}
+
+int ExplicitTriangulation::preconditionVertexNeighbors() {
+  if(!this->lazyPreconditioning_ || this->hasPreconditionedVertexNeighbors_) {
+    return AbstractTriangulation::preconditionVertexNeighbors();
+  }
+  const auto ret = this->preconditionLazyBlocks();
+  this->hasPreconditionedVertexNeighbors_ = true;
+  // blocks built so far do not hold the vertex neighbors
+  this->lazyBlocks_.clear();
+  this->lazyGeneration_ = nextLazyGeneration();
+  return ret;
+}
+
+int ExplicitTriangulation::preconditionVertexStars() {
+  if(!this->lazyPreconditioning_ || this->hasPreconditionedVertexStars_) {
+    return AbstractTriangulation::preconditionVertexStars();
+  }
+  const auto ret = this->preconditionLazyBlocks();
+  this->hasPreconditionedVertexStars_ = true;
+  return ret;
+}
+
+int ExplicitTriangulation::preconditionLazyBlocks() {
+
+  if(this->cellArray_ == nullptr || this->vertexNumber_ == 0) {
+#ifdef TTK_ENABLE_MPI
+    if(!(ttk::isRunningWithMPI()))
+#endif
+      this->printErr("Empty dataset, precondition skipped");
+    return 1;
+  }
+
+  if(!this->lazyBlockCells_.empty()) {
+    return 0;
+  }
+
+  Timer t;
+
+  const auto blockSize = this->lazyBlockSize_;
+  const SimplexId blockNumber = (vertexNumber_ + blockSize - 1) / blockSize;
+
+  // distinct blocks of the cell vertices (at most 4)
+  const auto getCellBlocks
+    = [this, blockSize](const SimplexId cid, std::array<SimplexId, 4> &blocks) {
+        const auto nv = std::min<SimplexId>(
+          this->cellArray_->getCellVertexNumber(cid), blocks.size());
+        SimplexId n{};
+        for(SimplexId i = 0; i < nv; ++i) {
+          const auto b = this->cellArray_->getCellVertex(cid, i) / blockSize;
+          if(std::find(blocks.begin(), blocks.begin() + n, b)
+             == blocks.begin() + n) {
+            blocks[n++] = b;
+          }
+        }
+        return n;
+      };
+
+  std::vector<SimplexId> offsets(blockNumber + 1);
+  std::array<SimplexId, 4> blocks{};
+  for(SimplexId i = 0; i < cellNumber_; ++i) {
+    const auto n = getCellBlocks(i, blocks);
+    for(SimplexId j = 0; j < n; ++j) {
+      offsets[blocks[j] + 1]++;
+    }
+  }
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+  // cells are appended in ascending order
+  std::vector<SimplexId> cells(offsets.back());
+  std::vector<SimplexId> cursors(offsets.begin(), offsets.end() - 1);
+  for(SimplexId i = 0; i < cellNumber_; ++i) {
+    const auto n = getCellBlocks(i, blocks);
+    for(SimplexId j = 0; j < n; ++j) {
+      cells[cursors[blocks[j]]++] = i;
+    }
+  }
+
+  this->lazyBlockCells_.setData(std::move(cells), std::move(offsets));
+
+  this->lazyGeneration_ = nextLazyGeneration();
+
+  this->printMsg("Indexed " + std::to_string(blockNumber)
+                   + " blocks of vertices for lazy preconditioning",
+                 1.0, t.getElapsedTime(), 1);
+
+  return 0;
+}
+
+void ExplicitTriangulation::resetLazyBlocks() {
+  this->lazyBlockCells_.clear();
+  this->lazyBlocks_.clear();
+  this->lazyGeneration_ = 0;
+}
+
+std::shared_ptr<ExplicitTriangulation::LazyBlock>
+  ExplicitTriangulation::buildLazyBlock(const SimplexId blockId) const {
+
+  auto block{std::make_shared<LazyBlock>()};
+
+  const auto first = blockId * this->lazyBlockSize_;
+  const auto last = std::min(first + this->lazyBlockSize_, vertexNumber_);
+  const auto cells = this->lazyBlockCells_[blockId];
+
+  // vertex stars: cells in ascending order, as in
+  // ZeroSkeleton::buildVertexStars
+  std::vector<SimplexId> offsets(last - first + 1);
+  for(const auto c : cells) {
+    const auto nv = this->cellArray_->getCellVertexNumber(c);
+    for(SimplexId i = 0; i < nv; ++i) {
+      const auto v = this->cellArray_->getCellVertex(c, i);
+      if(v >= first && v < last) {
+        offsets[v - first + 1]++;
+      }
+    }
+  }
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+  std::vector<SimplexId> stars(offsets.back());
+  std::vector<SimplexId> cursors(offsets.begin(), offsets.end() - 1);
+  for(const auto c : cells) {
+    const auto nv = this->cellArray_->getCellVertexNumber(c);
+    for(SimplexId i = 0; i < nv; ++i) {
+      const auto v = this->cellArray_->getCellVertex(c, i);
+      if(v >= first && v < last) {
+        stars[cursors[v - first]++] = c;
+      }
+    }
+  }
+  block->vertexStars.setData(std::move(stars), std::move(offsets));
+
+  if(!this->hasPreconditionedVertexNeighbors_) {
+    return block;
+  }
+
+  // vertex neighbors: edges are numbered by first occurrence in the
+  // cell array (cell id, then local edge id), so the neighbors of a
+  // vertex appear in the same order as in OneSkeleton::buildEdgeList
+  // when following its star and the vertices of every star cell
+  std::vector<SimplexId> neighOffsets(last - first + 1);
+  std::vector<SimplexId> neighbors{};
+  for(SimplexId v = first; v < last; ++v) {
+    const auto begin = neighbors.size();
+    for(const auto c : block->vertexStars[v - first]) {
+      const auto nv = this->cellArray_->getCellVertexNumber(c);
+      for(SimplexId i = 0; i < nv; ++i) {
+        const auto u = this->cellArray_->getCellVertex(c, i);
+        if(u != v
+           && std::find(neighbors.begin() + begin, neighbors.end(), u)
+                == neighbors.end()) {
+          neighbors.emplace_back(u);
+        }
+      }
+    }
+    neighOffsets[v - first + 1] = neighbors.size();
+  }
+  block->vertexNeighbors.setData(
+    std::move(neighbors), std::move(neighOffsets));
+
+  return block;
+}
+
+const ExplicitTriangulation::LazyBlock &
+  ExplicitTriangulation::getLazyBlock(const SimplexId vertexId) const {
+
+  static const LazyBlock emptyBlock{};
+  if(vertexId < 0 || vertexId >= vertexNumber_ || this->lazyGeneration_ == 0) {
+    return emptyBlock;
+  }
+
+  // last block accessed by the current thread
+  struct LastBlock {
+    size_t generation{};
+    SimplexId id{-1};
+    std::shared_ptr<const LazyBlock> block{};
+  };
+  thread_local LastBlock last{};
+
+  const auto blockId = vertexId / this->lazyBlockSize_;
+  if(last.generation == this->lazyGeneration_ && last.id == blockId) {
+    return *last.block;
+  }
+
+  std::shared_ptr<const LazyBlock> block{this->lazyBlocks_.get(blockId)};
+  if(block == nullptr) {
+    // concurrent builds of the same block are harmless: the first
+    // insertion wins
+    auto newBlock{this->buildLazyBlock(blockId)};
+    const auto nBytes = sizeof(LazyBlock) + newBlock->vertexStars.footprint()
+                        + newBlock->vertexNeighbors.footprint();
+    this->lazyBlocks_.insert(blockId, newBlock, nBytes);
+    block = std::move(newBlock);
+  }
+
+  last.generation = this->lazyGeneration_;
+  last.id = blockId;
+  last.block = std::move(block);
+  return *last.block;
+}
+
 int ExplicitTriangulation::preconditionVertexTrianglesInternal() {
 
   if(this->cellArray_ == nullptr || this->vertexNumber_ == 0) {
@@ -906,6 +1140,7 @@ int ttk::ExplicitTriangulation::preconditionExchangeGhostCells() {
                  ttk::MPIcomm_, MPI_STATUS_IGNORE);
   }
 
+  this->preconditionGhostCellLocalIds();
   this->hasPreconditionedExchangeGhostCells_ = true;
   return 0;
 }
@@ -1503,6 +1738,7 @@ int ttk::ExplicitTriangulation::preconditionExchangeGhostVertices() {
                  ttk::MPIcomm_, MPI_STATUS_IGNORE);
   }
 
+  this->preconditionGhostVertexLocalIds();
   this->hasPreconditionedExchangeGhostVertices_ = true;
 
   return 0;
@@ -1524,7 +1760,18 @@ void writeBinArray(std::ofstream &stream,
 
 // initialize static member variables
 const char *ExplicitTriangulation::magicBytes_ = "TTKTriangulationFileFormat";
-const unsigned long ExplicitTriangulation::formatVersion_ = 1;
+const unsigned long ExplicitTriangulation::formatVersion_ = 2;
+const unsigned long ExplicitTriangulation::asciiFormatVersion_ = 2;
+
+// sections of the binary format are aligned on this size (in bytes)
+static const size_t sectionAlignment{4096};
+// 5 fixed-size arrays, 11 FlatJaggedArrays (offsets + data), 3 bool arrays
+static const size_t sectionNumber{5 + 2 * 11 + 3};
+
+static inline size_t alignSection(const size_t offset) {
+  return (offset + sectionAlignment - 1) / sectionAlignment
+         * sectionAlignment;
+}
 
 int ExplicitTriangulation::writeToFile(std::ofstream &stream) const {
 
@@ -1533,13 +1780,15 @@ int ExplicitTriangulation::writeToFile(std::ofstream &stream) const {
                std::strlen(ttk::ExplicitTriangulation::magicBytes_));
   // 2. format version (unsigned long)
   writeBin(stream, ttk::ExplicitTriangulation::formatVersion_);
-  // 3. dimensionality (int)
+  // 3. size of SimplexId (int)
+  writeBin(stream, static_cast<int>(sizeof(SimplexId)));
+  // 4. dimensionality (int)
   const auto dim = this->getDimensionality();
   writeBin(stream, dim);
-  // 4. number of vertices (SimplexId)
+  // 5. number of vertices (SimplexId)
   const auto nVerts = this->getNumberOfVertices();
   writeBin(stream, nVerts);
-  // 5. number of edges (SimplexId)
+  // 6. number of edges (SimplexId)
   const auto edgesNumber = [this, dim]() -> SimplexId {
     if(dim == 1) {
       return this->getNumberOfCells();
@@ -1550,7 +1799,7 @@ int ExplicitTriangulation::writeToFile(std::ofstream &stream) const {
   };
   const auto nEdges = edgesNumber();
   writeBin(stream, nEdges);
-  // 6. number of triangles (SimplexId, 0 in 1D)
+  // 7. number of triangles (SimplexId, 0 in 1D)
   const auto trianglesNumber = [this, dim]() -> SimplexId {
     if(dim == 2) {
       return this->getNumberOfCells();
@@ -1561,98 +1810,130 @@ int ExplicitTriangulation::writeToFile(std::ofstream &stream) const {
   };
   const auto nTriangles = trianglesNumber();
   writeBin(stream, nTriangles);
-  // 7. number of tetrahedron (SimplexId, 0 in 2D)
+  // 8. number of tetrahedron (SimplexId, 0 in 2D)
   const auto nTetras = dim > 2 ? this->getNumberOfCells() : 0;
   writeBin(stream, nTetras);
 
   // only write buffers oustside this->cellArray_ (cellVertex, vertexCoords),
   // those ones will be provided by VTK
 
-  // fixed-size arrays (in AbstractTriangulation.h)
+  // every array is stored in a page-aligned section (empty arrays
+  // have an empty section)
+  std::vector<std::pair<const char *, size_t>> sections{};
+  sections.reserve(sectionNumber);
 
-#define WRITE_FIXED(ARRAY)                             \
-  if(ARRAY.empty()) {                                  \
-    writeBin(stream, char{0});                         \
-  } else {                                             \
-    writeBin(stream, char{1});                         \
-    writeBinArray(stream, ARRAY.data(), ARRAY.size()); \
-  }
+  // fixed-size arrays (in AbstractTriangulation.h)
+  const auto add_fixed = [&sections](const auto &arr) {
+    sections.emplace_back(reinterpret_cast<const char *>(arr.data()),
+                          arr.size() * sizeof(arr[0]));
+  };
 
-  // 8. edgeList (SimplexId array)
-  WRITE_FIXED(this->edgeList_);
-  // 9. triangleList (SimplexId array)
-  WRITE_FIXED(this->triangleList_);
-  // 10. triangleEdgeList (SimplexId array)
-  WRITE_FIXED(this->triangleEdgeList_);
-  // 11. tetraEdgeList (SimplexId array)
-  WRITE_FIXED(this->tetraEdgeList_);
-  // 12. tetraTriangleList (SimplexId array)
-  WRITE_FIXED(this->tetraTriangleList_);
+  // edgeList (SimplexId array)
+  add_fixed(this->edgeList_);
+  // triangleList (SimplexId array)
+  add_fixed(this->triangleList_);
+  // triangleEdgeList (SimplexId array)
+  add_fixed(this->triangleEdgeList_);
+  // tetraEdgeList (SimplexId array)
+  add_fixed(this->tetraEdgeList_);
+  // tetraTriangleList (SimplexId array)
+  add_fixed(this->tetraTriangleList_);
 
   // variable-size arrays (FlatJaggedArray in ExplicitTriangulation.h)
-
-#define WRITE_GUARD(ARRAY)     \
-  if(ARRAY.empty()) {          \
-    writeBin(stream, char{0}); \
-    return;                    \
-  } else {                     \
-    writeBin(stream, char{1}); \
-  }
-
-  const auto write_variable = [&stream](const FlatJaggedArray &arr) {
-    // empty array guard
-    WRITE_GUARD(arr);
-    writeBinArray(stream, arr.offset_ptr(), arr.size() + 1);
-    writeBinArray(stream, arr.get_ptr(0, 0), arr.dataSize());
+  const auto add_variable = [&sections](const FlatJaggedArray &arr) {
+    if(arr.empty()) {
+      sections.emplace_back(nullptr, 0);
+      sections.emplace_back(nullptr, 0);
+      return;
+    }
+    sections.emplace_back(reinterpret_cast<const char *>(arr.offset_ptr()),
+                          (arr.size() + 1) * sizeof(SimplexId));
+    sections.emplace_back(reinterpret_cast<const char *>(arr.data_ptr()),
+                          arr.dataSize() * sizeof(SimplexId));
   };
 
-  // 13. vertexNeighbors (SimplexId array, offsets then data)
-  write_variable(this->vertexNeighborData_);
-  // 14. cellNeighbors (SimplexId array, offsets then data)
-  write_variable(this->cellNeighborData_);
-  // 15. vertexEdges (SimplexId array, offsets then data)
-  write_variable(this->vertexEdgeData_);
-  // 16. vertexTriangles (SimplexId array, offsets then data)
-  write_variable(this->vertexTriangleData_);
-  // 17. edgeTriangles (SimplexId array, offsets then data)
-  write_variable(this->edgeTriangleData_);
-  // 18. vertexStars (SimplexId array, offsets then data)
-  write_variable(this->vertexStarData_);
-  // 19. edgeStars (SimplexId array, offsets then data)
-  write_variable(this->edgeStarData_);
-  // 20. triangleStars (SimplexId array, offsets then data)
-  write_variable(this->triangleStarData_);
-  // 21. vertexLinks (SimplexId array, offsets then data)
-  write_variable(this->vertexLinkData_);
-  // 22. edgeLinks (SimplexId array, offsets then data)
-  write_variable(this->edgeLinkData_);
-  // 23. triangleLinks (SimplexId array, offsets then data)
-  write_variable(this->triangleLinkData_);
-
-  const auto write_bool = [&stream](const std::vector<bool> &arr) {
-    // empty array guard
-    WRITE_GUARD(arr);
-    for(size_t i = 0; i < arr.size(); ++i) {
-      const auto b = static_cast<char>(arr[i]);
-      writeBin(stream, b);
-    }
+  // vertexNeighbors (SimplexId arrays, offsets then data)
+  add_variable(this->vertexNeighborData_);
+  // cellNeighbors (SimplexId arrays, offsets then data)
+  add_variable(this->cellNeighborData_);
+  // vertexEdges (SimplexId arrays, offsets then data)
+  add_variable(this->vertexEdgeData_);
+  // vertexTriangles (SimplexId arrays, offsets then data)
+  add_variable(this->vertexTriangleData_);
+  // edgeTriangles (SimplexId arrays, offsets then data)
+  add_variable(this->edgeTriangleData_);
+  // vertexStars (SimplexId arrays, offsets then data)
+  add_variable(this->vertexStarData_);
+  // edgeStars (SimplexId arrays, offsets then data)
+  add_variable(this->edgeStarData_);
+  // triangleStars (SimplexId arrays, offsets then data)
+  add_variable(this->triangleStarData_);
+  // vertexLinks (SimplexId arrays, offsets then data)
+  add_variable(this->vertexLinkData_);
+  // edgeLinks (SimplexId arrays, offsets then data)
+  add_variable(this->edgeLinkData_);
+  // triangleLinks (SimplexId arrays, offsets then data)
+  add_variable(this->triangleLinkData_);
+
+  // boolean arrays, one char per element
+  const auto to_chars = [](const std::vector<bool> &arr) {
+    return std::vector<char>(arr.begin(), arr.end());
   };
+  const auto boundaryVertices{to_chars(this->boundaryVertices_)};
+  const auto boundaryEdges{to_chars(this->boundaryEdges_)};
+  const auto boundaryTriangles{to_chars(this->boundaryTriangles_)};
+
+  // boundary vertices (char array)
+  add_fixed(boundaryVertices);
+  // boundary edges (char array)
+  add_fixed(boundaryEdges);
+  // boundary triangles (char array)
+  add_fixed(boundaryTriangles);
+
+  // 9. section alignment (uint64_t)
+  writeBin(stream, static_cast<std::uint64_t>(sectionAlignment));
+  // 10. number of sections (uint64_t)
+  writeBin(stream, static_cast<std::uint64_t>(sections.size()));
+
+  // 11. section table (uint64_t offset from the beginning of the
+  // file and uint64_t size in bytes, for every section)
+  size_t pos = std::strlen(ttk::ExplicitTriangulation::magicBytes_)
+               + sizeof(formatVersion_) + 2 * sizeof(int)
+               + 4 * sizeof(SimplexId) + 2 * sizeof(std::uint64_t)
+               + 2 * sections.size() * sizeof(std::uint64_t);
+  std::vector<size_t> offsets(sections.size());
+  size_t end = pos;
+  for(size_t i = 0; i < sections.size(); ++i) {
+    if(sections[i].second == 0) {
+      continue;
+    }
+    offsets[i] = alignSection(end);
+    end = offsets[i] + sections[i].second;
+  }
+  for(size_t i = 0; i < sections.size(); ++i) {
+    writeBin(stream, static_cast<std::uint64_t>(offsets[i]));
+    writeBin(stream, static_cast<std::uint64_t>(sections[i].second));
+  }
 
-  // 24. boundary vertices (bool array)
-  write_bool(this->boundaryVertices_);
-  // 25. boundary edges (bool array)
-  write_bool(this->boundaryEdges_);
-  // 26. boundary triangles (bool array)
-  write_bool(this->boundaryTriangles_);
+  // 12. sections content, padded with zeros
+  const std::vector<char> padding(sectionAlignment);
+  for(size_t i = 0; i < sections.size(); ++i) {
+    if(sections[i].second == 0) {
+      continue;
+    }
+    writeBinArray(stream, padding.data(), offsets[i] - pos);
+    writeBinArray(stream, sections[i].first, sections[i].second);
+    pos = offsets[i] + sections[i].second;
+  }
 
-  return 0;
+  return stream.good() ? 0 : -1;
 }
 
 int ExplicitTriangulation::writeToFileASCII(std::ofstream &stream) const {
   // 1. magic bytes
   stream << ttk::ExplicitTriangulation::magicBytes_ << '\n';
   // 2. format version
-  stream << ttk::ExplicitTriangulation::formatVersion_ + 1 << '\n';
+  stream << ttk::ExplicitTriangulation::asciiFormatVersion_ << '\n';
   // 3. dimensionality
   const auto dim = this->getDimensionality();
   stream << "dim " << dim << '\n';
@@ -1750,6 +2031,8 @@ void readBinArray(std::ifstream &stream, T *const res, const size_t size) {
 
 int ExplicitTriangulation::readFromFile(std::ifstream &stream) {
 
+  const auto start = stream.tellg();
+
   // 1. magic bytes (char *)
   const auto magicBytesLen
     = std::strlen(ttk::ExplicitTriangulation::magicBytes_);
@@ -1760,18 +2043,35 @@ int ExplicitTriangulation::readFromFile(std::ifstream &stream) {
   if(!hasMagicBytes) {
     this->printErr("Could not find magic bytes in input files!");
     this->printErr("Aborting...");
-    return 0;
+    return -1;
   }
   // 2. format version (unsigned long)
   unsigned long version{};
   readBin(stream, version);
-  if(version != ttk::ExplicitTriangulation::formatVersion_) {
-    this->printWrn("File format version (" + std::to_string(version)
-                   + ") and software version ("
-                   + std::to_string(ttk::ExplicitTriangulation::formatVersion_)
-                   + ") are different!");
+
+  if(version == ttk::ExplicitTriangulation::formatVersion_) {
+    // page-aligned format: load the header, then copy every section
+    stream.seekg(0, std::ios::end);
+    const size_t fileSize = stream.tellg() - start;
+    const size_t headerSize = magicBytesLen + sizeof(version)
+                              + 2 * sizeof(int) + 4 * sizeof(SimplexId)
+                              + (2 + 2 * sectionNumber) * sizeof(std::uint64_t);
+    std::vector<char> header(std::min(headerSize, fileSize));
+    stream.seekg(start);
+    stream.read(header.data(), header.size());
+    // section offsets are relative to the beginning of the file
+    stream.seekg(start);
+    return this->readPagedFormat(
+      header.data(), header.size(), fileSize, &stream);
+  }
+  if(version != 1) {
+    this->printErr("Unsupported file format version ("
+                   + std::to_string(version) + ")!");
+    return -1;
   }
 
+  // version 1: arrays are contiguous, with a leading guard byte
+
   int dim{};
   SimplexId nVerts{}, nEdges{}, nTriangles{}, nTetras{};
 
@@ -1788,16 +2088,16 @@ int ExplicitTriangulation::readFromFile(std::ifstream &stream) {
 
   if(dim != this->getDimensionality()) {
     this->printErr("Incorrect dimension!");
-    return 0;
+    return -1;
   }
   if(nVerts != this->getNumberOfVertices()) {
     this->printErr("Incorrect number of vertices!");
-    return 0;
+    return -1;
   }
   if((dim == 2 && nTriangles != this->getNumberOfCells())
      || (dim == 3 && nTetras != this->getNumberOfCells())) {
     this->printErr("Incorrect number of cells!");
-    return 0;
+    return -1;
   }
 
   // fixed-size arrays (in AbstractTriangulation.h)
@@ -1888,3 +2188,283 @@ int ExplicitTriangulation::readFromFile(std::ifstream &stream) {
 
   return 0;
 }
+
+int ExplicitTriangulation::readFromFile(const std::string &fileName) {
+
+  this->releaseMappedFile();
+
+  auto file{std::make_shared<MappedFile>()};
+  const auto status = file->open(fileName);
+  if(status == -1) {
+    this->printErr("Could not open file `" + fileName + "'!");
+    return -1;
+  }
+
+  const auto streamFallback = [this, &fileName]() {
+    std::ifstream stream(fileName, std::ios::in | std::ios::binary);
+    return this->readFromFile(stream);
+  };
+
+  if(status != 0) {
+    this->printWrn("Could not map file `" + fileName + "' in memory");
+    return streamFallback();
+  }
+
+  // 1. magic bytes (char *) and 2. format version (unsigned long)
+  const auto magicBytesLen
+    = std::strlen(ttk::ExplicitTriangulation::magicBytes_);
+  unsigned long version{};
+  if(file->size() >= magicBytesLen + sizeof(version)
+     && std::strncmp(file->data(), ttk::ExplicitTriangulation::magicBytes_,
+                     magicBytesLen)
+          == 0) {
+    std::memcpy(&version, file->data() + magicBytesLen, sizeof(version));
+  }
+  if(version != ttk::ExplicitTriangulation::formatVersion_) {
+    // older versions (or invalid files) are handled by the stream reader
+    return streamFallback();
+  }
+
+  this->mappedFile_ = file;
+  const auto ret = this->readPagedFormat(
+    file->data(), file->size(), file->size(), nullptr);
+  if(ret != 0) {
+    this->releaseMappedFile();
+  }
+
+  return ret;
+}
+
+int ExplicitTriangulation::readPagedFormat(const char *const buffer,
+                                           const size_t bufferSize,
+                                           const size_t fileSize,
+                                           std::ifstream *const stream) {
+
+  // beginning of the file in the stream
+  const auto start = stream != nullptr ? stream->tellg() : std::streampos{};
+
+  // 1. magic bytes and 2. format version (already checked)
+  size_t pos = std::strlen(ttk::ExplicitTriangulation::magicBytes_)
+               + sizeof(formatVersion_);
+
+  const auto read_header = [buffer, bufferSize, &pos](auto &res) {
+    if(pos + sizeof(res) > bufferSize) {
+      return false;
+    }
+    std::memcpy(&res, buffer + pos, sizeof(res));
+    pos += sizeof(res);
+    return true;
+  };
+
+  int idSize{}, dim{};
+  SimplexId nVerts{}, nEdges{}, nTriangles{}, nTetras{};
+  std::uint64_t alignment{}, nSections{};
+
+  // 3. size of SimplexId (int)
+  if(!read_header(idSize) || idSize != static_cast<int>(sizeof(SimplexId))) {
+    this->printErr("Incompatible SimplexId size (" + std::to_string(idSize)
+                   + " bytes instead of "
+                   + std::to_string(sizeof(SimplexId)) + ")!");
+    return -1;
+  }
+
+  // 4. dimensionality (int), 5. -> 8. number of simplices (SimplexId),
+  // 9. section alignment and 10. number of sections (uint64_t)
+  if(!read_header(dim) || !read_header(nVerts) || !read_header(nEdges)
+     || !read_header(nTriangles) || !read_header(nTetras)
+     || !read_header(alignment) || !read_header(nSections)) {
+    this->printErr("Truncated file!");
+    return -1;
+  }
+
+  if(dim != this->getDimensionality()) {
+    this->printErr("Incorrect dimension!");
+    return -1;
+  }
+  if(nVerts != this->getNumberOfVertices()) {
+    this->printErr("Incorrect number of vertices!");
+    return -1;
+  }
+  if((dim == 2 && nTriangles != this->getNumberOfCells())
+     || (dim == 3 && nTetras != this->getNumberOfCells())) {
+    this->printErr("Incorrect number of cells!");
+    return -1;
+  }
+  if(nSections != sectionNumber) {
+    this->printErr("Incorrect number of sections!");
+    return -1;
+  }
+
+  // 11. section table (offset and size in bytes)
+  std::vector<std::uint64_t> table(2 * sectionNumber);
+  for(auto &el : table) {
+    if(!read_header(el)) {
+      this->printErr("Truncated file!");
+      return -1;
+    }
+  }
+  for(size_t i = 0; i < sectionNumber; ++i) {
+    if(table[2 * i] > fileSize || table[2 * i + 1] > fileSize - table[2 * i]
+       || table[2 * i] % sizeof(SimplexId) != 0) {
+      this->printErr("Invalid section table!");
+      return -1;
+    }
+  }
+
+  // 12. sections content
+
+  size_t curr{};
+  bool valid{true};
+  // offset of the current section if not empty and with the expected size
+  // (0 otherwise, since the header starts the file)
+  const auto next_section
+    = [&table, &curr, &valid](const size_t nBytes) -> size_t {
+    const auto offset = table[2 * curr];
+    const auto sectSize = table[2 * curr + 1];
+    curr++;
+    if(sectSize == 0) {
+      return 0;
+    }
+    if(sectSize != nBytes) {
+      valid = false;
+      return 0;
+    }
+    return offset;
+  };
+  const auto copy_section
+    = [buffer, stream, start](void *const dst, const size_t offset,
+                              const size_t nBytes) {
+        if(stream == nullptr) {
+          std::memcpy(dst, buffer + offset, nBytes);
+        } else {
+          stream->seekg(start + static_cast<std::streamoff>(offset));
+          stream->read(static_cast<char *>(dst), nBytes);
+        }
+      };
+
+  // fixed-size arrays (in AbstractTriangulation.h) are always copied
+  const auto read_fixed
+    = [&next_section, &copy_section](auto &arr, const SimplexId nItems) {
+        const auto nBytes = nItems * sizeof(arr[0]);
+        const auto offset = next_section(nBytes);
+        if(offset != 0) {
+          arr.resize(nItems);
+          copy_section(arr.data(), offset, nBytes);
+        }
+      };
+
+  // edgeList (SimplexId array)
+  read_fixed(this->edgeList_, nEdges);
+  // triangleList (SimplexId array)
+  read_fixed(this->triangleList_, nTriangles);
+  // triangleEdgeList (SimplexId array)
+  read_fixed(this->triangleEdgeList_, nTriangles);
+  // tetraEdgeList (SimplexId array)
+  read_fixed(this->tetraEdgeList_, nTetras);
+  // tetraTriangleList (SimplexId array)
+  read_fixed(this->tetraTriangleList_, nTetras);
+
+  // variable-size arrays (FlatJaggedArray in ExplicitTriangulation.h)
+  const auto read_variable = [&, buffer, stream](FlatJaggedArray &arr,
+                                                 const SimplexId nItems) {
+    const auto offOffsets = next_section((nItems + 1) * sizeof(SimplexId));
+    if(offOffsets == 0) {
+      // skip data section
+      curr++;
+      return;
+    }
+    if(stream == nullptr) {
+      // zero-copy
+      const auto offsets
+        = reinterpret_cast<const SimplexId *>(buffer + offOffsets);
+      const auto offData = next_section(offsets[nItems] * sizeof(SimplexId));
+      if(offData != 0) {
+        const auto data
+          = reinterpret_cast<const SimplexId *>(buffer + offData);
+        arr.setExternalData(data, offsets, nItems + 1);
+      }
+      return;
+    }
+    std::vector<SimplexId> offsets(nItems + 1);
+    copy_section(
+      offsets.data(), offOffsets, offsets.size() * sizeof(SimplexId));
+    const auto offData = next_section(offsets.back() * sizeof(SimplexId));
+    if(offData != 0) {
+      std::vector<SimplexId> data(offsets.back());
+      copy_section(data.data(), offData, data.size() * sizeof(SimplexId));
+      arr.setData(std::move(data), std::move(offsets));
+    }
+  };
+
+  // vertexNeighbors (SimplexId arrays, offsets then data)
+  read_variable(this->vertexNeighborData_, nVerts);
+  // cellNeighbors (SimplexId arrays, offsets then data)
+  read_variable(this->cellNeighborData_, this->getNumberOfCells());
+  // vertexEdges (SimplexId arrays, offsets then data)
+  read_variable(this->vertexEdgeData_, nVerts);
+  // vertexTriangles (SimplexId arrays, offsets then data)
+  read_variable(this->vertexTriangleData_, nVerts);
+  // edgeTriangles (SimplexId arrays, offsets then data)
+  read_variable(this->edgeTriangleData_, nEdges);
+  // vertexStars (SimplexId arrays, offsets then data)
+  read_variable(this->vertexStarData_, nVerts);
+  // edgeStars (SimplexId arrays, offsets then data)
+  read_variable(this->edgeStarData_, nEdges);
+  // triangleStars (SimplexId arrays, offsets then data)
+  read_variable(this->triangleStarData_, nTriangles);
+  // vertexLinks (SimplexId arrays, offsets then data)
+  read_variable(this->vertexLinkData_, nVerts);
+  // edgeLinks (SimplexId arrays, offsets then data)
+  read_variable(this->edgeLinkData_, nEdges);
+  // triangleLinks (SimplexId arrays, offsets then data)
+  read_variable(this->triangleLinkData_, nTriangles);
+
+  const auto read_bool = [&next_section, &copy_section](
+                           std::vector<bool> &arr, const SimplexId nItems) {
+    const auto offset = next_section(nItems);
+    if(offset == 0) {
+      return;
+    }
+    std::vector<char> chars(nItems);
+    copy_section(chars.data(), offset, nItems);
+    arr.resize(nItems);
+    for(SimplexId i = 0; i < nItems; ++i) {
+      arr[i] = static_cast<bool>(chars[i]);
+    }
+  };
+
+  // boundary vertices (char array)
+  read_bool(this->boundaryVertices_, nVerts);
+  // boundary edges (char array)
+  read_bool(this->boundaryEdges_, nEdges);
+  // boundary triangles (char array)
+  read_bool(this->boundaryTriangles_, nTriangles);
+
+  if(!valid) {
+    this->printErr("Unexpected section size!");
+    return -1;
+  }
+  if(stream != nullptr && !stream->good()) {
+    this->printErr("Truncated file!");
+    return -1;
+  }
+
+  return 0;
+}
+
+void ExplicitTriangulation::releaseMappedFile() {
+  if(this->mappedFile_ == nullptr) {
+    return;
+  }
+  for(auto arr : {&this->vertexNeighborData_, &this->cellNeighborData_,
+                  &this->vertexEdgeData_, &this->vertexTriangleData_,
+                  &this->edgeTriangleData_, &this->vertexStarData_,
+                  &this->edgeStarData_, &this->triangleStarData_,
+                  &this->vertexLinkData_, &this->edgeLinkData_,
+                  &this->triangleLinkData_}) {
+    if(arr->isExternal()) {
+      arr->clear();
+    }
+  }
+  this->mappedFile_.reset();
+}
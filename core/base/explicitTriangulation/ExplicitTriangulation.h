@@ -13,6 +13,7 @@
 #include <AbstractTriangulation.h>
 #include <CellArray.h>
 #include <FlatJaggedArray.h>
+#include <MappedFile.h>
 
 #include <memory>
 
@@ -387,17 +388,32 @@ namespace ttk {
       const int &localNeighborId,
       SimplexId &neighborId) const override {
 
+      if(this->isLazy(vertexNeighborData_)) {
+        neighborId = this->getLazyBlock(vertexId)
+                       .vertexNeighbors[vertexId % lazyBlockSize_]
+                                       [localNeighborId];
+        return 0;
+      }
       neighborId = vertexNeighborData_[vertexId][localNeighborId];
       return 0;
     }
 
     inline SimplexId TTK_TRIANGULATION_INTERNAL(getVertexNeighborNumber)(
       const SimplexId &vertexId) const override {
+      if(this->isLazy(vertexNeighborData_)) {
+        return this->getLazyBlock(vertexId)
+          .vertexNeighbors[vertexId % lazyBlockSize_]
+          .size();
+      }
       return vertexNeighborData_[vertexId].size();
     }
 
     inline const std::vector<std::vector<SimplexId>> *
       TTK_TRIANGULATION_INTERNAL(getVertexNeighbors)() override {
+      if(this->isLazy(vertexNeighborData_)) {
+        // the whole list is requested: build it
+        this->preconditionVertexNeighborsInternal();
+      }
       vertexNeighborData_.copyTo(vertexNeighborList_);
       return &vertexNeighborList_;
     }
@@ -426,17 +442,31 @@ namespace ttk {
       const SimplexId &vertexId,
       const int &localStarId,
       SimplexId &starId) const override {
+      if(this->isLazy(vertexStarData_)) {
+        starId = this->getLazyBlock(vertexId)
+                   .vertexStars[vertexId % lazyBlockSize_][localStarId];
+        return 0;
+      }
       starId = vertexStarData_[vertexId][localStarId];
       return 0;
     }
 
     inline SimplexId TTK_TRIANGULATION_INTERNAL(getVertexStarNumber)(
       const SimplexId &vertexId) const override {
+      if(this->isLazy(vertexStarData_)) {
+        return this->getLazyBlock(vertexId)
+          .vertexStars[vertexId % lazyBlockSize_]
+          .size();
+      }
       return vertexStarData_[vertexId].size();
     }
 
     inline const std::vector<std::vector<SimplexId>> *
       TTK_TRIANGULATION_INTERNAL(getVertexStars)() override {
+      if(this->isLazy(vertexStarData_)) {
+        // the whole list is requested: build it
+        this->preconditionVertexStarsInternal();
+      }
       vertexStarData_.copyTo(vertexStarList_);
       return &vertexStarList_;
     }
@@ -517,6 +547,37 @@ namespace ttk {
 
     int preconditionManifoldInternal() override;
 
+    /**
+     * @brief Build vertex stars and vertex neighbors on demand
+     *
+     * In lazy mode, preconditionVertexStars() and
+     * preconditionVertexNeighbors() only index the cells per block of
+     * consecutive vertex identifiers, in a single pass over the cells.
+     * The relations of a block are built on first access (from any
+     * thread) and kept in a memory-bounded cache that evicts the least
+     * recently used blocks. Localized traversals then only pay for the
+     * blocks they touch. The relations are identical to the ones
+     * built by the global preconditioning.
+     *
+     * Should be called before the preconditioning.
+     */
+    void setLazyPreconditioning(const bool lazy);
+
+    /**
+     * @brief Memory budget (in bytes) of the lazy preconditioning cache
+     */
+    inline void setLazyCacheCapacity(const size_t nBytes) {
+      this->lazyBlocks_.setCapacity(nBytes);
+    }
+
+    /**
+     * @brief Number of consecutive vertices per lazy preconditioning block
+     */
+    void setLazyBlockSize(const SimplexId blockSize);
+
+    int preconditionVertexNeighbors() override;
+    int preconditionVertexStars() override;
+
 #ifdef TTK_CELL_ARRAY_NEW
     // Layout with connectivity + offset array (new)
     inline int setInputCells(const SimplexId &cellNumber,
@@ -603,10 +664,27 @@ namespace ttk {
       return 0;
     }
 
+    /**
+     * @brief Replace the point buffer without discarding the
+     * preconditioned data structures
+     *
+     * The new buffer must hold the same number of points as the
+     * current one.
+     */
+    inline int updateInputPoints(const void *pointSet,
+                                 const bool &doublePrecision = false) {
+      pointSet_ = pointSet;
+      doublePrecision_ = doublePrecision;
+      return 0;
+    }
+
     /**
      * @brief Write internal state to disk
      *
-     * Use a custom binary format for fast loading
+     * Use a custom binary format for fast loading: every array is
+     * stored in its own page-aligned section so that the file can be
+     * memory-mapped by readFromFile(const std::string &). The stream
+     * should point to the beginning of the file.
      */
     int writeToFile(std::ofstream &stream) const;
     /**
@@ -616,9 +694,20 @@ namespace ttk {
     /**
      * @brief Read from disk into internal state
      *
-     * Use a custom binary format for fast loading
+     * Use a custom binary format for fast loading. The arrays are
+     * copied into memory.
      */
     int readFromFile(std::ifstream &stream);
+    /**
+     * @brief Memory-map a file written by writeToFile
+     *
+     * The variable-size arrays (neighbors, stars, links...) directly
+     * use the mapped memory: they are not copied and are shared
+     * between processes loading the same file. Files written with an
+     * older version of the format are read with
+     * readFromFile(std::ifstream &).
+     */
+    int readFromFile(const std::string &fileName);
 
 #ifdef TTK_ENABLE_MPI
 
@@ -807,10 +896,75 @@ namespace ttk {
     FlatJaggedArray edgeLinkData_{};
     FlatJaggedArray triangleLinkData_{};
 
+    // memory-mapped file used by the external FlatJaggedArrays
+    std::shared_ptr<MappedFile> mappedFile_{};
+
+    // relations of a block of consecutive vertices (lazy mode)
+    struct LazyBlock {
+      FlatJaggedArray vertexStars{};
+      FlatJaggedArray vertexNeighbors{};
+    };
+
+    bool lazyPreconditioning_{false};
+    SimplexId lazyBlockSize_{1024};
+    // identifies the current lazy blocks (0 if not indexed)
+    size_t lazyGeneration_{};
+    // for every block, the cells with at least one vertex in the block
+    FlatJaggedArray lazyBlockCells_{};
+    // blocks built so far, 1GiB budget by default
+    mutable LRUCache<SimplexId, LazyBlock> lazyBlocks_{size_t{1} << 30};
+
     // Char array that identifies the file format.
     static const char *magicBytes_;
     // Current version of the file format. To be incremented at every
     // breaking change to keep backward compatibility.
     static const unsigned long formatVersion_;
+    // Version of the ASCII format, which evolves independently of the
+    // binary one.
+    static const unsigned long asciiFormatVersion_;
+
+    /**
+     * @brief Read the page-aligned binary format
+     *
+     * @param[in] buffer File content (only the header if stream is set)
+     * @param[in] bufferSize Buffer size
+     * @param[in] fileSize File size
+     * @param[in] stream If not null, sections are copied from this
+     * stream, else the FlatJaggedArrays directly use the buffer
+     */
+    int readPagedFormat(const char *const buffer,
+                        const size_t bufferSize,
+                        const size_t fileSize,
+                        std::ifstream *const stream);
+    /**
+     * @brief Clear the arrays using the mapped file, then unmap it
+     */
+    void releaseMappedFile();
+
+    /**
+     * @brief If a relation should be read from the lazy blocks
+     */
+    inline bool isLazy(const FlatJaggedArray &globalRelation) const {
+      return this->lazyPreconditioning_ && globalRelation.empty();
+    }
+    /**
+     * @brief Index the cells per block of vertices
+     */
+    int preconditionLazyBlocks();
+    /**
+     * @brief Drop the lazy blocks and their index
+     */
+    void resetLazyBlocks();
+    /**
+     * @brief Build the relations of a block of vertices
+     */
+    std::shared_ptr<LazyBlock> buildLazyBlock(const SimplexId blockId) const;
+    /**
+     * @brief Get the block containing a vertex, build it if needed
+     *
+     * The returned reference is valid until the next call from the
+     * same thread.
+     */
+    const LazyBlock &getLazyBlock(const SimplexId vertexId) const;
   };
 } // namespace ttk
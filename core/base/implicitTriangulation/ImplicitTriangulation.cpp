@@ -78,6 +78,9 @@ int ImplicitTriangulation::setInputGrid(const float &xOrigin,
                                         const SimplexId &yDim,
                                         const SimplexId &zDim) {
 
+  // the cached gradients were computed on the previous grid
+  this->resetGradientCache();
+
   // Dimensionality //
   if(xDim < 1 or yDim < 1 or zDim < 1)
     dimensionality_ = -1;
@@ -3207,6 +3210,7 @@ int ImplicitTriangulation::preconditionExchangeGhostCells() {
                  ttk::MPIcomm_, MPI_STATUS_IGNORE);
   }
 
+  this->preconditionGhostCellLocalIds();
   this->hasPreconditionedExchangeGhostCells_ = true;
   return 0;
 }
@@ -3334,6 +3338,7 @@ int ImplicitTriangulation::preconditionExchangeGhostVertices() {
                  ttk::MPIcomm_, MPI_STATUS_IGNORE);
   }
 
+  this->preconditionGhostVertexLocalIds();
   this->hasPreconditionedExchangeGhostVertices_ = true;
   return 0;
 }
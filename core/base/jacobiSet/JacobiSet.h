@@ -31,7 +31,7 @@
 #include <Debug.h>
 #include <ScalarFieldCriticalPoints.h>
 #include <Triangulation.h>
-#include <UnionFind.h>
+#include <UnionFindArray.h>
 #include <vector>
 
 namespace ttk {
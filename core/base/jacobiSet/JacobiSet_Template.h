@@ -453,17 +453,8 @@ char ttk::JacobiSet::getCriticalType(const SimplexId &edgeId,
   }
 
   // let's check the connectivity now
-  std::vector<UnionFind> lowerSeeds(lowerNeighbors.size());
-  std::vector<UnionFind *> lowerList(lowerNeighbors.size());
-  std::vector<UnionFind> upperSeeds(upperNeighbors.size());
-  std::vector<UnionFind *> upperList(upperNeighbors.size());
-
-  for(size_t i = 0; i < lowerSeeds.size(); i++) {
-    lowerList[i] = &(lowerSeeds[i]);
-  }
-  for(size_t i = 0; i < upperSeeds.size(); i++) {
-    upperList[i] = &(upperSeeds[i]);
-  }
+  UnionFindArray<SimplexId> lowerSeeds(lowerNeighbors.size());
+  UnionFindArray<SimplexId> upperSeeds(upperNeighbors.size());
 
   for(SimplexId i = 0; i < starNumber; i++) {
 
@@ -498,11 +489,11 @@ char ttk::JacobiSet::getCriticalType(const SimplexId &edgeId,
             }
 
             auto *neighbors = &lowerNeighbors;
-            auto *seeds = &lowerList;
+            auto *seeds = &lowerSeeds;
 
             if(!lower0) {
               neighbors = &upperNeighbors;
-              seeds = &upperList;
+              seeds = &upperSeeds;
             }
 
             if(lower0 == lower1) {
@@ -518,9 +509,7 @@ char ttk::JacobiSet::getCriticalType(const SimplexId &edgeId,
               }
 
               if((lowerId0 != -1) && (lowerId1 != -1)) {
-                (*seeds)[lowerId0] = UnionFind::makeUnion(
-                  (*seeds)[lowerId0], (*seeds)[lowerId1]);
-                (*seeds)[lowerId1] = (*seeds)[lowerId0];
+                seeds->makeUnion(lowerId0, lowerId1);
               }
             }
 
@@ -531,24 +520,8 @@ char ttk::JacobiSet::getCriticalType(const SimplexId &edgeId,
     }
   }
 
-  // update the UF if necessary
-  for(size_t i = 0; i < lowerList.size(); i++)
-    lowerList[i] = lowerList[i]->find();
-  for(size_t i = 0; i < upperList.size(); i++)
-    upperList[i] = upperList[i]->find();
-
-  {
-    std::sort(lowerList.begin(), lowerList.end());
-    const auto it = std::unique(lowerList.begin(), lowerList.end());
-    lowerList.erase(it, lowerList.end());
-  }
-  {
-    std::sort(upperList.begin(), upperList.end());
-    const auto it = std::unique(upperList.begin(), upperList.end());
-    upperList.erase(it, upperList.end());
-  }
-
-  if((upperList.size() == 1) && (lowerList.size() == 1))
+  // one root per connected component
+  if((upperSeeds.getSetNumber() == 1) && (lowerSeeds.getSetNumber() == 1))
     return -2;
 
   return 1;
@@ -5,6 +5,14 @@
 ///
 /// \brief TTK KD-Tree
 ///
+/// The nodes are laid out in flat arrays, in depth-first (preorder) order:
+/// the left child of a node immediately follows it and its right child
+/// follows the left subtree. The coordinates and bounding box of a node
+/// are packed together (a query reads every axis of both), the weights and
+/// minimal subtree weights are stored in one array per weight index. The
+/// KDTree objects returned by build() and getKClosest() are lightweight
+/// handles on these arrays, owned by the root.
+///
 
 #pragma once
 
@@ -13,51 +21,64 @@
 #include <Geometry.h> // for pow
 
 #include <algorithm>
+#include <array>
 #include <limits>
 #include <memory>
+#include <numeric>
 
 namespace ttk {
   template <typename dataType, typename Container>
   class KDTree {
 
   protected:
-    // Boolean indicating if the current node is a left node of its parent
-    bool is_left_{};
-    // Indicates according to which coordinate the tree splits its elements
-    int coords_number_{0};
+    // Flat storage of the whole tree, indexed by node (preorder)
+    struct Storage {
+      int size{};
+      int dimension{};
+      int weightNumber{};
+      // per node: coordinates, then lower and upper bounding box corners
+      std::vector<dataType> geometry{};
+      // per weight index: one value per node
+      std::vector<dataType> weights{};
+      std::vector<dataType> minSubweights{};
+      // -1 if no such node
+      std::vector<int> parents{};
+      std::vector<int> lefts{};
+      std::vector<int> rights{};
+      // handles returned to the user
+      std::unique_ptr<KDTree[]> nodes{};
+    };
+
+    // Storage owned by the root (nullptr for other nodes)
+    std::unique_ptr<Storage> storage_{};
+    // Storage of the tree and position of the current node in it
+    Storage *tree_{};
+    int index_{};
     // Power used for the computation of distances. p=2 yields euclidean
     // distance
     int p_{2};
     // Whether or not the KDTree should include weights that add up to distance
     // for the computation of nearest neighbours
     bool include_weights_{false};
+    // Number of threads used by build()
+    int threadNumber_{1};
 
   public:
     using KDTreeRoot = std::unique_ptr<KDTree>;
     using KDTreeMap = std::vector<KDTree *>;
 
-    KDTreeRoot left_{}; // Lower half for the coordinate specified
-    KDTreeRoot right_{}; // Higher half
-    KDTree *parent_{};
     // ID of the object saved here. The whole object is not kept in the KDTree
     // Users should keep track of them in a table for instance
     int id_{};
-    Container coordinates_{};
-    Container coords_min_{};
-    Container coords_max_{};
     int level_{};
 
-    std::vector<dataType> weight_{};
-    std::vector<dataType> min_subweights_{};
-
     KDTree() = default;
     KDTree(const bool include_weights, const int p)
       : p_{p}, include_weights_{include_weights} {
     }
 
-    KDTree(KDTree *const father, const int coords_number, const bool is_left)
-      : is_left_{is_left}, coords_number_{coords_number},
-        include_weights_{father->include_weights_}, parent_{father} {
+    inline void setThreadNumber(const int threadNumber) {
+      threadNumber_ = threadNumber;
     }
 
     KDTreeMap build(dataType *data,
@@ -66,18 +87,9 @@ namespace ttk {
                     const std::vector<std::vector<dataType>> &weights = {},
                     const int weight_number = 1);
 
-    void buildRecursive(dataType *data,
-                        std::vector<int> &idx_side,
-                        const int &ptNumber,
-                        const int &dimension,
-                        KDTree<dataType, Container> *parent,
-                        KDTreeMap &correspondence_map,
-                        const std::vector<std::vector<dataType>> &weights = {},
-                        const int weight_number = 1);
-
     inline void updateWeight(const dataType new_weight,
                              const int weight_index = 0) {
-      weight_[weight_index] = new_weight;
+      tree_->weights[weightPosition(weight_index)] = new_weight;
       updateMinSubweight(weight_index);
     }
 
@@ -88,54 +100,48 @@ namespace ttk {
                      std::vector<dataType> &costs,
                      const int weight_index = 0);
 
-    template <typename PowerFunc>
-    void recursiveGetKClosest(const unsigned int k,
-                              const Container &coordinates,
-                              KDTreeMap &neighbours,
-                              std::vector<dataType> &costs,
-                              const int weight_index,
-                              const PowerFunc &power);
-
-    template <typename PowerFunc>
-    inline dataType getCost(const Container &coordinates,
-                            const PowerFunc &power) const {
-      dataType cost = 0;
-      for(size_t i = 0; i < coordinates.size(); i++) {
-        cost += power(std::abs(coordinates[i] - coordinates_[i]));
-      }
-      return cost;
-    }
-
-    template <typename PowerFunc>
-    inline dataType distanceToBox(const KDTree<dataType, Container> &subtree,
-                                  const Container &coordinates,
-                                  const PowerFunc &power) const {
-      dataType d_min = 0;
-      for(size_t axis = 0; axis < coordinates.size(); axis++) {
-        if(subtree.coords_min_[axis] > coordinates[axis]) {
-          d_min += power(subtree.coords_min_[axis] - coordinates[axis]);
-        } else if(subtree.coords_max_[axis] < coordinates[axis]) {
-          d_min += power(coordinates[axis] - subtree.coords_max_[axis]);
-        }
-      }
-      return d_min;
-    }
-
-    inline const std::vector<dataType> &getCoordinates() const {
-      return coordinates_;
+    inline Container getCoordinates() const {
+      Container coordinates{};
+      const int dim = tree_->dimension;
+      std::copy(&tree_->geometry[3 * dim * index_],
+                &tree_->geometry[3 * dim * index_] + dim, coordinates.begin());
+      return coordinates;
     }
     inline dataType getWeight(const int weight_index = 0) const {
-      return weight_[weight_index];
+      return tree_->weights[weightPosition(weight_index)];
     }
     inline dataType getMinSubWeight(const int weight_index = 0) const {
-      return min_subweights_[weight_index];
+      return tree_->minSubweights[weightPosition(weight_index)];
     }
     inline bool isLeaf() const {
-      return left_ == nullptr && right_ == nullptr;
+      return tree_->lefts[index_] == -1 && tree_->rights[index_] == -1;
     }
     inline bool isRoot() const {
-      return parent_ == nullptr;
+      return tree_->parents[index_] == -1;
     }
+
+  protected:
+    // Position of the weights of the current node in the storage
+    inline size_t weightPosition(const int weight_index) const {
+      return static_cast<size_t>(weight_index) * tree_->size + index_;
+    }
+
+    void buildSubtree(const dataType *const data,
+                      int *const idx,
+                      const int ptNumber,
+                      const int node,
+                      const int parent,
+                      const bool isLeft,
+                      const int level,
+                      const std::vector<std::vector<dataType>> *const weights);
+
+    template <typename PowerFunc>
+    void searchKClosest(const unsigned int k,
+                        const Container &coordinates,
+                        KDTreeMap &neighbours,
+                        std::vector<dataType> &costs,
+                        const int weight_index,
+                        const PowerFunc &power);
   };
 } // namespace ttk
 
@@ -148,186 +154,180 @@ typename ttk::KDTree<dataType, Container>::KDTreeMap
     const std::vector<std::vector<dataType>> &weights,
     const int weight_number) {
 
-  KDTreeMap correspondence_map(ptNumber);
-  // First, perform a argsort on the data
-  // initialize original index locations
-  for(int axis = 0; axis < dimension; axis++) {
-    coords_min_[axis] = std::numeric_limits<dataType>::lowest();
-    coords_max_[axis] = std::numeric_limits<dataType>::max();
-  }
-  std::vector<int> idx(ptNumber);
-  for(int i = 0; i < ptNumber; i++) {
-    idx[i] = i;
-  }
-  // sort indexes based on comparing values in coordinates
-  sort(idx.begin(), idx.end(), [&](int i1, int i2) {
-    return data[dimension * i1 + coords_number_]
-           < data[dimension * i2 + coords_number_];
-  });
-  int median_loc = (int)(ptNumber - 1) / 2;
-  int median_idx = idx[median_loc];
-  correspondence_map[median_idx] = this;
-
-  for(int axis = 0; axis < dimension; axis++) {
-    coordinates_[axis] = data[dimension * median_idx + axis];
-  }
-
-  id_ = median_idx;
-  parent_ = nullptr;
+  storage_ = std::make_unique<Storage>();
+  tree_ = storage_.get();
+  index_ = 0;
+  id_ = 0;
   level_ = 0;
 
-  this->weight_.clear();
-  this->min_subweights_.clear();
-
-  if(weights.empty()) {
-    this->weight_.resize(weight_number);
-    this->min_subweights_.resize(weight_number);
-  } else {
-    for(int i = 0; i < weight_number; i++) {
-      weight_.push_back(weights[i][median_idx]);
-      min_subweights_.push_back(weights[i][median_idx]);
-    }
+  KDTreeMap correspondence_map(ptNumber);
+  if(ptNumber <= 0) {
+    return correspondence_map;
   }
 
-  if(idx.size() > 2) {
-    // Build left leaf
-    std::vector<int> idx_left(median_loc);
-    for(int i = 0; i < median_loc; i++) {
-      idx_left[i] = idx[i];
-    }
+  auto &tree{*tree_};
+  const size_t nWeights = static_cast<size_t>(weight_number) * ptNumber;
+  tree.size = ptNumber;
+  tree.dimension = dimension;
+  tree.weightNumber = weight_number;
+  tree.geometry.resize(3 * static_cast<size_t>(dimension) * ptNumber);
+  tree.weights.resize(nWeights);
+  tree.minSubweights.resize(nWeights);
+  tree.parents.resize(ptNumber);
+  tree.lefts.resize(ptNumber);
+  tree.rights.resize(ptNumber);
+  tree.nodes = std::make_unique<KDTree[]>(ptNumber);
 
-    this->left_
-      = std::make_unique<KDTree>(this, (coords_number_ + 1) % dimension, true);
-    this->left_->buildRecursive(data, idx_left, ptNumber, dimension, this,
-                                correspondence_map, weights, weight_number);
+  std::vector<int> idx(ptNumber);
+  std::iota(idx.begin(), idx.end(), 0);
+
+  // independent subtrees are built concurrently
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel num_threads(threadNumber_)
+#pragma omp single nowait
+#endif // TTK_ENABLE_OPENMP
+  this->buildSubtree(data, idx.data(), ptNumber, 0, -1, false, 0, &weights);
+
+  // children are stored after their parent
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+  for(int w = 0; w < weight_number; w++) {
+    const size_t offset = static_cast<size_t>(w) * ptNumber;
+    const dataType *const weight = &tree.weights[offset];
+    dataType *const minSubweight = &tree.minSubweights[offset];
+    for(int i = ptNumber - 1; i >= 0; i--) {
+      minSubweight[i] = weight[i];
+      if(tree.lefts[i] != -1) {
+        minSubweight[i] = std::min(minSubweight[i], minSubweight[i + 1]);
+      }
+      if(tree.rights[i] != -1) {
+        minSubweight[i]
+          = std::min(minSubweight[i], minSubweight[tree.rights[i]]);
+      }
+    }
   }
 
-  if(idx.size() > 1) {
-    // Build right leaf
-    std::vector<int> idx_right(ptNumber - median_loc - 1);
-    for(int i = 0; i < ptNumber - median_loc - 1; i++) {
-      idx_right[i] = idx[i + median_loc + 1];
-    }
-    this->right_
-      = std::make_unique<KDTree>(this, (coords_number_ + 1) % dimension, false);
-    this->right_->buildRecursive(data, idx_right, ptNumber, dimension, this,
-                                 correspondence_map, weights, weight_number);
+  for(int i = 0; i < ptNumber; i++) {
+    auto &node{tree.nodes[i]};
+    node.tree_ = tree_;
+    node.index_ = i;
+    node.p_ = p_;
+    node.include_weights_ = include_weights_;
+    correspondence_map[node.id_] = &node;
   }
+  id_ = tree.nodes[0].id_;
 
   return correspondence_map;
 }
 
 template <typename dataType, typename Container>
-void ttk::KDTree<dataType, Container>::buildRecursive(
-  dataType *data,
-  std::vector<int> &idx_side,
-  const int &ptNumber,
-  const int &dimension,
-  KDTree<dataType, Container> *parent,
-  KDTreeMap &correspondence_map,
-  const std::vector<std::vector<dataType>> &weights,
-  const int weight_number) {
-
-  // First, perform a argsort on the data
-  sort(idx_side.begin(), idx_side.end(), [&](int i1, int i2) {
-    return data[dimension * i1 + coords_number_]
-           < data[dimension * i2 + coords_number_];
+void ttk::KDTree<dataType, Container>::buildSubtree(
+  const dataType *const data,
+  int *const idx,
+  const int ptNumber,
+  const int node,
+  const int parent,
+  const bool isLeft,
+  const int level,
+  const std::vector<std::vector<dataType>> *const weights) {
+
+  auto &tree{*tree_};
+  const int dimension = tree.dimension;
+  const int axis = level % dimension;
+
+  // median along the splitting axis (ties broken by index for a
+  // deterministic layout)
+  const int median_loc = (ptNumber - 1) / 2;
+  std::nth_element(idx, idx + median_loc, idx + ptNumber, [&](int i1, int i2) {
+    const auto v1 = data[dimension * i1 + axis];
+    const auto v2 = data[dimension * i2 + axis];
+    return v1 < v2 || (v1 == v2 && i1 < i2);
   });
-  int median_loc = (int)(idx_side.size() - 1) / 2;
-  int median_idx = idx_side[median_loc];
-  correspondence_map[median_idx] = this;
-
-  for(int axis = 0; axis < dimension; axis++) {
-    coordinates_[axis] = data[dimension * median_idx + axis];
-  }
+  const int median_idx = idx[median_loc];
 
-  id_ = median_idx;
-  parent_ = parent;
-  level_ = parent->level_ + 1;
+  auto &handle{tree.nodes[node]};
+  handle.id_ = median_idx;
+  handle.level_ = level;
 
-  this->weight_.clear();
-  this->min_subweights_.clear();
+  dataType *const coordinates = &tree.geometry[3 * dimension * node];
+  dataType *const coords_min = coordinates + dimension;
+  dataType *const coords_max = coords_min + dimension;
+  std::copy(&data[dimension * median_idx],
+            &data[dimension * median_idx] + dimension, coordinates);
 
-  if(weights.empty()) {
-    this->weight_.resize(weight_number);
-    this->min_subweights_.resize(weight_number);
+  // Create bounding box
+  if(parent == -1) {
+    std::fill(coords_min, coords_max, std::numeric_limits<dataType>::lowest());
+    std::fill(coords_max, coords_max + dimension,
+              std::numeric_limits<dataType>::max());
   } else {
-    for(int i = 0; i < weight_number; i++) {
-      weight_.push_back(weights[i][median_idx]);
-      min_subweights_.push_back(weights[i][median_idx]);
-    }
-
-    if(idx_side.size() > 1) {
-      // Once we get to a leaf, update min_subweights of the parents
-      for(int w = 0; w < weight_number; w++) {
-        this->updateMinSubweight(w);
-      }
+    const dataType *const parentCoordinates
+      = &tree.geometry[3 * dimension * parent];
+    std::copy(parentCoordinates + dimension,
+              parentCoordinates + 3 * dimension, coords_min);
+    const int parentAxis = (level - 1) % dimension;
+    if(isLeft) {
+      coords_max[parentAxis] = parentCoordinates[parentAxis];
+    } else {
+      coords_min[parentAxis] = parentCoordinates[parentAxis];
     }
   }
 
-  // Create bounding box
-  for(int axis = 0; axis < dimension; axis++) {
-    coords_min_[axis] = parent_->coords_min_[axis];
-    coords_max_[axis] = parent_->coords_max_[axis];
-  }
-  if(is_left_ && !this->isRoot()) {
-    coords_max_[parent_->coords_number_]
-      = parent_->coordinates_[parent_->coords_number_];
-  } else if(!is_left_ && !this->isRoot()) {
-    coords_min_[parent_->coords_number_]
-      = parent_->coordinates_[parent_->coords_number_];
+  for(int w = 0; w < tree.weightNumber; w++) {
+    tree.weights[static_cast<size_t>(w) * tree.size + node]
+      = weights->empty() ? dataType{} : (*weights)[w][median_idx];
   }
 
-  if(idx_side.size() > 2) {
-    // Build left leaf
-    std::vector<int> idx_left(median_loc);
-    for(int i = 0; i < median_loc; i++) {
-      idx_left[i] = idx_side[i];
+  // the left subtree follows the node, the right one follows the left one
+  const int nLeft = median_loc;
+  const int nRight = ptNumber - median_loc - 1;
+  tree.parents[node] = parent;
+  tree.lefts[node] = nLeft > 0 ? node + 1 : -1;
+  tree.rights[node] = nRight > 0 ? node + 1 + nLeft : -1;
+
+  if(nLeft > 0) {
+    if(nLeft > 4096) {
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp task
+#endif // TTK_ENABLE_OPENMP
+      this->buildSubtree(
+        data, idx, nLeft, node + 1, node, true, level + 1, weights);
+    } else {
+      this->buildSubtree(
+        data, idx, nLeft, node + 1, node, true, level + 1, weights);
     }
-
-    this->left_
-      = std::make_unique<KDTree>(this, (coords_number_ + 1) % dimension, true);
-    this->left_->buildRecursive(data, idx_left, ptNumber, dimension, this,
-                                correspondence_map, weights, weight_number);
   }
-
-  if(idx_side.size() > 1) {
-    // Build right leaf
-    std::vector<int> idx_right(idx_side.size() - median_loc - 1);
-    for(unsigned int i = 0; i < idx_side.size() - median_loc - 1; i++) {
-      idx_right[i] = idx_side[i + median_loc + 1];
-    }
-    this->right_
-      = std::make_unique<KDTree>(this, (coords_number_ + 1) % dimension, false);
-    this->right_->buildRecursive(data, idx_right, ptNumber, dimension, this,
-                                 correspondence_map, weights, weight_number);
+  if(nRight > 0) {
+    this->buildSubtree(data, idx + median_loc + 1, nRight, node + 1 + nLeft,
+                       node, false, level + 1, weights);
   }
 }
 
 template <typename dataType, typename Container>
 void ttk::KDTree<dataType, Container>::updateMinSubweight(
   const int weight_index) {
-  dataType new_min_subweight;
-  if(this->isLeaf()) {
-    new_min_subweight = weight_[weight_index];
-  } else if(!left_) {
-    new_min_subweight
-      = std::min(right_->min_subweights_[weight_index], weight_[weight_index]);
-  } else if(!right_) {
-    new_min_subweight
-      = std::min(left_->min_subweights_[weight_index], weight_[weight_index]);
-  } else {
-    new_min_subweight
-      = std::min(std::min(left_->min_subweights_[weight_index],
-                          right_->min_subweights_[weight_index]),
-                 weight_[weight_index]);
-  }
 
-  if(new_min_subweight != min_subweights_[weight_index]) {
-    min_subweights_[weight_index] = new_min_subweight;
-    if(!this->isRoot()) {
-      parent_->updateMinSubweight(weight_index);
+  auto &tree{*tree_};
+  const size_t offset = static_cast<size_t>(weight_index) * tree.size;
+  const dataType *const weight = &tree.weights[offset];
+  dataType *const minSubweight = &tree.minSubweights[offset];
+
+  // walk up while the minimal subtree weight changes
+  for(int node = index_; node != -1; node = tree.parents[node]) {
+    dataType new_min_subweight = weight[node];
+    if(tree.lefts[node] != -1) {
+      new_min_subweight
+        = std::min(new_min_subweight, minSubweight[tree.lefts[node]]);
+    }
+    if(tree.rights[node] != -1) {
+      new_min_subweight
+        = std::min(new_min_subweight, minSubweight[tree.rights[node]]);
+    }
+    if(new_min_subweight == minSubweight[node]) {
+      break;
     }
+    minSubweight[node] = new_min_subweight;
   }
 }
 
@@ -338,80 +338,105 @@ void ttk::KDTree<dataType, Container>::getKClosest(const unsigned int k,
                                                    std::vector<dataType> &costs,
                                                    const int weight_index) {
 
-  const auto p{this->p_};
-
   /// Puts the k closest points to the given coordinates in the "neighbours"
   /// vector along with their costs in the "costs" vector The output is not
   /// sorted, if you are interested in the k nearest neighbours in the order,
   /// will need to sort them according to their cost.
-  if(this->isLeaf()) {
-    dataType cost{};
-    TTK_POW_LAMBDA(cost = this->getCost, dataType, p, coordinates);
-    cost += weight_[weight_index];
-    neighbours.push_back(this);
-    costs.push_back(cost);
-  } else {
-    neighbours.reserve(k);
-    costs.reserve(k);
-    TTK_POW_LAMBDA(this->recursiveGetKClosest, dataType, p, k, coordinates,
-                   neighbours, costs, weight_index);
+  if(tree_ == nullptr || tree_->size == 0) {
+    return;
   }
+
+  const auto p{this->p_};
+
+  neighbours.reserve(k);
+  costs.reserve(k);
+  TTK_POW_LAMBDA(this->searchKClosest, dataType, p, k, coordinates,
+                 neighbours, costs, weight_index);
   // TODO sort neighbours and costs !
 }
 
 template <typename dataType, typename Container>
 template <typename PowerFunc>
-void ttk::KDTree<dataType, Container>::recursiveGetKClosest(
+void ttk::KDTree<dataType, Container>::searchKClosest(
   const unsigned int k,
   const Container &coordinates,
   KDTreeMap &neighbours,
   std::vector<dataType> &costs,
   const int weight_index,
   const PowerFunc &power) {
-  // 1- Look whether or not to include the current point in the nearest
-  // neighbours
-  dataType cost = this->getCost(coordinates, power);
-  cost += weight_[weight_index];
-
-  if(costs.size() < k) {
-    neighbours.push_back(this);
-    costs.push_back(cost);
-  } else {
-    // 1.1- Find the most costly amongst neighbours
-    const auto idx_max_cost = std::distance(
-      costs.begin(), std::max_element(costs.begin(), costs.begin() + k));
-    const dataType max_cost = costs[idx_max_cost];
-
-    // 1.2- If the current KDTree is less costly, put it in the neighbours and
-    // update costs.
-    if(cost < max_cost) {
-      costs[idx_max_cost] = cost;
-      neighbours[idx_max_cost] = this;
+
+  const auto &tree{*tree_};
+  const int dimension = tree.dimension;
+  const size_t offset = static_cast<size_t>(weight_index) * tree.size;
+  const dataType *const weight = &tree.weights[offset];
+  const dataType *const minSubweight = &tree.minSubweights[offset];
+
+  // depth-first traversal, subtree on the side of the query first: each
+  // subtree is checked when popped, after the subtrees visited before it
+  // have lowered the costs (a stack of depth + 1 nodes is enough)
+  std::array<std::pair<int, int>, 2 * std::numeric_limits<int>::digits>
+    stack{};
+  int stackSize = 0;
+  stack[stackSize++] = {index_, level_};
+
+  while(stackSize > 0) {
+    const int node = stack[stackSize - 1].first;
+    const int level = stack[stackSize - 1].second;
+    stackSize--;
+    const dataType *const nodeCoordinates
+      = &tree.geometry[3 * dimension * node];
+
+    if(node != index_ && costs.size() >= k) {
+      // Visit only the subtrees that are worth it
+      const dataType *const coords_min = nodeCoordinates + dimension;
+      const dataType *const coords_max = coords_min + dimension;
+      dataType d_min = 0;
+      for(int axis = 0; axis < dimension; axis++) {
+        if(coords_min[axis] > coordinates[axis]) {
+          d_min += power(coords_min[axis] - coordinates[axis]);
+        } else if(coords_max[axis] < coordinates[axis]) {
+          d_min += power(coordinates[axis] - coords_max[axis]);
+        }
+      }
+      const dataType max_cost = *std::max_element(costs.begin(), costs.end());
+      if(!(d_min + minSubweight[node] < max_cost)) {
+        continue;
+      }
     }
-  }
 
-  // 2- Recursively visit KDTrees that are worth it
-  if(left_) {
-    const dataType max_cost = *std::max_element(costs.begin(), costs.end());
-    const dataType min_subweight = left_->min_subweights_[weight_index];
-    const dataType d_min = this->distanceToBox(*left_, coordinates, power);
-    if(costs.size() < k || d_min + min_subweight < max_cost) {
-      // 2.2- It is possible that there exists a point in this subtree that is
-      // less costly than max_cost
-      left_->recursiveGetKClosest(
-        k, coordinates, neighbours, costs, weight_index, power);
+    // Look whether or not to include the current point in the nearest
+    // neighbours
+    dataType cost = 0;
+    for(int axis = 0; axis < dimension; axis++) {
+      cost += power(std::abs(coordinates[axis] - nodeCoordinates[axis]));
+    }
+    cost += weight[node];
+
+    if(costs.size() < k) {
+      neighbours.push_back(&tree.nodes[node]);
+      costs.push_back(cost);
+    } else {
+      // If the current node is less costly than the most costly neighbour,
+      // replace it
+      const auto idx_max_cost = std::distance(
+        costs.begin(), std::max_element(costs.begin(), costs.begin() + k));
+      if(cost < costs[idx_max_cost]) {
+        costs[idx_max_cost] = cost;
+        neighbours[idx_max_cost] = &tree.nodes[node];
+      }
     }
-  }
 
-  if(right_) {
-    const dataType max_cost = *std::max_element(costs.begin(), costs.end());
-    const dataType min_subweight = right_->min_subweights_[weight_index];
-    const dataType d_min = this->distanceToBox(*right_, coordinates, power);
-    if(costs.size() < k || d_min + min_subweight < max_cost) {
-      // 2.2- It is possible that there exists a point in this subtree that is
-      // less costly than max_cost
-      right_->recursiveGetKClosest(
-        k, coordinates, neighbours, costs, weight_index, power);
+    const int axis = level % dimension;
+    int nearChild = tree.lefts[node];
+    int farChild = tree.rights[node];
+    if(coordinates[axis] > nodeCoordinates[axis]) {
+      std::swap(nearChild, farChild);
+    }
+    if(farChild != -1) {
+      stack[stackSize++] = {farChild, level + 1};
+    }
+    if(nearChild != -1) {
+      stack[stackSize++] = {nearChild, level + 1};
     }
   }
 }
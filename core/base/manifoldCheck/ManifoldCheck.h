@@ -25,7 +25,7 @@
 
 // base code includes
 #include <Triangulation.h>
-#include <UnionFind.h>
+#include <UnionFindArray.h>
 
 namespace ttk {
 
@@ -249,12 +249,7 @@ int ttk::ManifoldCheck::vertexManifoldCheck(
     }
   }
 
-  std::vector<UnionFind> seeds(linkNeighbors.size());
-  std::vector<UnionFind *> seedList(linkNeighbors.size());
-
-  for(SimplexId i = 0; i < (SimplexId)seeds.size(); i++) {
-    seedList[i] = &(seeds[i]);
-  }
+  UnionFindArray<SimplexId> seeds(linkNeighbors.size());
 
   for(SimplexId i = 0; i < linkSize; i++) {
 
@@ -282,8 +277,7 @@ int ttk::ManifoldCheck::vertexManifoldCheck(
         }
       }
 
-      seedList[uf0] = UnionFind::makeUnion(seedList[uf0], seedList[uf1]);
-      seedList[uf1] = seedList[uf0];
+      seeds.makeUnion(uf0, uf1);
     }
 
     if(triangulation->getDimensionality() == 3) {
@@ -311,26 +305,13 @@ int ttk::ManifoldCheck::vertexManifoldCheck(
         }
       }
 
-      seedList[uf0] = UnionFind::makeUnion(seedList[uf0], seedList[uf1]);
-      seedList[uf0] = UnionFind::makeUnion(seedList[uf0], seedList[uf2]);
-      seedList[uf1] = seedList[uf0];
-      seedList[uf2] = seedList[uf0];
+      seeds.makeUnion(uf0, uf1);
+      seeds.makeUnion(uf0, uf2);
     }
   }
 
-  // let's remove duplicates now
-
-  // update the UF if necessary
-  for(SimplexId i = 0; i < (SimplexId)seedList.size(); i++) {
-    seedList[i] = seedList[i]->find();
-  }
-
-  std::vector<UnionFind *>::iterator it;
-  sort(seedList.begin(), seedList.end());
-  it = unique(seedList.begin(), seedList.end());
-  seedList.resize(distance(seedList.begin(), it));
-
-  return (SimplexId)seedList.size();
+  // one root per connected component
+  return (SimplexId)seeds.getSetNumber();
 }
 
 template <class triangulationType>
@@ -374,12 +355,7 @@ int ttk::ManifoldCheck::edgeManifoldCheck(
       linkNeighbors.push_back(neighborId);
   }
 
-  std::vector<UnionFind> seeds(linkNeighbors.size());
-  std::vector<UnionFind *> seedList(linkNeighbors.size());
-
-  for(SimplexId i = 0; i < (SimplexId)seeds.size(); i++) {
-    seedList[i] = &(seeds[i]);
-  }
+  UnionFindArray<SimplexId> seeds(linkNeighbors.size());
 
   for(SimplexId i = 0; i < linkSize; i++) {
 
@@ -406,21 +382,9 @@ int ttk::ManifoldCheck::edgeManifoldCheck(
       }
     }
 
-    seedList[uf0] = UnionFind::makeUnion(seedList[uf0], seedList[uf1]);
-    seedList[uf1] = seedList[uf0];
-  }
-
-  // let's remove duplicates now
-
-  // update the UF if necessary
-  for(SimplexId i = 0; i < (SimplexId)seedList.size(); i++) {
-    seedList[i] = seedList[i]->find();
+    seeds.makeUnion(uf0, uf1);
   }
 
-  std::vector<UnionFind *>::iterator it;
-  sort(seedList.begin(), seedList.end());
-  it = unique(seedList.begin(), seedList.end());
-  seedList.resize(distance(seedList.begin(), it));
-
-  return (SimplexId)seedList.size();
+  // one root per connected component
+  return (SimplexId)seeds.getSetNumber();
 }
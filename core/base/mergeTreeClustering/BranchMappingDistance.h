@@ -30,6 +30,7 @@
 // ttk common includes
 #include <AssignmentAuction.h>
 #include <AssignmentExhaustive.h>
+#include <AssignmentLAPJV.h>
 #include <AssignmentMunkres.h>
 #include <Debug.h>
 #include <FTMTree_MT.h>
@@ -480,6 +481,7 @@ namespace ttk {
                       AssignmentSolver<dataType> *assignmentSolver;
                       AssignmentExhaustive<dataType> solverExhaustive;
                       AssignmentMunkres<dataType> solverMunkres;
+                      AssignmentLAPJV<dataType> solverLAPJV;
                       AssignmentAuction<dataType> solverAuction;
                       switch(assignmentSolverID_) {
                         case 1:
@@ -490,6 +492,10 @@ namespace ttk {
                           solverMunkres = AssignmentMunkres<dataType>();
                           assignmentSolver = &solverMunkres;
                           break;
+                        case 3:
+                          solverLAPJV = AssignmentLAPJV<dataType>();
+                          assignmentSolver = &solverLAPJV;
+                          break;
                         case 0:
                         default:
                           solverAuction = AssignmentAuction<dataType>();
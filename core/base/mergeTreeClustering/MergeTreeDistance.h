@@ -23,11 +23,46 @@
 #include "MergeTreeBase.h"
 #include <AssignmentAuction.h>
 #include <AssignmentExhaustive.h>
+#include <AssignmentLAPJV.h>
 #include <AssignmentMunkres.h>
 #include <AssignmentSolver.h>
 
 namespace ttk {
 
+  /**
+   * Position of the cells of the edit distance tables in their buffer. Row 0
+   * and column 0 stand for the empty tree. Without keepSubtree, a node is
+   * only matched to the nodes of the same level in the other tree, so the
+   * other rows only store column 0 and the columns of their level.
+   */
+  struct EditDistanceLayout {
+    std::vector<size_t> rowOffsets{};
+    std::vector<size_t> colPositions{};
+    size_t size{};
+  };
+
+  /**
+   * Edit distance dynamic programming table stored in a single contiguous
+   * buffer, indexed by table(i, j).
+   */
+  template <class T>
+  class EditDistanceTable {
+  public:
+    void setLayout(const EditDistanceLayout &layout) {
+      layout_ = layout;
+      data_.assign(layout.size, T{});
+    }
+
+    inline T &operator()(const size_t i, const size_t j) {
+      return i == 0 ? data_[j]
+                    : data_[layout_.rowOffsets[i] + layout_.colPositions[j]];
+    }
+
+  private:
+    EditDistanceLayout layout_{};
+    std::vector<T> data_{};
+  };
+
   /**
    * The MergeTreeDistance class provides methods to compute distance
    * between two merge trees.
@@ -117,14 +152,30 @@ namespace ttk {
     // ------------------------------------------------------------------------
     // Assignment Problem
     // ------------------------------------------------------------------------
+    // Solvers, cost matrix and matchings reused by all the assignment
+    // problems solved by a thread (one table per thread and data type)
+    template <class dataType>
+    struct AssignmentScratch {
+      AssignmentExhaustive<dataType> solverExhaustive{};
+      AssignmentMunkres<dataType> solverMunkres{};
+      AssignmentLAPJV<dataType> solverLAPJV{};
+      AssignmentAuction<dataType> solverAuction{};
+      std::vector<std::vector<dataType>> costMatrix{};
+      std::vector<MatchingType> matchings{};
+    };
+
+    template <class dataType>
+    static AssignmentScratch<dataType> &getAssignmentScratch() {
+      static thread_local AssignmentScratch<dataType> scratch{};
+      return scratch;
+    }
+
     template <class dataType>
     void
       runAssignmentProblemSolver(std::vector<std::vector<dataType>> &costMatrix,
                                  std::vector<MatchingType> &matchings) {
+      auto &scratch = getAssignmentScratch<dataType>();
       AssignmentSolver<dataType> *assignmentSolver;
-      AssignmentExhaustive<dataType> solverExhaustive;
-      AssignmentMunkres<dataType> solverMunkres;
-      AssignmentAuction<dataType> solverAuction;
 
       int nRows = costMatrix.size() - 1;
       int nCols = costMatrix[0].size() - 1;
@@ -137,28 +188,32 @@ namespace ttk {
 
       switch(assignmentSolverID) {
         case 1:
-          solverExhaustive = AssignmentExhaustive<dataType>();
-          assignmentSolver = &solverExhaustive;
+          assignmentSolver = &scratch.solverExhaustive;
           break;
         case 2:
-          solverMunkres = AssignmentMunkres<dataType>();
-          assignmentSolver = &solverMunkres;
+          assignmentSolver = &scratch.solverMunkres;
+          break;
+        case 3:
+          assignmentSolver = &scratch.solverLAPJV;
           break;
         case 0:
         default:
-          solverAuction = AssignmentAuction<dataType>();
+          auto &solverAuction = scratch.solverAuction;
           solverAuction.setEpsilon(auctionEpsilon_);
           solverAuction.setEpsilonDiviserMultiplier(auctionEpsilonDiviser_);
           solverAuction.setNumberOfRounds(auctionRound_);
+          // do not warm start from the prices of the previous problem
+          solverAuction.setPrices({});
           assignmentSolver = &solverAuction;
       }
+      assignmentSolver->clear();
       assignmentSolver->setInput(costMatrix);
       assignmentSolver->setBalanced(false);
       assignmentSolver->run(matchings);
     }
 
     template <class dataType>
-    void createCostMatrix(std::vector<std::vector<dataType>> &treeTable,
+    void createCostMatrix(EditDistanceTable<dataType> &treeTable,
                           std::vector<ftm::idNode> &children1,
                           std::vector<ftm::idNode> &children2,
                           std::vector<std::vector<dataType>> &costMatrix) {
@@ -168,18 +223,18 @@ namespace ttk {
         for(unsigned int j = 0; j < nCols; ++j) {
           int forestTableJ = children2[j] + 1;
           // Cost of assigning i and j
-          costMatrix[i][j] = treeTable[forestTableI][forestTableJ];
+          costMatrix[i][j] = treeTable(forestTableI, forestTableJ);
           if(tree1Level_[children1[i]] != tree2Level_[children2[j]]
              and not keepSubtree_)
             printErr("different levels!"); // should be impossible
         }
         // Cost of not assigning i
-        costMatrix[i][nCols] = treeTable[forestTableI][0];
+        costMatrix[i][nCols] = treeTable(forestTableI, 0);
       }
       for(unsigned int j = 0; j < nCols; ++j) {
         int forestTableJ = children2[j] + 1;
         // Cost of not assigning j
-        costMatrix[nRows][j] = treeTable[0][forestTableJ];
+        costMatrix[nRows][j] = treeTable(0, forestTableJ);
       }
       costMatrix[nRows][nCols] = 0;
     }
@@ -207,20 +262,24 @@ namespace ttk {
     dataType forestAssignmentProblem(
       ftm::FTMTree_MT *ttkNotUsed(tree1),
       ftm::FTMTree_MT *ttkNotUsed(tree2),
-      std::vector<std::vector<dataType>> &treeTable,
+      EditDistanceTable<dataType> &treeTable,
       std::vector<ftm::idNode> &children1,
       std::vector<ftm::idNode> &children2,
       std::vector<std::tuple<int, int>> &forestAssignment) {
       // --- Create cost matrix
       int nRows = children1.size(), nCols = children2.size();
-      std::vector<std::vector<dataType>> costMatrix(
-        nRows + 1, std::vector<dataType>(nCols + 1));
+      auto &scratch = getAssignmentScratch<dataType>();
+      auto &costMatrix = scratch.costMatrix;
+      costMatrix.resize(nRows + 1);
+      for(auto &row : costMatrix)
+        row.resize(nCols + 1);
       createCostMatrix(treeTable, children1, children2, costMatrix);
 
       // assignmentProblemSize[costMatrix.size()*costMatrix[0].size()]++;
 
       // --- Solve assignment problem
-      std::vector<MatchingType> matchings;
+      auto &matchings = scratch.matchings;
+      matchings.clear();
       runAssignmentProblemSolver(costMatrix, matchings);
 
       // --- Postprocess matching to create output assignment
@@ -236,10 +295,9 @@ namespace ttk {
       ftm::FTMTree_MT *tree2,
       int i,
       int j,
-      std::vector<std::vector<dataType>> &treeTable,
-      std::vector<std::vector<dataType>> &forestTable,
-      std::vector<std::vector<std::vector<std::tuple<int, int>>>>
-        &forestBackTable,
+      EditDistanceTable<dataType> &treeTable,
+      EditDistanceTable<dataType> &forestTable,
+      EditDistanceTable<std::vector<std::tuple<int, int>>> &forestBackTable,
       std::vector<ftm::idNode> &children1,
       std::vector<ftm::idNode> &children2) {
       if(children1.size() != 0 && children2.size() != 0) {
@@ -255,9 +313,9 @@ namespace ttk {
 
         if(not keepSubtree_) {
           // Compute table value
-          forestTable[i][j] = forestTerm3;
+          forestTable(i, j) = forestTerm3;
           // Add backtracking information
-          forestBackTable[i][j] = forestAssignment;
+          forestBackTable(i, j) = forestAssignment;
         } else {
           dataType forestTerm1, forestTerm2;
           std::tuple<dataType, ftm::idNode> forestCoTerm1, forestCoTerm2;
@@ -265,32 +323,32 @@ namespace ttk {
           // Term 1
           forestCoTerm1
             = computeTerm1_2<dataType>(children2, i, forestTable, true);
-          forestTerm1 = forestTable[0][j] + std::get<0>(forestCoTerm1);
+          forestTerm1 = forestTable(0, j) + std::get<0>(forestCoTerm1);
 
           // Term2
           forestCoTerm2
             = computeTerm1_2<dataType>(children1, j, forestTable, false);
-          forestTerm2 = forestTable[i][0] + std::get<0>(forestCoTerm2);
+          forestTerm2 = forestTable(i, 0) + std::get<0>(forestCoTerm2);
 
           // Compute table value
-          forestTable[i][j]
+          forestTable(i, j)
             = std::min(std::min(forestTerm1, forestTerm2), forestTerm3);
 
           // Add backtracking information
-          if(forestTable[i][j] == forestTerm3) {
-            forestBackTable[i][j] = forestAssignment;
-          } else if(forestTable[i][j] == forestTerm2) {
-            forestBackTable[i][j].push_back(
+          if(forestTable(i, j) == forestTerm3) {
+            forestBackTable(i, j) = forestAssignment;
+          } else if(forestTable(i, j) == forestTerm2) {
+            forestBackTable(i, j).push_back(
               std::make_tuple(std::get<1>(forestCoTerm2), j));
           } else {
-            forestBackTable[i][j].push_back(
+            forestBackTable(i, j).push_back(
               std::make_tuple(i, std::get<1>(forestCoTerm1)));
           }
         }
       } else {
         // If one of the forest is empty we get back to equation 8 or 10
-        forestTable[i][j]
-          = (children1.size() == 0) ? forestTable[0][j] : forestTable[i][0];
+        forestTable(i, j)
+          = (children1.size() == 0) ? forestTable(0, j) : forestTable(i, 0);
       }
     }
 
@@ -302,13 +360,13 @@ namespace ttk {
       ftm::FTMTree_MT *tree1,
       ftm::idNode nodeI,
       int i,
-      std::vector<std::vector<dataType>> &treeTable,
-      std::vector<std::vector<dataType>> &forestTable) {
+      EditDistanceTable<dataType> &treeTable,
+      EditDistanceTable<dataType> &forestTable) {
       std::vector<ftm::idNode> children;
       tree1->getChildren(nodeI, children);
-      forestTable[i][0] = 0;
+      forestTable(i, 0) = 0;
       for(ftm::idNode child : children)
-        forestTable[i][0] += treeTable[child + 1][0];
+        forestTable(i, 0) += treeTable(child + 1, 0);
     }
 
     template <class dataType>
@@ -316,9 +374,9 @@ namespace ttk {
       ftm::FTMTree_MT *tree1,
       ftm::idNode nodeI,
       int i,
-      std::vector<std::vector<dataType>> &treeTable,
-      std::vector<std::vector<dataType>> &forestTable) {
-      treeTable[i][0] = forestTable[i][0] + deleteCost<dataType>(tree1, nodeI);
+      EditDistanceTable<dataType> &treeTable,
+      EditDistanceTable<dataType> &forestTable) {
+      treeTable(i, 0) = forestTable(i, 0) + deleteCost<dataType>(tree1, nodeI);
     }
 
     template <class dataType>
@@ -326,13 +384,13 @@ namespace ttk {
       ftm::FTMTree_MT *tree2,
       ftm::idNode nodeJ,
       int j,
-      std::vector<std::vector<dataType>> &treeTable,
-      std::vector<std::vector<dataType>> &forestTable) {
+      EditDistanceTable<dataType> &treeTable,
+      EditDistanceTable<dataType> &forestTable) {
       std::vector<ftm::idNode> children;
       tree2->getChildren(nodeJ, children);
-      forestTable[0][j] = 0;
+      forestTable(0, j) = 0;
       for(ftm::idNode child : children)
-        forestTable[0][j] += treeTable[0][child + 1];
+        forestTable(0, j) += treeTable(0, child + 1);
     }
 
     template <class dataType>
@@ -340,9 +398,9 @@ namespace ttk {
       ftm::FTMTree_MT *tree2,
       ftm::idNode nodeJ,
       int j,
-      std::vector<std::vector<dataType>> &treeTable,
-      std::vector<std::vector<dataType>> &forestTable) {
-      treeTable[0][j] = forestTable[0][j] + insertCost<dataType>(tree2, nodeJ);
+      EditDistanceTable<dataType> &treeTable,
+      EditDistanceTable<dataType> &forestTable) {
+      treeTable(0, j) = forestTable(0, j) + insertCost<dataType>(tree2, nodeJ);
     }
 
     // Compute first or second term of forests and subtrees distance
@@ -350,19 +408,19 @@ namespace ttk {
     std::tuple<dataType, ftm::idNode>
       computeTerm1_2(std::vector<ftm::idNode> &childrens,
                      int ind,
-                     std::vector<std::vector<dataType>> &table,
+                     EditDistanceTable<dataType> &table,
                      bool computeTerm1) {
       dataType tempMin = (childrens.size() == 0)
-                           ? ((computeTerm1) ? table[ind][0] : table[0][ind])
+                           ? ((computeTerm1) ? table(ind, 0) : table(0, ind))
                            : std::numeric_limits<dataType>::max();
       ftm::idNode bestIdNode = 0;
       for(ftm::idNode children : childrens) {
         children += 1;
         dataType temp;
         if(computeTerm1) {
-          temp = table[ind][children] - table[0][children];
+          temp = table(ind, children) - table(0, children);
         } else {
-          temp = table[children][ind] - table[children][0];
+          temp = table(children, ind) - table(children, 0);
         }
         if(temp < tempMin) {
           tempMin = temp;
@@ -380,44 +438,44 @@ namespace ttk {
       int j,
       ftm::idNode nodeI,
       ftm::idNode nodeJ,
-      std::vector<std::vector<dataType>> &treeTable,
-      std::vector<std::vector<dataType>> &forestTable,
-      std::vector<std::vector<std::tuple<int, int>>> &treeBackTable,
+      EditDistanceTable<dataType> &treeTable,
+      EditDistanceTable<dataType> &forestTable,
+      EditDistanceTable<std::tuple<int, int>> &treeBackTable,
       std::vector<ftm::idNode> &children1,
       std::vector<ftm::idNode> &children2) {
       dataType treeTerm3;
 
       // Term 3
       treeTerm3
-        = forestTable[i][j] + relabelCost<dataType>(tree1, nodeI, tree2, nodeJ);
+        = forestTable(i, j) + relabelCost<dataType>(tree1, nodeI, tree2, nodeJ);
 
       if(not keepSubtree_) {
         // Compute table value
-        treeTable[i][j] = treeTerm3;
+        treeTable(i, j) = treeTerm3;
         // Add backtracking information
-        treeBackTable[i][j] = std::make_tuple(i, j);
+        treeBackTable(i, j) = std::make_tuple(i, j);
       } else {
         dataType treeTerm1, treeTerm2;
         std::tuple<dataType, ftm::idNode> treeCoTerm1, treeCoTerm2;
 
         // Term 1
         treeCoTerm1 = computeTerm1_2<dataType>(children2, i, treeTable, true);
-        treeTerm1 = treeTable[0][j] + std::get<0>(treeCoTerm1);
+        treeTerm1 = treeTable(0, j) + std::get<0>(treeCoTerm1);
 
         // Term 2
         treeCoTerm2 = computeTerm1_2<dataType>(children1, j, treeTable, false);
-        treeTerm2 = treeTable[i][0] + std::get<0>(treeCoTerm2);
+        treeTerm2 = treeTable(i, 0) + std::get<0>(treeCoTerm2);
 
         // Compute table value
-        treeTable[i][j] = std::min(std::min(treeTerm1, treeTerm2), treeTerm3);
+        treeTable(i, j) = std::min(std::min(treeTerm1, treeTerm2), treeTerm3);
 
         // Add backtracking information
-        if(treeTable[i][j] == treeTerm3) {
-          treeBackTable[i][j] = std::make_tuple(i, j);
-        } else if(treeTable[i][j] == treeTerm2) {
-          treeBackTable[i][j] = std::make_tuple(std::get<1>(treeCoTerm2), j);
+        if(treeTable(i, j) == treeTerm3) {
+          treeBackTable(i, j) = std::make_tuple(i, j);
+        } else if(treeTable(i, j) == treeTerm2) {
+          treeBackTable(i, j) = std::make_tuple(std::get<1>(treeCoTerm2), j);
         } else {
-          treeBackTable[i][j] = std::make_tuple(i, std::get<1>(treeCoTerm1));
+          treeBackTable(i, j) = std::make_tuple(i, std::get<1>(treeCoTerm1));
         }
       }
     }
@@ -429,9 +487,8 @@ namespace ttk {
     void computeMatching(
       ftm::FTMTree_MT *tree1,
       ftm::FTMTree_MT *tree2,
-      std::vector<std::vector<std::tuple<int, int>>> &treeBackTable,
-      std::vector<std::vector<std::vector<std::tuple<int, int>>>>
-        &forestBackTable,
+      EditDistanceTable<std::tuple<int, int>> &treeBackTable,
+      EditDistanceTable<std::vector<std::tuple<int, int>>> &forestBackTable,
       std::vector<std::tuple<ftm::idNode, ftm::idNode, double>> &outputMatching,
       int startR,
       int startC) {
@@ -446,8 +503,8 @@ namespace ttk {
         int j = std::get<1>(elem);
 
         if(useTreeTable) {
-          int tupleI = std::get<0>(treeBackTable[i][j]);
-          int tupleJ = std::get<1>(treeBackTable[i][j]);
+          int tupleI = std::get<0>(treeBackTable(i, j));
+          int tupleJ = std::get<1>(treeBackTable(i, j));
           if(tupleI != 0 && tupleJ != 0) {
             useTreeTable = (tupleI != i || tupleJ != j);
             backQueue.emplace(std::make_tuple(tupleI, tupleJ, useTreeTable));
@@ -462,7 +519,7 @@ namespace ttk {
             }
           }
         } else {
-          for(std::tuple<int, int> forestBackElem : forestBackTable[i][j]) {
+          for(std::tuple<int, int> forestBackElem : forestBackTable(i, j)) {
             int tupleI = std::get<0>(forestBackElem);
             int tupleJ = std::get<1>(forestBackElem);
             if(tupleI != 0 && tupleJ != 0) {
@@ -477,6 +534,34 @@ namespace ttk {
     // ------------------------------------------------------------------------
     // Main Functions
     // ------------------------------------------------------------------------
+    void getEditDistanceLayout(const size_t nRows,
+                               const size_t nCols,
+                               EditDistanceLayout &layout) {
+      layout.rowOffsets.resize(nRows);
+      layout.colPositions.resize(nCols);
+      if(keepSubtree_) {
+        for(size_t i = 0; i < nRows; ++i)
+          layout.rowOffsets[i] = i * nCols;
+        for(size_t j = 0; j < nCols; ++j)
+          layout.colPositions[j] = j;
+        layout.size = nRows * nCols;
+        return;
+      }
+      layout.colPositions[0] = 0;
+      for(const auto &levelNodes : tree2LevelToNode_)
+        for(size_t r = 0; r < levelNodes.size(); ++r)
+          layout.colPositions[levelNodes[r] + 1] = r + 1;
+      layout.size = nCols;
+      for(size_t i = 1; i < nRows; ++i) {
+        layout.rowOffsets[i] = layout.size;
+        const auto level = static_cast<size_t>(tree1Level_[i - 1]);
+        layout.size += 1
+                       + (level < tree2LevelToNode_.size()
+                            ? tree2LevelToNode_[level].size()
+                            : 0);
+      }
+    }
+
     template <class dataType>
     dataType
       computeDistance(ftm::FTMTree_MT *tree1,
@@ -488,33 +573,34 @@ namespace ttk {
       // --------------------
       size_t nRows = tree1->getNumberOfNodes() + 1;
       size_t nCols = tree2->getNumberOfNodes() + 1;
-      std::vector<std::vector<dataType>> treeTable(
-        nRows, std::vector<dataType>(nCols));
-      std::vector<std::vector<dataType>> forestTable(
-        nRows, std::vector<dataType>(nCols));
+
+      tree1->getAllNodeLevel(tree1Level_);
+      tree2->getAllNodeLevel(tree2Level_);
+      tree2->getLevelToNode(tree2LevelToNode_);
+
+      EditDistanceLayout layout{};
+      getEditDistanceLayout(nRows, nCols, layout);
+      EditDistanceTable<dataType> treeTable{}, forestTable{};
+      treeTable.setLayout(layout);
+      forestTable.setLayout(layout);
 
       // Backtracking tables (output matching)
-      std::vector<std::vector<std::tuple<int, int>>> treeBackTable(
-        nRows, std::vector<std::tuple<int, int>>(nCols));
-      std::vector<std::vector<std::vector<std::tuple<int, int>>>>
-        forestBackTable(
-          nRows, std::vector<std::vector<std::tuple<int, int>>>(nCols));
+      EditDistanceTable<std::tuple<int, int>> treeBackTable{};
+      EditDistanceTable<std::vector<std::tuple<int, int>>> forestBackTable{};
+      treeBackTable.setLayout(layout);
+      forestBackTable.setLayout(layout);
 
       int indR = tree1->getRoot() + 1;
       int indC = tree2->getRoot() + 1;
 
-      tree1->getAllNodeLevel(tree1Level_);
-      tree2->getAllNodeLevel(tree2Level_);
-      tree2->getLevelToNode(tree2LevelToNode_);
-
       // ---------------------
       // ----- Compute edit distance
       // --------------------
       computeEditDistance(tree1, tree2, treeTable, forestTable, treeBackTable,
                           forestBackTable, nRows, nCols);
-      dataType distance = treeTable[indR][indC];
+      dataType distance = treeTable(indR, indC);
       if(onlyEmptyTreeDistance_)
-        distance = treeTable[indR][0];
+        distance = treeTable(indR, 0);
       if(branchDecomposition_) {
         if(not useMinMaxPair_) {
           if(onlyEmptyTreeDistance_)
@@ -653,11 +739,10 @@ namespace ttk {
     void computeEditDistance(
       ftm::FTMTree_MT *tree1,
       ftm::FTMTree_MT *tree2,
-      std::vector<std::vector<dataType>> &treeTable,
-      std::vector<std::vector<dataType>> &forestTable,
-      std::vector<std::vector<std::tuple<int, int>>> &treeBackTable,
-      std::vector<std::vector<std::vector<std::tuple<int, int>>>>
-        &forestBackTable,
+      EditDistanceTable<dataType> &treeTable,
+      EditDistanceTable<dataType> &forestTable,
+      EditDistanceTable<std::tuple<int, int>> &treeBackTable,
+      EditDistanceTable<std::vector<std::tuple<int, int>>> &forestBackTable,
       int nRows,
       int nCols) {
       Timer t_dyn;
@@ -700,11 +785,10 @@ namespace ttk {
       bool computeEmptyTree,
       ftm::idNode nodeI,
       ftm::idNode nodeJ,
-      std::vector<std::vector<dataType>> &treeTable,
-      std::vector<std::vector<dataType>> &forestTable,
-      std::vector<std::vector<std::tuple<int, int>>> &treeBackTable,
-      std::vector<std::vector<std::vector<std::tuple<int, int>>>>
-        &forestBackTable,
+      EditDistanceTable<dataType> &treeTable,
+      EditDistanceTable<dataType> &forestTable,
+      EditDistanceTable<std::tuple<int, int>> &treeBackTable,
+      EditDistanceTable<std::vector<std::tuple<int, int>>> &forestBackTable,
       int nRows,
       int nCols) {
       if(processTree1) {
@@ -771,11 +855,10 @@ namespace ttk {
     void parallelEditDistance(
       ftm::FTMTree_MT *tree1,
       ftm::FTMTree_MT *tree2,
-      std::vector<std::vector<dataType>> &treeTable,
-      std::vector<std::vector<dataType>> &forestTable,
-      std::vector<std::vector<std::tuple<int, int>>> &treeBackTable,
-      std::vector<std::vector<std::vector<std::tuple<int, int>>>>
-        &forestBackTable,
+      EditDistanceTable<dataType> &treeTable,
+      EditDistanceTable<dataType> &forestTable,
+      EditDistanceTable<std::tuple<int, int>> &treeBackTable,
+      EditDistanceTable<std::vector<std::tuple<int, int>>> &forestBackTable,
       int ttkNotUsed(nRows),
       int ttkNotUsed(nCols)) {
       std::vector<int> tree1NodeChildSize, tree2NodeChildSize;
@@ -824,16 +907,14 @@ namespace ttk {
       std::vector<int> &tree1NodeChildSize,
       std::vector<ftm::idNode> &tree2Leaves,
       std::vector<int> &tree2NodeChildSize,
-      std::vector<std::vector<dataType>> &treeTable,
-      std::vector<std::vector<dataType>> &forestTable,
-      std::vector<std::vector<std::tuple<int, int>>> &treeBackTable,
-      std::vector<std::vector<std::vector<std::tuple<int, int>>>>
-        &forestBackTable,
+      EditDistanceTable<dataType> &treeTable,
+      EditDistanceTable<dataType> &forestTable,
+      EditDistanceTable<std::tuple<int, int>> &treeBackTable,
+      EditDistanceTable<std::vector<std::tuple<int, int>>> &forestBackTable,
       bool firstCall = false) {
       ftm::idNode nodeT = -1;
       ftm::FTMTree_MT *treeT = (isTree1) ? tree1 : tree2;
       std::vector<int> treeChildDone(treeT->getNumberOfNodes(), 0);
-      std::vector<bool> treeNodeDone(treeT->getNumberOfNodes(), false);
       std::queue<ftm::idNode> treeQueue;
 
       if(isTree1)
@@ -851,13 +932,13 @@ namespace ttk {
                                  tree1NodeChildSize, tree2Leaves,
                                  tree2NodeChildSize, treeTable, forestTable,
                                  treeBackTable, forestBackTable, firstCall,
-                                 nodeT, treeChildDone, treeNodeDone, treeQueue);
+                                 nodeT, treeChildDone, treeQueue);
       else
         parallelTreeDistanceTask(tree1, tree2, isTree1, i, tree1Leaves,
                                  tree1NodeChildSize, tree2Leaves,
                                  tree2NodeChildSize, treeTable, forestTable,
                                  treeBackTable, forestBackTable, nodeT,
-                                 treeChildDone, treeNodeDone, treeQueue);
+                                 treeChildDone, treeQueue);
     }
 
     // (isCalled_=false)
@@ -871,15 +952,13 @@ namespace ttk {
       std::vector<int> &tree1NodeChildSize,
       std::vector<ftm::idNode> &tree2Leaves,
       std::vector<int> &tree2NodeChildSize,
-      std::vector<std::vector<dataType>> &treeTable,
-      std::vector<std::vector<dataType>> &forestTable,
-      std::vector<std::vector<std::tuple<int, int>>> &treeBackTable,
-      std::vector<std::vector<std::vector<std::tuple<int, int>>>>
-        &forestBackTable,
+      EditDistanceTable<dataType> &treeTable,
+      EditDistanceTable<dataType> &forestTable,
+      EditDistanceTable<std::tuple<int, int>> &treeBackTable,
+      EditDistanceTable<std::vector<std::tuple<int, int>>> &forestBackTable,
       bool firstCall,
       ftm::idNode nodeT,
       std::vector<int> &treeChildDone,
-      std::vector<bool> &treeNodeDone,
       std::queue<ftm::idNode> &treeQueue) {
 #ifdef TTK_ENABLE_OPENMP
 #pragma omp parallel num_threads(this->threadNumber_) if(firstCall)
@@ -890,7 +969,7 @@ namespace ttk {
                                  tree1NodeChildSize, tree2Leaves,
                                  tree2NodeChildSize, treeTable, forestTable,
                                  treeBackTable, forestBackTable, nodeT,
-                                 treeChildDone, treeNodeDone, treeQueue);
+                                 treeChildDone, treeQueue);
 #ifdef TTK_ENABLE_OPENMP
       } // pragma omp parallel
 #endif
@@ -908,14 +987,12 @@ namespace ttk {
       std::vector<int> &tree1NodeChildSize,
       std::vector<ftm::idNode> &tree2Leaves,
       std::vector<int> &tree2NodeChildSize,
-      std::vector<std::vector<dataType>> &treeTable,
-      std::vector<std::vector<dataType>> &forestTable,
-      std::vector<std::vector<std::tuple<int, int>>> &treeBackTable,
-      std::vector<std::vector<std::vector<std::tuple<int, int>>>>
-        &forestBackTable,
+      EditDistanceTable<dataType> &treeTable,
+      EditDistanceTable<dataType> &forestTable,
+      EditDistanceTable<std::tuple<int, int>> &treeBackTable,
+      EditDistanceTable<std::vector<std::tuple<int, int>>> &forestBackTable,
       ftm::idNode nodeT,
       std::vector<int> &treeChildDone,
-      std::vector<bool> &treeNodeDone,
       std::queue<ftm::idNode> &treeQueue) {
       int nodePerTask = nodePerTask_;
       while(!treeQueue.empty()) {
@@ -930,7 +1007,7 @@ namespace ttk {
 #ifdef TTK_ENABLE_OPENMP
 #pragma omp task firstprivate(taskQueue, nodeT) UNTIED()         \
   shared(treeTable, forestTable, treeBackTable, forestBackTable, \
-         treeChildDone, treeNodeDone) if(isTree1)
+         treeChildDone) if(isTree1 or not treeQueue.empty())
         {
 #endif
           ftm::FTMTree_MT *treeT = (isTree1) ? tree1 : tree2;
@@ -982,11 +1059,10 @@ namespace ttk {
 #ifdef TTK_ENABLE_OPENMP
             } // pragma omp atomic capture
 #endif
-            if(not treeNodeDone[nodeTParent]
-               and oldTreeChildDone + 1 == childSize) {
+            // only the last child to finish reaches the child count
+            if(oldTreeChildDone + 1 == childSize) {
               // nodeT = nodeTParent;
               taskQueue.emplace(nodeTParent);
-              treeNodeDone[nodeTParent] = true;
 #ifdef TTK_ENABLE_OPENMP
 #pragma omp taskyield
 #endif
@@ -1010,14 +1086,12 @@ namespace ttk {
       bool isTree1,
       std::vector<ftm::idNode> &treeLeaves,
       std::vector<int> &treeNodeChildSize,
-      std::vector<std::vector<dataType>> &treeTable,
-      std::vector<std::vector<dataType>> &forestTable,
-      std::vector<std::vector<std::tuple<int, int>>> &treeBackTable,
-      std::vector<std::vector<std::vector<std::tuple<int, int>>>>
-        &forestBackTable) {
+      EditDistanceTable<dataType> &treeTable,
+      EditDistanceTable<dataType> &forestTable,
+      EditDistanceTable<std::tuple<int, int>> &treeBackTable,
+      EditDistanceTable<std::vector<std::tuple<int, int>>> &forestBackTable) {
       ftm::idNode nodeT = -1;
       std::vector<int> treeChildDone(tree->getNumberOfNodes(), 0);
-      std::vector<bool> treeNodeDone(tree->getNumberOfNodes(), false);
       std::queue<ftm::idNode> treeQueue;
       for(ftm::idNode leaf : treeLeaves)
         treeQueue.emplace(leaf);
@@ -1025,12 +1099,12 @@ namespace ttk {
         parallelEmptyTreeDistancePara(tree, isTree1, treeLeaves,
                                       treeNodeChildSize, treeTable, forestTable,
                                       treeBackTable, forestBackTable, nodeT,
-                                      treeChildDone, treeNodeDone, treeQueue);
+                                      treeChildDone, treeQueue);
       else
         parallelEmptyTreeDistanceTask(tree, isTree1, treeLeaves,
                                       treeNodeChildSize, treeTable, forestTable,
                                       treeBackTable, forestBackTable, nodeT,
-                                      treeChildDone, treeNodeDone, treeQueue);
+                                      treeChildDone, treeQueue);
     }
 
     template <class dataType>
@@ -1039,14 +1113,12 @@ namespace ttk {
       bool isTree1,
       std::vector<ftm::idNode> &treeLeaves,
       std::vector<int> &treeNodeChildSize,
-      std::vector<std::vector<dataType>> &treeTable,
-      std::vector<std::vector<dataType>> &forestTable,
-      std::vector<std::vector<std::tuple<int, int>>> &treeBackTable,
-      std::vector<std::vector<std::vector<std::tuple<int, int>>>>
-        &forestBackTable,
+      EditDistanceTable<dataType> &treeTable,
+      EditDistanceTable<dataType> &forestTable,
+      EditDistanceTable<std::tuple<int, int>> &treeBackTable,
+      EditDistanceTable<std::vector<std::tuple<int, int>>> &forestBackTable,
       ftm::idNode nodeT,
       std::vector<int> &treeChildDone,
-      std::vector<bool> &treeNodeDone,
       std::queue<ftm::idNode> &treeQueue) {
 #ifdef TTK_ENABLE_OPENMP
 #pragma omp parallel num_threads(this->threadNumber_)
@@ -1056,7 +1128,7 @@ namespace ttk {
         parallelEmptyTreeDistanceTask(tree, isTree1, treeLeaves,
                                       treeNodeChildSize, treeTable, forestTable,
                                       treeBackTable, forestBackTable, nodeT,
-                                      treeChildDone, treeNodeDone, treeQueue);
+                                      treeChildDone, treeQueue);
 #ifdef TTK_ENABLE_OPENMP
       } // pragma omp parallel
 #endif
@@ -1068,14 +1140,12 @@ namespace ttk {
       bool isTree1,
       std::vector<ftm::idNode> &ttkNotUsed(treeLeaves),
       std::vector<int> &treeNodeChildSize,
-      std::vector<std::vector<dataType>> &treeTable,
-      std::vector<std::vector<dataType>> &forestTable,
-      std::vector<std::vector<std::tuple<int, int>>> &treeBackTable,
-      std::vector<std::vector<std::vector<std::tuple<int, int>>>>
-        &forestBackTable,
+      EditDistanceTable<dataType> &treeTable,
+      EditDistanceTable<dataType> &forestTable,
+      EditDistanceTable<std::tuple<int, int>> &treeBackTable,
+      EditDistanceTable<std::vector<std::tuple<int, int>>> &forestBackTable,
       ftm::idNode nodeT,
       std::vector<int> &treeChildDone,
-      std::vector<bool> &treeNodeDone,
       std::queue<ftm::idNode> &treeQueue) {
       while(!treeQueue.empty()) {
         nodeT = treeQueue.front();
@@ -1084,7 +1154,7 @@ namespace ttk {
 #ifdef TTK_ENABLE_OPENMP
 #pragma omp task firstprivate(nodeT) UNTIED()                    \
   shared(treeTable, forestTable, treeBackTable, forestBackTable, \
-         treeChildDone, treeNodeDone)
+         treeChildDone)
         {
 #endif
           while((int)nodeT != -1) {
@@ -1120,10 +1190,9 @@ namespace ttk {
 #ifdef TTK_ENABLE_OPENMP
             } // pragma omp atomic capture
 #endif
-            if(not treeNodeDone[nodeTParent]
-               and oldTreeChildDone + 1 == treeNodeChildSize[nodeTParent]) {
+            // only the last child to finish reaches the child count
+            if(oldTreeChildDone + 1 == treeNodeChildSize[nodeTParent]) {
               nodeT = nodeTParent;
-              treeNodeDone[nodeTParent] = true;
 #ifdef TTK_ENABLE_OPENMP
 #pragma omp taskyield
 #endif
@@ -30,6 +30,7 @@
 // ttk common includes
 #include <AssignmentAuction.h>
 #include <AssignmentExhaustive.h>
+#include <AssignmentLAPJV.h>
 #include <AssignmentMunkres.h>
 #include <Debug.h>
 #include <FTMTree_MT.h>
@@ -225,6 +226,7 @@ namespace ttk {
           AssignmentSolver<dataType> *assignmentSolver;
           AssignmentExhaustive<dataType> solverExhaustive;
           AssignmentMunkres<dataType> solverMunkres;
+          AssignmentLAPJV<dataType> solverLAPJV;
           AssignmentAuction<dataType> solverAuction;
           switch(assignmentSolverID_) {
             case 1:
@@ -235,6 +237,10 @@ namespace ttk {
               solverMunkres = AssignmentMunkres<dataType>();
               assignmentSolver = &solverMunkres;
               break;
+            case 3:
+              solverLAPJV = AssignmentLAPJV<dataType>();
+              assignmentSolver = &solverLAPJV;
+              break;
             case 0:
             default:
               solverAuction = AssignmentAuction<dataType>();
@@ -552,6 +558,7 @@ namespace ttk {
                   AssignmentSolver<dataType> *assignmentSolver;
                   AssignmentExhaustive<dataType> solverExhaustive;
                   AssignmentMunkres<dataType> solverMunkres;
+                  AssignmentLAPJV<dataType> solverLAPJV;
                   AssignmentAuction<dataType> solverAuction;
                   switch(assignmentSolverID_) {
                     case 1:
@@ -562,6 +569,10 @@ namespace ttk {
                       solverMunkres = AssignmentMunkres<dataType>();
                       assignmentSolver = &solverMunkres;
                       break;
+                    case 3:
+                      solverLAPJV = AssignmentLAPJV<dataType>();
+                      assignmentSolver = &solverLAPJV;
+                      break;
                     case 0:
                     default:
                       solverAuction = AssignmentAuction<dataType>();
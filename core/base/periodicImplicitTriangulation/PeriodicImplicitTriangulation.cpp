@@ -22,6 +22,9 @@ int PeriodicImplicitTriangulation::setInputGrid(const float &xOrigin,
                                                 const int &yDim,
                                                 const int &zDim) {
 
+  // the cached gradients were computed on the previous grid
+  this->resetGradientCache();
+
   // Dimensionality //
   if(xDim < 1 or yDim < 1 or zDim < 1)
     dimensionality_ = -1;
@@ -172,6 +172,9 @@ namespace ttk {
     inline void setComputeSadMax(const bool data) {
       this->dms_.setComputeSadMax(data);
     }
+    inline void setReleaseMemory(const bool data) {
+      this->dms_.setReleaseMemory(data);
+    }
 
     /**
      * @brief Complete a ttk::DiagramType instance with scalar field
@@ -501,6 +504,8 @@ int ttk::PersistenceDiagram::executeDiscreteMorseSandwich(
   Timer tm{};
   const auto dim = triangulation->getDimensionality();
 
+  dms_.setDebugLevel(this->debugLevel_);
+  dms_.setThreadNumber(this->threadNumber_);
   dms_.buildGradient(inputScalars, scalarsMTime, inputOffsets, *triangulation);
   std::vector<DiscreteMorseSandwich::PersistencePair> dms_pairs{};
   dms_.computePersistencePairs(
@@ -0,0 +1,165 @@
+/// \ingroup base
+/// \class ttk::PersistenceDiagramBatch
+/// \date October 2026.
+///
+/// \brief Persistence diagrams of a batch of scalar fields defined on the
+/// same triangulation (e.g. the time steps of an ensemble).
+///
+/// The triangulation is preconditioned once for the whole batch. The fields
+/// are dispatched dynamically to a pool of ttk::PersistenceDiagram workers
+/// that keep their working buffers from one field to the next (and from one
+/// execute() call to the next), see
+/// ttk::DiscreteMorseSandwich::setReleaseMemory().
+///
+/// The threads are split between the fields and the inner parallelism of
+/// each computation: with K fields and T threads, min(K, T) workers run
+/// concurrently with T / min(K, T) threads each (the remainder going to the
+/// first workers). Many fields are hence processed one per thread, while a
+/// handful of fields still use the whole machine.
+///
+/// \sa ttk::PersistenceDiagram
+/// \sa ttk::TrackingFromFields
+
+#pragma once
+
+#include <PersistenceDiagram.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+namespace ttk {
+
+  class PersistenceDiagramBatch : virtual public Debug {
+
+  public:
+    PersistenceDiagramBatch() {
+      this->setDebugMsgPrefix("PersistenceDiagramBatch");
+    }
+
+    inline void setBackend(const PersistenceDiagram::BACKEND be) {
+      if(be != this->BackEnd) {
+        this->workers_.clear();
+      }
+      this->BackEnd = be;
+    }
+
+    inline void
+      preconditionTriangulation(AbstractTriangulation *triangulation) {
+      // the preconditioned data structures live in the triangulation and
+      // are shared by the workers
+      PersistenceDiagram pd{};
+      pd.setDebugLevel(this->debugLevel_);
+      pd.setThreadNumber(this->threadNumber_);
+      pd.setBackend(this->BackEnd);
+      pd.preconditionTriangulation(triangulation);
+    }
+
+    /**
+     * @brief Release the working buffers kept by the workers
+     */
+    inline void releaseMemory() {
+      this->workers_.clear();
+    }
+
+    /**
+     * @brief Compute the persistence diagram of every scalar field
+     *
+     * @param[out] diagrams One (augmented) diagram per scalar field
+     * @param[in] scalars Scalar fields
+     * @param[in] offsets Vertex order of each scalar field
+     * @param[in] triangulation Preconditioned triangulation
+     *
+     * @pre preconditionTriangulation() should be called on @p triangulation
+     * and every buffer of @p offsets filled by ttk::preconditionOrderArray()
+     */
+    template <typename scalarType, typename triangulationType>
+    int execute(std::vector<DiagramType> &diagrams,
+                const std::vector<const scalarType *> &scalars,
+                const std::vector<const SimplexId *> &offsets,
+                const triangulationType *triangulation);
+
+  protected:
+    PersistenceDiagram::BACKEND BackEnd{
+      PersistenceDiagram::BACKEND::DISCRETE_MORSE_SANDWICH};
+
+    std::vector<std::unique_ptr<PersistenceDiagram>> workers_{};
+  };
+
+} // namespace ttk
+
+template <typename scalarType, typename triangulationType>
+int ttk::PersistenceDiagramBatch::execute(
+  std::vector<DiagramType> &diagrams,
+  const std::vector<const scalarType *> &scalars,
+  const std::vector<const SimplexId *> &offsets,
+  const triangulationType *triangulation) {
+
+  const int nFields = scalars.size();
+  if(offsets.size() != scalars.size()) {
+    this->printErr("Expected one order array per scalar field");
+    return -1;
+  }
+  diagrams.resize(nFields);
+  if(nFields == 0) {
+    return 0;
+  }
+
+  Timer tm{};
+
+  // split the threads between the fields and the computation of each field
+  const int nThreads = std::max(1, static_cast<int>(this->threadNumber_));
+  const int nWorkers = std::min(nFields, nThreads);
+  if(this->workers_.size() < static_cast<size_t>(nWorkers)) {
+    this->workers_.resize(nWorkers);
+  }
+  for(int w = 0; w < nWorkers; ++w) {
+    auto &worker{this->workers_[w]};
+    if(worker == nullptr) {
+      worker = std::make_unique<PersistenceDiagram>();
+      worker->setBackend(this->BackEnd);
+      worker->setReleaseMemory(false);
+    }
+    // fields are processed concurrently, keep them quiet
+    worker->setDebugLevel(std::min(this->debugLevel_,
+                                   static_cast<int>(debug::Priority::WARNING)));
+    worker->setThreadNumber(nThreads / nWorkers
+                            + (w < nThreads % nWorkers ? 1 : 0));
+  }
+
+  std::atomic<int> next{0};
+  int status{0};
+
+#ifdef TTK_ENABLE_OPENMP
+  const auto maxActiveLevels = omp_get_max_active_levels();
+  if(nWorkers > 1 && nWorkers < nThreads) {
+    // nested parallelism: one team per worker
+    omp_set_max_active_levels(std::max(maxActiveLevels, 2));
+  }
+#pragma omp parallel num_threads(nWorkers) reduction(min : status)
+#endif // TTK_ENABLE_OPENMP
+  {
+#ifdef TTK_ENABLE_OPENMP
+    const auto w = omp_get_thread_num();
+#else
+    const auto w = 0;
+#endif // TTK_ENABLE_OPENMP
+    auto &worker{*this->workers_[w]};
+    // dynamic dispatch, fields may have very different costs
+    for(int i = next++; i < nFields; i = next++) {
+      const auto res = worker.execute(
+        diagrams[i], scalars[i], 0, offsets[i], triangulation);
+      status = std::min(status, res);
+    }
+  }
+
+#ifdef TTK_ENABLE_OPENMP
+  omp_set_max_active_levels(maxActiveLevels);
+#endif // TTK_ENABLE_OPENMP
+
+  this->printMsg("Computed " + std::to_string(nFields) + " diagrams ("
+                   + std::to_string(nWorkers) + " concurrent fields)",
+                 1.0, tm.getElapsedTime(), this->threadNumber_);
+
+  return status;
+}
@@ -47,6 +47,134 @@ void ttk::PersistenceDiagramAuction::runAuctionRound(int &n_biddings,
   }
 }
 
+void ttk::PersistenceDiagramAuction::runParallelAuctionRound(
+  int &n_biddings, const int kdt_index) {
+  double max_price = getMaximalPrice();
+  double epsilon = epsilon_;
+  if(epsilon_ < 1e-6 * max_price) {
+    // Risks of floating point limits reached...
+    epsilon = 1e-6 * max_price;
+  }
+
+  const size_t nGoods = goods_.size();
+  roundWinners_.resize(nGoods + diagonal_goods_.size(), -1);
+
+  // bounded rounds (Gauss-Seidel blocks): the later bidders see the prices
+  // raised by the earlier rounds, which limits the conflicts
+  const size_t blockSize = 64 * static_cast<size_t>(threadNumber_);
+  std::vector<int> biddersRound{}, diagonalBidders{};
+  std::vector<Good *> bidGoods{};
+  std::vector<KDT *> bidNodes{};
+  std::vector<double> bidPrices{};
+  std::vector<size_t> bidGoodIds{};
+
+  while(!unassignedBidders_.empty()) {
+    biddersRound.clear();
+    diagonalBidders.clear();
+    while(!unassignedBidders_.empty()
+          && biddersRound.size() + diagonalBidders.size() < blockSize) {
+      const int pos = unassignedBidders_.front();
+      unassignedBidders_.pop();
+      if(bidders_[pos].isDiagonal()) {
+        diagonalBidders.emplace_back(pos);
+      } else {
+        biddersRound.emplace_back(pos);
+      }
+    }
+
+    // 1. concurrent bids of the off-diagonal bidders (read-only)
+    const size_t nBids = biddersRound.size();
+    bidGoods.resize(nBids);
+    bidNodes.resize(nBids);
+    bidPrices.resize(nBids);
+    bidGoodIds.resize(nBids);
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_) schedule(dynamic, 16)
+#endif // TTK_ENABLE_OPENMP
+    for(size_t i = 0; i < nBids; ++i) {
+      const Bidder &b = bidders_[biddersRound[i]];
+      Good &twin_good = diagonal_goods_[b.id_];
+      if(use_kdt_) {
+        bidGoods[i]
+          = b.getKDTBid(&goods_, twin_good, wasserstein_, epsilon,
+                        geometricalFactor_, &kdt_, bidPrices[i], bidNodes[i],
+                        kdt_index);
+      } else {
+        bidGoods[i] = b.getBid(&goods_, twin_good, wasserstein_, epsilon,
+                               geometricalFactor_, bidPrices[i]);
+      }
+      if(bidGoods[i] == &twin_good) {
+        bidGoodIds[i] = nGoods + b.id_;
+      } else if(bidGoods[i] != nullptr) {
+        bidGoodIds[i] = bidGoods[i] - goods_.data();
+      }
+    }
+    n_biddings += nBids;
+
+    // 2. each good goes to its highest bid (the first one on ties)
+    for(size_t i = 0; i < nBids; ++i) {
+      if(bidGoods[i] == nullptr) {
+        continue;
+      }
+      auto &winner = roundWinners_[bidGoodIds[i]];
+      if(winner == -1 || bidPrices[i] > bidPrices[winner]) {
+        winner = i;
+      }
+    }
+    for(size_t i = 0; i < nBids; ++i) {
+      if(bidGoods[i] == nullptr) {
+        continue;
+      }
+      if(roundWinners_[bidGoodIds[i]] != static_cast<int>(i)) {
+        // outbid, will bid again against the new prices
+        unassignedBidders_.push(biddersRound[i]);
+        continue;
+      }
+      Bidder &b = bidders_[biddersRound[i]];
+      Good &good = *bidGoods[i];
+      b.setProperty(good);
+      b.setPricePaid(bidPrices[i]);
+      const int idx_reassigned = good.getOwner();
+      good.assign(b.getPositionInAuction(), bidPrices[i]);
+      if(use_kdt_ && bidGoodIds[i] < nGoods) {
+        bidNodes[i]->updateWeight(bidPrices[i], kdt_index);
+      }
+      if(idx_reassigned >= 0) {
+        bidders_[idx_reassigned].resetProperty();
+        unassignedBidders_.push(idx_reassigned);
+      }
+    }
+    for(size_t i = 0; i < nBids; ++i) {
+      if(bidGoods[i] != nullptr) {
+        roundWinners_[bidGoodIds[i]] = -1;
+      }
+    }
+
+    // 3. diagonal bidders, one after the other
+    for(const auto pos : diagonalBidders) {
+      n_biddings++;
+      Bidder &b = this->bidders_[pos];
+      Good &twin_good = goods_[-b.id_ - 1];
+      int idx_reassigned;
+      if(use_kdt_) {
+        idx_reassigned = b.runDiagonalKDTBidding(
+          &diagonal_goods_, twin_good, wasserstein_, epsilon,
+          geometricalFactor_, correspondence_kdt_map_, diagonal_queue_,
+          kdt_index);
+      } else {
+        idx_reassigned
+          = b.runDiagonalBidding(&diagonal_goods_, twin_good, wasserstein_,
+                                 epsilon, geometricalFactor_, diagonal_queue_);
+      }
+      if(idx_reassigned >= 0) {
+        Bidder &reassigned = bidders_[idx_reassigned];
+        reassigned.resetProperty();
+        unassignedBidders_.push(idx_reassigned);
+      }
+    }
+  }
+}
+
 double ttk::PersistenceDiagramAuction::getMaximalPrice() {
   double max_price = 0;
   for(size_t i = 0; i < goods_.size(); ++i) {
@@ -158,7 +286,11 @@ double ttk::PersistenceDiagramAuction::run(std::vector<MatchingType> &matchings,
     epsilon_ /= 5;
     this->buildUnassignedBidders();
     this->reinitializeGoods();
-    this->runAuctionRound(n_biddings, kdt_index);
+    if(this->threadNumber_ > 1) {
+      this->runParallelAuctionRound(n_biddings, kdt_index);
+    } else {
+      this->runAuctionRound(n_biddings, kdt_index);
+    }
     delta = this->getRelativePrecision();
   }
   double wassersteinDistance = this->getMatchingsAndDistance(matchings, true);
@@ -194,11 +326,12 @@ double ttk::PersistenceDiagramAuctionActor::cost(
   }
 }
 
-int ttk::Bidder::runBidding(GoodDiagram *goods,
-                            Good &twinGood,
-                            int wasserstein,
-                            double epsilon,
-                            double geometricalFactor) {
+ttk::Good *ttk::Bidder::getBid(GoodDiagram *goods,
+                               Good &twinGood,
+                               int wasserstein,
+                               double epsilon,
+                               double geometricalFactor,
+                               double &new_price) const {
   double best_val = std::numeric_limits<double>::lowest();
   double second_val = std::numeric_limits<double>::lowest();
   Good *best_good{};
@@ -231,13 +364,27 @@ int ttk::Bidder::runBidding(GoodDiagram *goods,
     second_val = best_val;
   }
   if(best_good == nullptr) {
-    return -1;
+    return nullptr;
   }
   double old_price = best_good->getPrice();
-  double new_price = old_price + best_val - second_val + epsilon;
+  new_price = old_price + best_val - second_val + epsilon;
   if(new_price > std::numeric_limits<double>::max() / 2) {
     new_price = old_price + epsilon;
   }
+  return best_good;
+}
+
+int ttk::Bidder::runBidding(GoodDiagram *goods,
+                            Good &twinGood,
+                            int wasserstein,
+                            double epsilon,
+                            double geometricalFactor) {
+  double new_price{};
+  Good *best_good = this->getBid(
+    goods, twinGood, wasserstein, epsilon, geometricalFactor, new_price);
+  if(best_good == nullptr) {
+    return -1;
+  }
   // Assign bidder to best_good
   this->setProperty(*best_good);
   this->setPricePaid(new_price);
@@ -483,15 +630,16 @@ int ttk::Bidder::runDiagonalKDTBidding(
   return idx_reassigned;
 }
 
-int ttk::Bidder::runKDTBidding(GoodDiagram *goods,
-                               Good &twinGood,
-                               int wasserstein,
-                               double epsilon,
-                               double geometricalFactor,
-                               KDT *kdt,
-                               const int kdt_index) {
+ttk::Good *ttk::Bidder::getKDTBid(GoodDiagram *goods,
+                                  Good &twinGood,
+                                  int wasserstein,
+                                  double epsilon,
+                                  double geometricalFactor,
+                                  KDT *kdt,
+                                  double &new_price,
+                                  KDT *&closest_kdt,
+                                  const int kdt_index) const {
 
-  /// Runs bidding of a non-diagonal bidder
   std::vector<KDT *> neighbours;
   std::vector<double> costs;
 
@@ -500,7 +648,6 @@ int ttk::Bidder::runKDTBidding(GoodDiagram *goods,
 
   kdt->getKClosest(2, coordinates, neighbours, costs, kdt_index);
   double best_val, second_val;
-  KDT *closest_kdt;
   Good *best_good{};
   if(costs.size() == 2) {
     std::array<int, 2> idx{0, 1};
@@ -521,7 +668,6 @@ int ttk::Bidder::runKDTBidding(GoodDiagram *goods,
     second_val = best_val;
   }
   // And now check for the corresponding twin bidder
-  bool twin_chosen = false;
   Good &g = twinGood;
   double val = -this->cost(g, wasserstein, geometricalFactor);
   val -= g.getPrice();
@@ -529,7 +675,6 @@ int ttk::Bidder::runKDTBidding(GoodDiagram *goods,
     second_val = best_val;
     best_val = val;
     best_good = &g;
-    twin_chosen = true;
   } else if(val > second_val) {
     second_val = val;
   }
@@ -539,10 +684,27 @@ int ttk::Bidder::runKDTBidding(GoodDiagram *goods,
     second_val = best_val;
   }
   double old_price = best_good->getPrice();
-  double new_price = old_price + best_val - second_val + epsilon;
+  new_price = old_price + best_val - second_val + epsilon;
   if(new_price > std::numeric_limits<double>::max() / 2) {
     new_price = old_price + epsilon;
   }
+  return best_good;
+}
+
+int ttk::Bidder::runKDTBidding(GoodDiagram *goods,
+                               Good &twinGood,
+                               int wasserstein,
+                               double epsilon,
+                               double geometricalFactor,
+                               KDT *kdt,
+                               const int kdt_index) {
+
+  /// Runs bidding of a non-diagonal bidder
+  double new_price{};
+  KDT *closest_kdt{};
+  Good *best_good
+    = this->getKDTBid(goods, twinGood, wasserstein, epsilon, geometricalFactor,
+                      kdt, new_price, closest_kdt, kdt_index);
   // Assign bidder to best_good
   this->setProperty(*best_good);
   this->setPricePaid(new_price);
@@ -552,7 +714,7 @@ int ttk::Bidder::runKDTBidding(GoodDiagram *goods,
 
   best_good->assign(this->position_in_auction_, new_price);
   // Update the price in the KDTree
-  if(!twin_chosen) {
+  if(best_good != &twinGood) {
     closest_kdt->updateWeight(new_price, kdt_index);
   }
   return idx_reassigned;
@@ -33,6 +33,8 @@ namespace ttk {
                               bool use_kdTree)
       : wasserstein_{wasserstein}, geometricalFactor_{geometricalFactor},
         lambda_{lambda}, delta_lim_{delta_lim}, use_kdt_{use_kdTree} {
+      // concurrent bidding is opt-in (auctions are often run concurrently)
+      this->setThreadNumber(1);
     }
 
     PersistenceDiagramAuction(BidderDiagram &bidders,
@@ -49,6 +51,7 @@ namespace ttk {
       : kdt_{kdt}, correspondence_kdt_map_{correspondence_kdt_map},
         bidders_{bidders}, goods_{goods} {
 
+      this->setThreadNumber(1);
       n_bidders_ = bidders.size();
       n_goods_ = goods.size();
 
@@ -85,6 +88,16 @@ namespace ttk {
     }
 
     void runAuctionRound(int &n_biddings, const int kdt_index = 0);
+    /**
+     * Same as runAuctionRound() with several threads, used by run() when
+     * setThreadNumber() was given more than one thread. The unassigned
+     * bidders are taken in blocks of 64 per thread. In a block, the
+     * off-diagonal bidders bid concurrently against the current prices
+     * (Jacobi), each good goes to its highest bid and the other bidders are
+     * queued again. Diagonal bidders, which all compete for the cheapest
+     * diagonal goods, then bid one after the other.
+     */
+    void runParallelAuctionRound(int &n_biddings, const int kdt_index = 0);
     double getMatchingsAndDistance(std::vector<MatchingType> &matchings,
                                    bool get_diagonal_matches = false);
     double run(std::vector<MatchingType> &matchings, const int kdt_index = 0);
@@ -291,6 +304,9 @@ namespace ttk {
                         Compare>
       diagonal_queue_{};
     std::queue<int> unassignedBidders_{};
+    // winning bid of each good (off-diagonal then diagonal goods) in a
+    // parallel round
+    std::vector<int> roundWinners_{};
 
     int n_bidders_{0};
     int n_goods_{0};
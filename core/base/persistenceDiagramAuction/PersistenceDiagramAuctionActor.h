@@ -259,6 +259,25 @@ namespace ttk {
                       KDT *kdt,
                       const int kdt_index = 0);
 
+    // Best good of an off-diagonal bidder and the price it offers for it
+    // (with or without the use of a KD-Tree). The goods are left untouched,
+    // so that several bidders can bid concurrently.
+    Good *getBid(GoodDiagram *goods,
+                 Good &diagonalGood,
+                 int wasserstein,
+                 double epsilon,
+                 double geometricalFactor,
+                 double &new_price) const;
+    Good *getKDTBid(GoodDiagram *goods,
+                    Good &diagonalGood,
+                    int wasserstein,
+                    double epsilon,
+                    double geometricalFactor,
+                    KDT *kdt,
+                    double &new_price,
+                    KDT *&closest_kdt,
+                    const int kdt_index = 0) const;
+
     // Diagonal Bidding (with or without the use of a KD-Tree
     int runDiagonalBidding(
       GoodDiagram *goods,
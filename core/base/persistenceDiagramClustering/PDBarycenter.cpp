@@ -550,6 +550,7 @@ void ttk::PDBarycenter::setInitialBarycenter(double min_persistence) {
 typename ttk::PDBarycenter::KDTreePair ttk::PDBarycenter::getKDTree() const {
   Timer tm;
   auto kdt = std::make_unique<KDT>(true, wasserstein_);
+  kdt->setThreadNumber(threadNumber_);
 
   const int dimension = geometrical_factor_ >= 1 ? 2 : 5;
 
@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <functional>
 #include <limits>
 
 #include <PersistenceDiagramDistanceMatrix.h>
@@ -11,6 +12,58 @@ std::vector<std::vector<double>> PersistenceDiagramDistanceMatrix::execute(
 
   Timer tm{};
 
+  std::vector<BidderDiagram> diags_min{}, diags_sad{}, diags_max{};
+  this->prepareDiagrams(intermediateDiagrams, diags_min, diags_sad, diags_max);
+
+  std::vector<std::vector<double>> distMat{};
+  if(this->Entries == EntriesType::ALL_ENTRIES) {
+    getDiagramsDistMat(nInputs, distMat, diags_min, diags_sad, diags_max);
+  } else {
+    // entries left out of the sparse rows are set to infinity
+    std::vector<SparseRow> rows{};
+    getSparseDistMat(nInputs, rows, diags_min, diags_sad, diags_max);
+    const auto nCols = nInputs[1] == 0 ? nInputs[0] : nInputs[1];
+    distMat.resize(nInputs[0]);
+    for(size_t i = 0; i < nInputs[0]; ++i) {
+      distMat[i].resize(nCols, std::numeric_limits<double>::infinity());
+      if(nInputs[1] == 0) {
+        distMat[i][i] = 0.0;
+      }
+      for(const auto &e : rows[i]) {
+        distMat[i][e.first] = e.second;
+      }
+    }
+  }
+
+  this->printMsg("Complete", 1.0, tm.getElapsedTime(), this->threadNumber_);
+
+  return distMat;
+}
+
+std::vector<PersistenceDiagramDistanceMatrix::SparseRow>
+  PersistenceDiagramDistanceMatrix::executeSparse(
+    const std::vector<DiagramType> &intermediateDiagrams,
+    const std::array<size_t, 2> &nInputs) const {
+
+  Timer tm{};
+
+  std::vector<BidderDiagram> diags_min{}, diags_sad{}, diags_max{};
+  this->prepareDiagrams(intermediateDiagrams, diags_min, diags_sad, diags_max);
+
+  std::vector<SparseRow> rows{};
+  getSparseDistMat(nInputs, rows, diags_min, diags_sad, diags_max);
+
+  this->printMsg("Complete", 1.0, tm.getElapsedTime(), this->threadNumber_);
+
+  return rows;
+}
+
+void PersistenceDiagramDistanceMatrix::prepareDiagrams(
+  const std::vector<DiagramType> &intermediateDiagrams,
+  std::vector<BidderDiagram> &diags_min,
+  std::vector<BidderDiagram> &diags_sad,
+  std::vector<BidderDiagram> &diags_max) const {
+
   const auto nDiags = intermediateDiagrams.size();
 
   if(do_min_ && do_sad_ && do_max_) {
@@ -107,10 +160,10 @@ std::vector<std::vector<double>> PersistenceDiagramDistanceMatrix::execute(
       break;
   }
 
-  std::vector<std::vector<double>> distMat{};
   if(this->Constraint == ConstraintType::FULL_DIAGRAMS) {
-    getDiagramsDistMat(nInputs, distMat, bidder_diagrams_min,
-                       bidder_diagrams_sad, bidder_diagrams_max);
+    diags_min = std::move(bidder_diagrams_min);
+    diags_sad = std::move(bidder_diagrams_sad);
+    diags_max = std::move(bidder_diagrams_max);
   } else {
     if(this->do_min_) {
       enrichCurrentBidderDiagrams(
@@ -124,14 +177,10 @@ std::vector<std::vector<double>> PersistenceDiagramDistanceMatrix::execute(
       enrichCurrentBidderDiagrams(
         bidder_diagrams_max, current_bidder_diagrams_max, maxDiagPersistence);
     }
-    getDiagramsDistMat(nInputs, distMat, current_bidder_diagrams_min,
-                       current_bidder_diagrams_sad,
-                       current_bidder_diagrams_max);
+    diags_min = std::move(current_bidder_diagrams_min);
+    diags_sad = std::move(current_bidder_diagrams_sad);
+    diags_max = std::move(current_bidder_diagrams_max);
   }
-
-  this->printMsg("Complete", 1.0, tm.getElapsedTime(), this->threadNumber_);
-
-  return distMat;
 }
 
 double PersistenceDiagramDistanceMatrix::getMostPersistent(
@@ -152,7 +201,10 @@ double PersistenceDiagramDistanceMatrix::getMostPersistent(
 }
 
 double PersistenceDiagramDistanceMatrix::computePowerDistance(
-  const BidderDiagram &D1, const BidderDiagram &D2) const {
+  const BidderDiagram &D1,
+  const BidderDiagram &D2,
+  const int nThreads,
+  const double deltaLim) const {
 
   GoodDiagram D2_bis{};
   for(size_t i = 0; i < D2.size(); i++) {
@@ -163,9 +215,12 @@ double PersistenceDiagramDistanceMatrix::computePowerDistance(
     D2_bis.emplace_back(g);
   }
 
-  PersistenceDiagramAuction auction(
-    this->Wasserstein, this->Alpha, this->Lambda, this->DeltaLim, true);
+  PersistenceDiagramAuction auction(this->Wasserstein, this->Alpha,
+                                    this->Lambda,
+                                    deltaLim < 0 ? this->DeltaLim : deltaLim,
+                                    true);
   auction.BuildAuctionDiagrams(D1, D2_bis);
+  auction.setThreadNumber(nThreads);
   return auction.run();
 }
 
@@ -178,8 +233,17 @@ void PersistenceDiagramDistanceMatrix::getDiagramsDistMat(
 
   distanceMatrix.resize(nInputs[0]);
 
+  // fewer pairs than threads: the threads go to each auction instead
+  const size_t nPairs = nInputs[1] == 0 ? nInputs[0] * (nInputs[0] - 1) / 2
+                                        : nInputs[0] * nInputs[1];
+  const bool parallelPairs
+    = nPairs >= static_cast<size_t>(this->threadNumber_);
+  const int auctionThreads = parallelPairs ? 1 : this->threadNumber_;
+  TTK_FORCE_USE(parallelPairs);
+
 #ifdef TTK_ENABLE_OPENMP
-#pragma omp parallel for schedule(dynamic) num_threads(this->threadNumber_)
+#pragma omp parallel for schedule(dynamic) num_threads(this->threadNumber_) \
+  if(parallelPairs)
 #endif // TTK_ENABLE_OPENMP
   for(size_t i = 0; i < nInputs[0]; ++i) {
 
@@ -196,17 +260,17 @@ void PersistenceDiagramDistanceMatrix::getDiagramsDistMat(
       if(this->do_min_) {
         auto &dimin = diags_min[a];
         auto &djmin = diags_min[b];
-        distance += computePowerDistance(dimin, djmin);
+        distance += computePowerDistance(dimin, djmin, auctionThreads);
       }
       if(this->do_sad_) {
         auto &disad = diags_sad[a];
         auto &djsad = diags_sad[b];
-        distance += computePowerDistance(disad, djsad);
+        distance += computePowerDistance(disad, djsad, auctionThreads);
       }
       if(this->do_max_) {
         auto &dimax = diags_max[a];
         auto &djmax = diags_max[b];
-        distance += computePowerDistance(dimax, djmax);
+        distance += computePowerDistance(dimax, djmax, auctionThreads);
       }
       return Geometry::pow(distance, 1.0 / this->Wasserstein);
     };
@@ -234,6 +298,292 @@ void PersistenceDiagramDistanceMatrix::getDiagramsDistMat(
   }
 }
 
+void PersistenceDiagramDistanceMatrix::getSparseDistMat(
+  const std::array<size_t, 2> &nInputs,
+  std::vector<SparseRow> &rows,
+  const std::vector<BidderDiagram> &diags_min,
+  const std::vector<BidderDiagram> &diags_sad,
+  const std::vector<BidderDiagram> &diags_max) const {
+
+  Timer tm{};
+
+  const bool square = nInputs[1] == 0;
+  const size_t nCols = square ? nInputs[0] : nInputs[1];
+  // column j is diagram j + colOffset
+  const size_t colOffset = square ? 0 : nInputs[0];
+  const size_t nDiags = colOffset + nCols;
+  const int p = this->Wasserstein;
+
+  rows.clear();
+  rows.resize(nInputs[0]);
+
+  std::vector<const std::vector<BidderDiagram> *> types{};
+  if(this->do_min_) {
+    types.emplace_back(&diags_min);
+  }
+  if(this->do_sad_) {
+    types.emplace_back(&diags_sad);
+  }
+  if(this->do_max_) {
+    types.emplace_back(&diags_max);
+  }
+  const size_t nTypes = types.size();
+
+  // Bounds on W_p^p. Matching two points costs at least
+  // Alpha * |pers1 - pers2|^p / 2^(p-1), with a zero persistence for
+  // the diagonal, so the monotone matching of the sorted persistence
+  // values (a one-dimensional transport, generalizing the difference of
+  // total persistence) is a lower bound. Matching every point to the
+  // diagonal gives an upper bound: the auction reports pers^p / 2^(p-1)
+  // for a diagonal match, whatever Alpha. Sliced Wasserstein or
+  // persistence image distances do not bound W_p, except for the slice
+  // orthogonal to the diagonal, which is this lower bound. No bounds are
+  // used for the bottleneck distance (p = inf).
+  const bool useBounds = p >= 1;
+  const double diagonalFactor
+    = useBounds ? 1.0 / Geometry::pow(2.0, p - 1) : 0.0;
+  const double factor = this->Alpha * diagonalFactor;
+  std::vector<std::vector<double>> persistences(nDiags * nTypes);
+  std::vector<double> diagonalCosts(nDiags);
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(this->threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+  for(size_t i = 0; i < nDiags; ++i) {
+    for(size_t t = 0; t < nTypes; ++t) {
+      auto &pers = persistences[i * nTypes + t];
+      for(const auto &b : (*types[t])[i]) {
+        pers.emplace_back(b.getPersistence());
+      }
+      std::sort(pers.begin(), pers.end(), std::greater<double>());
+      if(useBounds) {
+        for(const auto v : pers) {
+          diagonalCosts[i] += Geometry::pow(v, p);
+        }
+      }
+    }
+  }
+
+  // fewer rows than threads: the threads go to each auction instead
+  const bool parallelRows
+    = nInputs[0] >= static_cast<size_t>(this->threadNumber_);
+  const int auctionThreads = parallelRows ? 1 : this->threadNumber_;
+  TTK_FORCE_USE(parallelRows);
+
+  const auto getDist = [&](const size_t a, const size_t b,
+                           const double deltaLim) -> double {
+    double distance{};
+    for(size_t t = 0; t < nTypes; ++t) {
+      distance += computePowerDistance(
+        (*types[t])[a], (*types[t])[b], auctionThreads, deltaLim);
+    }
+    return Geometry::pow(distance, 1.0 / p);
+  };
+
+  // The distances to a few pivot diagrams, picked by farthest-first
+  // traversal, bound the other distances through the triangle inequality.
+  // An auction result d only ensures d / (1 + DeltaLim) <= W_p <= d.
+  // When Alpha < 1, the auction minimizes a cost that charges
+  // Alpha * pers^p / 2^(p-1) for a diagonal match but reports
+  // pers^p / 2^(p-1): its result is not within 1 + DeltaLim of a metric,
+  // so neither pivots nor coarse auctions (below) are used.
+  const bool usePivots = useBounds && this->Alpha >= 1.0;
+  const size_t nPivots = usePivots ? std::min<size_t>(16, nDiags / 8) : 0;
+  std::vector<double> pivotDists(nPivots * nDiags);
+  std::vector<size_t> pivots(nPivots);
+  {
+    std::vector<double> minPivotDist(nDiags, 0.0);
+    size_t pivot = 0;
+    for(size_t r = 0; r < nPivots; ++r) {
+      pivots[r] = pivot;
+      auto dists = &pivotDists[r * nDiags];
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(this->threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+      for(size_t i = 0; i < nDiags; ++i) {
+        dists[i] = i == pivot ? 0.0 : getDist(pivot, i, -1.0);
+        minPivotDist[i]
+          = r == 0 ? dists[i] : std::min(minPivotDist[i], dists[i]);
+      }
+      pivot = std::max_element(minPivotDist.begin(), minPivotDist.end())
+              - minPivotDist.begin();
+    }
+  }
+
+  // bounds on the distance (not on its p-th power)
+  const auto getBounds
+    = [&](const size_t a, const size_t b, double &lb, double &ub) {
+        if(!useBounds) {
+          lb = 0.0;
+          ub = std::numeric_limits<double>::infinity();
+          return;
+        }
+        lb = 0.0;
+        for(size_t t = 0; t < nTypes; ++t) {
+          const auto &pa = persistences[a * nTypes + t];
+          const auto &pb = persistences[b * nTypes + t];
+          for(size_t k = 0; k < std::max(pa.size(), pb.size()); ++k) {
+            const double va = k < pa.size() ? pa[k] : 0.0;
+            const double vb = k < pb.size() ? pb[k] : 0.0;
+            lb += Geometry::pow(std::abs(va - vb), p);
+          }
+        }
+        ub = diagonalCosts[a] + diagonalCosts[b];
+        // with Alpha = 1, an empty diagram makes both bounds equal to the
+        // exact distance
+        lb = Geometry::pow(factor * lb, 1.0 / p);
+        ub = Geometry::pow(diagonalFactor * ub, 1.0 / p);
+        for(size_t r = 0; r < nPivots; ++r) {
+          const auto da = pivotDists[r * nDiags + a];
+          const auto db = pivotDists[r * nDiags + b];
+          if(a == pivots[r] || b == pivots[r]) {
+            lb = ub = da + db;
+            return;
+          }
+          lb = std::max(lb, std::max(da / (1.0 + this->DeltaLim) - db,
+                                     db / (1.0 + this->DeltaLim) - da));
+          ub = std::min(ub, da + db);
+        }
+      };
+
+  // An auction stopped at a relative precision delta returns a distance d
+  // with d / (1 + delta) <= W_p <= d. A coarse auction is run first to
+  // discard the pairs that are farther than the pruning radius.
+  const double coarseDeltaLim = 0.25;
+  const bool useCoarse
+    = this->DeltaLim < coarseDeltaLim && this->Alpha >= 1.0;
+
+  // returns false if the pair (a, b) is farther than radius
+  const auto refine = [&](const size_t a, const size_t b, const double lb,
+                          const double ub, const double radius, double &dist,
+                          size_t &nCoarse, size_t &nExact) {
+    if(lb > radius) {
+      return false;
+    }
+    if(lb >= ub) {
+      dist = ub;
+      return true;
+    }
+    if(useCoarse) {
+      nCoarse++;
+      if(getDist(a, b, coarseDeltaLim) / (1.0 + coarseDeltaLim) > radius) {
+        return false;
+      }
+    }
+    nExact++;
+    dist = getDist(a, b, -1.0);
+    return true;
+  };
+
+  const bool knn = this->Entries == EntriesType::NEAREST_NEIGHBORS;
+  const size_t nNeighbors
+    = std::min(this->NumberOfNeighbors, square ? nCols - 1 : nCols);
+  size_t nCoarse{}, nExact{};
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(this->threadNumber_) \
+  if(parallelRows) reduction(+ : nCoarse, nExact)
+#endif // TTK_ENABLE_OPENMP
+  for(size_t i = 0; i < nInputs[0]; ++i) {
+
+    // square matrix with a threshold: only the upper triangle
+    const size_t jBegin = (square && !knn) ? i + 1 : 0;
+    std::vector<double> lbs(nCols), ubs(nCols);
+    for(size_t j = jBegin; j < nCols; ++j) {
+      if(!square || j != i) {
+        getBounds(i, j + colOffset, lbs[j], ubs[j]);
+      }
+    }
+
+    if(!knn) {
+      for(size_t j = jBegin; j < nCols; ++j) {
+        double dist{};
+        if(refine(i, j + colOffset, lbs[j], ubs[j], this->DistanceThreshold,
+                  dist, nCoarse, nExact)
+           && dist <= this->DistanceThreshold) {
+          rows[i].emplace_back(j, dist);
+        }
+      }
+      continue;
+    }
+
+    if(nNeighbors == 0) {
+      continue;
+    }
+
+    // candidates by increasing lower bound, the k-th smallest upper bound
+    // caps the distance to the k-th neighbor
+    std::vector<std::pair<double, size_t>> candidates{};
+    std::vector<double> sortedUbs{};
+    for(size_t j = 0; j < nCols; ++j) {
+      if(!square || j != i) {
+        candidates.emplace_back(lbs[j], j);
+        sortedUbs.emplace_back(ubs[j]);
+      }
+    }
+    std::nth_element(
+      sortedUbs.begin(), sortedUbs.begin() + nNeighbors - 1, sortedUbs.end());
+    const double cap = sortedUbs[nNeighbors - 1];
+    std::sort(candidates.begin(), candidates.end());
+
+    // max-heap of the (distance, column) of the current nearest neighbors
+    std::vector<std::pair<double, size_t>> nearest{};
+    for(const auto &c : candidates) {
+      const double radius
+        = nearest.size() < nNeighbors ? cap : nearest.front().first;
+      if(c.first > radius) {
+        break;
+      }
+      const auto j = c.second;
+      double dist{};
+      if(!refine(i, j + colOffset, lbs[j], ubs[j], radius, dist, nCoarse,
+                 nExact)) {
+        continue;
+      }
+      if(nearest.size() < nNeighbors) {
+        nearest.emplace_back(dist, j);
+        std::push_heap(nearest.begin(), nearest.end());
+      } else if(std::make_pair(dist, j) < nearest.front()) {
+        std::pop_heap(nearest.begin(), nearest.end());
+        nearest.back() = std::make_pair(dist, j);
+        std::push_heap(nearest.begin(), nearest.end());
+      }
+    }
+    std::sort_heap(nearest.begin(), nearest.end());
+    for(const auto &n : nearest) {
+      rows[i].emplace_back(n.second, n.first);
+    }
+  }
+
+  if(!knn) {
+    if(square) {
+      // complete the lower triangle
+      for(size_t i = 0; i < nInputs[0]; ++i) {
+        for(const auto &e : rows[i]) {
+          if(e.first > i) {
+            rows[e.first].emplace_back(i, e.second);
+          }
+        }
+      }
+    }
+    for(auto &row : rows) {
+      std::sort(row.begin(), row.end(),
+                [](const std::pair<size_t, double> &a,
+                   const std::pair<size_t, double> &b) {
+                  return a.second < b.second
+                         || (a.second == b.second && a.first < b.first);
+                });
+    }
+  }
+
+  const size_t nPairs
+    = square ? nInputs[0] * (nInputs[0] - 1) / 2 : nInputs[0] * nCols;
+  this->printMsg("Refined " + std::to_string(nExact) + " of "
+                   + std::to_string(nPairs) + " pairs ("
+                   + std::to_string(nCoarse) + " coarse auctions)",
+                 1.0, tm.getElapsedTime(), this->threadNumber_);
+}
+
 void PersistenceDiagramDistanceMatrix::setBidderDiagrams(
   const size_t nInputs,
   std::vector<DiagramType> &inputDiagrams,
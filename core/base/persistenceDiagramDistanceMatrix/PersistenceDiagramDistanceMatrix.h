@@ -38,6 +38,22 @@ namespace ttk {
       execute(const std::vector<DiagramType> &intermediateDiagrams,
               const std::array<size_t, 2> &nInputs) const;
 
+    /**
+     * Sparse rows of the distance matrix: (column, distance) pairs sorted by
+     * increasing distance.
+     */
+    using SparseRow = std::vector<std::pair<size_t, double>>;
+
+    /**
+     * Compute only the entries selected by setEntries() (the k nearest
+     * neighbors or the distances below a threshold of every row). Every pair
+     * first gets cheap bounds and an auction is only run for the pairs that
+     * cannot be decided from them.
+     */
+    std::vector<SparseRow>
+      executeSparse(const std::vector<DiagramType> &intermediateDiagrams,
+                    const std::array<size_t, 2> &nInputs) const;
+
     inline void setWasserstein(const int data) {
       Wasserstein = data;
     }
@@ -74,17 +90,43 @@ namespace ttk {
         this->Constraint = ConstraintType::RELATIVE_PERSISTENCE_GLOBAL;
       }
     }
+    inline void setEntries(const int data) {
+      if(data == 0) {
+        this->Entries = EntriesType::ALL_ENTRIES;
+      } else if(data == 1) {
+        this->Entries = EntriesType::NEAREST_NEIGHBORS;
+      } else if(data == 2) {
+        this->Entries = EntriesType::DISTANCE_THRESHOLD;
+      }
+    }
+    inline void setNumberOfNeighbors(const size_t data) {
+      NumberOfNeighbors = data;
+    }
+    inline void setDistanceThreshold(const double data) {
+      DistanceThreshold = data;
+    }
 
   protected:
     double
       getMostPersistent(const std::vector<BidderDiagram> &bidder_diags) const;
+    void prepareDiagrams(const std::vector<DiagramType> &intermediateDiagrams,
+                         std::vector<BidderDiagram> &diags_min,
+                         std::vector<BidderDiagram> &diags_sad,
+                         std::vector<BidderDiagram> &diags_max) const;
     double computePowerDistance(const BidderDiagram &D1,
-                                const BidderDiagram &D2) const;
+                                const BidderDiagram &D2,
+                                const int nThreads = 1,
+                                const double deltaLim = -1.0) const;
     void getDiagramsDistMat(const std::array<size_t, 2> &nInputs,
                             std::vector<std::vector<double>> &distanceMatrix,
                             const std::vector<BidderDiagram> &diags_min,
                             const std::vector<BidderDiagram> &diags_sad,
                             const std::vector<BidderDiagram> &diags_max) const;
+    void getSparseDistMat(const std::array<size_t, 2> &nInputs,
+                          std::vector<SparseRow> &rows,
+                          const std::vector<BidderDiagram> &diags_min,
+                          const std::vector<BidderDiagram> &diags_sad,
+                          const std::vector<BidderDiagram> &diags_max) const;
     void setBidderDiagrams(const size_t nInputs,
                            std::vector<DiagramType> &inputDiagrams,
                            std::vector<BidderDiagram> &bidder_diags) const;
@@ -115,5 +157,14 @@ namespace ttk {
       RELATIVE_PERSISTENCE_GLOBAL,
     };
     ConstraintType Constraint{ConstraintType::RELATIVE_PERSISTENCE_GLOBAL};
+
+    enum class EntriesType {
+      ALL_ENTRIES,
+      NEAREST_NEIGHBORS,
+      DISTANCE_THRESHOLD,
+    };
+    EntriesType Entries{EntriesType::ALL_ENTRIES};
+    size_t NumberOfNeighbors{5};
+    double DistanceThreshold{1.0};
   };
 } // namespace ttk
@@ -1,5 +1,5 @@
 #include <PersistentGenerators.h>
-#include <UnionFind.h>
+#include <UnionFindArray.h>
 
 ttk::PersistentGenerators::PersistentGenerators() {
   this->setDebugMsgPrefix("PersistentGenerators");
@@ -10,32 +10,24 @@ void ttk::PersistentGenerators::getConnectedComponents(
   std::vector<SimplexId> &connComp) const {
 
   // use Union-Find to get connected components
-  std::vector<ttk::UnionFind> uf(connComp.size());
-
-  // initialize UFs
-  for(size_t j = 0; j < edgeNeighs.size(); ++j) {
-    uf[j].setRank(j);
-  }
+  ttk::UnionFindArray<SimplexId> uf(connComp.size());
 
   // Union between adjacent edges
   for(size_t j = 0; j < edgeNeighs.size(); ++j) {
-    ttk::UnionFind::makeUnion(&uf[j], &uf[edgeNeighs[j][0]]);
-    ttk::UnionFind::makeUnion(&uf[j], &uf[edgeNeighs[j][1]]);
+    uf.makeUnion(j, edgeNeighs[j][0]);
+    uf.makeUnion(j, edgeNeighs[j][1]);
   }
 
-  // UF rank -> componend id mapping
+  // UF root -> componend id mapping
   std::vector<SimplexId> connCompIds(edgeNeighs.size(), -1);
   size_t nConnComps{};
 
   // find connected component ids
   for(size_t j = 0; j < edgeNeighs.size(); ++j) {
-    const auto root{uf[j].find()};
-    if(root != nullptr) {
-      const auto rank{root->getRank()};
-      if(connCompIds[rank] == -1) {
-        connCompIds[rank] = nConnComps++;
-      }
-      connComp[j] = connCompIds[rank];
+    const auto root{uf.find(j)};
+    if(connCompIds[root] == -1) {
+      connCompIds[root] = nConnComps++;
     }
+    connComp[j] = connCompIds[root];
   }
 }
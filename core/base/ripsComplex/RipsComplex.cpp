@@ -1,5 +1,7 @@
 #include <RipsComplex.h>
 
+#include <algorithm>
+#include <cmath>
 #include <limits>
 
 ttk::RipsComplex::RipsComplex() {
@@ -12,6 +14,41 @@ struct LocCell {
   std::array<ttk::SimplexId, n> verts;
 };
 
+/**
+ * @brief Concatenate the cells gathered per first vertex into the VTK
+ * connectivity array, keeping their order
+ */
+template <size_t n>
+static void gatherCells(std::vector<ttk::SimplexId> &connectivity,
+                        std::vector<double> &diameters,
+                        const std::vector<std::vector<LocCell<n>>> &cells,
+                        const int nThreads) {
+
+  TTK_FORCE_USE(nThreads);
+
+  std::vector<size_t> psum(cells.size() + 1);
+  for(size_t i = 0; i < cells.size(); ++i) {
+    psum[i + 1] = psum[i] + cells[i].size();
+  }
+
+  const auto nCells{psum.back()};
+  diameters.resize(nCells);
+  connectivity.resize((n + 1) * nCells);
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(nThreads) schedule(dynamic)
+#endif // TTK_ENABLE_OPENMP
+  for(size_t i = 0; i < cells.size(); ++i) {
+    for(size_t j = 0; j < cells[i].size(); ++j) {
+      connectivity[(n + 1) * (psum[i] + j)] = static_cast<ttk::SimplexId>(i);
+      for(size_t k = 0; k < n; ++k) {
+        connectivity[(n + 1) * (psum[i] + j) + k + 1] = cells[i][j].verts[k];
+      }
+      diameters[psum[i] + j] = cells[i][j].diam;
+    }
+  }
+}
+
 static void computeEdges(std::vector<ttk::SimplexId> &connectivity,
                          std::vector<double> &diameters,
                          const double epsilon,
@@ -35,25 +72,7 @@ static void computeEdges(std::vector<ttk::SimplexId> &connectivity,
     }
   }
 
-  std::vector<size_t> psum(edges.size() + 1);
-  for(size_t i = 0; i < edges.size(); ++i) {
-    psum[i + 1] = psum[i] + edges[i].size();
-  }
-
-  const auto nCells{psum.back()};
-  diameters.resize(nCells);
-  connectivity.resize(2 * nCells);
-
-#ifdef TTK_ENABLE_OPENMP
-#pragma omp parallel for num_threads(nThreads) schedule(dynamic)
-#endif // TTK_ENABLE_OPENMP
-  for(size_t i = 0; i < edges.size(); ++i) {
-    for(size_t j = 0; j < edges[i].size(); ++j) {
-      connectivity[2 * (psum[i] + j) + 0] = static_cast<ttk::SimplexId>(i);
-      connectivity[2 * (psum[i] + j) + 1] = edges[i][j].verts[0];
-      diameters[psum[i] + j] = edges[i][j].diam;
-    }
-  }
+  gatherCells(connectivity, diameters, edges, nThreads);
 }
 
 static inline void maxAssign(double &a, const double b) {
@@ -97,26 +116,7 @@ static void
     }
   }
 
-  std::vector<size_t> psum(triangles.size() + 1);
-  for(size_t i = 0; i < triangles.size(); ++i) {
-    psum[i + 1] = psum[i] + triangles[i].size();
-  }
-
-  const auto nCells{psum.back()};
-  diameters.resize(nCells);
-  connectivity.resize(3 * nCells);
-
-#ifdef TTK_ENABLE_OPENMP
-#pragma omp parallel for num_threads(nThreads) schedule(dynamic)
-#endif // TTK_ENABLE_OPENMP
-  for(size_t i = 0; i < triangles.size(); ++i) {
-    for(size_t j = 0; j < triangles[i].size(); ++j) {
-      connectivity[3 * (psum[i] + j) + 0] = static_cast<ttk::SimplexId>(i);
-      connectivity[3 * (psum[i] + j) + 1] = triangles[i][j].verts[0];
-      connectivity[3 * (psum[i] + j) + 2] = triangles[i][j].verts[1];
-      diameters[psum[i] + j] = triangles[i][j].diam;
-    }
-  }
+  gatherCells(connectivity, diameters, triangles, nThreads);
 }
 
 static void
@@ -164,27 +164,288 @@ static void
     }
   }
 
-  std::vector<size_t> psum(tetras.size() + 1);
-  for(size_t i = 0; i < tetras.size(); ++i) {
-    psum[i + 1] = psum[i] + tetras[i].size();
+  gatherCells(connectivity, diameters, tetras, nThreads);
+}
+
+/**
+ * @brief Epsilon-neighborhood graph of a point cloud in CSR layout
+ *
+ * Only the neighbors of greater index are stored, sorted by increasing
+ * index, together with their distances.
+ */
+struct NeighborGraph {
+  std::vector<size_t> offsets{};
+  std::vector<ttk::SimplexId> neighbors{};
+  std::vector<double> distances{};
+
+  inline size_t begin(const size_t i) const {
+    return this->offsets[i];
+  }
+  inline size_t end(const size_t i) const {
+    return this->offsets[i + 1];
   }
+};
 
-  const auto nCells{psum.back()};
-  diameters.resize(nCells);
-  connectivity.resize(4 * nCells);
+static inline double pointDistance(const double *const a,
+                                   const double *const b,
+                                   const int dimension) {
+  double res{};
+  for(int i = 0; i < dimension; ++i) {
+    res += (a[i] - b[i]) * (a[i] - b[i]);
+  }
+  return std::sqrt(res);
+}
+
+/**
+ * @brief Radius search on a uniform grid over (at most) the first three
+ * coordinates, with cells at least epsilon wide
+ */
+static void computeNeighborGraph(NeighborGraph &graph,
+                                 const double *const points,
+                                 const size_t nPoints,
+                                 const int dimension,
+                                 const double epsilon,
+                                 const int nThreads) {
+
+  TTK_FORCE_USE(nThreads);
+
+  const int gridDim = std::min(dimension, 3);
+  // at most 2^20 cells per axis, so that cell keys fit in 64 bits
+  constexpr double maxCellsPerAxis = 1 << 20;
+  std::array<double, 3> pMin{}, cellSize{};
+  std::array<uint64_t, 3> nCells{1, 1, 1};
+  for(int j = 0; j < gridDim; ++j) {
+    double pMax{std::numeric_limits<double>::lowest()};
+    pMin[j] = std::numeric_limits<double>::max();
+    for(size_t i = 0; i < nPoints; ++i) {
+      pMin[j] = std::min(pMin[j], points[i * dimension + j]);
+      pMax = std::max(pMax, points[i * dimension + j]);
+    }
+    cellSize[j] = std::max(epsilon, (pMax - pMin[j]) / maxCellsPerAxis);
+    if(cellSize[j] <= 0.0) {
+      cellSize[j] = 1.0;
+    }
+    nCells[j] = static_cast<uint64_t>((pMax - pMin[j]) / cellSize[j]) + 1;
+  }
 
+  const auto cellCoords = [&](const size_t i) {
+    std::array<uint64_t, 3> res{};
+    for(int j = 0; j < gridDim; ++j) {
+      const auto x{points[i * dimension + j]};
+      res[j] = std::min(
+        static_cast<uint64_t>((x - pMin[j]) / cellSize[j]), nCells[j] - 1);
+    }
+    return res;
+  };
+  const auto cellKey = [&nCells](const std::array<uint64_t, 3> &c) {
+    return (c[2] * nCells[1] + c[1]) * nCells[0] + c[0];
+  };
+
+  // sort the points by cell
+  std::vector<std::pair<uint64_t, ttk::SimplexId>> sorted(nPoints);
 #ifdef TTK_ENABLE_OPENMP
-#pragma omp parallel for num_threads(nThreads) schedule(dynamic)
+#pragma omp parallel for num_threads(nThreads)
+#endif // TTK_ENABLE_OPENMP
+  for(size_t i = 0; i < nPoints; ++i) {
+    sorted[i] = {cellKey(cellCoords(i)), static_cast<ttk::SimplexId>(i)};
+  }
+  TTK_PSORT(nThreads, sorted.begin(), sorted.end());
+
+  std::vector<std::vector<std::pair<ttk::SimplexId, double>>> neighbors(
+    nPoints);
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(nThreads) schedule(dynamic, 64)
+#endif // TTK_ENABLE_OPENMP
+  for(size_t i = 0; i < nPoints; ++i) {
+    const auto c{cellCoords(i)};
+    std::array<uint64_t, 3> lo{}, hi{};
+    for(int j = 0; j < 3; ++j) {
+      lo[j] = c[j] > 0 ? c[j] - 1 : 0;
+      hi[j] = std::min(c[j] + 1, nCells[j] - 1);
+    }
+    std::array<uint64_t, 3> nc{};
+    for(nc[2] = lo[2]; nc[2] <= hi[2]; ++nc[2]) {
+      for(nc[1] = lo[1]; nc[1] <= hi[1]; ++nc[1]) {
+        for(nc[0] = lo[0]; nc[0] <= hi[0]; ++nc[0]) {
+          const auto key{cellKey(nc)};
+          auto it = std::lower_bound(
+            sorted.begin(), sorted.end(),
+            std::make_pair(key, static_cast<ttk::SimplexId>(i + 1)));
+          for(; it != sorted.end() && it->first == key; ++it) {
+            const auto p{it->second};
+            const auto dist{pointDistance(
+              &points[i * dimension], &points[p * dimension], dimension)};
+            if(dist <= epsilon) {
+              neighbors[i].emplace_back(p, dist);
+            }
+          }
+        }
+      }
+    }
+    std::sort(neighbors[i].begin(), neighbors[i].end());
+  }
+
+  graph.offsets.resize(nPoints + 1);
+  graph.offsets[0] = 0;
+  for(size_t i = 0; i < nPoints; ++i) {
+    graph.offsets[i + 1] = graph.offsets[i] + neighbors[i].size();
+  }
+  graph.neighbors.resize(graph.offsets.back());
+  graph.distances.resize(graph.offsets.back());
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(nThreads) schedule(dynamic, 64)
+#endif // TTK_ENABLE_OPENMP
+  for(size_t i = 0; i < nPoints; ++i) {
+    for(size_t j = 0; j < neighbors[i].size(); ++j) {
+      graph.neighbors[graph.offsets[i] + j] = neighbors[i][j].first;
+      graph.distances[graph.offsets[i] + j] = neighbors[i][j].second;
+    }
+    // release memory as soon as possible
+    std::vector<std::pair<ttk::SimplexId, double>>{}.swap(neighbors[i]);
+  }
+}
+
+static void computeEdges(std::vector<ttk::SimplexId> &connectivity,
+                         std::vector<double> &diameters,
+                         const double epsilon,
+                         const NeighborGraph &graph,
+                         const int nThreads) {
+
+  const size_t nPoints = graph.offsets.size() - 1;
+  std::vector<std::vector<LocCell<1>>> edges(nPoints);
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(nThreads) schedule(dynamic, 64)
+#endif // TTK_ENABLE_OPENMP
+  for(size_t i = 0; i < nPoints; ++i) {
+    for(size_t a = graph.begin(i); a < graph.end(i); ++a) {
+      if(graph.distances[a] < epsilon) {
+        edges[i].emplace_back(LocCell<1>{
+          graph.distances[a],
+          std::array<ttk::SimplexId, 1>{graph.neighbors[a]}});
+      }
+    }
+  }
+
+  gatherCells(connectivity, diameters, edges, nThreads);
+}
+
+/**
+ * @brief Common neighbors of i and j (j neighbor of i), with their
+ * distances to i and j
+ */
+static void commonNeighbors(std::vector<ttk::SimplexId> &common,
+                            std::vector<double> &distI,
+                            std::vector<double> &distJ,
+                            const NeighborGraph &graph,
+                            const size_t a,
+                            const size_t i,
+                            const ttk::SimplexId j) {
+  common.clear();
+  distI.clear();
+  distJ.clear();
+  size_t b = a + 1, c = graph.begin(j);
+  while(b < graph.end(i) && c < graph.end(j)) {
+    if(graph.neighbors[b] < graph.neighbors[c]) {
+      ++b;
+    } else if(graph.neighbors[c] < graph.neighbors[b]) {
+      ++c;
+    } else {
+      common.emplace_back(graph.neighbors[b]);
+      distI.emplace_back(graph.distances[b]);
+      distJ.emplace_back(graph.distances[c]);
+      ++b;
+      ++c;
+    }
+  }
+}
+
+static void computeTriangles(std::vector<ttk::SimplexId> &connectivity,
+                             std::vector<double> &diameters,
+                             const NeighborGraph &graph,
+                             const int nThreads) {
+
+  const size_t nPoints = graph.offsets.size() - 1;
+  std::vector<std::vector<LocCell<2>>> triangles(nPoints);
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel num_threads(nThreads)
+#endif // TTK_ENABLE_OPENMP
+  {
+    std::vector<ttk::SimplexId> common{};
+    std::vector<double> distI{}, distJ{};
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp for schedule(dynamic, 64)
+#endif // TTK_ENABLE_OPENMP
+    for(size_t i = 0; i < nPoints; ++i) {
+      for(size_t a = graph.begin(i); a < graph.end(i); ++a) {
+        const auto j{graph.neighbors[a]};
+        commonNeighbors(common, distI, distJ, graph, a, i, j);
+        for(size_t c = 0; c < common.size(); ++c) {
+          auto diam{graph.distances[a]};
+          maxAssign(diam, distI[c]);
+          maxAssign(diam, distJ[c]);
+          triangles[i].emplace_back(LocCell<2>{
+            diam, std::array<ttk::SimplexId, 2>{j, common[c]}});
+        }
+      }
+    }
+  }
+
+  gatherCells(connectivity, diameters, triangles, nThreads);
+}
+
+static void computeTetras(std::vector<ttk::SimplexId> &connectivity,
+                          std::vector<double> &diameters,
+                          const NeighborGraph &graph,
+                          const int nThreads) {
+
+  const size_t nPoints = graph.offsets.size() - 1;
+  std::vector<std::vector<LocCell<3>>> tetras(nPoints);
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel num_threads(nThreads)
 #endif // TTK_ENABLE_OPENMP
-  for(size_t i = 0; i < tetras.size(); ++i) {
-    for(size_t j = 0; j < tetras[i].size(); ++j) {
-      connectivity[4 * (psum[i] + j) + 0] = static_cast<ttk::SimplexId>(i);
-      connectivity[4 * (psum[i] + j) + 1] = tetras[i][j].verts[0];
-      connectivity[4 * (psum[i] + j) + 2] = tetras[i][j].verts[1];
-      connectivity[4 * (psum[i] + j) + 3] = tetras[i][j].verts[2];
-      diameters[psum[i] + j] = tetras[i][j].diam;
+  {
+    std::vector<ttk::SimplexId> common{};
+    std::vector<double> distI{}, distJ{};
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp for schedule(dynamic, 64)
+#endif // TTK_ENABLE_OPENMP
+    for(size_t i = 0; i < nPoints; ++i) {
+      for(size_t a = graph.begin(i); a < graph.end(i); ++a) {
+        const auto j{graph.neighbors[a]};
+        commonNeighbors(common, distI, distJ, graph, a, i, j);
+        // l should be a common neighbor of i and j, and a neighbor of k
+        for(size_t c = 0; c < common.size(); ++c) {
+          const auto k{common[c]};
+          size_t d = c + 1, e = graph.begin(k);
+          while(d < common.size() && e < graph.end(k)) {
+            if(common[d] < graph.neighbors[e]) {
+              ++d;
+            } else if(graph.neighbors[e] < common[d]) {
+              ++e;
+            } else {
+              auto diam{graph.distances[a]};
+              maxAssign(diam, distI[c]);
+              maxAssign(diam, distJ[c]);
+              maxAssign(diam, distI[d]);
+              maxAssign(diam, distJ[d]);
+              maxAssign(diam, graph.distances[e]);
+              tetras[i].emplace_back(LocCell<3>{
+                diam, std::array<ttk::SimplexId, 3>{j, k, common[d]}});
+              ++d;
+              ++e;
+            }
+          }
+        }
+      }
     }
   }
+
+  gatherCells(connectivity, diameters, tetras, nThreads);
 }
 
 int ttk::RipsComplex::computeGaussianDensity(
@@ -210,6 +471,29 @@ int ttk::RipsComplex::computeGaussianDensity(
   return 0;
 }
 
+int ttk::RipsComplex::computeGaussianDensity(double *const density,
+                                             const double *const points,
+                                             const SimplexId nPoints,
+                                             const int dimension) const {
+
+  const auto sq = [](const double a) -> double { return a * a; };
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(this->threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+  for(SimplexId i = 0; i < nPoints; ++i) {
+    density[i] = 1.0;
+    for(SimplexId j = 0; j < nPoints; ++j) {
+      density[i] += std::exp(
+        -sq(pointDistance(
+          &points[i * dimension], &points[j * dimension], dimension))
+        / (2.0 * sq(this->StdDev)));
+    }
+  }
+
+  return 0;
+}
+
 int ttk::RipsComplex::computeDiameterStats(
   const SimplexId nPoints,
   std::array<double *const, 3> diamStats,
@@ -301,3 +585,58 @@ int ttk::RipsComplex::execute(
   this->printMsg("Complete", 1.0, tm.getElapsedTime(), this->threadNumber_);
   return 0;
 }
+
+int ttk::RipsComplex::execute(std::vector<SimplexId> &connectivity,
+                              std::vector<double> &diameters,
+                              std::array<double *const, 3> diamStats,
+                              const double *const points,
+                              const SimplexId nPoints,
+                              const int dimension,
+                              double *const density) const {
+
+  Timer tm{};
+
+  if(points == nullptr || nPoints <= 0 || dimension <= 0) {
+    this->printErr("Invalid point cloud");
+    return 1;
+  }
+
+  Timer tm_graph{};
+
+  NeighborGraph graph{};
+  computeNeighborGraph(
+    graph, points, nPoints, dimension, this->Epsilon, this->threadNumber_);
+
+  this->printMsg("Computed neighborhood graph ("
+                   + std::to_string(graph.neighbors.size()) + " edges)",
+                 1.0, tm_graph.getElapsedTime(), this->threadNumber_,
+                 debug::LineMode::NEW, debug::Priority::DETAIL);
+
+  Timer tm_rips{};
+
+  if(this->OutputDimension == 1) {
+    computeEdges(
+      connectivity, diameters, this->Epsilon, graph, this->threadNumber_);
+  } else if(this->OutputDimension == 2) {
+    computeTriangles(connectivity, diameters, graph, this->threadNumber_);
+  } else if(this->OutputDimension == 3) {
+    computeTetras(connectivity, diameters, graph, this->threadNumber_);
+  }
+
+  // release the graph before the statistics
+  graph = NeighborGraph{};
+
+  this->printMsg("Generated Rips complex from point cloud ("
+                   + std::to_string(diameters.size()) + " cells)",
+                 1.0, tm_rips.getElapsedTime(), this->threadNumber_,
+                 debug::LineMode::NEW, debug::Priority::DETAIL);
+
+  this->computeDiameterStats(nPoints, diamStats, connectivity, diameters);
+
+  if(this->ComputeGaussianDensity) {
+    this->computeGaussianDensity(density, points, nPoints, dimension);
+  }
+
+  this->printMsg("Complete", 1.0, tm.getElapsedTime(), this->threadNumber_);
+  return 0;
+}
@@ -28,6 +28,7 @@
 #include <Debug.h>
 
 #include <array>
+#include <vector>
 
 namespace ttk {
 
@@ -50,6 +51,28 @@ namespace ttk {
                 const std::vector<std::vector<double>> &distanceMatrix,
                 double *const density = nullptr) const;
 
+    /**
+     * @brief Main entry point, point cloud variant
+     *
+     * The complex is built from an epsilon-neighborhood graph computed
+     * with a uniform grid, so that no distance matrix is ever stored.
+     *
+     * @param[out] connectivity Cell connectivity array (VTK format)
+     * @param[out] diameters Cell diameters
+     * @param[out] diamStats Min, mean and max cell diameters around point
+     * @param[in] points Point coordinates (row-major, nPoints x dimension)
+     * @param[in] nPoints Number of input points
+     * @param[in] dimension Number of coordinates per point
+     * @param[out] density Gaussian density array on points
+     */
+    int execute(std::vector<SimplexId> &connectivity,
+                std::vector<double> &diameters,
+                std::array<double *const, 3> diamStats,
+                const double *const points,
+                const SimplexId nPoints,
+                const int dimension,
+                double *const density = nullptr) const;
+
   protected:
     /**
      * @brief Compute diameter statistics on points
@@ -74,6 +97,19 @@ namespace ttk {
       double *const density,
       const std::vector<std::vector<double>> &distanceMatrix) const;
 
+    /**
+     * @brief Compute Gaussian density on points from their coordinates
+     *
+     * @param[out] density Gaussian density array on points
+     * @param[in] points Point coordinates (row-major, nPoints x dimension)
+     * @param[in] nPoints Number of input points
+     * @param[in] dimension Number of coordinates per point
+     */
+    int computeGaussianDensity(double *const density,
+                               const double *const points,
+                               const SimplexId nPoints,
+                               const int dimension) const;
+
     /** Dimension of the generated complex */
     int OutputDimension{2};
     /** Distance threshold */
@@ -82,6 +118,8 @@ namespace ttk {
     double StdDev{1.0};
     /** Compute the Gaussian density from the distance matrix */
     bool ComputeGaussianDensity{false};
+    /** Input columns form a distance matrix (instead of point coordinates) */
+    bool InputIsADistanceMatrix{true};
   };
 
 } // namespace ttk
@@ -93,14 +93,8 @@ char ttk::ScalarFieldCriticalPoints::getCriticalType(
   // now enumerate the connected components of the lower and upper links
   // NOTE: a breadth first search might be faster than a UF
   // if so, one would need the one-skeleton data structure, not the edge list
-  std::vector<UnionFind> lowerSeeds(lowerCount);
-  std::vector<UnionFind> upperSeeds(upperCount);
-  std::vector<UnionFind *> lowerList(lowerCount);
-  std::vector<UnionFind *> upperList(upperCount);
-  for(SimplexId i = 0; i < (SimplexId)lowerList.size(); i++)
-    lowerList[i] = &(lowerSeeds[i]);
-  for(SimplexId i = 0; i < (SimplexId)upperList.size(); i++)
-    upperList[i] = &(upperSeeds[i]);
+  UnionFindArray<SimplexId> lowerSeeds(lowerCount);
+  UnionFindArray<SimplexId> upperSeeds(upperCount);
 
   for(SimplexId i = 0; i < (SimplexId)vertexLink.size(); i++) {
 
@@ -117,9 +111,7 @@ char ttk::ScalarFieldCriticalPoints::getCriticalType(
       std::map<SimplexId, SimplexId>::iterator n1It
         = global2LowerLink.find(neighborId1);
 
-      lowerList[n0It->second] = UnionFind::makeUnion(
-        lowerList[n0It->second], lowerList[n1It->second]);
-      lowerList[n1It->second] = lowerList[n0It->second];
+      lowerSeeds.makeUnion(n0It->second, n1It->second);
     }
 
     // process the upper link
@@ -132,42 +124,28 @@ char ttk::ScalarFieldCriticalPoints::getCriticalType(
       std::map<SimplexId, SimplexId>::iterator n1It
         = global2UpperLink.find(neighborId1);
 
-      upperList[n0It->second] = UnionFind::makeUnion(
-        upperList[n0It->second], upperList[n1It->second]);
-      upperList[n1It->second] = upperList[n0It->second];
+      upperSeeds.makeUnion(n0It->second, n1It->second);
     }
   }
 
-  // let's remove duplicates
-  std::vector<UnionFind *>::iterator it;
-  // update the UFs if necessary
-  for(SimplexId i = 0; i < (SimplexId)lowerList.size(); i++)
-    lowerList[i] = lowerList[i]->find();
-  for(SimplexId i = 0; i < (SimplexId)upperList.size(); i++)
-    upperList[i] = upperList[i]->find();
-
-  sort(lowerList.begin(), lowerList.end());
-  it = unique(lowerList.begin(), lowerList.end());
-  lowerList.resize(distance(lowerList.begin(), it));
-
-  sort(upperList.begin(), upperList.end());
-  it = unique(upperList.begin(), upperList.end());
-  upperList.resize(distance(upperList.begin(), it));
+  // one root per connected component
+  const size_t lowerComponentNumber = lowerSeeds.getSetNumber();
+  const size_t upperComponentNumber = upperSeeds.getSetNumber();
 
   if(debugLevel_ >= (int)(debug::Priority::VERBOSE)) {
     printMsg("Vertex #" + std::to_string(vertexId)
-               + ": lowerLink-#CC=" + std::to_string(lowerList.size())
-               + " upperLink-#CC=" + std::to_string(upperList.size()),
+               + ": lowerLink-#CC=" + std::to_string(lowerComponentNumber)
+               + " upperLink-#CC=" + std::to_string(upperComponentNumber),
              debug::Priority::VERBOSE);
   }
 
-  if((lowerList.size() == 1) && (upperList.size() == 1))
+  if((lowerComponentNumber == 1) && (upperComponentNumber == 1))
     // regular point
     return (char)(CriticalType::Regular);
   else {
     // saddles
     if(dimension_ == 2) {
-      if((lowerList.size() > 2) || (upperList.size() > 2)) {
+      if((lowerComponentNumber > 2) || (upperComponentNumber > 2)) {
         // monkey saddle
         return (char)(CriticalType::Degenerate);
       } else {
@@ -179,9 +157,9 @@ char ttk::ScalarFieldCriticalPoints::getCriticalType(
         // boundary from interior vertices
       }
     } else if(dimension_ == 3) {
-      if((lowerList.size() == 2) && (upperList.size() == 1)) {
+      if((lowerComponentNumber == 2) && (upperComponentNumber == 1)) {
         return (char)(CriticalType::Saddle1);
-      } else if((lowerList.size() == 1) && (upperList.size() == 2)) {
+      } else if((lowerComponentNumber == 1) && (upperComponentNumber == 2)) {
         return (char)(CriticalType::Saddle2);
       } else {
         // monkey saddle
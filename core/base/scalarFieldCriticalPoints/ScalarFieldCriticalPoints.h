@@ -48,7 +48,7 @@
 // base code includes
 #include <ProgressiveTopology.h>
 #include <Triangulation.h>
-#include <UnionFind.h>
+#include <UnionFindArray.h>
 
 namespace ttk {
 
@@ -396,17 +396,8 @@ int ttk::ScalarFieldCriticalPoints::getLowerUpperComponents(
   }
 
   // now do the actual work
-  std::vector<UnionFind> lowerSeeds(lowerNeighbors.size());
-  std::vector<UnionFind *> lowerList(lowerNeighbors.size());
-  std::vector<UnionFind> upperSeeds(upperNeighbors.size());
-  std::vector<UnionFind *> upperList(upperNeighbors.size());
-
-  for(SimplexId i = 0; i < (SimplexId)lowerSeeds.size(); i++) {
-    lowerList[i] = &(lowerSeeds[i]);
-  }
-  for(SimplexId i = 0; i < (SimplexId)upperSeeds.size(); i++) {
-    upperList[i] = &(upperSeeds[i]);
-  }
+  UnionFindArray<SimplexId> lowerSeeds(lowerNeighbors.size());
+  UnionFindArray<SimplexId> upperSeeds(upperNeighbors.size());
 
   SimplexId vertexStarSize = triangulation->getVertexStarNumber(vertexId);
 
@@ -435,11 +426,11 @@ int ttk::ScalarFieldCriticalPoints::getLowerUpperComponents(
             bool lower1 = offsets[neighborId1] < offsets[vertexId];
 
             std::vector<SimplexId> *neighbors = &lowerNeighbors;
-            std::vector<UnionFind *> *seeds = &lowerList;
+            UnionFindArray<SimplexId> *seeds = &lowerSeeds;
 
             if(!lower0) {
               neighbors = &upperNeighbors;
-              seeds = &upperList;
+              seeds = &upperSeeds;
             }
 
             if(lower0 == lower1) {
@@ -454,9 +445,7 @@ int ttk::ScalarFieldCriticalPoints::getLowerUpperComponents(
                 }
               }
               if((lowerId0 != -1) && (lowerId1 != -1)) {
-                (*seeds)[lowerId0] = UnionFind::makeUnion(
-                  (*seeds)[lowerId0], (*seeds)[lowerId1]);
-                (*seeds)[lowerId1] = (*seeds)[lowerId0];
+                seeds->makeUnion(lowerId0, lowerId1);
               }
             }
           }
@@ -468,15 +457,17 @@ int ttk::ScalarFieldCriticalPoints::getLowerUpperComponents(
   // let's remove duplicates now
 
   // update the UF if necessary
+  std::vector<SimplexId> lowerList(lowerNeighbors.size());
+  std::vector<SimplexId> upperList(upperNeighbors.size());
   for(SimplexId i = 0; i < (SimplexId)lowerList.size(); i++)
-    lowerList[i] = lowerList[i]->find();
+    lowerList[i] = lowerSeeds.find(i);
   for(SimplexId i = 0; i < (SimplexId)upperList.size(); i++)
-    upperList[i] = upperList[i]->find();
+    upperList[i] = upperSeeds.find(i);
 
-  std::unordered_map<UnionFind *, std::vector<ttk::SimplexId>>::iterator it;
-  std::unordered_map<UnionFind *, std::vector<ttk::SimplexId>>
+  std::unordered_map<SimplexId, std::vector<ttk::SimplexId>>::iterator it;
+  std::unordered_map<SimplexId, std::vector<ttk::SimplexId>>
     upperComponentId{};
-  std::unordered_map<UnionFind *, std::vector<ttk::SimplexId>>
+  std::unordered_map<SimplexId, std::vector<ttk::SimplexId>>
     lowerComponentId{};
 
   // We retrieve the lower and upper components if we want them
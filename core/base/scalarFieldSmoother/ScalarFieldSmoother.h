@@ -109,69 +109,293 @@ int ttk::ScalarFieldSmoother::smooth(const triangulationType *triangulation,
     return -4;
 #endif
 
-  SimplexId vertexNumber = triangulation->getNumberOfVertices();
-
-  std::vector<dataType> tmpData(vertexNumber * dimensionNumber_, 0);
+  const SimplexId vertexNumber = triangulation->getNumberOfVertices();
+  const int dim = dimensionNumber_;
+  const size_t valueNumber = static_cast<size_t>(vertexNumber) * dim;
 
   dataType *outputData = (dataType *)outputData_;
   dataType *inputData = (dataType *)inputData_;
+
+  // the two buffers are swapped after each iteration, masked vertices keep
+  // their input value in both
+  std::vector<dataType> tmpData(valueNumber);
   // init the output
-  for(SimplexId i = 0; i < vertexNumber; i++) {
-    for(int j = 0; j < dimensionNumber_; j++) {
-      outputData[dimensionNumber_ * i + j]
-        = inputData[dimensionNumber_ * i + j];
-    }
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_)
+#endif
+  for(size_t i = 0; i < valueNumber; i++) {
+    outputData[i] = inputData[i];
+    tmpData[i] = inputData[i];
   }
 
   printMsg("Smoothing " + std::to_string(vertexNumber) + " vertices", 0, 0,
            threadNumber_, ttk::debug::LineMode::REPLACE);
 
-  int timeBuckets = 10;
-  if(numberOfIterations < timeBuckets)
-    timeBuckets = numberOfIterations;
+  // On implicit grids, interior vertices share the same neighborhood
+  // (relative offsets, in the order given by the triangulation), so that
+  // whole rows can be processed with a stencil. Other vertices go through
+  // the triangulation. On other triangulations, the vertex neighborhoods
+  // are extracted once in a flat (CSR) adjacency.
+  std::array<SimplexId, 3> gridDims{};
+  std::vector<SimplexId> stencil{};
+  if(dynamic_cast<const ImplicitTriangulation *>(triangulation) != nullptr) {
+    gridDims = triangulation->getGridDimensions();
+    std::array<SimplexId, 3> ref{};
+    bool hasInterior = true;
+    for(int k = 0; k < 3; k++) {
+      hasInterior = hasInterior && (gridDims[k] == 1 || gridDims[k] > 2);
+      ref[k] = gridDims[k] > 1 ? 1 : 0;
+    }
+    if(hasInterior) {
+      const SimplexId refVertex
+        = ref[0] + gridDims[0] * (ref[1] + gridDims[1] * ref[2]);
+      const auto neighborNumber
+        = triangulation->getVertexNeighborNumber(refVertex);
+      stencil.resize(neighborNumber);
+      for(SimplexId k = 0; k < neighborNumber; k++) {
+        SimplexId neighborId = -1;
+        triangulation->getVertexNeighbor(refVertex, k, neighborId);
+        stencil[k] = (neighborId - refVertex) * dim;
+      }
+    }
+  }
 
-  for(int it = 0; it < numberOfIterations; it++) {
+  std::vector<SimplexId> neighborOffsets{}, neighbors{};
+  if(stencil.empty()) {
+    neighborOffsets.resize(vertexNumber + 1);
+    neighborOffsets[0] = 0;
+    for(SimplexId i = 0; i < vertexNumber; i++) {
+      neighborOffsets[i + 1]
+        = neighborOffsets[i] + triangulation->getVertexNeighborNumber(i);
+    }
+    neighbors.resize(neighborOffsets.back());
 #ifdef TTK_ENABLE_OPENMP
 #pragma omp parallel for num_threads(threadNumber_)
 #endif
     for(SimplexId i = 0; i < vertexNumber; i++) {
+      SimplexId *const vertexNeighbors = &neighbors[neighborOffsets[i]];
+      for(SimplexId k = 0; k < neighborOffsets[i + 1] - neighborOffsets[i];
+          k++) {
+        triangulation->getVertexNeighbor(i, k, vertexNeighbors[k]);
+      }
+    }
+  }
+
+  // smooth one vertex through the triangulation
+  const auto smoothVertex
+    = [&](const SimplexId i, const dataType *const src, dataType *const dst) {
+        if(mask_ != nullptr && mask_[i] == 0)
+          return;
+        const auto neighborNumber = triangulation->getVertexNeighborNumber(i);
+        for(int j = 0; j < dim; j++) {
+          const auto curr{dim * i + j};
+          dataType value = src[curr];
+          for(SimplexId k = 0; k < neighborNumber; k++) {
+            SimplexId neighborId = -1;
+            triangulation->getVertexNeighbor(i, k, neighborId);
+            value += src[dim * neighborId + j];
+          }
+          dst[curr] = value / static_cast<double>(neighborNumber + 1);
+        }
+      };
+
+  // smooth the interior vertices [begin, end) of a grid row with the stencil
+  const double stencilWeight = stencil.size() + 1;
+  const auto smoothRow = [&](const SimplexId begin, const SimplexId end,
+                             const dataType *const src, dataType *const dst) {
+    const size_t first = static_cast<size_t>(begin) * dim;
+    const size_t last = static_cast<size_t>(end) * dim;
+    if(mask_ == nullptr) {
+      for(size_t k = first; k < last; k++) {
+        dst[k] = src[k];
+      }
+      for(const auto offset : stencil) {
+        const dataType *const nsrc = src + offset;
+        for(size_t k = first; k < last; k++) {
+          dst[k] += nsrc[k];
+        }
+      }
+      for(size_t k = first; k < last; k++) {
+        dst[k] = dst[k] / stencilWeight;
+      }
+    } else {
+      for(SimplexId i = begin; i < end; i++) {
+        if(mask_[i] == 0)
+          continue;
+        for(size_t k = i * dim; k < static_cast<size_t>(i + 1) * dim; k++) {
+          dataType value = src[k];
+          for(const auto offset : stencil) {
+            value += src[k + offset];
+          }
+          dst[k] = value / stencilWeight;
+        }
+      }
+    }
+  };
 
-      // avoid to process masked vertices
-      if(mask_ != nullptr && mask_[i] == 0)
-        continue;
+  // smooth one vertex through the flat adjacency
+  const auto smoothNeighbors
+    = [&](const SimplexId i, const dataType *const src, dataType *const dst) {
+        // avoid to process masked vertices
+        if(mask_ != nullptr && mask_[i] == 0)
+          return;
 
-      for(int j = 0; j < dimensionNumber_; j++) {
-        const auto curr{dimensionNumber_ * i + j};
-        tmpData[curr] = outputData[curr];
+        const auto nBegin = neighborOffsets[i];
+        const auto nEnd = neighborOffsets[i + 1];
+        const double weight = nEnd - nBegin + 1;
+        for(int j = 0; j < dim; j++) {
+          const auto curr{dim * i + j};
+          dataType value = src[curr];
+          for(SimplexId k = nBegin; k < nEnd; k++) {
+            value += src[dim * neighbors[k] + j];
+          }
+          dst[curr] = value / weight;
+        }
+      };
 
-        const auto neighborNumber = triangulation->getVertexNeighborNumber(i);
+  const auto isBoundary = [&gridDims](const SimplexId c, const int axis) {
+    return gridDims[axis] > 1 && (c == 0 || c == gridDims[axis] - 1);
+  };
+
+  // With MPI, the halo vertices (the ghost vertices and their neighbors)
+  // read values of the previous iteration received from other ranks. The
+  // other vertices are smoothed while these messages are in flight, the
+  // halo vertices once they have arrived.
+  std::vector<char> isHalo{};
+  std::vector<SimplexId> haloVertices{};
+  // grid rows holding at least one halo vertex
+  std::vector<char> isHaloRow{};
+#ifdef TTK_ENABLE_MPI
+  if(ttk::isRunningWithMPI()) {
+    isHalo.resize(vertexNumber, 0);
+    for(const auto &ghosts :
+        triangulation->getGhostVertexLocalIdsPerOwner()) {
+      for(const auto ghost : ghosts) {
+        isHalo[ghost] = 1;
+        const auto neighborNumber
+          = triangulation->getVertexNeighborNumber(ghost);
         for(SimplexId k = 0; k < neighborNumber; k++) {
           SimplexId neighborId = -1;
-          triangulation->getVertexNeighbor(i, k, neighborId);
-          tmpData[curr] += outputData[dimensionNumber_ * (neighborId) + j];
+          triangulation->getVertexNeighbor(ghost, k, neighborId);
+          isHalo[neighborId] = 1;
+        }
+      }
+    }
+    if(!stencil.empty()) {
+      isHaloRow.resize(gridDims[1] * gridDims[2], 0);
+    }
+    for(SimplexId i = 0; i < vertexNumber; i++) {
+      if(isHalo[i]) {
+        haloVertices.emplace_back(i);
+        if(!isHaloRow.empty()) {
+          isHaloRow[i / gridDims[0]] = 1;
         }
-        tmpData[curr] /= static_cast<double>(neighborNumber + 1);
       }
     }
+  }
+#endif // TTK_ENABLE_MPI
 
-    if(numberOfIterations) {
-      // assign the tmpData back to the output
-      for(SimplexId i = 0; i < vertexNumber; i++) {
-        for(int j = 0; j < dimensionNumber_; j++) {
-          // only set value for unmasked points
-          if(mask_ == nullptr || mask_[i] != 0) {
-            outputData[dimensionNumber_ * i + j]
-              = tmpData[dimensionNumber_ * i + j];
+  int timeBuckets = 10;
+  if(numberOfIterations < timeBuckets)
+    timeBuckets = numberOfIterations;
+
+  dataType *src = outputData;
+  dataType *dst = tmpData.data();
+
+#ifdef TTK_ENABLE_MPI
+  // persistent ghost vertex exchanges of both buffers
+  GhostExchange outputExchange{triangulation->getNeighborRanks(),
+                               triangulation->getRemoteGhostVertexLocalIds(),
+                               triangulation->getGhostVertexLocalIdsPerOwner(),
+                               ttk::MPIcomm_};
+  outputExchange.addArray(outputData, dim);
+  GhostExchange tmpExchange{triangulation->getNeighborRanks(),
+                            triangulation->getRemoteGhostVertexLocalIds(),
+                            triangulation->getGhostVertexLocalIdsPerOwner(),
+                            ttk::MPIcomm_};
+  tmpExchange.addArray(tmpData.data(), dim);
+#endif // TTK_ENABLE_MPI
+
+#ifdef TTK_ENABLE_MPI
+  // exchange of the ghost values of src started by the previous iteration
+  GhostExchange *pendingExchange{};
+#endif // TTK_ENABLE_MPI
+
+  for(int it = 0; it < numberOfIterations; it++) {
+    // 1. vertices that do not read ghost values
+    if(!stencil.empty()) {
+      const SimplexId rowNumber = gridDims[1] * gridDims[2];
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_)
+#endif
+      for(SimplexId row = 0; row < rowNumber; row++) {
+        const SimplexId y = row % gridDims[1];
+        const SimplexId z = row / gridDims[1];
+        const SimplexId begin = row * gridDims[0];
+        const SimplexId end = begin + gridDims[0];
+        if(!isHaloRow.empty() && isHaloRow[row]) {
+          for(SimplexId i = begin; i < end; i++) {
+            if(!isHalo[i]) {
+              smoothVertex(i, src, dst);
+            }
+          }
+        } else if(isBoundary(y, 1) || isBoundary(z, 2)) {
+          for(SimplexId i = begin; i < end; i++) {
+            smoothVertex(i, src, dst);
           }
+        } else if(gridDims[0] > 1) {
+          smoothVertex(begin, src, dst);
+          smoothRow(begin + 1, end - 1, src, dst);
+          smoothVertex(end - 1, src, dst);
+        } else {
+          smoothRow(begin, end, src, dst);
+        }
+      }
+    } else if(isHalo.empty()) {
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_)
+#endif
+      for(SimplexId i = 0; i < vertexNumber; i++) {
+        smoothNeighbors(i, src, dst);
+      }
+    } else {
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_)
+#endif
+      for(SimplexId i = 0; i < vertexNumber; i++) {
+        if(!isHalo[i]) {
+          smoothNeighbors(i, src, dst);
         }
       }
     }
+
+    // 2. halo vertices, once the ghost values of src have arrived
+#ifdef TTK_ENABLE_MPI
+    if(pendingExchange != nullptr) {
+      pendingExchange->end();
+      pendingExchange = nullptr;
+    }
+#endif // TTK_ENABLE_MPI
+    const SimplexId haloNumber = haloVertices.size();
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_)
+#endif
+    for(SimplexId k = 0; k < haloNumber; k++) {
+      if(stencil.empty()) {
+        smoothNeighbors(haloVertices[k], src, dst);
+      } else {
+        smoothVertex(haloVertices[k], src, dst);
+      }
+    }
+
+    std::swap(src, dst);
+
 #ifdef TTK_ENABLE_MPI
     if(ttk::isRunningWithMPI()) {
       // after each iteration we need to exchange the ghostcell values with our
-      // neighbors
-      exchangeGhostVertices<dataType, triangulationType>(
-        outputData, triangulation, ttk::MPIcomm_, dimensionNumber_);
+      // neighbors, it completes during the next iteration
+      pendingExchange = src == outputData ? &outputExchange : &tmpExchange;
+      pendingExchange->begin();
     }
 #endif // TTK_ENABLE_MPI
 
@@ -184,6 +408,22 @@ int ttk::ScalarFieldSmoother::smooth(const triangulationType *triangulation,
     }
   }
 
+#ifdef TTK_ENABLE_MPI
+  if(pendingExchange != nullptr) {
+    pendingExchange->end();
+  }
+#endif // TTK_ENABLE_MPI
+
+  // after an odd number of iterations, the result is in the temporary buffer
+  if(src != outputData) {
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_)
+#endif
+    for(size_t i = 0; i < valueNumber; i++) {
+      outputData[i] = src[i];
+    }
+  }
+
   printMsg("Smoothed " + std::to_string(vertexNumber) + " vertices", 1,
            t.getElapsedTime(), threadNumber_);
 
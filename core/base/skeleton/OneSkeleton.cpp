@@ -1,6 +1,10 @@
 #include <OneSkeleton.h>
+#include <OpenMP.h>
+
 #include <boost/container/small_vector.hpp>
 
+#include <bitset>
+
 using namespace ttk;
 
 OneSkeleton::OneSkeleton() {
@@ -215,6 +219,225 @@ int OneSkeleton::buildEdgeList(
     return -1;
   }
 
+  if(this->threadNumber_ == 1) {
+    return this->buildEdgeListSequential(
+      vertexNumber, cellArray, edgeList, edgeStars, cellEdgeList);
+  }
+
+  printMsg("Building edges", 0, 0, threadNumber_,
+           ttk::debug::LineMode::REPLACE);
+
+  const SimplexId cellNumber = cellArray.getNbCells();
+  cellEdgeList.resize(cellNumber);
+
+  // Edges are numbered by order of first occurrence in the cell array
+  // (cell id, then local edge id). The vertices are split into one
+  // contiguous chunk per thread, a chunk owning the edges whose lower
+  // vertex it contains. The cells are processed by blocks: each thread
+  // sends the edges of a range of cells of the block to their owner
+  // chunk, then each chunk processes the edges it received by
+  // increasing cell ids. First occurrences are flagged per cell and a
+  // prefix sum over the flags gives the same numbering as a sequential
+  // sweep. Finally, each chunk scans the cells again to write the ids
+  // and the stars of its edges straight into the outputs.
+
+  struct EdgeData {
+    // the id of the edge higher vertex
+    SimplexId highVert{};
+    // the edge id in its chunk
+    SimplexId id{};
+    // the number of cells in the edge star
+    SimplexId nStars{1};
+    EdgeData(SimplexId hv, SimplexId i) : highVert{hv}, id{i} {
+    }
+  };
+
+  // an occurrence of an edge in a cell
+  struct EdgeOccurrence {
+    SimplexId v0;
+    SimplexId v1;
+    SimplexId cid;
+    SimplexId ecid;
+  };
+
+  using boost::container::small_vector;
+  // for each vertex, a vector of EdgeData
+  std::vector<small_vector<EdgeData, 8>> edgeTable(vertexNumber);
+  // for each cell, a bit mask of the edges occurring for the first time
+  std::vector<unsigned char> firstSeen(cellNumber);
+
+  // at most 256 chunks, so that a chunk index fits in a byte
+  const SimplexId nChunks = std::min(256, std::max(1, threadNumber_));
+  // per chunk, first occurrence (cell id, local id) of the edges in
+  // discovery order, later replaced by (edge id, next position in the
+  // edge stars)
+  std::vector<std::vector<std::array<SimplexId, 2>>> chunkEdges(nChunks);
+  // for each edge occurrence, the chunk owning the edge
+  std::vector<std::array<unsigned char, n>> cellEdgeChunks(cellNumber);
+  // edge occurrences sent by thread i to chunk j in buckets[i * nChunks + j]
+  std::vector<std::vector<EdgeOccurrence>> buckets(nChunks * nChunks);
+
+  const SimplexId chunkSize
+    = std::max<SimplexId>(1, (vertexNumber + nChunks - 1) / nChunks);
+  const auto chunkBounds = [vertexNumber, chunkSize](const SimplexId c) {
+    return std::array<SimplexId, 2>{
+      std::min(vertexNumber, c * chunkSize),
+      std::min(vertexNumber, (c + 1) * chunkSize)};
+  };
+
+  // number of cells per block
+  const SimplexId blockSize = 1 << 16;
+
+  for(SimplexId begin = 0; begin < cellNumber; begin += blockSize) {
+    const auto end = std::min(cellNumber, begin + blockSize);
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_) schedule(static, 1)
+#endif // TTK_ENABLE_OPENMP
+    for(SimplexId i = 0; i < nChunks; ++i) {
+      for(SimplexId j = 0; j < nChunks; ++j) {
+        buckets[i * nChunks + j].clear();
+      }
+      const auto first = begin + (end - begin) * i / nChunks;
+      const auto last = begin + (end - begin) * (i + 1) / nChunks;
+      for(SimplexId cid = first; cid < last; cid++) {
+        const auto localEdges{getLocalEdges<n>(cellArray, cid)};
+        for(size_t ecid = 0; ecid < n; ++ecid) {
+          const auto v0 = std::min(localEdges[ecid][0], localEdges[ecid][1]);
+          const auto v1 = std::max(localEdges[ecid][0], localEdges[ecid][1]);
+          const auto c = v0 / chunkSize;
+          cellEdgeChunks[cid][ecid] = c;
+          buckets[i * nChunks + c].emplace_back(
+            EdgeOccurrence{v0, v1, cid, static_cast<SimplexId>(ecid)});
+        }
+      }
+    }
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_) schedule(static, 1)
+#endif // TTK_ENABLE_OPENMP
+    for(SimplexId c = 0; c < nChunks; ++c) {
+      auto &edges = chunkEdges[c];
+      // the threads ranges are sorted by increasing cell ids
+      for(SimplexId i = 0; i < nChunks; ++i) {
+        for(const auto &occ : buckets[i * nChunks + c]) {
+          auto &vec = edgeTable[occ.v0];
+          const auto pos = std::find_if(
+            vec.begin(), vec.end(),
+            [&](const EdgeData &a) { return a.highVert == occ.v1; });
+          SimplexId id{};
+          if(pos == vec.end()) {
+            // not found in edgeTable: new edge
+            id = edges.size();
+            vec.emplace_back(EdgeData{occ.v1, id});
+            edges.push_back({occ.cid, occ.ecid});
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp atomic update
+#endif // TTK_ENABLE_OPENMP
+            firstSeen[occ.cid] |= 1 << occ.ecid;
+          } else {
+            // found an existing edge
+            pos->nStars++;
+            id = pos->id;
+          }
+          cellEdgeList[occ.cid][occ.ecid] = id;
+        }
+      }
+    }
+  }
+  std::vector<std::vector<EdgeOccurrence>>{}.swap(buckets);
+
+  printMsg("Building edges", 0.5, t.getElapsedTime(), threadNumber_,
+           debug::LineMode::REPLACE);
+
+  // number of new edges per cell
+  std::vector<SimplexId> cellOffsets(cellNumber + 1);
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+  for(SimplexId i = 0; i < cellNumber; ++i) {
+    cellOffsets[i + 1] = std::bitset<8>(firstSeen[i]).count();
+  }
+
+  parallelInclusiveScan(cellOffsets.data(), cellOffsets.size(), threadNumber_);
+  const SimplexId edgeCount = cellOffsets.back();
+
+  // allocate & fill edgeList in parallel
+  edgeList.resize(edgeCount);
+  // number of cells per edge
+  std::vector<SimplexId> offsets(edgeCount + 1);
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_) schedule(static, 1)
+#endif // TTK_ENABLE_OPENMP
+  for(SimplexId c = 0; c < nChunks; ++c) {
+    const auto bounds = chunkBounds(c);
+    auto &edges = chunkEdges[c];
+    for(auto &edge : edges) {
+      const auto cid = edge[0];
+      // rank of the edge among the new edges of its first cell
+      const auto prev = firstSeen[cid] & ((1 << edge[1]) - 1);
+      edge[0] = cellOffsets[cid] + std::bitset<8>(prev).count();
+    }
+    for(SimplexId v = bounds[0]; v < bounds[1]; ++v) {
+      for(const auto &data : edgeTable[v]) {
+        const auto id = edges[data.id][0];
+        edgeList[id] = {v, data.highVert};
+        offsets[id + 1] = data.nStars;
+      }
+    }
+  }
+
+  // compute partial sum of number of cells per edge
+  parallelInclusiveScan(offsets.data(), offsets.size(), threadNumber_);
+
+  // allocate flat edge stars vector
+  std::vector<SimplexId> edgeSt(offsets.back());
+
+  // each chunk replaces its edge ids in cellEdgeList and fills the
+  // stars of its edges, by increasing cell ids
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_) schedule(static, 1)
+#endif // TTK_ENABLE_OPENMP
+  for(SimplexId c = 0; c < nChunks; ++c) {
+    auto &edges = chunkEdges[c];
+    for(auto &edge : edges) {
+      edge[1] = offsets[edge[0]];
+    }
+    for(SimplexId cid = 0; cid < cellNumber; cid++) {
+      for(size_t ecid = 0; ecid < n; ++ecid) {
+        if(cellEdgeChunks[cid][ecid] != c) {
+          continue;
+        }
+        auto &ce = cellEdgeList[cid][ecid];
+        auto &edge = edges[ce];
+        ce = edge[0];
+        edgeSt[edge[1]] = cid;
+        edge[1]++;
+      }
+    }
+  }
+
+  // fill FlatJaggedArray struct
+  edgeStars.setData(std::move(edgeSt), std::move(offsets));
+
+  printMsg("Built " + std::to_string(edgeCount) + " edges", 1,
+           t.getElapsedTime(), threadNumber_);
+
+  return 0;
+}
+
+template <std::size_t n>
+int OneSkeleton::buildEdgeListSequential(
+  const SimplexId &vertexNumber,
+  const CellArray &cellArray,
+  std::vector<std::array<SimplexId, 2>> &edgeList,
+  FlatJaggedArray &edgeStars,
+  std::vector<std::array<SimplexId, n>> &cellEdgeList) const {
+
+  Timer t;
+
   printMsg("Building edges", 0, 0, 1, ttk::debug::LineMode::REPLACE);
 
   const SimplexId cellNumber = cellArray.getNbCells();
@@ -271,12 +494,8 @@ int OneSkeleton::buildEdgeList(
     }
   }
 
-  // allocate & fill edgeList in parallel
   edgeList.resize(edgeCount);
 
-#ifdef TTK_ENABLE_OPENMP
-#pragma omp parallel for num_threads(this->threadNumber_)
-#endif // TTK_ENABLE_OPENMP
   for(SimplexId i = 0; i < vertexNumber; ++i) {
     const auto &etable = edgeTable[i];
     for(const auto &data : etable) {
@@ -319,10 +538,6 @@ int OneSkeleton::buildEdgeList(
   printMsg(
     "Built " + std::to_string(edgeCount) + " edges", 1, t.getElapsedTime(), 1);
 
-  // ethaneDiolMedium.vtu, 70Mtets, hal9000 (12coresHT)
-  // 1 thread: 10.4979 s
-  // 24 threads: 12.3994 s [not efficient in parallel]
-
   return 0;
 }
 
@@ -86,5 +86,16 @@ namespace ttk {
                     std::vector<std::array<SimplexId, 2>> &edgeList,
                     FlatJaggedArray &edgeStars,
                     std::vector<std::array<SimplexId, n>> &cellEdgeList) const;
+
+  private:
+    /// Single-threaded version of buildEdgeList, with a single sweep
+    /// over the cells.
+    template <std::size_t n>
+    int buildEdgeListSequential(
+      const SimplexId &vertexNumber,
+      const CellArray &cellArray,
+      std::vector<std::array<SimplexId, 2>> &edgeList,
+      FlatJaggedArray &edgeStars,
+      std::vector<std::array<SimplexId, n>> &cellEdgeList) const;
   };
 } // namespace ttk
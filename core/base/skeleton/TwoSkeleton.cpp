@@ -1,6 +1,10 @@
+#include <OpenMP.h>
 #include <TwoSkeleton.h>
+
 #include <boost/container/small_vector.hpp>
 
+#include <bitset>
+
 using namespace ttk;
 
 TwoSkeleton::TwoSkeleton() {
@@ -253,11 +257,271 @@ int TwoSkeleton::buildTriangleList(
     return -1;
   }
 
+  if(this->threadNumber_ == 1) {
+    return this->buildTriangleListSequential(
+      vertexNumber, cellArray, triangleList, triangleStars, cellTriangleList);
+  }
+
   printMsg(
     "Building triangles", 0, 0, threadNumber_, ttk::debug::LineMode::REPLACE);
 
   const SimplexId cellNumber = cellArray.getNbCells();
 
+  // we need cellTriangleList to number the triangles
+  std::vector<std::array<SimplexId, 4>> defaultCellTriangleList{};
+  if(cellTriangleList == nullptr) {
+    cellTriangleList = &defaultCellTriangleList;
+  }
+  cellTriangleList->resize(cellNumber, {-1, -1, -1, -1});
+
+  // Triangles are numbered by order of first occurrence in the cell
+  // array, as the edges in OneSkeleton::buildEdgeList: the vertices are
+  // split into one contiguous chunk per thread, each chunk owning the
+  // triangles whose lower vertex it contains. For each block of cells,
+  // the threads send the triangles of their range of cells to the
+  // owner chunks, which process them by increasing cell ids. A prefix
+  // sum over the first occurrences flagged per cell gives the triangle
+  // ids, written with the triangle stars by a last scan of each chunk.
+
+  struct TriangleData {
+    // the two higher vertices id of the triangle
+    std::array<SimplexId, 2> highVerts{};
+    // the triangle id in its chunk
+    SimplexId id{-1};
+    // the number of cells in the triangle star
+    SimplexId nStars{1};
+    TriangleData(std::array<SimplexId, 2> hVerts, SimplexId i)
+      : highVerts{hVerts}, id{i} {
+    }
+  };
+
+  // an occurrence of a triangle in a cell
+  struct TriangleOccurrence {
+    std::array<SimplexId, 3> triangle;
+    SimplexId cid;
+    SimplexId j;
+  };
+
+  using boost::container::small_vector;
+  // for each vertex, a vector of TriangleData
+  std::vector<small_vector<TriangleData, 8>> triangleTable(vertexNumber);
+  // for each cell, a bit mask of the triangles occurring for the first time
+  std::vector<unsigned char> firstSeen(cellNumber);
+
+  // at most 256 chunks, so that a chunk index fits in a byte
+  const SimplexId nChunks = std::min(256, std::max(1, threadNumber_));
+  // per chunk, first occurrence (cell id, local id) of the triangles in
+  // discovery order, later replaced by (triangle id, next position in the
+  // triangle stars)
+  std::vector<std::vector<std::array<SimplexId, 2>>> chunkTriangles(nChunks);
+  // for each triangle occurrence, the chunk owning the triangle
+  std::vector<std::array<unsigned char, 4>> cellTriangleChunks(cellNumber);
+  // triangle occurrences sent by thread i to chunk j in
+  // buckets[i * nChunks + j]
+  std::vector<std::vector<TriangleOccurrence>> buckets(nChunks * nChunks);
+
+  const SimplexId chunkSize
+    = std::max<SimplexId>(1, (vertexNumber + nChunks - 1) / nChunks);
+  const auto chunkBounds = [vertexNumber, chunkSize](const SimplexId c) {
+    return std::array<SimplexId, 2>{
+      std::min(vertexNumber, c * chunkSize),
+      std::min(vertexNumber, (c + 1) * chunkSize)};
+  };
+
+  const auto getTriangle = [&cellArray](const SimplexId cid, const size_t j) {
+    std::array<SimplexId, 3> triangle{};
+    for(size_t k = 0; k < 3; k++) {
+      // TODO: ASSUME Regular Mesh Here!
+      triangle[k] = cellArray.getCellVertex(cid, (j + k) % 4);
+    }
+    std::sort(triangle.begin(), triangle.end());
+    return triangle;
+  };
+
+  printMsg("Building triangles", 0.25, t.getElapsedTime(), threadNumber_,
+           debug::LineMode::REPLACE);
+
+  // number of cells per block
+  const SimplexId blockSize = 1 << 16;
+
+  for(SimplexId begin = 0; begin < cellNumber; begin += blockSize) {
+    const auto end = std::min(cellNumber, begin + blockSize);
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_) schedule(static, 1)
+#endif // TTK_ENABLE_OPENMP
+    for(SimplexId i = 0; i < nChunks; ++i) {
+      for(SimplexId j = 0; j < nChunks; ++j) {
+        buckets[i * nChunks + j].clear();
+      }
+      const auto first = begin + (end - begin) * i / nChunks;
+      const auto last = begin + (end - begin) * (i + 1) / nChunks;
+      for(SimplexId cid = first; cid < last; cid++) {
+        // a tetra cell has 4 faces
+        for(size_t j = 0; j < 4; j++) {
+          const auto triangle = getTriangle(cid, j);
+          const auto c = triangle[0] / chunkSize;
+          cellTriangleChunks[cid][j] = c;
+          buckets[i * nChunks + c].emplace_back(
+            TriangleOccurrence{triangle, cid, static_cast<SimplexId>(j)});
+        }
+      }
+    }
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_) schedule(static, 1)
+#endif // TTK_ENABLE_OPENMP
+    for(SimplexId c = 0; c < nChunks; ++c) {
+      auto &triangles = chunkTriangles[c];
+      // the threads ranges are sorted by increasing cell ids
+      for(SimplexId i = 0; i < nChunks; ++i) {
+        for(const auto &occ : buckets[i * nChunks + c]) {
+          const auto &triangle = occ.triangle;
+          auto &ttable = triangleTable[triangle[0]];
+
+          // check if current triangle already registered in
+          // triangleTable via another tetra in its star
+          const auto pos = std::find_if(
+            ttable.begin(), ttable.end(), [&triangle](const TriangleData &d) {
+              return d.highVerts[0] == triangle[1]
+                     && d.highVerts[1] == triangle[2];
+            });
+          SimplexId id{};
+          if(pos == ttable.end()) {
+            // new triangle added
+            id = triangles.size();
+            ttable.emplace_back(TriangleData{{triangle[1], triangle[2]}, id});
+            triangles.push_back({occ.cid, occ.j});
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp atomic update
+#endif // TTK_ENABLE_OPENMP
+            firstSeen[occ.cid] |= 1 << occ.j;
+          } else {
+            pos->nStars++;
+            id = pos->id;
+          }
+          (*cellTriangleList)[occ.cid][occ.j] = id;
+        }
+      }
+    }
+  }
+  std::vector<std::vector<TriangleOccurrence>>{}.swap(buckets);
+
+  printMsg("Building triangles", 0.5, t.getElapsedTime(), threadNumber_,
+           debug::LineMode::REPLACE);
+
+  // number of new triangles per cell
+  std::vector<SimplexId> cellOffsets(cellNumber + 1);
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+  for(SimplexId i = 0; i < cellNumber; ++i) {
+    cellOffsets[i + 1] = std::bitset<8>(firstSeen[i]).count();
+  }
+
+  parallelInclusiveScan(cellOffsets.data(), cellOffsets.size(), threadNumber_);
+  const SimplexId nTriangles = cellOffsets.back();
+
+  // resize vectors to the correct size
+  if(triangleList) {
+    triangleList->resize(nTriangles);
+  }
+  // number of cells per triangle
+  std::vector<SimplexId> offsets{};
+  if(triangleStars) {
+    offsets.resize(nTriangles + 1);
+  }
+
+  // fill data buffers in parallel
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_) schedule(static, 1)
+#endif // TTK_ENABLE_OPENMP
+  for(SimplexId c = 0; c < nChunks; ++c) {
+    const auto bounds = chunkBounds(c);
+    auto &triangles = chunkTriangles[c];
+    for(auto &triangle : triangles) {
+      const auto cid = triangle[0];
+      // rank of the triangle among the new triangles of its first cell
+      const auto prev = firstSeen[cid] & ((1 << triangle[1]) - 1);
+      triangle[0] = cellOffsets[cid] + std::bitset<8>(prev).count();
+    }
+    for(SimplexId v = bounds[0]; v < bounds[1]; ++v) {
+      for(const auto &data : triangleTable[v]) {
+        const auto id = triangles[data.id][0];
+        if(triangleList != nullptr) {
+          (*triangleList)[id] = {v, data.highVerts[0], data.highVerts[1]};
+        }
+        if(triangleStars != nullptr) {
+          offsets[id + 1] = data.nStars;
+        }
+      }
+    }
+  }
+
+  printMsg("Building triangles", 0.75, t.getElapsedTime(), threadNumber_,
+           debug::LineMode::REPLACE);
+
+  // flat triangle stars vector
+  std::vector<SimplexId> triangleSt{};
+  if(triangleStars != nullptr) {
+    // compute partial sum of number of cells per triangle
+    parallelInclusiveScan(offsets.data(), offsets.size(), threadNumber_);
+    triangleSt.resize(offsets.back());
+  }
+
+  // each chunk replaces its triangle ids in cellTriangleList and fills
+  // the stars of its triangles, by increasing cell ids
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_) schedule(static, 1)
+#endif // TTK_ENABLE_OPENMP
+  for(SimplexId c = 0; c < nChunks; ++c) {
+    auto &triangles = chunkTriangles[c];
+    if(triangleStars != nullptr) {
+      for(auto &triangle : triangles) {
+        triangle[1] = offsets[triangle[0]];
+      }
+    }
+    for(SimplexId cid = 0; cid < cellNumber; cid++) {
+      for(size_t j = 0; j < 4; j++) {
+        if(cellTriangleChunks[cid][j] != c) {
+          continue;
+        }
+        auto &ct = (*cellTriangleList)[cid][j];
+        auto &triangle = triangles[ct];
+        ct = triangle[0];
+        if(triangleStars != nullptr) {
+          triangleSt[triangle[1]] = cid;
+          triangle[1]++;
+        }
+      }
+    }
+  }
+
+  if(triangleStars != nullptr) {
+    // fill FlatJaggedArray struct
+    triangleStars->setData(std::move(triangleSt), std::move(offsets));
+  }
+
+  printMsg("Built " + std::to_string(nTriangles) + " triangles", 1,
+           t.getElapsedTime(), threadNumber_);
+  return 0;
+}
+
+int TwoSkeleton::buildTriangleListSequential(
+  const SimplexId &vertexNumber,
+  const CellArray &cellArray,
+  std::vector<std::array<SimplexId, 3>> *triangleList,
+  FlatJaggedArray *triangleStars,
+  std::vector<std::array<SimplexId, 4>> *cellTriangleList) const {
+
+  Timer t;
+
+  printMsg("Building triangles", 0, 0, 1, ttk::debug::LineMode::REPLACE);
+
+  const SimplexId cellNumber = cellArray.getNbCells();
+
   // we need cellTriangleList to compute triangleStars
   std::vector<std::array<SimplexId, 4>> defaultCellTriangleList{};
   if(triangleStars != nullptr && cellTriangleList == nullptr) {
@@ -328,17 +592,8 @@ int TwoSkeleton::buildTriangleList(
   // resize vectors to the correct size
   if(triangleList) {
     triangleList->resize(nTriangles);
-  }
-
-  // fill data buffers in parallel
-
-#ifdef TTK_ENABLE_OPENMP
-#pragma omp parallel for num_threads(this->threadNumber_)
-#endif // TTK_ENABLE_OPENMP
-  for(SimplexId i = 0; i < vertexNumber; ++i) {
-    const auto &ttable = triangleTable[i];
-    for(const auto &data : ttable) {
-      if(triangleList != nullptr) {
+    for(SimplexId i = 0; i < vertexNumber; ++i) {
+      for(const auto &data : triangleTable[i]) {
         (*triangleList)[data.id] = {i, data.highVerts[0], data.highVerts[1]};
       }
     }
@@ -371,14 +626,10 @@ int TwoSkeleton::buildTriangleList(
     // fill flat neighbors vector using offsets and neighbors count vectors
     for(size_t i = 0; i < cellTriangleList->size(); ++i) {
       const auto &ct{(*cellTriangleList)[i]};
-      triangleSt[offsets[ct[0]] + starIds[ct[0]]] = i;
-      starIds[ct[0]]++;
-      triangleSt[offsets[ct[1]] + starIds[ct[1]]] = i;
-      starIds[ct[1]]++;
-      triangleSt[offsets[ct[2]] + starIds[ct[2]]] = i;
-      starIds[ct[2]]++;
-      triangleSt[offsets[ct[3]] + starIds[ct[3]]] = i;
-      starIds[ct[3]]++;
+      for(const auto tid : ct) {
+        triangleSt[offsets[tid] + starIds[tid]] = i;
+        starIds[tid]++;
+      }
     }
 
     // fill FlatJaggedArray struct
@@ -387,13 +638,6 @@ int TwoSkeleton::buildTriangleList(
 
   printMsg("Built " + std::to_string(nTriangles) + " triangles", 1,
            t.getElapsedTime(), 1);
-  // ethaneDiolMedium.vtu, 70Mtets, hal9000 (12coresHT)// 1 thread: 58.5631 s//
-  // 24 threads: 87.5816 s (~) ethaneDiol.vtu, 8.7Mtets, vger (2coresHT) - no
-  // tet adj// 1 thread: 5.7427 s// 4 threads: 9.14764 s (~)
-  // ethaneDiol.vtu, 8.7Mtets, vger (2coresHT) - tet adjacency// 1
-  // thread: 8.59854 s// 4 threads: 15.837 s
-  // (~) ethaneDiol.vtu, 8.7Mtets, vger (2coresHT) - tet adjacency only// 1
-  // thread: 6.85897 s// 4 threads: 14.78 s (~)
   return 0;
 }
 
@@ -209,5 +209,15 @@ namespace ttk {
       const SimplexId &vertexNumber,
       const std::vector<std::array<SimplexId, 3>> &triangleList,
       FlatJaggedArray &vertexTriangles) const;
+
+  private:
+    /// Single-threaded version of buildTriangleList, with a single
+    /// sweep over the cells.
+    int buildTriangleListSequential(
+      const SimplexId &vertexNumber,
+      const CellArray &cellArray,
+      std::vector<std::array<SimplexId, 3>> *triangleList,
+      FlatJaggedArray *triangleStars,
+      std::vector<std::array<SimplexId, 4>> *cellTriangleList) const;
   };
 } // namespace ttk
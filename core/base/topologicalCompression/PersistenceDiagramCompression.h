@@ -72,6 +72,24 @@ int ttk::TopologicalCompression::ReadPersistenceGeometry(
 #endif
   }
 
+  const auto status = ReconstructPersistenceGeometry(
+    mappingsSortedPerValue, min, max, nbConstraints, vertexNumber,
+    triangulation);
+
+  this->rawFileLength += numberOfBytesRead;
+
+  return status;
+}
+
+template <typename triangulationType>
+int ttk::TopologicalCompression::ReconstructPersistenceGeometry(
+  std::vector<std::tuple<double, int>> &mappingsSortedPerValue,
+  double min,
+  double max,
+  int nbConstraints,
+  int vertexNumber,
+  const triangulationType &triangulation) {
+
   // No SQ.
   if(SQMethodInt == 0 || SQMethodInt == 3) {
     for(int i = 0; i < (int)criticalConstraints_.size(); ++i) {
@@ -106,8 +124,6 @@ int ttk::TopologicalCompression::ReadPersistenceGeometry(
                                 triangulation);
   this->printMsg("Successfully performed simplification.");
 
-  this->rawFileLength += numberOfBytesRead;
-
   return 0;
 }
 
@@ -11,8 +11,9 @@ ttk::TopologicalCompression::TopologicalCompression() {
 
 #include <zfp.h>
 
+template <typename StreamType>
 int ttk::TopologicalCompression::CompressWithZFP(
-  FILE *file,
+  StreamType *file,
   const bool decompress,
   std::vector<double> &array,
   const int nx,
@@ -69,7 +70,7 @@ int ttk::TopologicalCompression::CompressWithZFP(
   // compress or decompress entire array
   if(decompress) {
     // read compressed stream and decompress array
-    zfpsize += fread(buffer.data(), 1, bufsize, file);
+    zfpsize += ReadByteArray(file, buffer.data(), bufsize);
 
     // read the ZFP header (from v2)
     const auto res = zfp_read_header(zfp, field, ZFP_HEADER_FULL);
@@ -96,7 +97,7 @@ int ttk::TopologicalCompression::CompressWithZFP(
       this->printErr("Compression failed");
       status = 1;
     } else
-      fwrite(buffer.data(), 1, zfpsize, file);
+      WriteByteArray(file, buffer.data(), zfpsize);
   }
 
   // clean up
@@ -111,6 +112,14 @@ int ttk::TopologicalCompression::CompressWithZFP(
   return (int)zfpsize;
 }
 
+template int ttk::TopologicalCompression::CompressWithZFP<FILE>(
+  FILE *, const bool, std::vector<double> &, const int, const int, const int,
+  const double) const;
+template int ttk::TopologicalCompression::CompressWithZFP<
+  ttk::TopologicalCompression::ByteBuffer>(
+  ByteBuffer *, const bool, std::vector<double> &, const int, const int,
+  const int, const double) const;
+
 #endif // TTK_ENABLE_ZFP
 
 #ifdef TTK_ENABLE_ZLIB
@@ -152,8 +161,9 @@ unsigned int ttk::TopologicalCompression::log2(int val) {
 
 // IO.
 
+template <typename StreamType>
 int ttk::TopologicalCompression::ReadCompactSegmentation(
-  FILE *fm,
+  StreamType *fm,
   std::vector<int> &segmentation,
   int &numberOfVertices,
   int &numberOfSegments) const {
@@ -256,8 +266,9 @@ int ttk::TopologicalCompression::ReadCompactSegmentation(
 }
 
 // Returns number of bytes written.
+template <typename StreamType>
 int ttk::TopologicalCompression::WriteCompactSegmentation(
-  FILE *fm,
+  StreamType *fm,
   const std::vector<int> &segmentation,
   int numberOfVertices,
   int numberOfSegments) const {
@@ -339,8 +350,9 @@ int ttk::TopologicalCompression::WriteCompactSegmentation(
   return numberOfBytesWritten;
 }
 
+template <typename StreamType>
 int ttk::TopologicalCompression::ReadPersistenceIndex(
-  FILE *fm,
+  StreamType *fm,
   std::vector<std::tuple<double, int>> &mappings,
   std::vector<std::tuple<double, int>> &mappingsSortedPerValue,
   std::vector<std::tuple<int, double, int>> &constraints,
@@ -406,8 +418,9 @@ int ttk::TopologicalCompression::ReadPersistenceIndex(
   return numberOfBytesRead;
 }
 
+template <typename StreamType>
 int ttk::TopologicalCompression::WritePersistenceIndex(
-  FILE *fm,
+  StreamType *fm,
   std::vector<std::tuple<double, int>> &mapping,
   std::vector<std::tuple<int, double, int>> &constraints) const {
 
@@ -453,100 +466,22 @@ int ttk::TopologicalCompression::WritePersistenceIndex(
   return numberOfBytesWritten;
 }
 
-int ttk::TopologicalCompression::ComputeTotalSizeForPersistenceDiagram(
-  std::vector<std::tuple<double, int>> &mapping,
-  std::vector<std::tuple<int, double, int>> &criticalConstraints,
-  bool zfpOnly,
-  int nSegments,
-  int nVertices,
-  double zfpTolerance) const {
-
-  int totalSize = 0;
-
-  if(!zfpOnly) {
-    // Topological segments.
-    int numberOfBitsPerSegment = log2(nSegments) + 1;
-    double nbCharPerSegment = (double)numberOfBitsPerSegment / 8.0;
-    totalSize += (sizeof(int) * 2 + std::ceil(nbCharPerSegment * nVertices));
-
-    // Geometrical mapping.
-    auto mappingSize = (int)mapping.size();
-    auto constraintsSize = (int)criticalConstraints.size();
-    totalSize += (mappingSize) * (sizeof(int) + sizeof(double)) + sizeof(int);
-    totalSize
-      += (constraintsSize) * (2 * sizeof(int) + sizeof(double)) + sizeof(int);
-  }
-
-  // conservative estimate of the ZFP buffer (no compression at all...)
-  totalSize += zfpTolerance > 0.0 ? nVertices * sizeof(double) : 0 + 2;
-
-  return totalSize;
-}
-
-int ttk::TopologicalCompression::WritePersistenceTopology(FILE *fm) {
-  int numberOfBytesWritten = 0;
-
-  int numberOfVertices = getNbVertices();
-  int numberOfSegments = getNbSegments();
-
-  // Test arguments.
-  if(numberOfSegments < 1)
-    return -1;
-
-  numberOfBytesWritten += sizeof(int);
-  Write<int32_t>(fm, numberOfVertices);
-
-  numberOfBytesWritten += sizeof(int);
-  Write<int32_t>(fm, numberOfSegments);
-
-  numberOfBytesWritten += WriteCompactSegmentation(
-    fm, getSegmentation(), numberOfVertices, numberOfSegments);
-
-  rawFileLength += numberOfBytesWritten;
-
-  return 0;
-}
-
-int ttk::TopologicalCompression::WritePersistenceGeometry(FILE *fm,
-                                                          int *dataExtent,
-                                                          bool zfpOnly,
-                                                          double zfpTolerance,
-                                                          double *toCompress) {
-  int numberOfBytesWritten = 0;
-
-  if(!zfpOnly) {
-    // 1. Write segmentation map.
-    // 2. Write critical constraints.
-    numberOfBytesWritten
-      += WritePersistenceIndex(fm, mapping_, criticalConstraints_);
-  }
-
-  this->printMsg("Wrote raw geometry.");
-
-  if(zfpTolerance >= 0.0) {
-#ifdef TTK_ENABLE_ZFP
-    // (1. or 3.) Write zfp-compressed array.
-    int nx = 1 + dataExtent[1] - dataExtent[0];
-    int ny = 1 + dataExtent[3] - dataExtent[2];
-    int nz = 1 + dataExtent[5] - dataExtent[4];
-
-    std::vector<double> dataVector(toCompress, toCompress + (nx * ny * nz));
-    numberOfBytesWritten
-      += CompressWithZFP(fm, false, dataVector, nx, ny, nz, zfpTolerance);
-
-#else
-    TTK_FORCE_USE(dataExtent);
-    TTK_FORCE_USE(toCompress);
-
-    this->printErr("Attempted to write with ZFP but ZFP is not installed.");
-    return -5;
-#endif
-  }
-
-  rawFileLength += numberOfBytesWritten;
-
-  return 0;
-}
+#define TTK_INSTANTIATE_STREAM(StreamType)                                     \
+  template int ttk::TopologicalCompression::ReadCompactSegmentation(          \
+    StreamType *, std::vector<int> &, int &, int &) const;                    \
+  template int ttk::TopologicalCompression::WriteCompactSegmentation(         \
+    StreamType *, const std::vector<int> &, int, int) const;                  \
+  template int ttk::TopologicalCompression::ReadPersistenceIndex(             \
+    StreamType *, std::vector<std::tuple<double, int>> &,                     \
+    std::vector<std::tuple<double, int>> &,                                   \
+    std::vector<std::tuple<int, double, int>> &, double &, double &, int &)   \
+    const;                                                                    \
+  template int ttk::TopologicalCompression::WritePersistenceIndex(            \
+    StreamType *, std::vector<std::tuple<double, int>> &,                     \
+    std::vector<std::tuple<int, double, int>> &) const;
+
+TTK_INSTANTIATE_STREAM(FILE)
+TTK_INSTANTIATE_STREAM(ttk::TopologicalCompression::ByteBuffer)
 
 int ttk::TopologicalCompression::ReadPersistenceTopology(FILE *fm) {
   int numberOfSegments;
@@ -564,14 +499,6 @@ int ttk::TopologicalCompression::ReadPersistenceTopology(FILE *fm) {
 // Other compression methods //
 ///////////////////////////////
 
-int ttk::TopologicalCompression::ComputeTotalSizeForOther() const {
-  // Should return the number of bytes to be written on the output file
-  // sizeof(char) = 1 (byte)
-  // use sizeof(int), sizeof(double) to get the number of bytes of
-  // the matching structures.
-  return 0;
-}
-
 int ttk::TopologicalCompression::computeOther() const {
   // Code me
   return 0;
@@ -603,6 +530,422 @@ int ttk::TopologicalCompression::ReadOtherGeometry(FILE *ttkNotUsed(fm)) const {
   return 0;
 }
 
+////////////
+// Bricks //
+////////////
+
+void ttk::TopologicalCompression::getBrickBounds(
+  const int brick,
+  const std::array<int, 3> &nBricks,
+  const std::array<int, 3> &dimensions,
+  std::array<int, 6> &bounds) const {
+
+  const std::array<int, 3> index{brick % nBricks[0],
+                                 (brick / nBricks[0]) % nBricks[1],
+                                 brick / (nBricks[0] * nBricks[1])};
+  for(int i = 0; i < 3; ++i) {
+    bounds[2 * i] = index[i] * BrickSize;
+    // the last brick along each axis also holds the remainder (no brick
+    // thinner than BrickSize, ZFP does not support one-dimensional arrays)
+    bounds[2 * i + 1] = index[i] == nBricks[i] - 1 ? dimensions[i]
+                                                   : (index[i] + 1) * BrickSize;
+  }
+}
+
+void ttk::TopologicalCompression::CompressChunk(
+  const ByteBuffer &chunk, std::vector<unsigned char> &dest) const {
+#ifdef TTK_ENABLE_ZLIB
+  if(chunk.data.empty()) {
+    dest.clear();
+    return;
+  }
+  auto destLen = GetZlibDestLen(chunk.data.size());
+  dest.resize(destLen);
+  CompressWithZlib(
+    false, dest.data(), destLen, chunk.data.data(), chunk.data.size());
+  dest.resize(destLen);
+#else
+  dest = chunk.data;
+#endif
+}
+
+int ttk::TopologicalCompression::UncompressChunk(
+  const std::vector<unsigned char> &source,
+  const uint64_t rawSize,
+  const bool useZlib,
+  ByteBuffer &chunk) const {
+
+  chunk.data.resize(rawSize);
+  chunk.cursor = 0;
+
+  if(!useZlib || rawSize == 0) {
+    if(source.size() != rawSize)
+      return -1;
+    std::copy(source.begin(), source.end(), chunk.data.begin());
+    return 0;
+  }
+
+#ifdef TTK_ENABLE_ZLIB
+  auto destLen = static_cast<unsigned long>(rawSize);
+  CompressWithZlib(
+    true, chunk.data.data(), destLen, source.data(), source.size());
+  return destLen == rawSize ? 0 : -1;
+#else
+  this->printErr("File compressed but ZLIB not installed! Aborting.");
+  return -4;
+#endif
+}
+
+int ttk::TopologicalCompression::WriteChunk(FILE *fp,
+                                            const ByteBuffer &chunk) const {
+  std::vector<unsigned char> dest{};
+  CompressChunk(chunk, dest);
+
+  Write<uint64_t>(fp, dest.size()); // Compressed size...
+  Write<uint64_t>(fp, chunk.data.size()); // Uncompressed size...
+  if(!dest.empty())
+    WriteByteArray(fp, dest.data(), dest.size());
+
+  return 0;
+}
+
+int ttk::TopologicalCompression::ReadChunk(FILE *fp,
+                                           const bool useZlib,
+                                           ByteBuffer &chunk) const {
+  const auto sl = Read<uint64_t>(fp); // Compressed size...
+  const auto dl = Read<uint64_t>(fp); // Uncompressed size...
+
+  std::vector<unsigned char> source(sl);
+  if(sl > 0)
+    ReadByteArray(fp, source.data(), sl);
+
+  return UncompressChunk(source, dl, useZlib, chunk);
+}
+
+int ttk::TopologicalCompression::WritePersistenceBricks(FILE *fp,
+                                                        int *dataExtent,
+                                                        bool zfpOnly,
+                                                        double zfpTolerance,
+                                                        double *toCompress) {
+  Timer tm{};
+
+#ifndef TTK_ENABLE_ZFP
+  TTK_FORCE_USE(toCompress);
+  if(zfpTolerance >= 0.0) {
+    this->printErr("Attempted to write with ZFP but ZFP is not installed.");
+    return -5;
+  }
+#endif // TTK_ENABLE_ZFP
+
+  if(BrickSize < 2) {
+    this->printErr("Brick size should be at least 2.");
+    return -1;
+  }
+
+  const std::array<int, 3> dims{1 + dataExtent[1] - dataExtent[0],
+                                1 + dataExtent[3] - dataExtent[2],
+                                1 + dataExtent[5] - dataExtent[4]};
+  std::array<int, 3> nBricks{};
+  for(int i = 0; i < 3; ++i)
+    nBricks[i] = std::max(1, dims[i] / BrickSize);
+  const int brickNumber = nBricks[0] * nBricks[1] * nBricks[2];
+
+  // 1. Brick size and (global) persistence index.
+  Write<int32_t>(fp, BrickSize);
+
+  ByteBuffer index{};
+  if(!zfpOnly)
+    WritePersistenceIndex(&index, mapping_, criticalConstraints_);
+  WriteChunk(fp, index);
+
+  // 2. Encode and compress the bricks in parallel.
+  std::vector<std::vector<unsigned char>> bricks(brickNumber);
+  std::vector<uint64_t> rawSizes(brickNumber);
+  std::vector<int> status(brickNumber, 0);
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_) schedule(dynamic)
+#endif // TTK_ENABLE_OPENMP
+  for(int b = 0; b < brickNumber; ++b) {
+    std::array<int, 6> bounds{};
+    getBrickBounds(b, nBricks, dims, bounds);
+    const std::array<int, 3> bDims{
+      bounds[1] - bounds[0], bounds[3] - bounds[2], bounds[5] - bounds[4]};
+    const int bVertexNumber = bDims[0] * bDims[1] * bDims[2];
+
+    // brick vertices, x first
+    std::vector<int> vertices{};
+    vertices.reserve(bVertexNumber);
+    for(int k = bounds[4]; k < bounds[5]; ++k)
+      for(int j = bounds[2]; j < bounds[3]; ++j)
+        for(int i = bounds[0]; i < bounds[1]; ++i)
+          vertices.emplace_back(i + dims[0] * (j + dims[1] * k));
+
+    ByteBuffer raw{};
+
+    if(!zfpOnly) {
+      // (the encoder reads a few segments past the end)
+      std::vector<int> segmentation(bVertexNumber + 32, 0);
+      for(int v = 0; v < bVertexNumber; ++v)
+        segmentation[v] = segmentation_[vertices[v]];
+      Write<int32_t>(&raw, bVertexNumber);
+      Write<int32_t>(&raw, NbSegments);
+      if(WriteCompactSegmentation(
+           &raw, segmentation, bVertexNumber, NbSegments)
+         < 0)
+        status[b] = -3;
+    }
+
+#ifdef TTK_ENABLE_ZFP
+    if(zfpTolerance >= 0.0) {
+      std::vector<double> values(bVertexNumber);
+      for(int v = 0; v < bVertexNumber; ++v)
+        values[v] = toCompress[vertices[v]];
+      CompressWithZFP(
+        &raw, false, values, bDims[0], bDims[1], bDims[2], zfpTolerance);
+    }
+#endif // TTK_ENABLE_ZFP
+
+    rawSizes[b] = raw.data.size();
+    CompressChunk(raw, bricks[b]);
+  }
+
+  for(int b = 0; b < brickNumber; ++b) {
+    if(status[b] != 0) {
+      this->printErr("Could not encode brick " + std::to_string(b) + ".");
+      return status[b];
+    }
+  }
+
+  // 3. Chunk index: offset (from the end of the index), compressed size and
+  // raw size of each brick.
+  Write<uint64_t>(fp, brickNumber);
+  uint64_t offset = 0;
+  for(int b = 0; b < brickNumber; ++b) {
+    Write<uint64_t>(fp, offset);
+    Write<uint64_t>(fp, bricks[b].size());
+    Write<uint64_t>(fp, rawSizes[b]);
+    offset += bricks[b].size();
+  }
+
+  // 4. Bricks.
+  for(int b = 0; b < brickNumber; ++b)
+    if(!bricks[b].empty())
+      WriteByteArray(fp, bricks[b].data(), bricks[b].size());
+
+  this->printMsg("Wrote " + std::to_string(brickNumber) + " bricks ("
+                   + std::to_string(offset) + " bytes)",
+                 1.0, tm.getElapsedTime(), this->threadNumber_);
+
+  return 0;
+}
+
+int ttk::TopologicalCompression::ReadPersistenceBricks(
+  FILE *fp,
+  const bool useZlib,
+  std::vector<std::tuple<double, int>> &mappingsSortedPerValue,
+  double &min,
+  double &max,
+  int &nbConstraints) {
+
+  Timer tm{};
+
+  // 1. Brick size and (global) persistence index.
+  const int brickSize = Read<int32_t>(fp);
+  if(brickSize < 2) {
+    this->printErr("Invalid brick size.");
+    return -1;
+  }
+  BrickSize = brickSize;
+
+  ByteBuffer index{};
+  if(ReadChunk(fp, useZlib, index) != 0) {
+    this->printErr("Could not read the persistence index.");
+    return -1;
+  }
+  mapping_.clear();
+  criticalConstraints_.clear();
+  if(!ZFPOnly) {
+    ReadPersistenceIndex(&index, mapping_, mappingsSortedPerValue,
+                         criticalConstraints_, min, max, nbConstraints);
+    this->printMsg("Successfully read geomap.");
+  }
+
+  // 2. Chunk index.
+  const std::array<int, 3> dims{1 + dataExtent_[1] - dataExtent_[0],
+                                1 + dataExtent_[3] - dataExtent_[2],
+                                1 + dataExtent_[5] - dataExtent_[4]};
+  std::array<int, 3> nBricks{};
+  for(int i = 0; i < 3; ++i)
+    nBricks[i] = std::max(1, dims[i] / BrickSize);
+  const int brickNumber = nBricks[0] * nBricks[1] * nBricks[2];
+
+  if(Read<uint64_t>(fp) != static_cast<uint64_t>(brickNumber)) {
+    this->printErr("Unexpected number of bricks.");
+    return -1;
+  }
+  std::vector<uint64_t> offsets(brickNumber), sizes(brickNumber),
+    rawSizes(brickNumber);
+  for(int b = 0; b < brickNumber; ++b) {
+    offsets[b] = Read<uint64_t>(fp);
+    sizes[b] = Read<uint64_t>(fp);
+    rawSizes[b] = Read<uint64_t>(fp);
+  }
+  const auto bricksStart = std::ftell(fp);
+
+  // 3. Read extent, relative to the data extent (whole extent if empty or
+  // if the geometry reconstruction needs the whole grid).
+  const bool subExtent = this->canReadSubExtent();
+  std::array<int, 3> r0{}, r1{};
+  for(int i = 0; i < 3; ++i) {
+    r0[i] = 0;
+    r1[i] = dims[i] - 1;
+    if(subExtent && readExtent_[2 * i] <= readExtent_[2 * i + 1]) {
+      r0[i] = std::max(r0[i], readExtent_[2 * i] - dataExtent_[2 * i]);
+      r1[i] = std::min(r1[i], readExtent_[2 * i + 1] - dataExtent_[2 * i]);
+    }
+    if(r0[i] > r1[i]) {
+      this->printErr("Read extent does not intersect the data extent.");
+      return -1;
+    }
+    readExtent_[2 * i] = dataExtent_[2 * i] + r0[i];
+    readExtent_[2 * i + 1] = dataExtent_[2 * i] + r1[i];
+  }
+  const std::array<int, 3> rDims{
+    1 + r1[0] - r0[0], 1 + r1[1] - r0[1], 1 + r1[2] - r0[2]};
+  const int vertexNumber = rDims[0] * rDims[1] * rDims[2];
+
+  // 4. Read the bricks intersecting the read extent.
+  std::vector<int> selected{};
+  std::vector<std::array<int, 6>> bounds{};
+  for(int b = 0; b < brickNumber; ++b) {
+    std::array<int, 6> bb{};
+    getBrickBounds(b, nBricks, dims, bb);
+    bool intersects = true;
+    for(int i = 0; i < 3; ++i)
+      intersects = intersects && bb[2 * i] <= r1[i] && bb[2 * i + 1] > r0[i];
+    if(intersects) {
+      selected.emplace_back(b);
+      bounds.emplace_back(bb);
+    }
+  }
+  const int selectedNumber = selected.size();
+
+  std::vector<std::vector<unsigned char>> payloads(selectedNumber);
+  for(int s = 0; s < selectedNumber; ++s) {
+    const auto b = selected[s];
+    payloads[s].resize(sizes[b]);
+    if(sizes[b] == 0)
+      continue;
+    std::fseek(fp, bricksStart + static_cast<long>(offsets[b]), SEEK_SET);
+    ReadByteArray(fp, payloads[s].data(), sizes[b]);
+  }
+
+  // 5. Decode them in parallel.
+  decompressedData_.assign(vertexNumber, 0.0);
+  segmentation_.assign(ZFPOnly ? 0 : vertexNumber, 0);
+  std::vector<int> status(selectedNumber, 0);
+
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(threadNumber_) schedule(dynamic)
+#endif // TTK_ENABLE_OPENMP
+  for(int s = 0; s < selectedNumber; ++s) {
+    const auto &bb = bounds[s];
+    const std::array<int, 3> bDims{
+      bb[1] - bb[0], bb[3] - bb[2], bb[5] - bb[4]};
+    const int bVertexNumber = bDims[0] * bDims[1] * bDims[2];
+
+    ByteBuffer raw{};
+    if(UncompressChunk(payloads[s], rawSizes[selected[s]], useZlib, raw)
+       != 0) {
+      status[s] = -1;
+      continue;
+    }
+
+    std::vector<int> segmentation{};
+    if(!ZFPOnly) {
+      int numberOfVertices{}, numberOfSegments{};
+      ReadCompactSegmentation(
+        &raw, segmentation, numberOfVertices, numberOfSegments);
+      if(numberOfVertices != bVertexNumber
+         || static_cast<int>(segmentation.size()) < bVertexNumber) {
+        status[s] = -2;
+        continue;
+      }
+    }
+
+    std::vector<double> values{};
+    if(ZFPTolerance >= 0.0) {
+#ifdef TTK_ENABLE_ZFP
+      values.resize(bVertexNumber);
+      CompressWithZFP(
+        &raw, true, values, bDims[0], bDims[1], bDims[2], ZFPTolerance);
+#else
+      status[s] = -5;
+      continue;
+#endif // TTK_ENABLE_ZFP
+    }
+
+    // copy the part of the brick inside the read extent
+    for(int k = std::max(bb[4], r0[2]); k < std::min(bb[5], r1[2] + 1); ++k) {
+      for(int j = std::max(bb[2], r0[1]); j < std::min(bb[3], r1[1] + 1);
+          ++j) {
+        for(int i = std::max(bb[0], r0[0]); i < std::min(bb[1], r1[0] + 1);
+            ++i) {
+          const int v
+            = (i - bb[0]) + bDims[0] * ((j - bb[2]) + bDims[1] * (k - bb[4]));
+          const int l
+            = (i - r0[0]) + rDims[0] * ((j - r0[1]) + rDims[1] * (k - r0[2]));
+          if(!ZFPOnly)
+            segmentation_[l] = segmentation[v];
+          if(ZFPTolerance >= 0.0) {
+            decompressedData_[l] = values[v];
+          } else {
+            // assign values to points thanks to topology indices
+            const auto it
+              = std::lower_bound(mapping_.begin(), mapping_.end(),
+                                 std::make_tuple(0, segmentation[v]), cmp);
+            if(it == mapping_.end() || std::get<1>(*it) != segmentation[v]) {
+              status[s] = -3;
+              continue;
+            }
+            decompressedData_[l] = std::get<0>(*it);
+          }
+        }
+      }
+    }
+  }
+
+  for(int s = 0; s < selectedNumber; ++s) {
+    if(status[s] != 0) {
+      this->printErr("Could not decode brick " + std::to_string(selected[s])
+                     + " (" + std::to_string(status[s]) + ").");
+      return status[s];
+    }
+  }
+
+  // 6. Keep the critical constraints of the read extent.
+  std::vector<std::tuple<int, double, int>> constraints{};
+  for(const auto &c : criticalConstraints_) {
+    const int id = std::get<0>(c);
+    const int i = id % dims[0] - r0[0];
+    const int j = (id / dims[0]) % dims[1] - r0[1];
+    const int k = id / (dims[0] * dims[1]) - r0[2];
+    if(i >= 0 && i < rDims[0] && j >= 0 && j < rDims[1] && k >= 0
+       && k < rDims[2])
+      constraints.emplace_back(
+        i + rDims[0] * (j + rDims[1] * k), std::get<1>(c), std::get<2>(c));
+  }
+  criticalConstraints_ = std::move(constraints);
+  nbConstraints = criticalConstraints_.size();
+
+  this->printMsg("Decoded " + std::to_string(selectedNumber) + "/"
+                   + std::to_string(brickNumber) + " bricks",
+                 1.0, tm.getElapsedTime(), this->threadNumber_);
+
+  return 0;
+}
+
 /////////////////////////////
 // Read/Write File methods //
 /////////////////////////////
@@ -627,6 +970,7 @@ int ttk::TopologicalCompression::WriteToFile(FILE *fp,
 #ifdef TTK_ENABLE_ZLIB
   Write<uint8_t>(fp, true);
 #else
+  this->printMsg("ZLIB not found, writing raw file.");
   Write<uint8_t>(fp, false);
 #endif
 
@@ -639,95 +983,27 @@ int ttk::TopologicalCompression::WriteToFile(FILE *fp,
     numberOfVertices *= (1 + dataExtent[2 * i + 1] - dataExtent[2 * i]);
   NbVertices = numberOfVertices;
 
-  int totalSize = usePersistence ? ComputeTotalSizeForPersistenceDiagram(
-                    getMapping(), getCriticalConstraints(), zfpOnly,
-                    getNbSegments(), getNbVertices(), zfpTolerance)
-                  : useOther ? ComputeTotalSizeForOther()
-                             : 0;
-
-  std::vector<char> bbuf(totalSize);
-  char *buf = bbuf.data();
-  size_t len = (size_t)totalSize;
-
-  // #ifndef _MSC_VER
-  // FILE *fm = fmemopen(buf, len, "r+");
-  // #else
-  const std::string s = fileName + std::string(".temp");
-  const char *ffn = s.c_str();
-  FILE *fm = fopen(ffn, "wb");
-  // #endif
-
-  // [->fm] Encode, lossless compress and write topology.
-  if(!(zfpOnly)) {
-    if(usePersistence)
-      WritePersistenceTopology(fm);
-    else if(useOther)
-      WriteOtherTopology(fm);
-  }
-
-  this->printMsg("Topology successfully written to buffer.");
-
+  // [->fp] Encode, compress and write topology and geometry per brick.
   int status = 0;
-  // [->fm] Write altered geometry.
-  if(usePersistence)
+  if(usePersistence) {
     status
-      = WritePersistenceGeometry(fm, dataExtent, zfpOnly, zfpTolerance, data);
-  else if(useOther)
-    status = WriteOtherGeometry(fm);
-
-  fclose(fm); // !Close stream to write changes!
-  // #ifdef _MSC_VER
-  fm = fopen(ffn, "rb");
-  int ret = fread(buf, len, sizeof(char), fm);
-  fclose(fm);
-  remove(ffn);
-  // #endif
+      = WritePersistenceBricks(fp, dataExtent, zfpOnly, zfpTolerance, data);
+  } else if(useOther) {
+    WriteOtherTopology(fp);
+    status = WriteOtherGeometry(fp);
+  }
+
+  fflush(fp);
+  fclose(fp);
 
   if(status == 0) {
-    this->printMsg("Geometry successfully written to buffer.");
+    this->printMsg("Data successfully written to filesystem.");
   } else {
-    this->printErr("Geometry was not successfully written to buffer.");
-    fflush(fp);
-    fclose(fp);
+    this->printErr("Data was not successfully written.");
     return -1;
   }
 
-  // Check computed size vs read size.
-  if(totalSize < rawFileLength) {
-    this->printErr("Invalid total size (" + std::to_string(totalSize) + " vs "
-                   + std::to_string(rawFileLength) + ").");
-  }
-
-#ifdef TTK_ENABLE_ZLIB
-  // [fm->ff] Compress fm.
-  auto sourceLen = static_cast<unsigned long>(rawFileLength);
-  const auto source = reinterpret_cast<unsigned char *>(buf);
-  auto destLen = GetZlibDestLen(sourceLen);
-  std::vector<unsigned char> ddest(destLen);
-  CompressWithZlib(false, ddest.data(), destLen, source, sourceLen);
-  this->printMsg("Data successfully compressed.");
-
-  // [fm->fp] Copy fm to fp.
-  Write<uint64_t>(fp, destLen); // Compressed size...
-  Write<uint64_t>(fp, sourceLen);
-  WriteByteArray(fp, ddest.data(), destLen);
-  this->printMsg("Data successfully written to filesystem.");
-
-#else
-  this->printMsg("ZLIB not found, writing raw file.");
-  unsigned char *source = reinterpret_cast<unsigned char *>(buf);
-  unsigned long sourceLen = (unsigned long)rawFileLength;
-  unsigned long destLen = (unsigned long)rawFileLength;
-
-  Write<uint64_t>(fp, destLen); // Compressed size...
-  Write<uint64_t>(fp, sourceLen);
-  WriteByteArray(fp, source, destLen);
-#endif
-
-  fflush(fp);
-  fclose(fp);
-
-  return ret;
+  return 0;
 }
 
 int ttk::TopologicalCompression::WriteMetaData(
@@ -812,7 +1088,7 @@ int ttk::TopologicalCompression::ReadMetaData(FILE *fm) {
 
   // -3. File format version
   const auto fileVersion = Read<uint64_t>(fm);
-  if(fileVersion < this->formatVersion_) {
+  if(fileVersion < this->minFormatVersion_) {
     this->printErr("Old format version detected (" + std::to_string(fileVersion)
                    + " vs. " + std::to_string(this->formatVersion_) + ").");
     this->printErr("Older formats are not supported!");
@@ -824,6 +1100,7 @@ int ttk::TopologicalCompression::ReadMetaData(FILE *fm) {
     this->printErr("Cannot read file with current TTK, try with to update.");
     return 1;
   }
+  fileVersion_ = fileVersion;
 
   // -2. Compression type.
   compressionType_ = Read<int32_t>(fm);
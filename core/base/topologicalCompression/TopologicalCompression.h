@@ -8,6 +8,11 @@
 /// %TopologicalCompression is a TTK processing package that takes a scalar
 /// field on the input and produces a scalar field on the output.
 ///
+/// The compressed file is split into bricks (of setBrickSize() vertices
+/// along each axis) that are encoded and decoded in parallel. A chunk index
+/// in the file header gives the position of each brick, so that only the
+/// bricks intersecting a given extent (see setReadExtent()) are decoded.
+///
 /// \sa ttk::Triangulation
 /// \sa vtkTopologicalCompression.cpp %for a usage example.
 
@@ -19,6 +24,8 @@
 #include <Triangulation.h>
 
 // std
+#include <algorithm>
+#include <array>
 #include <cstring>
 #include <stack>
 #include <type_traits>
@@ -100,6 +107,17 @@ namespace ttk {
     inline void setFileName(char *fn) {
       fileName = fn;
     }
+    inline void setBrickSize(const int brickSize) {
+      BrickSize = brickSize;
+    }
+    /**
+     * Restrict the decoding to the vertices of this extent (in the
+     * coordinates of the file extent). The whole extent is read if the
+     * extent is empty or if canReadSubExtent() is false.
+     */
+    inline void setReadExtent(const int *const readExtent) {
+      std::copy(readExtent, readExtent + 6, readExtent_.begin());
+    }
     inline void
       preconditionTriangulation(AbstractTriangulation *const triangulation) {
       if(triangulation != nullptr) {
@@ -137,6 +155,30 @@ namespace ttk {
     inline int *getDataExtent() {
       return dataExtent_;
     }
+    inline const std::array<int, 6> &getReadExtent() const {
+      return readExtent_;
+    }
+    /**
+     * @brief Whether the file read by ReadMetaData() is split into bricks
+     * (allowing partial reads)
+     */
+    inline bool hasBricks() const {
+      return fileVersion_ >= 3;
+    }
+    /**
+     * @brief Whether a sub-extent of the file read by ReadMetaData() can be
+     * decoded on its own
+     *
+     * The topological simplification reconstructing the geometry of a
+     * persistence diagram compression is global: on a cropped grid, its
+     * result would not match the neighboring pieces at their shared
+     * boundaries. Such files are always decoded as a whole.
+     */
+    inline bool canReadSubExtent() const {
+      return this->hasBricks()
+             && (compressionType_ != (int)CompressionType::PersistenceDiagram
+                 || SQMethodInt == 1 || SQMethodInt == 2 || ZFPOnly);
+    }
     inline double *getDataSpacing() {
       return dataSpacing_;
     }
@@ -175,6 +217,15 @@ namespace ttk {
     }
 
     // IO management.
+
+    /**
+     * In-memory stream, used to encode and decode the bricks in parallel.
+     */
+    struct ByteBuffer {
+      std::vector<unsigned char> data{};
+      size_t cursor{0};
+    };
+
     static unsigned int log2(int val);
     inline static bool cmp(const std::tuple<double, int> &a,
                            const std::tuple<double, int> &b) {
@@ -199,12 +250,32 @@ namespace ttk {
       return ret;
     }
     template <typename T>
-    void ReadByteArray(FILE *fm, T *buffer, size_t length) const {
+    size_t ReadByteArray(FILE *fm, T *buffer, size_t length) const {
       const auto status = std::fread(buffer, sizeof(T), length, fm);
       if(status == 0) {
         this->printErr("Error reading " + std::string(typeid(T).name())
                        + "array!");
       }
+      return status;
+    }
+    template <typename T>
+    size_t ReadByteArray(ByteBuffer *fm, T *buffer, size_t length) const {
+      const auto status
+        = std::min(length, (fm->data.size() - fm->cursor) / sizeof(T));
+      if(status == 0) {
+        this->printErr("Error reading " + std::string(typeid(T).name())
+                       + "array!");
+        return 0;
+      }
+      std::memcpy(buffer, &fm->data[fm->cursor], status * sizeof(T));
+      fm->cursor += status * sizeof(T);
+      return status;
+    }
+    template <typename T>
+    T Read(ByteBuffer *fm) const {
+      T ret{};
+      this->ReadByteArray(fm, &ret, 1);
+      return ret;
     }
     template <typename T>
     void Write(FILE *fm, T data) const {
@@ -225,13 +296,24 @@ namespace ttk {
                        + "array!");
       }
     }
+    template <typename T>
+    void WriteByteArray(ByteBuffer *fm, const T *buffer, size_t length) const {
+      const auto bytes = reinterpret_cast<const unsigned char *>(buffer);
+      fm->data.insert(fm->data.end(), bytes, bytes + length * sizeof(T));
+    }
+    template <typename T>
+    void Write(ByteBuffer *fm, T data) const {
+      this->WriteByteArray(fm, &data, 1);
+    }
 
-    int ReadCompactSegmentation(FILE *fm,
+    template <typename StreamType>
+    int ReadCompactSegmentation(StreamType *fm,
                                 std::vector<int> &segmentation,
                                 int &numberOfVertices,
                                 int &numberOfSegments) const;
+    template <typename StreamType>
     int ReadPersistenceIndex(
-      FILE *fm,
+      StreamType *fm,
       std::vector<std::tuple<double, int>> &mappings,
       std::vector<std::tuple<double, int>> &mappingsSortedPerValue,
       std::vector<std::tuple<int, double, int>> &constraints,
@@ -243,12 +325,14 @@ namespace ttk {
     template <typename triangulationType>
     int ReadFromFile(FILE *fm, const triangulationType &triangulation);
 
-    int WriteCompactSegmentation(FILE *fm,
+    template <typename StreamType>
+    int WriteCompactSegmentation(StreamType *fm,
                                  const std::vector<int> &segmentation,
                                  int numberOfVertices,
                                  int numberOfSegments) const;
+    template <typename StreamType>
     int WritePersistenceIndex(
-      FILE *fm,
+      StreamType *fm,
       std::vector<std::tuple<double, int>> &mapping,
       std::vector<std::tuple<int, double, int>> &constraints) const;
 
@@ -290,7 +374,8 @@ namespace ttk {
     // API management.
 
 #ifdef TTK_ENABLE_ZFP
-    int CompressWithZFP(FILE *file,
+    template <typename StreamType>
+    int CompressWithZFP(StreamType *file,
                         const bool decompress,
                         std::vector<double> &array,
                         const int nx,
@@ -311,16 +396,6 @@ namespace ttk {
   private:
     // Internal read/write.
 
-    int ComputeTotalSizeForOther() const;
-
-    int ComputeTotalSizeForPersistenceDiagram(
-      std::vector<std::tuple<double, int>> &mapping,
-      std::vector<std::tuple<int, double, int>> &criticalConstraints,
-      bool zfpOnly,
-      int nbSegments,
-      int nbVertices,
-      double zfpTolerance) const;
-
     int ReadPersistenceTopology(FILE *fm);
     int ReadOtherTopology(FILE *fm) const;
     template <typename triangulationType>
@@ -328,15 +403,62 @@ namespace ttk {
                                 const triangulationType &triangulation);
     int ReadOtherGeometry(FILE *fm) const;
 
-    int WritePersistenceTopology(FILE *fm);
     int WriteOtherTopology(FILE *fm) const;
-    int WritePersistenceGeometry(FILE *fm,
-                                 int *dataExtent,
-                                 bool zfpOnly,
-                                 double zfpTolerance,
-                                 double *toCompress);
     int WriteOtherGeometry(FILE *fm) const;
 
+    // Bricks.
+
+    /**
+     * Vertex range [begin, end[ along each axis of the given brick.
+     */
+    void getBrickBounds(const int brick,
+                        const std::array<int, 3> &nBricks,
+                        const std::array<int, 3> &dimensions,
+                        std::array<int, 6> &bounds) const;
+
+    /**
+     * Compress a buffer with zlib (if available).
+     */
+    void CompressChunk(const ByteBuffer &chunk,
+                       std::vector<unsigned char> &dest) const;
+    /**
+     * Write a compressed buffer as a chunk of the file: compressed size,
+     * raw size, data.
+     */
+    int WriteChunk(FILE *fp, const ByteBuffer &chunk) const;
+    int ReadChunk(FILE *fp, const bool useZlib, ByteBuffer &chunk) const;
+    int UncompressChunk(const std::vector<unsigned char> &source,
+                        const uint64_t rawSize,
+                        const bool useZlib,
+                        ByteBuffer &chunk) const;
+
+    int WritePersistenceBricks(FILE *fp,
+                               int *dataExtent,
+                               bool zfpOnly,
+                               double zfpTolerance,
+                               double *toCompress);
+
+    /**
+     * Decode the bricks intersecting the read extent into segmentation_ and
+     * decompressedData_, keep the critical constraints of the read extent.
+     */
+    int ReadPersistenceBricks(
+      FILE *fp,
+      const bool useZlib,
+      std::vector<std::tuple<double, int>> &mappingsSortedPerValue,
+      double &min,
+      double &max,
+      int &nbConstraints);
+
+    template <typename triangulationType>
+    int ReconstructPersistenceGeometry(
+      std::vector<std::tuple<double, int>> &mappingsSortedPerValue,
+      double min,
+      double max,
+      int nbConstraints,
+      int vertexNumber,
+      const triangulationType &triangulation);
+
     template <typename dataType, typename triangulationType>
     int PerformSimplification(
       const std::vector<std::tuple<int, double, int>> &constraints,
@@ -374,9 +496,11 @@ namespace ttk {
     std::string SQMethod{};
     bool Subdivide{false};
     bool UseTopologicalSimplification{true};
+    int BrickSize{64};
 
     int dataScalarType_{};
     int dataExtent_[6];
+    std::array<int, 6> readExtent_{0, -1, 0, -1, 0, -1};
     double dataSpacing_[3];
     double dataOrigin_[3];
 
@@ -401,7 +525,12 @@ namespace ttk {
     const char *magicBytes_{"TTKCompressedFileFormat"};
     // Current version of the file format. To be incremented at every
     // breaking change to keep backward compatibility.
-    const unsigned long formatVersion_{2};
+    const unsigned long formatVersion_{3};
+    // Oldest supported version of the file format (v2: single zlib stream,
+    // v3: bricks).
+    const unsigned long minFormatVersion_{2};
+    // Version of the file read by ReadMetaData().
+    unsigned long fileVersion_{formatVersion_};
   };
 
 } // namespace ttk
@@ -452,6 +581,39 @@ int ttk::TopologicalCompression::ReadFromFile(
   }
 
   bool useZlib = Read<uint8_t>(fp);
+
+  if(this->hasBricks()) {
+    // [fp->] Read and decode the bricks of the read extent.
+    int status = 0;
+    if(compressionType_ == (int)ttk::CompressionType::PersistenceDiagram) {
+      std::vector<std::tuple<double, int>> mappingsSortedPerValue;
+      double min = 0;
+      double max = 0;
+      int nbConstraints = 0;
+      status = ReadPersistenceBricks(
+        fp, useZlib, mappingsSortedPerValue, min, max, nbConstraints);
+      if(status == 0) {
+        int vertexNumber = 1;
+        for(int i = 0; i < 3; ++i)
+          vertexNumber *= 1 + readExtent_[2 * i + 1] - readExtent_[2 * i];
+        status = ReconstructPersistenceGeometry(mappingsSortedPerValue, min,
+                                                max, nbConstraints,
+                                                vertexNumber, triangulation);
+      }
+    } else if(compressionType_ == (int)ttk::CompressionType::Other) {
+      ReadOtherTopology(fp);
+      status = ReadOtherGeometry(fp);
+    }
+    fclose(fp);
+
+    if(status == 0) {
+      this->printMsg("Successfully read file.");
+    } else {
+      this->printErr("Failed to read bricks, file may be corrupted!");
+    }
+    return status;
+  }
+
   unsigned char *dest;
   std::vector<unsigned char> ddest;
   unsigned long destLen;
@@ -12,7 +12,7 @@
 
 // base code includes
 #include <BottleneckDistance.h>
-#include <PersistenceDiagram.h>
+#include <PersistenceDiagramBatch.h>
 #include <Triangulation.h>
 
 namespace ttk {
@@ -59,8 +59,8 @@ namespace ttk {
 
     inline void
       preconditionTriangulation(AbstractTriangulation *triangulation) {
-      ttk::PersistenceDiagram pd{};
-      pd.preconditionTriangulation(triangulation);
+      diagramBatch_.setThreadNumber(this->threadNumber_);
+      diagramBatch_.preconditionTriangulation(triangulation);
     }
 
     inline void setInputScalars(std::vector<void *> &is) {
@@ -83,6 +83,8 @@ namespace ttk {
     int numberOfInputs_{0};
     std::vector<void *> inputData_{};
     std::vector<SimplexId *> inputOffsets_{};
+    // keeps its working buffers from one execution to the next
+    PersistenceDiagramBatch diagramBatch_{};
   };
 } // namespace ttk
 
@@ -92,26 +94,17 @@ int ttk::TrackingFromFields::performDiagramComputation(
   std::vector<ttk::DiagramType> &persistenceDiagrams,
   const triangulationType *triangulation) {
 
-#ifdef TTK_ENABLE_OPENMP
-#pragma omp parallel for num_threads(threadNumber_)
-#endif // TTK_ENABLE_OPENMP
+  std::vector<const dataType *> scalars(fieldNumber);
+  std::vector<const SimplexId *> offsets(fieldNumber);
   for(int i = 0; i < fieldNumber; ++i) {
-    ttk::PersistenceDiagram persistenceDiagram;
-    persistenceDiagram.setThreadNumber(1);
-    persistenceDiagram.execute(persistenceDiagrams[i],
-                               (dataType *)(inputData_[i]), 0, inputOffsets_[i],
-                               triangulation);
-
-    // Augment diagram.
-    for(auto &pair : persistenceDiagrams[i]) {
-      triangulation->getVertexPoint(pair.birth.id, pair.birth.coords[0],
-                                    pair.birth.coords[1], pair.birth.coords[2]);
-      triangulation->getVertexPoint(pair.death.id, pair.death.coords[0],
-                                    pair.death.coords[1], pair.death.coords[2]);
-      pair.birth.sfValue = static_cast<double *>(inputData_[i])[pair.birth.id];
-      pair.death.sfValue = static_cast<double *>(inputData_[i])[pair.death.id];
-    }
+    scalars[i] = static_cast<const dataType *>(inputData_[i]);
+    offsets[i] = inputOffsets_[i];
   }
 
-  return 0;
+  // the diagrams are augmented with the critical point coordinates and
+  // scalar values
+  diagramBatch_.setDebugLevel(this->debugLevel_);
+  diagramBatch_.setThreadNumber(this->threadNumber_);
+  return diagramBatch_.execute(
+    persistenceDiagrams, scalars, offsets, triangulation);
 }
@@ -1433,6 +1433,36 @@ namespace ttk {
       return abstractTriangulation_->getRemoteGhostCells();
     }
 
+    inline const std::vector<std::vector<SimplexId>> &
+      getGhostVerticesPerOwner() const override {
+      return abstractTriangulation_->getGhostVerticesPerOwner();
+    }
+
+    inline const std::vector<std::vector<SimplexId>> &
+      getRemoteGhostVertices() const override {
+      return abstractTriangulation_->getRemoteGhostVertices();
+    }
+
+    inline const std::vector<std::vector<SimplexId>> &
+      getGhostCellLocalIdsPerOwner() const override {
+      return abstractTriangulation_->getGhostCellLocalIdsPerOwner();
+    }
+
+    inline const std::vector<std::vector<SimplexId>> &
+      getRemoteGhostCellLocalIds() const override {
+      return abstractTriangulation_->getRemoteGhostCellLocalIds();
+    }
+
+    inline const std::vector<std::vector<SimplexId>> &
+      getGhostVertexLocalIdsPerOwner() const override {
+      return abstractTriangulation_->getGhostVertexLocalIdsPerOwner();
+    }
+
+    inline const std::vector<std::vector<SimplexId>> &
+      getRemoteGhostVertexLocalIds() const override {
+      return abstractTriangulation_->getRemoteGhostVertexLocalIds();
+    }
+
     inline int getVertexRank(const SimplexId lvid) const override {
       return this->abstractTriangulation_->getVertexRank(lvid);
     }
@@ -2671,6 +2701,20 @@ namespace ttk {
       return 0;
     }
 
+    /// Build the vertex stars and vertex neighbors on demand, per block of
+    /// vertices (explicit triangulations only). Should be called before the
+    /// preconditioning.
+    /// \param lazy Enable or disable the lazy preconditioning.
+    /// \param cacheCapacity Memory budget (in bytes) for the built blocks.
+    /// \sa ExplicitTriangulation::setLazyPreconditioning()
+    inline int setLazyPreconditioning(const bool lazy,
+                                      const size_t cacheCapacity
+                                      = size_t{1} << 30) {
+      explicitTriangulation_.setLazyPreconditioning(lazy);
+      explicitTriangulation_.setLazyCacheCapacity(cacheCapacity);
+      return 0;
+    }
+
 #ifdef TTK_CELL_ARRAY_NEW
     /// Here the notion of cell refers to the simplicices of maximal
     /// dimension (3D: tetrahedra, 2D: triangles, 1D: edges).
@@ -2878,6 +2922,21 @@ namespace ttk {
         pointNumber, pointSet, doublePrecision);
     }
 
+    /// Replace the 3D points of an explicit triangulation while keeping
+    /// its preconditioned data structures (edges, stars, links...).
+    /// \param pointSet Pointer to the new 3D points, with the same number of
+    /// points and layout as in setInputPoints().
+    /// \param doublePrecision Should we use double precision or stay
+    /// with simple?
+    /// \return Returns 0 upon success, negative values otherwise.
+    inline int updateInputPoints(const void *pointSet,
+                                 const bool &doublePrecision = false) {
+      if(abstractTriangulation_ != &explicitTriangulation_)
+        return -1;
+      return explicitTriangulation_.updateInputPoints(
+        pointSet, doublePrecision);
+    }
+
     inline int setStellarInputPoints(const SimplexId &pointNumber,
                                      const void *pointSet,
                                      const int *indexArray,
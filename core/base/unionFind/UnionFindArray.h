@@ -0,0 +1,241 @@
+/// \ingroup base
+/// \class ttk::UnionFindArray
+/// \date October 2026.
+///
+/// \brief Array-based Union Find implementation for connectivity tracking.
+///
+/// Contrary to ttk::UnionFind, which allocates one object per element
+/// and links them with pointers, this class stores the whole forest in
+/// two flat arrays (parent indices and ranks). Elements are identified
+/// by their index in [0, size()), roots are their own parent.
+///
+/// find() uses path halving, makeUnion() uses union by rank.
+///
+/// ttk::AtomicUnionFindArray is a lock-free variant that can be
+/// shared between threads.
+///
+/// \sa ttk::UnionFind
+/// \sa ttk::ftm::AtomicUF
+
+#pragma once
+
+#include <DataTypes.h>
+
+#include <atomic>
+#include <memory>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace ttk {
+
+  template <typename IdType = SimplexId>
+  class UnionFindArray {
+
+  public:
+    UnionFindArray() = default;
+
+    explicit UnionFindArray(const size_t nElements) {
+      this->init(nElements);
+    }
+
+    /**
+     * @brief Reset the structure to nElements singletons
+     */
+    inline void init(const size_t nElements) {
+      this->parent_.resize(nElements);
+      std::iota(this->parent_.begin(), this->parent_.end(), IdType{0});
+      this->rank_.assign(nElements, 0);
+    }
+
+    inline size_t size() const {
+      return this->parent_.size();
+    }
+
+    inline bool isRoot(const IdType id) const {
+      return this->parent_[id] == id;
+    }
+
+    inline int getRank(const IdType id) const {
+      return this->rank_[id];
+    }
+
+    /**
+     * @brief Get the representative of the set containing id
+     */
+    inline IdType find(IdType id) {
+      while(this->parent_[id] != id) {
+        // path halving: point every other node to its grand-parent
+        this->parent_[id] = this->parent_[this->parent_[id]];
+        id = this->parent_[id];
+      }
+      return id;
+    }
+
+    /**
+     * @brief Merge the sets containing id0 and id1
+     *
+     * @return Representative of the merged set
+     */
+    inline IdType makeUnion(IdType id0, IdType id1) {
+      id0 = this->find(id0);
+      id1 = this->find(id1);
+
+      if(id0 == id1) {
+        return id0;
+      } else if(this->rank_[id0] > this->rank_[id1]) {
+        this->parent_[id1] = id0;
+        return id0;
+      } else if(this->rank_[id0] < this->rank_[id1]) {
+        this->parent_[id0] = id1;
+        return id1;
+      } else {
+        this->parent_[id1] = id0;
+        this->rank_[id0]++;
+        return id0;
+      }
+    }
+
+    /**
+     * @brief Merge all the sets containing the given elements
+     *
+     * @return Representative of the merged set, -1 if ids is empty
+     */
+    inline IdType makeUnion(const std::vector<IdType> &ids) {
+      if(ids.empty()) {
+        return -1;
+      }
+
+      IdType root = this->find(ids[0]);
+      for(size_t i = 1; i < ids.size(); ++i) {
+        root = this->makeUnion(root, ids[i]);
+      }
+
+      return root;
+    }
+
+    /**
+     * @brief Number of disjoint sets
+     */
+    inline size_t getSetNumber() const {
+      size_t res{};
+      for(size_t i = 0; i < this->parent_.size(); ++i) {
+        if(this->parent_[i] == static_cast<IdType>(i)) {
+          res++;
+        }
+      }
+      return res;
+    }
+
+  protected:
+    std::vector<IdType> parent_{};
+    // ranks are bounded by log2(size()), a byte is enough
+    std::vector<unsigned char> rank_{};
+  };
+
+  /**
+   * @brief Lock-free, array-based Union Find
+   *
+   * Can be used concurrently by several threads (find() and
+   * makeUnion() are linearizable). Since ranks cannot be updated
+   * atomically with the parent links, roots are linked by index
+   * (the smallest root is attached to the largest one), which keeps
+   * the forest acyclic under concurrent unions.
+   */
+  template <typename IdType = SimplexId>
+  class AtomicUnionFindArray {
+
+  public:
+    AtomicUnionFindArray() = default;
+
+    explicit AtomicUnionFindArray(const size_t nElements) {
+      this->init(nElements);
+    }
+
+    /**
+     * @brief Reset the structure to nElements singletons
+     *
+     * Not thread-safe.
+     */
+    inline void init(const size_t nElements) {
+      this->parent_.reset(new std::atomic<IdType>[nElements]);
+      this->size_ = nElements;
+      for(size_t i = 0; i < nElements; ++i) {
+        this->parent_[i].store(
+          static_cast<IdType>(i), std::memory_order_relaxed);
+      }
+    }
+
+    inline size_t size() const {
+      return this->size_;
+    }
+
+    inline bool isRoot(const IdType id) const {
+      return this->parent_[id].load(std::memory_order_acquire) == id;
+    }
+
+    inline IdType find(IdType id) {
+      while(true) {
+        IdType parent = this->parent_[id].load(std::memory_order_acquire);
+        if(parent == id) {
+          return id;
+        }
+        const IdType grandParent
+          = this->parent_[parent].load(std::memory_order_acquire);
+        if(parent != grandParent) {
+          // path halving, failure means someone else already updated the
+          // link to an ancestor: just go on
+          this->parent_[id].compare_exchange_weak(
+            parent, grandParent, std::memory_order_acq_rel,
+            std::memory_order_relaxed);
+        }
+        id = grandParent;
+      }
+    }
+
+    /**
+     * @brief Merge the sets containing id0 and id1
+     *
+     * @return Representative of the merged set at the time of the
+     * union (it may be merged further by concurrent threads)
+     */
+    inline IdType makeUnion(IdType id0, IdType id1) {
+      while(true) {
+        id0 = this->find(id0);
+        id1 = this->find(id1);
+        if(id0 == id1) {
+          return id0;
+        }
+        if(id0 > id1) {
+          std::swap(id0, id1);
+        }
+        // try to attach root id0 to root id1
+        IdType expected = id0;
+        if(this->parent_[id0].compare_exchange_strong(
+             expected, id1, std::memory_order_acq_rel)) {
+          return id1;
+        }
+        // id0 is no longer a root, try again
+      }
+    }
+
+    inline bool isSameSet(IdType id0, IdType id1) {
+      while(true) {
+        id0 = this->find(id0);
+        id1 = this->find(id1);
+        if(id0 == id1) {
+          return true;
+        }
+        // id0 may have been linked meanwhile
+        if(this->isRoot(id0)) {
+          return false;
+        }
+      }
+    }
+
+  protected:
+    std::unique_ptr<std::atomic<IdType>[]> parent_{};
+    size_t size_{};
+  };
+
+} // namespace ttk
@@ -72,6 +72,27 @@ ttk::Triangulation *ttkAlgorithm::GetTriangulation(vtkDataSet *dataSet) {
   return nullptr;
 }
 
+void ttkAlgorithm::SetShareTriangulationsByContent(bool share) {
+  ttkTriangulationFactory::SetShareByContent(share);
+}
+
+bool ttkAlgorithm::GetShareTriangulationsByContent() {
+  return ttkTriangulationFactory::GetShareByContent();
+}
+
+void ttkAlgorithm::SetSharedTriangulationsMemoryLimit(double megaBytes) {
+  ttkTriangulationFactory::SetSharedMemoryLimit(
+    static_cast<size_t>((megaBytes > 0 ? megaBytes : 0) * 1024 * 1024));
+}
+
+vtkIdType ttkAlgorithm::GetSharedTriangulationsHits() {
+  return ttkTriangulationFactory::GetSharedStatistics().hits;
+}
+
+vtkIdType ttkAlgorithm::GetSharedTriangulationsMisses() {
+  return ttkTriangulationFactory::GetSharedStatistics().misses;
+}
+
 vtkDataArray *ttkAlgorithm::GetOptionalArray(const bool &enforceArrayIndex,
                                              const int &arrayIndex,
                                              const std::string &arrayName,
@@ -164,6 +164,30 @@ public:
    */
   ttk::Triangulation *GetTriangulation(vtkDataSet *dataSet);
 
+  /**
+   * Share one triangulation between all the datasets with identical cells
+   * (resp. identical grids for vtkImageData), e.g. the time steps of a
+   * simulation on a fixed mesh, instead of one triangulation per dataset.
+   * The triangulations are then keyed on a hash of the connectivity and
+   * offset buffers and kept within a global memory budget (see
+   * SetSharedTriangulationsMemoryLimit()), the least recently used ones
+   * being released first. Disabled by default.
+   */
+  static void SetShareTriangulationsByContent(bool share);
+  static bool GetShareTriangulationsByContent();
+
+  /**
+   * Memory budget (in megabytes) of the shared triangulations.
+   */
+  static void SetSharedTriangulationsMemoryLimit(double megaBytes);
+
+  /**
+   * Number of shared triangulation retrievals served from the registry
+   * (resp. that needed a new triangulation).
+   */
+  static vtkIdType GetSharedTriangulationsHits();
+  static vtkIdType GetSharedTriangulationsMisses();
+
   /**
    * This key can be used during the FillOutputPortInformation() call to
    * specify that an output port should produce the same data type as a
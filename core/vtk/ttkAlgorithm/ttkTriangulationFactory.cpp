@@ -7,12 +7,16 @@
 #include <vtkCellData.h>
 #include <vtkCellTypes.h>
 #include <vtkCommand.h>
+#include <vtkDataArray.h>
 #include <vtkImageData.h>
 #include <vtkPointData.h>
 #include <vtkPolyData.h>
 #include <vtkUnstructuredGrid.h>
 #include <vtkVersion.h>
 
+#include <algorithm>
+#include <cstring>
+
 static vtkCellArray *GetCells(vtkDataSet *dataSet) {
   switch(dataSet->GetDataObjectType()) {
     case VTK_UNSTRUCTURED_GRID: {
@@ -65,6 +69,127 @@ static int checkCellTypes(vtkPointSet *object) {
   return 1;
 }
 
+// calls f with a typed pointer to the values of a connectivity or offset
+// array (32 or 64 bit storage)
+template <typename Functor>
+static bool visitIdArray(vtkDataArray *array, const Functor &f) {
+  if(array == nullptr)
+    return false;
+  const auto n = static_cast<size_t>(array->GetNumberOfValues());
+  const auto data = ttkUtils::GetVoidPointer(array);
+  switch(array->GetDataTypeSize()) {
+    case 4:
+      f(static_cast<const std::int32_t *>(data), n);
+      return true;
+    case 8:
+      f(static_cast<const std::int64_t *>(data), n);
+      return true;
+  }
+  return false;
+}
+
+static inline std::uint64_t mixHash(std::uint64_t h) {
+  // splitmix64 finalizer
+  h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+  return h ^ (h >> 31);
+}
+
+static inline std::uint64_t combineHash(const std::uint64_t h,
+                                        const std::uint64_t v) {
+  return mixHash(h ^ (v + 0x9e3779b97f4a7c15ULL));
+}
+
+// hashes the values (not the bytes) so that the result does not depend on
+// the storage width; four independent lanes to keep the pipeline busy
+template <typename T>
+static std::uint64_t hashValues(const T *values, const size_t n) {
+  constexpr std::uint64_t prime = 0x100000001b3ULL;
+  std::uint64_t lanes[4]
+    = {0xcbf29ce484222325ULL, 0x84222325cbf29ce4ULL, 0x9e3779b97f4a7c15ULL,
+       0x7f4a7c159e3779b9ULL};
+  size_t i = 0;
+  for(; i + 4 <= n; i += 4) {
+    for(size_t k = 0; k < 4; ++k) {
+      lanes[k] = (lanes[k] ^ static_cast<std::uint64_t>(values[i + k]))
+                 * prime;
+    }
+  }
+  for(; i < n; ++i) {
+    lanes[0] = (lanes[0] ^ static_cast<std::uint64_t>(values[i])) * prime;
+  }
+  std::uint64_t h = n;
+  for(size_t k = 0; k < 4; ++k) {
+    h = combineHash(h, lanes[k]);
+  }
+  return h;
+}
+
+static bool sameIdArrays(vtkDataArray *a, vtkDataArray *b) {
+  if(a == b)
+    return true;
+  if(a == nullptr || b == nullptr
+     || a->GetNumberOfValues() != b->GetNumberOfValues())
+    return false;
+  bool same = false;
+  visitIdArray(a, [&](const auto *va, const size_t n) {
+    visitIdArray(b, [&](const auto *vb, const size_t) {
+      same = std::equal(va, va + n, vb, [](const auto x, const auto y) {
+        return static_cast<std::int64_t>(x) == static_cast<std::int64_t>(y);
+      });
+    });
+  });
+  return same;
+}
+
+static bool canShareByContent(vtkDataSet *dataSet) {
+  if(dataSet->IsA("vtkImageData"))
+    return true;
+  if(!dataSet->IsA("vtkPointSet"))
+    return false;
+  // compact triangulations depend on the point index array
+  if(dataSet->GetPointData()->HasArray(ttk::compactTriangulationIndex))
+    return false;
+  auto cells = GetCells(dataSet);
+  return cells != nullptr && cells->GetNumberOfCells() > 0
+         && static_cast<vtkPointSet *>(dataSet)->GetPoints() != nullptr;
+}
+
+static std::uint64_t contentKey(vtkDataSet *dataSet) {
+  if(dataSet->IsA("vtkImageData")) {
+    auto image = static_cast<vtkImageData *>(dataSet);
+    int extent[6];
+    double origin[3];
+    double spacing[3];
+    image->GetExtent(extent);
+    image->GetOrigin(origin);
+    image->GetSpacing(spacing);
+    std::uint64_t h = mixHash(VTK_IMAGE_DATA);
+    for(int i = 0; i < 6; i++)
+      h = combineHash(h, static_cast<std::uint64_t>(extent[i]));
+    for(int i = 0; i < 3; i++) {
+      std::uint64_t bits[2]{};
+      std::memcpy(&bits[0], &origin[i], sizeof(double));
+      std::memcpy(&bits[1], &spacing[i], sizeof(double));
+      h = combineHash(combineHash(h, bits[0]), bits[1]);
+    }
+    return h;
+  }
+
+  auto cells = GetCells(dataSet);
+  std::uint64_t h = mixHash(static_cast<std::uint64_t>(
+    static_cast<vtkPointSet *>(dataSet)->GetNumberOfPoints()));
+  visitIdArray(
+    cells->GetConnectivityArray(), [&](const auto *values, const size_t n) {
+      h = combineHash(h, hashValues(values, n));
+    });
+  visitIdArray(
+    cells->GetOffsetsArray(), [&](const auto *values, const size_t n) {
+      h = combineHash(h, hashValues(values, n));
+    });
+  return h;
+}
+
 struct ttkOnDeleteCommand : public vtkCommand {
   RegistryKey key;
   vtkObject *observee;
@@ -92,6 +217,10 @@ struct ttkOnDeleteCommand : public vtkCommand {
       this->observee->RemoveObserver(this);
 
     auto instance = &ttkTriangulationFactory::Instance;
+    std::lock_guard<std::recursive_mutex> lock(instance->mutex_);
+
+    for(auto &thread : instance->threadRegistries_)
+      thread.second.registry.erase(this->key);
 
     if(instance->registry.empty()) {
       return;
@@ -160,6 +289,46 @@ bool RegistryValue::isValid(vtkDataSet *dataSet) const {
   return false;
 }
 
+bool SharedRegistryValue::isValid(vtkDataSet *dataSet) const {
+  if(this->isImage) {
+    if(!dataSet->IsA("vtkImageData"))
+      return false;
+    auto image = static_cast<vtkImageData *>(dataSet);
+
+    int extent_[6];
+    double origin_[3];
+    double spacing_[3];
+
+    image->GetExtent(extent_);
+    image->GetOrigin(origin_);
+    image->GetSpacing(spacing_);
+
+    for(int i = 0; i < 6; i++)
+      if(this->extent[i] != extent_[i])
+        return false;
+    for(int i = 0; i < 3; i++)
+      if(this->origin[i] != origin_[i] || this->spacing[i] != spacing_[i])
+        return false;
+    return true;
+  }
+
+  // the buffers the triangulation points to have been modified in place
+  if(this->cells == nullptr || this->cells->GetMTime() != this->cellModTime)
+    return false;
+
+  auto cells_ = GetCells(dataSet);
+  auto points_ = static_cast<vtkPointSet *>(dataSet)->GetPoints();
+  if(cells_ == nullptr || points_ == nullptr
+     || points_->GetNumberOfPoints() != this->nPoints)
+    return false;
+
+  // a hash collision is unlikely but the triangulation would be wrong
+  return sameIdArrays(
+           this->cells->GetConnectivityArray(), cells_->GetConnectivityArray())
+         && sameIdArrays(
+           this->cells->GetOffsetsArray(), cells_->GetOffsetsArray());
+}
+
 ttkTriangulationFactory::ttkTriangulationFactory() {
   this->setDebugMsgPrefix("TriangulationFactory");
 }
@@ -337,13 +506,31 @@ RegistryTriangulation
 ttk::Triangulation *ttkTriangulationFactory::GetTriangulation(
   int debugLevel, float cacheRatio, vtkDataSet *object) {
   auto instance = &ttkTriangulationFactory::Instance;
+  std::lock_guard<std::recursive_mutex> lock(instance->mutex_);
   instance->setDebugLevel(debugLevel);
 
+  auto registry = &instance->registry;
+  const auto thread
+    = instance->threadRegistries_.find(std::this_thread::get_id());
+  const bool isPrivate = thread != instance->threadRegistries_.end()
+                         && thread->second.enabled;
+  if(isPrivate)
+    registry = &thread->second.registry;
+
+  if(!isPrivate && instance->shareByContent_ && canShareByContent(object)) {
+    auto triangulation = instance->GetSharedTriangulation(object);
+    if(triangulation) {
+      triangulation->setDebugLevel(debugLevel);
+      triangulation->setCacheSize(cacheRatio);
+    }
+    return triangulation;
+  }
+
   auto key = ttkTriangulationFactory::GetKey(object);
 
   ttk::Triangulation *triangulation{nullptr};
-  auto it = instance->registry.find(key);
-  if(it != instance->registry.end()) {
+  auto it = registry->find(key);
+  if(it != registry->end()) {
     // object is the owner of the explicit or implicit triangulation
     if(it->second.isValid(object)) {
       instance->printMsg(
@@ -352,11 +539,11 @@ ttk::Triangulation *ttkTriangulationFactory::GetTriangulation(
     } else {
       instance->printMsg(
         "Existing Triangulation No Longer Valid", ttk::debug::Priority::DETAIL);
-      instance->registry.erase(key);
+      registry->erase(key);
     }
   }
 
-  if(!triangulation && object->IsA("vtkImageData")) {
+  if(!triangulation && !isPrivate && object->IsA("vtkImageData")) {
     instance->FindImplicitTriangulation(
       triangulation, static_cast<vtkImageData *>(object));
     if(triangulation)
@@ -367,14 +554,13 @@ ttk::Triangulation *ttkTriangulationFactory::GetTriangulation(
   if(!triangulation) {
     triangulation = instance->CreateTriangulation(object).release();
     if(triangulation) {
-      instance->registry.emplace(std::piecewise_construct,
-                                 std::forward_as_tuple(key),
-                                 std::forward_as_tuple(object, triangulation));
+      registry->emplace(std::piecewise_construct, std::forward_as_tuple(key),
+                        std::forward_as_tuple(object, triangulation));
     }
   }
 
   instance->printMsg(
-    "# Registered Triangulations: " + std::to_string(instance->registry.size()),
+    "# Registered Triangulations: " + std::to_string(registry->size()),
     ttk::debug::Priority::VERBOSE);
 
   if(triangulation) {
@@ -385,6 +571,207 @@ ttk::Triangulation *ttkTriangulationFactory::GetTriangulation(
   return triangulation;
 }
 
+ttk::Triangulation *
+  ttkTriangulationFactory::GetSharedTriangulation(vtkDataSet *dataSet) {
+  ttk::Timer timer;
+  const auto key = contentKey(dataSet);
+  const auto isImage = dataSet->IsA("vtkImageData") != 0;
+
+  auto entry = this->sharedRegistry.end();
+  auto it = this->sharedIndex_.find(key);
+  if(it != this->sharedIndex_.end()) {
+    if(it->second->isValid(dataSet)) {
+      // move to the front (most recently used)
+      this->sharedRegistry.splice(
+        this->sharedRegistry.begin(), this->sharedRegistry, it->second);
+      entry = this->sharedRegistry.begin();
+      this->sharedStatistics_.hits++;
+    } else {
+      this->printMsg(
+        "Shared Triangulation No Longer Valid", ttk::debug::Priority::DETAIL);
+      // other datasets may still use it, release it when they are deleted
+      it->second->stale = true;
+      this->sharedIndex_.erase(it);
+    }
+  }
+
+  if(entry != this->sharedRegistry.end() && !isImage) {
+    // point to the coordinates of the current dataset (the datasets sharing
+    // this triangulation have to retrieve it again before using it)
+    auto points = static_cast<vtkPointSet *>(dataSet)->GetPoints();
+    auto pointDataType = points->GetDataType();
+    if(pointDataType != VTK_FLOAT && pointDataType != VTK_DOUBLE) {
+      this->printErr("Unable to initialize 'ttk::Triangulation' for point "
+                     "precision other than 'float' or 'double'.");
+      return nullptr;
+    }
+    entry->triangulation->updateInputPoints(
+      ttkUtils::GetVoidPointer(points), pointDataType == VTK_DOUBLE);
+    entry->points = points;
+  }
+
+  if(entry == this->sharedRegistry.end()) {
+    this->sharedStatistics_.misses++;
+    auto triangulation = this->CreateTriangulation(dataSet);
+    if(!triangulation)
+      return nullptr;
+
+    this->sharedRegistry.emplace_front();
+    entry = this->sharedRegistry.begin();
+    entry->triangulation = std::move(triangulation);
+    entry->key = key;
+    entry->isImage = isImage;
+    if(isImage) {
+      auto image = static_cast<vtkImageData *>(dataSet);
+      image->GetExtent(entry->extent);
+      image->GetOrigin(entry->origin);
+      image->GetSpacing(entry->spacing);
+    } else {
+      // after a possible conversion to 64-bit storage
+      entry->cells = GetCells(dataSet);
+      entry->cellModTime = entry->cells->GetMTime();
+      entry->points = static_cast<vtkPointSet *>(dataSet)->GetPoints();
+      entry->nPoints = entry->points->GetNumberOfPoints();
+    }
+    this->sharedIndex_[key] = entry;
+  }
+
+  this->PinShared(dataSet, entry);
+  this->EvictShared();
+
+  this->printMsg("Retrieving Shared Triangulation (hits: "
+                   + std::to_string(this->sharedStatistics_.hits)
+                   + ", misses: "
+                   + std::to_string(this->sharedStatistics_.misses) + ")",
+                 1, timer.getElapsedTime(), ttk::debug::LineMode::NEW,
+                 ttk::debug::Priority::DETAIL);
+  this->printMsg("# Shared Triangulations: "
+                   + std::to_string(this->sharedStatistics_.entries) + " ("
+                   + std::to_string(this->sharedStatistics_.bytes / 1024 / 1024)
+                   + " MB)",
+                 ttk::debug::Priority::VERBOSE);
+
+  return entry->triangulation.get();
+}
+
+void ttkTriangulationFactory::PinShared(vtkDataSet *dataSet,
+                                        SharedRegistry::iterator entry) {
+  auto user = this->sharedUsers_.find(dataSet);
+  if(user == this->sharedUsers_.end()) {
+    // unpin the triangulation when the dataset gets deleted
+    auto onDelete = vtkSmartPointer<vtkCallbackCommand>::New();
+    onDelete->SetCallback(&ttkTriangulationFactory::OnSharedUserDelete);
+    dataSet->AddObserver(vtkCommand::DeleteEvent, onDelete);
+    this->sharedUsers_.emplace(dataSet, entry);
+    entry->pins++;
+  } else if(user->second != entry) {
+    // the dataset has been modified since its last retrieval
+    user->second->pins--;
+    entry->pins++;
+    user->second = entry;
+  }
+}
+
+void ttkTriangulationFactory::OnSharedUserDelete(
+  vtkObject *object,
+  unsigned long ttkNotUsed(eventId),
+  void *ttkNotUsed(clientData),
+  void *ttkNotUsed(callData)) {
+  auto instance = &ttkTriangulationFactory::Instance;
+  std::lock_guard<std::recursive_mutex> lock(instance->mutex_);
+
+  auto user = instance->sharedUsers_.find(object);
+  if(user == instance->sharedUsers_.end())
+    return;
+  const auto unpinned = --user->second->pins == 0;
+  instance->sharedUsers_.erase(user);
+  if(unpinned)
+    instance->EvictShared();
+}
+
+void ttkTriangulationFactory::EvictShared() {
+  // the triangulations grow when they get preconditioned by the filters,
+  // refresh their footprint
+  size_t bytes = 0;
+  for(auto &value : this->sharedRegistry) {
+    // footprint() lists every table, silence it (the debug level is set
+    // again each time the triangulation is retrieved)
+    value.triangulation->setDebugLevel(0);
+    value.footprint = value.triangulation->footprint();
+    bytes += value.footprint;
+  }
+
+  // release the stale triangulations and the least recently used ones, as
+  // long as no dataset uses them
+  auto it = this->sharedRegistry.end();
+  while(it != this->sharedRegistry.begin()) {
+    --it;
+    if(it->pins > 0 || (!it->stale && bytes <= this->sharedMemoryLimit_))
+      continue;
+    bytes -= it->footprint;
+    if(!it->stale)
+      this->sharedIndex_.erase(it->key);
+    it = this->sharedRegistry.erase(it);
+    this->sharedStatistics_.evictions++;
+  }
+
+  this->sharedStatistics_.entries = this->sharedRegistry.size();
+  this->sharedStatistics_.bytes = bytes;
+}
+
+void ttkTriangulationFactory::SetShareByContent(bool share) {
+  auto instance = &ttkTriangulationFactory::Instance;
+  std::lock_guard<std::recursive_mutex> lock(instance->mutex_);
+  instance->shareByContent_ = share;
+}
+
+bool ttkTriangulationFactory::GetShareByContent() {
+  return ttkTriangulationFactory::Instance.shareByContent_;
+}
+
+void ttkTriangulationFactory::SetSharedMemoryLimit(size_t nBytes) {
+  auto instance = &ttkTriangulationFactory::Instance;
+  std::lock_guard<std::recursive_mutex> lock(instance->mutex_);
+  instance->sharedMemoryLimit_ = nBytes;
+  instance->EvictShared();
+}
+
+size_t ttkTriangulationFactory::GetSharedMemoryLimit() {
+  return ttkTriangulationFactory::Instance.sharedMemoryLimit_;
+}
+
+ttkTriangulationFactory::SharedStatistics
+  ttkTriangulationFactory::GetSharedStatistics() {
+  auto instance = &ttkTriangulationFactory::Instance;
+  std::lock_guard<std::recursive_mutex> lock(instance->mutex_);
+  return instance->sharedStatistics_;
+}
+
+void ttkTriangulationFactory::ClearShared() {
+  auto instance = &ttkTriangulationFactory::Instance;
+  std::lock_guard<std::recursive_mutex> lock(instance->mutex_);
+  // the triangulations still in use are released with their last dataset
+  instance->sharedIndex_.clear();
+  for(auto &value : instance->sharedRegistry)
+    value.stale = true;
+  instance->EvictShared();
+  instance->sharedStatistics_.hits = 0;
+  instance->sharedStatistics_.misses = 0;
+  instance->sharedStatistics_.evictions = 0;
+}
+
+void ttkTriangulationFactory::SetThreadRegistry(bool enable) {
+  auto instance = &ttkTriangulationFactory::Instance;
+  std::lock_guard<std::recursive_mutex> lock(instance->mutex_);
+  instance->threadRegistries_[std::this_thread::get_id()].enabled = enable;
+}
+
+void ttkTriangulationFactory::ReleaseThreadRegistry() {
+  auto instance = &ttkTriangulationFactory::Instance;
+  std::lock_guard<std::recursive_mutex> lock(instance->mutex_);
+  instance->threadRegistries_.erase(std::this_thread::get_id());
+}
+
 int ttkTriangulationFactory::FindImplicitTriangulation(
   ttk::Triangulation *&triangulation, vtkImageData *image) {
 
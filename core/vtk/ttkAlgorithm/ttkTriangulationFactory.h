@@ -3,16 +3,22 @@
 #include <ttkAlgorithmModule.h>
 
 #include <Debug.h>
+#include <vtkCellArray.h>
+#include <vtkPoints.h>
+#include <vtkSmartPointer.h>
 #include <vtkType.h>
 
+#include <cstdint>
+#include <list>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include <unordered_map>
 
 class vtkDataSet;
 class vtkImageData;
+class vtkObject;
 class vtkPointSet;
-class vtkPoints;
-class vtkCellArray;
 namespace ttk {
   class Triangulation;
 }
@@ -37,6 +43,51 @@ struct RegistryValue {
 using RegistryKey = long long;
 using Registry = std::unordered_map<RegistryKey, RegistryValue>;
 
+// registry private to a thread, see ttkTriangulationFactory::SetThreadRegistry
+struct ThreadRegistry {
+  Registry registry;
+  bool enabled{false};
+};
+
+// Triangulation shared by all the datasets with identical cells (or
+// identical grids), keyed on a hash of their content.
+struct SharedRegistryValue {
+  RegistryTriangulation triangulation;
+  std::uint64_t key{0};
+
+  // explicit triangulations point into the connectivity and offset
+  // buffers of the first dataset, keep them alive
+  vtkSmartPointer<vtkCellArray> cells{};
+  vtkMTimeType cellModTime{0};
+  // points of the last dataset the triangulation was retrieved for
+  vtkSmartPointer<vtkPoints> points{};
+  vtkIdType nPoints{0};
+
+  bool isImage{false};
+  int extent[6];
+  double origin[3];
+  double spacing[3];
+
+  size_t footprint{0};
+
+  // number of alive datasets this triangulation was last retrieved for,
+  // pinned triangulations are never released
+  size_t pins{0};
+  // no longer retrievable (modified cells or cleared registry), released as
+  // soon as it gets unpinned
+  bool stale{false};
+
+  bool isValid(vtkDataSet *dataSet) const;
+};
+
+// least recently used entries at the back
+using SharedRegistry = std::list<SharedRegistryValue>;
+using SharedRegistryIndex
+  = std::unordered_map<std::uint64_t, SharedRegistry::iterator>;
+// shared triangulation each alive dataset was last retrieved for
+using SharedRegistryUsers
+  = std::unordered_map<vtkObject *, SharedRegistry::iterator>;
+
 class TTKALGORITHM_EXPORT ttkTriangulationFactory : public ttk::Debug {
 public:
   static ttk::Triangulation *
@@ -45,6 +96,51 @@ public:
   static ttkTriangulationFactory Instance;
   static RegistryKey GetKey(vtkDataSet *dataSet);
 
+  struct SharedStatistics {
+    size_t hits{0};
+    size_t misses{0};
+    size_t evictions{0};
+    size_t entries{0};
+    size_t bytes{0};
+  };
+
+  /**
+   * Key the triangulations on a hash of the cell connectivity and offset
+   * buffers (resp. the extent, origin and spacing of images) instead of
+   * the dataset pointer, so that a single preconditioned triangulation
+   * is reused by all the datasets with identical cells, e.g. the time
+   * steps of a simulation on a fixed mesh. Disabled by default.
+   *
+   * A shared triangulation stays alive as long as one of the datasets it
+   * was retrieved for does. The triangulation of a point set is re-bound to
+   * the points of the dataset at each retrieval: the datasets sharing it
+   * must retrieve it again before using it, and must not be processed
+   * concurrently.
+   */
+  static void SetShareByContent(bool share);
+  static bool GetShareByContent();
+
+  /**
+   * Memory budget (in bytes) of the shared triangulations. The least
+   * recently used ones are released when it is exceeded (default 4GiB),
+   * except those still in use by a dataset.
+   */
+  static void SetSharedMemoryLimit(size_t nBytes);
+  static size_t GetSharedMemoryLimit();
+
+  static SharedStatistics GetSharedStatistics();
+  static void ClearShared();
+
+  /**
+   * While enabled, the triangulations retrieved from the calling thread
+   * come from a registry of its own, shared neither with the other threads
+   * nor by content, so that independent pipelines can be updated
+   * concurrently. The registry is kept when disabled, until
+   * ReleaseThreadRegistry() is called from the same thread.
+   */
+  static void SetThreadRegistry(bool enable);
+  static void ReleaseThreadRegistry();
+
 #ifdef _WIN32
   // to fix a weird MSVC warning about unique_ptr inside
   // unordered_map, this dummy class member should be declared before
@@ -53,7 +149,28 @@ public:
 #endif // _WIN32
   Registry registry;
 
+  SharedRegistry sharedRegistry;
+
 private:
+  bool shareByContent_{false};
+  size_t sharedMemoryLimit_{size_t{1} << 32};
+  SharedStatistics sharedStatistics_{};
+  SharedRegistryIndex sharedIndex_{};
+  SharedRegistryUsers sharedUsers_{};
+  std::unordered_map<std::thread::id, ThreadRegistry> threadRegistries_{};
+  // guards all the registries (recursive: deleting a dataset in a call may
+  // trigger an on-delete observer)
+  std::recursive_mutex mutex_{};
+
+  // called with mutex_ held
+  ttk::Triangulation *GetSharedTriangulation(vtkDataSet *dataSet);
+  void PinShared(vtkDataSet *dataSet, SharedRegistry::iterator entry);
+  void EvictShared();
+  static void OnSharedUserDelete(vtkObject *object,
+                                 unsigned long eventId,
+                                 void *clientData,
+                                 void *callData);
+
   RegistryTriangulation CreateImplicitTriangulation(vtkImageData *image);
   RegistryTriangulation CreateExplicitTriangulation(vtkPointSet *pointSet);
   RegistryTriangulation CreateTriangulation(vtkDataSet *dataSet);
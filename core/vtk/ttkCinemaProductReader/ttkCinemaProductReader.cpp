@@ -1,5 +1,7 @@
 #include <ttkCinemaProductReader.h>
 
+#include <MappedFile.h>
+
 #include <vtkInformation.h>
 
 #include <vtkDoubleArray.h>
@@ -10,6 +12,11 @@
 #include <vtkTable.h>
 #include <vtkXMLGenericDataObjectReader.h>
 
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 vtkStandardNewMacro(ttkCinemaProductReader);
 
 ttkCinemaProductReader::ttkCinemaProductReader() {
@@ -82,6 +89,82 @@ vtkSmartPointer<vtkDataObject>
   return nullptr;
 }
 
+static size_t getFileSize(const std::string &pathToFile) {
+  std::ifstream is(pathToFile.data(), std::ios::binary | std::ios::ate);
+  return is.good() ? static_cast<size_t>(is.tellg()) : 0;
+}
+
+// Map the file and, if it is an XML file with raw appended data, load the
+// pages of the appended block (read by the XML parser with large seeks and
+// reads) in one sequential pass. Returns 1 if the file is XML encoded, 0
+// otherwise and -1 if the file cannot be opened.
+static int prefetchXMLFile(const std::string &pathToFile, size_t &nBytes) {
+  ttk::MappedFile file{};
+  if(file.open(pathToFile) != 0) {
+    nBytes = getFileSize(pathToFile);
+    return std::ifstream(pathToFile.data()).good() ? 0 : -1;
+  }
+  nBytes = file.size();
+
+  const char *const begin = file.data();
+  const char *const end = begin + file.size();
+  const std::string prefix(begin, std::min<size_t>(file.size(), 9));
+  if(prefix != "<VTKFile " && prefix != "<?xml ver")
+    return 0;
+
+  const std::string tag{"<AppendedData"};
+  const auto appended = std::search(begin, end, tag.begin(), tag.end());
+  if(appended == end)
+    return 1;
+  const auto tagEnd = std::find(appended, end, '>');
+  const std::string raw{"encoding=\"raw\""};
+  if(std::search(appended, tagEnd, raw.begin(), raw.end()) == tagEnd)
+    return 1;
+
+  constexpr size_t pageSize = 4096;
+  volatile char sink{};
+  for(const char *p = tagEnd; p < end; p += pageSize)
+    sink = *p;
+  TTK_FORCE_USE(sink);
+
+  return 1;
+}
+
+// Same as ttkCinemaProductReader::readFileLocal, but with readers owned by
+// the calling thread
+static vtkSmartPointer<vtkDataObject>
+  readFileConcurrent(const std::string &pathToFile,
+                     const int debugLevel,
+                     size_t &nBytes) {
+
+  if(pathToFile.substr(pathToFile.length() - 4, 4).compare(".ttk") == 0) {
+    nBytes = getFileSize(pathToFile);
+    vtkNew<ttkTopologicalCompressionReader> reader{};
+    reader->SetDebugLevel(debugLevel);
+    return readFileLocal_(pathToFile, reader);
+  } else if(pathToFile.substr(pathToFile.size() - 4) == ".tif"
+            || pathToFile.substr(pathToFile.size() - 5) == ".tiff") {
+    nBytes = getFileSize(pathToFile);
+    vtkNew<vtkTIFFReader> reader{};
+    return readFileLocal_(pathToFile, reader);
+  } else if(pathToFile.substr(pathToFile.length() - 4, 4).compare(".png")
+            == 0) {
+    nBytes = getFileSize(pathToFile);
+    vtkNew<vtkPNGReader> reader{};
+    return readFileLocal_(pathToFile, reader);
+  }
+
+  const auto isXML = prefetchXMLFile(pathToFile, nBytes);
+  if(isXML < 0)
+    return nullptr;
+  if(isXML) {
+    vtkNew<vtkXMLGenericDataObjectReader> reader{};
+    return readFileLocal_(pathToFile, reader);
+  }
+  vtkNew<vtkGenericDataObjectReader> reader{};
+  return readFileLocal_(pathToFile, reader);
+}
+
 int ttkCinemaProductReader::addFieldDataRecursively(vtkDataObject *object,
                                                     vtkFieldData *fd) {
   auto objectAsMB = vtkMultiBlockDataSet::SafeDownCast(object);
@@ -97,6 +180,131 @@ int ttkCinemaProductReader::addFieldDataRecursively(vtkDataObject *object,
   return 1;
 }
 
+int ttkCinemaProductReader::addRowData(vtkDataObject *block,
+                                       vtkTable *inputTable,
+                                       const size_t row) {
+  auto fieldData = block->GetFieldData();
+  for(size_t j = 0, m = inputTable->GetNumberOfColumns(); j < m; j++) {
+    auto columnName = inputTable->GetColumnName(j);
+
+    // always write FILE column
+    if(!fieldData->HasArray(columnName)
+       || columnName == this->FilepathColumnName) {
+      if(inputTable->GetColumn(j)->IsNumeric()) {
+        auto c = vtkSmartPointer<vtkDoubleArray>::New();
+        c->SetName(columnName);
+        c->SetNumberOfValues(1);
+        c->SetValue(0, inputTable->GetValue(row, j).ToDouble());
+        fieldData->AddArray(c);
+      } else {
+        auto c = vtkSmartPointer<vtkStringArray>::New();
+        c->SetName(columnName);
+        c->SetNumberOfValues(1);
+        c->SetValue(0, inputTable->GetValue(row, j).ToString());
+        fieldData->AddArray(c);
+      }
+    }
+  }
+
+  if(this->AddFieldDataRecursively)
+    this->addFieldDataRecursively(block, fieldData);
+
+  return 1;
+}
+
+int ttkCinemaProductReader::readFilesParallel(
+  const std::vector<std::string> &paths,
+  vtkTable *inputTable,
+  vtkMultiBlockDataSet *outputMB,
+  size_t &nBytes) {
+
+  const size_t n = paths.size();
+  const size_t nThreads
+    = std::min(n, static_cast<size_t>(std::max(this->threadNumber_, 1)));
+  // products read but not yet added to the output
+  const size_t window = nThreads + std::max(this->ReadAhead, 0);
+  const int debugLevel = this->debugLevel_;
+
+  std::vector<vtkSmartPointer<vtkDataObject>> products(n);
+  std::vector<size_t> sizes(n, 0);
+  std::vector<bool> ready(n, false);
+  size_t next{0}, consumed{0};
+  bool abort{false};
+  std::mutex mutex{};
+  std::condition_variable cv{};
+
+  const auto worker = [&]() {
+    while(true) {
+      size_t i{};
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [&]() {
+          return abort || next >= n || next < consumed + window;
+        });
+        if(abort || next >= n)
+          return;
+        i = next++;
+      }
+      size_t fileSize{};
+      auto product = readFileConcurrent(paths[i], debugLevel, fileSize);
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        products[i] = product;
+        sizes[i] = fileSize;
+        ready[i] = true;
+      }
+      cv.notify_all();
+    }
+  };
+
+  std::vector<std::thread> pool{};
+  for(size_t t = 0; t < nThreads; t++)
+    pool.emplace_back(worker);
+
+  int status = 1;
+  for(size_t i = 0; i < n; i++) {
+    ttk::Timer fileTimer;
+    const auto file = paths[i].substr(paths[i].find_last_of("/") + 1);
+
+    vtkSmartPointer<vtkDataObject> product{};
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      cv.wait(lock, [&]() { return ready[i]; });
+      product = std::move(products[i]);
+    }
+    if(!product) {
+      this->printErr("Unable to read file \"" + file + "\".");
+      status = 0;
+      break;
+    }
+    nBytes += sizes[i];
+
+    // block order does not depend on the reading order
+    outputMB->SetBlock(i, product);
+    this->addRowData(product, inputTable, i);
+
+    this->printMsg("Reading (" + std::to_string(i + 1) + "/"
+                     + std::to_string(n) + "): \"" + file + "\"",
+                   1, fileTimer.getElapsedTime(), static_cast<int>(nThreads));
+
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      consumed = i + 1;
+    }
+    cv.notify_all();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    abort = true;
+  }
+  cv.notify_all();
+  for(auto &thread : pool)
+    thread.join();
+
+  return status;
+}
+
 int ttkCinemaProductReader::RequestData(vtkInformation *ttkNotUsed(request),
                                         vtkInformationVector **inputVector,
                                         vtkInformationVector *outputVector) {
@@ -108,7 +316,7 @@ int ttkCinemaProductReader::RequestData(vtkInformation *ttkNotUsed(request),
   auto outputMB = vtkMultiBlockDataSet::GetData(outputVector);
 
   size_t n = inputTable->GetNumberOfRows();
-  size_t m = inputTable->GetNumberOfColumns();
+  size_t nBytes = 0;
   // Determine number of files
   this->printMsg(
     {{"#Files", std::to_string(n)}, {"FILE Column", this->FilepathColumnName}});
@@ -124,71 +332,55 @@ int ttkCinemaProductReader::RequestData(vtkInformation *ttkNotUsed(request),
       return 0;
     }
 
-    // For each row
-    for(size_t i = 0; i < n; i++) {
+    if(this->ParallelRead) {
+      std::vector<std::string> filePaths(n);
+      for(size_t i = 0; i < n; i++)
+        filePaths[i] = paths->GetVariantValue(i).ToString();
+      if(!this->readFilesParallel(filePaths, inputTable, outputMB, nBytes))
+        return 0;
+    } else {
+      // For each row
+      for(size_t i = 0; i < n; i++) {
 
-      // initialize timer for individual file
-      ttk::Timer fileTimer;
+        // initialize timer for individual file
+        ttk::Timer fileTimer;
 
-      // get filepath
-      auto path = paths->GetVariantValue(i).ToString();
-      auto file = path.substr(path.find_last_of("/") + 1);
+        // get filepath
+        auto path = paths->GetVariantValue(i).ToString();
+        auto file = path.substr(path.find_last_of("/") + 1);
 
-      // print progress
-      this->printMsg("Reading (" + std::to_string(i + 1) + "/"
-                       + std::to_string(n) + "): \"" + file + "\"",
-                     0, ttk::debug::LineMode::REPLACE);
+        // print progress
+        this->printMsg("Reading (" + std::to_string(i + 1) + "/"
+                         + std::to_string(n) + "): \"" + file + "\"",
+                       0, ttk::debug::LineMode::REPLACE);
+
+        // read local file
+        {
+          std::ifstream infile(path.data(), std::ios::binary | std::ios::ate);
+          bool exists = infile.good();
+          if(!exists) {
+            this->printErr("File does not exist.");
+            return 0;
+          }
+          nBytes += static_cast<size_t>(infile.tellg());
 
-      // read local file
-      {
-        std::ifstream infile(path.data());
-        bool exists = infile.good();
-        if(!exists) {
-          this->printErr("File does not exist.");
-          return 0;
-        }
+          auto readerOutput = this->readFileLocal(path);
+          if(!readerOutput) {
+            this->printErr("Unable to read file.");
+            return 0;
+          }
 
-        auto readerOutput = this->readFileLocal(path);
-        if(!readerOutput) {
-          this->printErr("Unable to read file.");
-          return 0;
+          outputMB->SetBlock(i, readerOutput);
         }
 
-        outputMB->SetBlock(i, readerOutput);
-      }
+        // augment data products with row data
+        {
+          this->addRowData(outputMB->GetBlock(i), inputTable, i);
 
-      // augment data products with row data
-      {
-        auto block = outputMB->GetBlock(i);
-        auto fieldData = block->GetFieldData();
-        for(size_t j = 0; j < m; j++) {
-          auto columnName = inputTable->GetColumnName(j);
-
-          // always write FILE column
-          if(!fieldData->HasArray(columnName)
-             || columnName == this->FilepathColumnName) {
-            if(inputTable->GetColumn(j)->IsNumeric()) {
-              auto c = vtkSmartPointer<vtkDoubleArray>::New();
-              c->SetName(columnName);
-              c->SetNumberOfValues(1);
-              c->SetValue(0, inputTable->GetValue(i, j).ToDouble());
-              fieldData->AddArray(c);
-            } else {
-              auto c = vtkSmartPointer<vtkStringArray>::New();
-              c->SetName(columnName);
-              c->SetNumberOfValues(1);
-              c->SetValue(0, inputTable->GetValue(i, j).ToString());
-              fieldData->AddArray(c);
-            }
-          }
+          this->printMsg("Reading (" + std::to_string(i + 1) + "/"
+                           + std::to_string(n) + "): \"" + file + "\"",
+                         1, fileTimer.getElapsedTime());
         }
-
-        if(this->AddFieldDataRecursively)
-          this->addFieldDataRecursively(block, fieldData);
-
-        this->printMsg("Reading (" + std::to_string(i + 1) + "/"
-                         + std::to_string(n) + "): \"" + file + "\"",
-                       1, fileTimer.getElapsedTime());
       }
     }
   }
@@ -197,6 +389,9 @@ int ttkCinemaProductReader::RequestData(vtkInformation *ttkNotUsed(request),
   this->printMsg(ttk::debug::Separator::L2);
   this->printMsg("Complete (#products: " + std::to_string(n) + ")", 1,
                  timer.getElapsedTime());
+  const double elapsed = std::max(timer.getElapsedTime(), 1e-9);
+  this->printMsg("Throughput: " + std::to_string(n / elapsed) + " files/s, "
+                 + std::to_string(nBytes / elapsed / 1048576.0) + " MB/s");
   this->printMsg(ttk::debug::Separator::L1);
 
   return 1;
@@ -10,6 +10,12 @@
 /// results are stored in a vtkMultiBlockDataSet where each block corresponds to
 /// a row of the table with consistent ordering.
 ///
+/// With ParallelRead, the products are read concurrently by a pool of
+/// threadNumber_ threads that may run up to ReadAhead products ahead of the
+/// assembly of the output, which still happens in row order. XML files with
+/// raw appended data are memory-mapped and their appended block is
+/// pre-faulted before being parsed.
+///
 /// \param Input vtkTable that contains data product references (vtkTable)
 /// \param Output vtkMultiBlockDataSet where each block is a referenced product
 /// of an input table row (vtkMultiBlockDataSet)
@@ -65,6 +71,9 @@
 #include <vtkTIFFReader.h>
 #include <vtkXMLGenericDataObjectReader.h>
 
+class vtkMultiBlockDataSet;
+class vtkTable;
+
 class TTKCINEMAPRODUCTREADER_EXPORT ttkCinemaProductReader
   : public ttkAlgorithm {
 
@@ -76,6 +85,10 @@ public:
   vtkGetMacro(FilepathColumnName, std::string);
   vtkSetMacro(AddFieldDataRecursively, bool);
   vtkGetMacro(AddFieldDataRecursively, bool);
+  vtkSetMacro(ParallelRead, bool);
+  vtkGetMacro(ParallelRead, bool);
+  vtkSetMacro(ReadAhead, int);
+  vtkGetMacro(ReadAhead, int);
 
 protected:
   ttkCinemaProductReader();
@@ -83,6 +96,11 @@ protected:
 
   vtkSmartPointer<vtkDataObject> readFileLocal(const std::string &pathToFile);
   int addFieldDataRecursively(vtkDataObject *object, vtkFieldData *fd);
+  int addRowData(vtkDataObject *block, vtkTable *inputTable, const size_t row);
+  int readFilesParallel(const std::vector<std::string> &paths,
+                        vtkTable *inputTable,
+                        vtkMultiBlockDataSet *outputMB,
+                        size_t &nBytes);
 
   int FillInputPortInformation(int port, vtkInformation *info) override;
   int FillOutputPortInformation(int port, vtkInformation *info) override;
@@ -94,6 +112,8 @@ protected:
 private:
   std::string FilepathColumnName{"FILE"};
   bool AddFieldDataRecursively{true};
+  bool ParallelRead{false};
+  int ReadAhead{4};
 
   // PNG READER
   vtkNew<vtkPNGReader> pngReader{};
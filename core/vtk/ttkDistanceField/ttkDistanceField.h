@@ -36,6 +36,7 @@
 // ttk code includes
 #include <DistanceField.h>
 #include <ttkAlgorithm.h>
+#include <ttkMacros.h>
 
 #include <string>
 
@@ -55,6 +56,9 @@ public:
   vtkSetMacro(ForceInputVertexScalarField, bool);
   vtkGetMacro(ForceInputVertexScalarField, bool);
 
+  ttkSetEnumMacro(Method, METHOD);
+  vtkGetEnumMacro(Method, METHOD);
+
 protected:
   ttkDistanceField();
 
@@ -6,8 +6,17 @@
 #include <vtkInformation.h>
 #include <vtkInformationVector.h>
 #include <vtkMultiBlockDataSet.h>
+#include <vtkSmartPointer.h>
+#include <vtkTrivialProducer.h>
 
 #include <ttkForEach.h>
+#include <ttkTriangulationFactory.h>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <utility>
 
 vtkStandardNewMacro(ttkEndFor);
 
@@ -23,6 +32,8 @@ ttkEndFor::~ttkEndFor() = default;
 int ttkEndFor::FillInputPortInformation(int port, vtkInformation *info) {
   if(port == 0 || port == 1) {
     info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkDataObject", 1);
+    if(port == 0)
+      info->Set(vtkAlgorithm::INPUT_IS_REPEATABLE(), 1);
     return 1;
   }
   return 0;
@@ -46,19 +57,259 @@ static int removeFieldDataRecursively(vtkDataObject *object) {
   return 1;
 }
 
+static ttkForEach *findForEach(vtkAlgorithm *algorithm) {
+  while(algorithm && !algorithm->IsA("ttkForEach")) {
+    algorithm = algorithm->GetInputAlgorithm();
+  }
+  return ttkForEach::SafeDownCast(algorithm);
+}
+
+// collects the filters between the output of a loop body and its ttkForEach
+// head
+static bool collectLoopBody(vtkAlgorithm *algorithm,
+                            vtkAlgorithm *head,
+                            std::vector<vtkAlgorithm *> &filters) {
+  if(algorithm == nullptr)
+    return false;
+  if(algorithm == head)
+    return true;
+
+  bool reachesHead = false;
+  for(int i = 0; i < algorithm->GetNumberOfInputPorts(); i++)
+    for(int j = 0; j < algorithm->GetNumberOfInputConnections(i); j++)
+      if(collectLoopBody(algorithm->GetInputAlgorithm(i, j), head, filters))
+        reachesHead = true;
+
+  if(reachesHead
+     && std::find(filters.begin(), filters.end(), algorithm) == filters.end())
+    filters.emplace_back(algorithm);
+
+  return reachesHead;
+}
+
+static vtkSmartPointer<vtkDataObject> shallowCopy(vtkDataObject *data) {
+  if(!data)
+    return nullptr;
+  auto copy = vtkSmartPointer<vtkDataObject>::Take(data->NewInstance());
+  copy->ShallowCopy(data);
+  return copy;
+}
+
+int ttkEndFor::RequestDataObject(vtkInformation *request,
+                                 vtkInformationVector **inputVector,
+                                 vtkInformationVector *outputVector) {
+  if(this->GetNumberOfInputConnections(0) < 2)
+    return ttkAlgorithm::RequestDataObject(request, inputVector, outputVector);
+
+  // concurrent loop bodies: one block per iteration
+  auto outInfo = outputVector->GetInformationObject(0);
+  if(!vtkMultiBlockDataSet::GetData(outInfo)) {
+    auto output = vtkSmartPointer<vtkMultiBlockDataSet>::New();
+    this->GetOutputPortInformation(0)->Set(
+      vtkDataObject::DATA_TYPE_NAME(), output->GetClassName());
+    outInfo->Set(vtkDataObject::DATA_OBJECT(), output);
+  }
+  return 1;
+}
+
+int ttkEndFor::RequestDataConcurrent(vtkInformation *request,
+                                     vtkInformationVector *outputVector) {
+  ttk::Timer timer;
+
+  // input connection of a loop body filter to a producer outside of the body
+  struct BodyInput {
+    vtkAlgorithm *consumer{};
+    int port{};
+    int index{};
+    vtkSmartPointer<vtkAlgorithmOutput> source{};
+  };
+
+  struct LoopBody {
+    vtkAlgorithm *algorithm{};
+    int port{};
+    ttkForEach *forEach{};
+    int iterationIdx{};
+    // algorithm updated for each iteration
+    vtkAlgorithm *sink{};
+    std::vector<vtkAlgorithm *> filters{};
+    std::vector<std::pair<ttkAlgorithm *, int>> threadNumbers{};
+    // stands for the ttkForEach head during the concurrent iterations
+    vtkSmartPointer<vtkTrivialProducer> head{};
+    std::vector<BodyInput> inputs{};
+  };
+
+  // find the for each head of every loop body
+  const int nBodies = this->GetNumberOfInputConnections(0);
+  std::vector<LoopBody> bodies(nBodies);
+  for(int b = 0; b < nBodies; b++) {
+    auto &body = bodies[b];
+    body.algorithm = this->GetInputAlgorithm(0, b, body.port);
+    body.forEach = findForEach(body.algorithm);
+    if(!body.forEach) {
+      this->printErr("Loop body " + std::to_string(b)
+                     + " not connected to a ttkForEach filter.");
+      return 0;
+    }
+    for(int c = 0; c < b; c++) {
+      if(bodies[c].forEach == body.forEach) {
+        this->printErr("Each loop body requires its own ttkForEach filter.");
+        return 0;
+      }
+    }
+    body.iterationIdx = body.forEach->GetIterationIdx();
+    collectLoopBody(body.algorithm, body.forEach, body.filters);
+  }
+
+  const int n = bodies[0].forEach->GetIterationNumber();
+  for(const auto &body : bodies) {
+    if(body.forEach->GetIterationNumber() != n) {
+      this->printErr("ttkForEach filters with different iteration numbers.");
+      return 0;
+    }
+  }
+
+  // output of each iteration
+  std::vector<vtkSmartPointer<vtkDataObject>> iterations(n);
+  const auto collect = [&](vtkDataObject *data, const int i) {
+    if(!data)
+      return false;
+    iterations[i] = shallowCopy(data);
+    removeFieldDataRecursively(iterations[i]);
+    return true;
+  };
+
+  // keep the iterations computed by the update that triggered this request
+  for(const auto &body : bodies) {
+    const int i = body.iterationIdx - 1;
+    if(i >= 0 && i < n && !iterations[i])
+      collect(body.algorithm->GetOutputDataObject(body.port), i);
+  }
+  std::vector<int> pending{};
+  for(int i = 0; i < n; i++)
+    if(!iterations[i])
+      pending.emplace_back(i);
+
+  // each loop body gets its share of the thread number
+  const int bodyThreadNumber = std::max(1, this->threadNumber_ / nBodies);
+  for(auto &body : bodies) {
+    for(auto algorithm : body.filters) {
+      auto filter = ttkAlgorithm::SafeDownCast(algorithm);
+      if(filter) {
+        body.threadNumbers.emplace_back(filter, filter->getThreadNumber());
+        filter->setThreadNumber(bodyThreadNumber);
+      }
+    }
+  }
+
+  // Detach every loop body from the pipeline shared with the other bodies:
+  // the connections to the ttkForEach head and to the other producers outside
+  // of the body are replaced by trivial producers holding shallow copies of
+  // their outputs. Updating a body then never reaches a shared executive.
+  for(auto &body : bodies) {
+    body.head = vtkSmartPointer<vtkTrivialProducer>::New();
+    for(auto filter : body.filters) {
+      for(int p = 0; p < filter->GetNumberOfInputPorts(); p++) {
+        for(int c = 0; c < filter->GetNumberOfInputConnections(p); c++) {
+          auto source = filter->GetInputConnection(p, c);
+          auto producer = source->GetProducer();
+          if(std::find(body.filters.begin(), body.filters.end(), producer)
+             != body.filters.end())
+            continue;
+          auto copy = body.head;
+          if(producer != body.forEach) {
+            copy = vtkSmartPointer<vtkTrivialProducer>::New();
+            copy->SetOutput(
+              shallowCopy(producer->GetOutputDataObject(source->GetIndex())));
+          }
+          body.inputs.emplace_back(BodyInput{filter, p, c, source});
+          filter->SetNthInputConnection(p, c, copy->GetOutputPort());
+        }
+      }
+    }
+    // empty loop body
+    body.sink = body.algorithm == body.forEach ? body.head : body.algorithm;
+  }
+
+  std::atomic<size_t> next{0};
+  std::atomic<bool> failed{false};
+  std::mutex headMutex{};
+
+  const auto run = [&](const LoopBody &body) {
+    for(size_t k = next++; k < pending.size() && !failed; k = next++) {
+      {
+        // the ttkForEach heads share their upstream pipeline
+        std::lock_guard<std::mutex> lock(headMutex);
+        body.forEach->SetIterationIdx(pending[k]);
+        body.forEach->Modified();
+        body.forEach->Update();
+        body.head->SetOutput(shallowCopy(body.forEach->GetOutputDataObject(0)));
+      }
+      // the filters of the body get triangulations of their own
+      ttkTriangulationFactory::SetThreadRegistry(true);
+      const int port = body.sink == body.head ? 0 : body.port;
+      body.sink->Update(port);
+      ttkTriangulationFactory::SetThreadRegistry(false);
+      if(!collect(body.sink->GetOutputDataObject(port), pending[k]))
+        failed = true;
+    }
+    ttkTriangulationFactory::ReleaseThreadRegistry();
+  };
+
+  std::vector<std::thread> pool{};
+  for(int b = 1; b < nBodies; b++)
+    pool.emplace_back(run, std::cref(bodies[b]));
+  run(bodies[0]);
+  for(auto &thread : pool)
+    thread.join();
+
+  for(auto &body : bodies) {
+    for(const auto &input : body.inputs)
+      input.consumer->SetNthInputConnection(
+        input.port, input.index, input.source);
+    for(const auto &filter : body.threadNumbers)
+      filter.first->setThreadNumber(filter.second);
+    // Bring the ttkForEach head back to the iteration it computed before.
+    // Restoring the connections modified the filters of the body: update
+    // them again, otherwise their outputs would be newer than the output of
+    // this filter and the whole loop would run again on the next update.
+    if(body.iterationIdx > 0) {
+      body.forEach->SetIterationIdx(body.iterationIdx - 1);
+      body.forEach->Modified();
+      body.algorithm->Update(body.port);
+    } else {
+      body.forEach->SetIterationIdx(body.iterationIdx);
+    }
+  }
+
+  request->Remove(vtkStreamingDemandDrivenPipeline::CONTINUE_EXECUTING());
+
+  if(failed) {
+    this->printErr("Unable to compute all the iterations.");
+    return 0;
+  }
+
+  auto output = vtkMultiBlockDataSet::GetData(outputVector);
+  output->SetNumberOfBlocks(n);
+  for(int i = 0; i < n; i++)
+    output->SetBlock(i, iterations[i]);
+
+  this->printMsg("Complete (" + std::to_string(n) + " iterations, "
+                   + std::to_string(nBodies) + " loop bodies, "
+                   + std::to_string(bodyThreadNumber) + " thread(s) each)",
+                 1, timer.getElapsedTime(), this->threadNumber_);
+
+  return 1;
+}
+
 int ttkEndFor::RequestData(vtkInformation *request,
                            vtkInformationVector **inputVector,
                            vtkInformationVector *outputVector) {
 
+  if(this->GetNumberOfInputConnections(0) > 1)
+    return this->RequestDataConcurrent(request, outputVector);
+
   // find for each head
-  ttkForEach *forEach = nullptr;
-  {
-    auto inputAlgorithm = this->GetInputAlgorithm(1, 0);
-    while(inputAlgorithm && !inputAlgorithm->IsA("ttkForEach")) {
-      inputAlgorithm = inputAlgorithm->GetInputAlgorithm();
-    }
-    forEach = ttkForEach::SafeDownCast(inputAlgorithm);
-  }
+  ttkForEach *forEach = findForEach(this->GetInputAlgorithm(1, 0));
 
   if(!forEach) {
     this->printErr("Second input not connected to a ttkForEach filter.");
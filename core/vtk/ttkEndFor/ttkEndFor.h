@@ -11,6 +11,17 @@
 /// \param Input vtkDataObject that will be passed through after all iterations.
 /// \param Output vtkDataObject Shallow copy of the input
 ///
+/// Several loop bodies, each one starting with its own ttkForEach filter, can
+/// be connected to the first input port. In that case the iterations are
+/// distributed over the loop bodies, which are updated concurrently with a
+/// share of the thread number of this filter each, and the output is a
+/// vtkMultiBlockDataSet holding the output of every iteration in order.
+/// VTK cannot clone a pipeline, so the loop bodies have to be built by the
+/// user. During the loop, each body reads shallow copies of its inputs instead
+/// of the shared upstream pipeline and gets triangulations of its own, and
+/// the ttkForEach filters are brought back to their previous iteration
+/// afterwards.
+///
 /// \b Online \b examples: \n
 ///   - <a href="https://topology-tool-kit.github.io/examples/cinemaIO/">Cinema
 ///   IO example</a> \n
@@ -38,6 +49,10 @@ public:
   static ttkEndFor *New();
   vtkTypeMacro(ttkEndFor, ttkAlgorithm);
 
+  void RemoveAllDataInputs() {
+    this->RemoveAllInputConnections(0);
+  }
+
 protected:
   ttkEndFor();
   ~ttkEndFor() override;
@@ -45,7 +60,18 @@ protected:
   int FillInputPortInformation(int port, vtkInformation *info) override;
   int FillOutputPortInformation(int port, vtkInformation *info) override;
 
+  int RequestDataObject(vtkInformation *request,
+                        vtkInformationVector **inputVector,
+                        vtkInformationVector *outputVector) override;
+
   int RequestData(vtkInformation *request,
                   vtkInformationVector **inputVector,
                   vtkInformationVector *outputVector) override;
+
+  /**
+   * Runs all the iterations over the loop bodies connected to the first
+   * input port and collects their outputs in order.
+   */
+  int RequestDataConcurrent(vtkInformation *request,
+                            vtkInformationVector *outputVector);
 };
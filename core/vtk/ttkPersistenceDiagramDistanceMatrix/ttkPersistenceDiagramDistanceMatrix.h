@@ -126,6 +126,28 @@ public:
   vtkSetMacro(MinPersistence, double);
   vtkGetMacro(MinPersistence, double);
 
+  void SetEntries(const int arg_) {
+    this->setEntries(arg_);
+    this->Modified();
+  }
+  int GetEntries() {
+    switch(this->Entries) {
+      case EntriesType::ALL_ENTRIES:
+        return 0;
+      case EntriesType::NEAREST_NEIGHBORS:
+        return 1;
+      case EntriesType::DISTANCE_THRESHOLD:
+        return 2;
+    }
+    return -1;
+  }
+
+  vtkSetMacro(NumberOfNeighbors, unsigned int);
+  vtkGetMacro(NumberOfNeighbors, unsigned int);
+
+  vtkSetMacro(DistanceThreshold, double);
+  vtkGetMacro(DistanceThreshold, double);
+
 protected:
   ttkPersistenceDiagramDistanceMatrix();
   ~ttkPersistenceDiagramDistanceMatrix() override = default;
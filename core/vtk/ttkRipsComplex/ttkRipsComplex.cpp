@@ -72,7 +72,7 @@ int ttkRipsComplex::RequestData(vtkInformation *ttkNotUsed(request),
     return 0;
   }
 
-  if(numberOfColumns != numberOfRows) {
+  if(this->InputIsADistanceMatrix && numberOfColumns != numberOfRows) {
     this->printErr("Input distance matrix is not square (rows: "
                    + std::to_string(numberOfRows)
                    + ", columns: " + std::to_string(numberOfColumns) + ")");
@@ -112,16 +112,6 @@ int ttkRipsComplex::RequestData(vtkInformation *ttkNotUsed(request),
     arrays.push_back(input->GetColumnByName(s.data()));
   }
 
-  std::vector<std::vector<double>> inputMatrix(numberOfRows);
-#ifdef TTK_ENABLE_OPENMP
-#pragma omp parallel for num_threads(this->threadNumber_)
-#endif // TTK_ENABLE_OPENMP
-  for(SimplexId i = 0; i < numberOfRows; ++i) {
-    for(size_t j = 0; j < arrays.size(); ++j) {
-      inputMatrix[i].emplace_back(arrays[j]->GetVariantValue(i).ToDouble());
-    }
-  }
-
   std::vector<ttk::SimplexId> vec_connectivity{};
   std::vector<double> diameters{};
   // PointData diameter statistics (min, mean, max)
@@ -136,14 +126,43 @@ int ttkRipsComplex::RequestData(vtkInformation *ttkNotUsed(request),
   gaussianDensity->SetName("GaussianDensity");
   gaussianDensity->SetNumberOfTuples(numberOfRows);
 
-  const auto ret
-    = this->execute(vec_connectivity, diameters,
-                    std::array<double *const, 3>{
-                      ttkUtils::GetPointer<double>(diamMin),
-                      ttkUtils::GetPointer<double>(diamMean),
-                      ttkUtils::GetPointer<double>(diamMax),
-                    },
-                    inputMatrix, ttkUtils::GetPointer<double>(gaussianDensity));
+  const std::array<double *const, 3> diamStats{
+    ttkUtils::GetPointer<double>(diamMin),
+    ttkUtils::GetPointer<double>(diamMean),
+    ttkUtils::GetPointer<double>(diamMax),
+  };
+
+  int ret{};
+  if(this->InputIsADistanceMatrix) {
+    std::vector<std::vector<double>> inputMatrix(numberOfRows);
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(this->threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+    for(SimplexId i = 0; i < numberOfRows; ++i) {
+      for(size_t j = 0; j < arrays.size(); ++j) {
+        inputMatrix[i].emplace_back(arrays[j]->GetVariantValue(i).ToDouble());
+      }
+    }
+
+    ret = this->execute(vec_connectivity, diameters, diamStats, inputMatrix,
+                        ttkUtils::GetPointer<double>(gaussianDensity));
+  } else {
+    // input columns are the coordinates of the point cloud
+    std::vector<double> inputPoints(numberOfRows * numberOfColumns);
+#ifdef TTK_ENABLE_OPENMP
+#pragma omp parallel for num_threads(this->threadNumber_)
+#endif // TTK_ENABLE_OPENMP
+    for(SimplexId i = 0; i < numberOfRows; ++i) {
+      for(SimplexId j = 0; j < numberOfColumns; ++j) {
+        inputPoints[i * numberOfColumns + j]
+          = arrays[j]->GetVariantValue(i).ToDouble();
+      }
+    }
+
+    ret = this->execute(vec_connectivity, diameters, diamStats,
+                        inputPoints.data(), numberOfRows, numberOfColumns,
+                        ttkUtils::GetPointer<double>(gaussianDensity));
+  }
 
   if(ret != 0) {
     return 0;
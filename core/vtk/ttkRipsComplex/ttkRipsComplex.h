@@ -59,6 +59,9 @@ public:
   vtkSetMacro(Epsilon, double);
   vtkGetMacro(Epsilon, double);
 
+  vtkSetMacro(InputIsADistanceMatrix, bool);
+  vtkGetMacro(InputIsADistanceMatrix, bool);
+
   vtkSetMacro(KeepAllDataArrays, bool);
   vtkGetMacro(KeepAllDataArrays, bool);
 
@@ -66,6 +66,9 @@ int ttkTopologicalCompressionReader::RequestInformation(
   outInfo->Set(vtkDataObject::ORIGIN(), DataOrigin.data(), 3);
   outInfo->Set(
     vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), DataExtent.data(), 6);
+  if(this->canReadSubExtent()) {
+    outInfo->Set(vtkAlgorithm::CAN_PRODUCE_SUB_EXTENT(), 1);
+  }
 
   int numberOfVertices = 1;
   for(int i = 0; i < 3; ++i)
@@ -108,14 +111,36 @@ int ttkTopologicalCompressionReader::RequestData(
     DataExtent[i] = this->getDataExtent()[i];
     DataExtent[3 + i] = this->getDataExtent()[3 + i];
   }
-  int nx = 1 + DataExtent[1] - DataExtent[0];
-  int ny = 1 + DataExtent[3] - DataExtent[2];
-  int nz = 1 + DataExtent[5] - DataExtent[4];
-  int vertexNumber = nx * ny * nz;
   ZFPOnly = this->getZFPOnly();
 
+  // get the info object
+  vtkInformation *outInfo = outputVector->GetInformationObject(0);
+
+  // only decode the bricks of the requested extent
+  std::array<int, 6> readExtent{DataExtent};
+  if(this->canReadSubExtent()
+     && outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT())) {
+    outInfo->Get(
+      vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), readExtent.data());
+    for(int i = 0; i < 3; ++i) {
+      readExtent[2 * i] = std::max(readExtent[2 * i], DataExtent[2 * i]);
+      readExtent[2 * i + 1]
+        = std::min(readExtent[2 * i + 1], DataExtent[2 * i + 1]);
+      if(readExtent[2 * i] > readExtent[2 * i + 1]) {
+        readExtent = DataExtent;
+        break;
+      }
+    }
+  }
+  this->setReadExtent(readExtent.data());
+
+  int nx = 1 + readExtent[1] - readExtent[0];
+  int ny = 1 + readExtent[3] - readExtent[2];
+  int nz = 1 + readExtent[5] - readExtent[4];
+  int vertexNumber = nx * ny * nz;
+
   vtkNew<vtkImageData> mesh{};
-  BuildMesh(mesh);
+  BuildMesh(mesh, readExtent);
 
   auto triangulation = ttkAlgorithm::GetTriangulation(mesh);
   this->preconditionTriangulation(triangulation);
@@ -162,8 +187,6 @@ int ttkTopologicalCompressionReader::RequestData(
                  + " vertice(s), " + std::to_string(mesh->GetNumberOfCells())
                  + " cell(s).");
 
-  // get the info object
-  vtkInformation *outInfo = outputVector->GetInformationObject(0);
   outInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES(), 1);
 
   // Set the output
@@ -178,11 +201,14 @@ vtkImageData *ttkTopologicalCompressionReader::GetOutput() {
   return vtkImageData::SafeDownCast(this->GetOutputDataObject(0));
 }
 
-void ttkTopologicalCompressionReader::BuildMesh(vtkImageData *mesh) const {
-  int nx = 1 + DataExtent[1] - DataExtent[0];
-  int ny = 1 + DataExtent[3] - DataExtent[2];
-  int nz = 1 + DataExtent[5] - DataExtent[4];
-  mesh->SetDimensions(nx, ny, nz);
+void ttkTopologicalCompressionReader::BuildMesh(
+  vtkImageData *mesh, const std::array<int, 6> &readExtent) const {
+  int nx = 1 + readExtent[1] - readExtent[0];
+  int ny = 1 + readExtent[3] - readExtent[2];
+  int nz = 1 + readExtent[5] - readExtent[4];
+  // (sub-)extent of the advertised whole extent
+  mesh->SetExtent(readExtent[0], readExtent[1], readExtent[2], readExtent[3],
+                  readExtent[4], readExtent[5]);
   mesh->SetSpacing(DataSpacing[0], DataSpacing[1], DataSpacing[2]);
   mesh->SetOrigin(DataOrigin[0], DataOrigin[1], DataOrigin[2]);
   mesh->AllocateScalars(DataScalarType, 2);
@@ -6,6 +6,12 @@
 /// \brief VTK-filter that wraps the topologicalCompressionWriter processing
 /// package.
 ///
+/// Files split into bricks can produce sub-extents: only the bricks
+/// intersecting the update extent requested downstream are decoded.
+/// Persistence diagram compressions reconstructed with a topological
+/// simplification are the exception: the simplification is global, so these
+/// files are always decoded as a whole.
+///
 /// \b Online \b examples: \n
 ///   - <a
 ///   href="https://topology-tool-kit.github.io/examples/persistenceDrivenCompression/">Persistence-Driven
@@ -53,7 +59,8 @@ protected:
                          vtkInformationVector *outputVector) override;
 
   // TTK management.
-  void BuildMesh(vtkImageData *mesh) const;
+  void BuildMesh(vtkImageData *mesh,
+                 const std::array<int, 6> &readExtent) const;
 
 private:
   // General properties.
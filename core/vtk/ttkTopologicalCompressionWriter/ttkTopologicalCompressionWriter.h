@@ -65,6 +65,9 @@ public:
   vtkSetMacro(UseTopologicalSimplification, bool);
   vtkGetMacro(UseTopologicalSimplification, bool);
 
+  vtkSetMacro(BrickSize, int);
+  vtkGetMacro(BrickSize, int);
+
   inline void SetSQMethodPV(int c) {
     if(c == 1) {
       SetSQMethod("r");
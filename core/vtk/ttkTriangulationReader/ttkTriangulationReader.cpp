@@ -76,8 +76,11 @@ int ttkTriangulationReader::RequestData(vtkInformation *ttkNotUsed(request),
   if(!this->validateFilePath()) {
     return 0;
   }
-  std::ifstream in(this->TriangulationFilePath);
-  explTri->readFromFile(in);
+  // memory-map the file: the preconditioned arrays are not copied
+  if(explTri->readFromFile(this->TriangulationFilePath) != 0) {
+    this->printErr("Could not read " + this->TriangulationFilePath);
+    return 0;
+  }
 
   this->printMsg("Restored triangulation from " + this->TriangulationFilePath,
                  1.0, timer.getElapsedTime(), 1);
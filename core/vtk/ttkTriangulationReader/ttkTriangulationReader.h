@@ -8,6 +8,10 @@
 /// This filter can be used as any other VTK filter (for instance, by using the
 /// sequence of calls SetInputData(), Update(), GetOutput()).
 ///
+/// The file is memory-mapped: the preconditioned neighbor, star and link
+/// arrays are not copied and are shared between processes reading the same
+/// file.
+///
 /// \param Output Preconditioned triangulation attached to the input dataset
 
 #pragma once
@@ -74,12 +74,17 @@ int ttkTriangulationWriter::Write() {
     return 1;
   }
 
+  int ret{};
   if(this->UseASCIIFormat) {
-    explTri->writeToFileASCII(this->Stream);
+    ret = explTri->writeToFileASCII(this->Stream);
   } else {
-    explTri->writeToFile(this->Stream);
+    ret = explTri->writeToFile(this->Stream);
   }
   this->Stream.flush();
+  if(ret != 0) {
+    this->printErr("Could not write to `" + std::string{Filename} + "'");
+    return 1;
+  }
 
   this->printMsg("Wrote triangulation to " + std::string{this->Filename}, 1.0,
                  tm.getElapsedTime(), 1);